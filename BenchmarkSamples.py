@@ -0,0 +1,93 @@
+# !/usr/bin/env python3
+# Run every sample in benchmark mode and compare the median frame times against a stored baseline.
+import argparse
+import json
+import os
+import pathlib
+import shutil
+import subprocess
+import sys
+
+current_dir = pathlib.Path(__file__).parent.resolve()
+
+parser = argparse.ArgumentParser(description="Benchmark all OpenGL samples")
+parser.add_argument("--build-dir", default=os.path.join(current_dir, "build"))
+parser.add_argument("--baseline-dir", help="Default is benchmark/baseline in the build directory")
+parser.add_argument("--output-dir", help="Default is benchmark/results in the build directory")
+parser.add_argument("--frames", type=int, default=256)
+parser.add_argument("--warmup", type=int, default=16)
+parser.add_argument("--width", type=int, default=1280)
+parser.add_argument("--height", type=int, default=720)
+parser.add_argument("--timeout", type=float, default=600)
+parser.add_argument("--tolerance", type=float, default=0.10, help="Allowed relative increase of the median")
+parser.add_argument("--headless", action=argparse.BooleanOptionalAction, default=True)
+parser.add_argument("--update-baseline", action="store_true", help="Store the results as the new baseline")
+args = parser.parse_args()
+
+# Keep the results out of the source tree.
+if args.baseline_dir is None:
+    args.baseline_dir = os.path.join(args.build_dir, "benchmark", "baseline")
+if args.output_dir is None:
+    args.output_dir = os.path.join(args.build_dir, "benchmark", "results")
+
+executable_dir = os.path.join(args.build_dir, "bin")
+os.makedirs(args.output_dir, exist_ok=True)
+
+failed = []
+regressions = []
+
+for program in sorted(os.listdir(executable_dir)):
+    program_exec_path = os.path.join(executable_dir, program)
+    if not os.path.isfile(program_exec_path) or not os.access(program_exec_path, os.X_OK):
+        continue
+
+    output = os.path.join(args.output_dir, program + ".json")
+    command = [program_exec_path, "--benchmark-frames", str(args.frames), "--benchmark-warmup", str(args.warmup),
+               "--benchmark-output", output, "--width", str(args.width), "--height", str(args.height),
+               "--debug=false"]
+    if args.headless:
+        command.append("--headless")
+
+    print("Running " + program)
+    if os.path.exists(output):
+        os.remove(output)
+    try:
+        subprocess.run(command, cwd=current_dir, timeout=args.timeout, stdout=subprocess.DEVNULL)
+    except subprocess.TimeoutExpired:
+        pass
+
+    if not os.path.exists(output):
+        failed.append(program)
+        continue
+
+    with open(output) as file:
+        result = json.load(file)["summary"]
+
+    baseline_path = os.path.join(args.baseline_dir, program + ".json")
+    if args.update_baseline:
+        os.makedirs(args.baseline_dir, exist_ok=True)
+        shutil.copyfile(output, baseline_path)
+        continue
+    if not os.path.exists(baseline_path):
+        print("  No baseline")
+        continue
+
+    with open(baseline_path) as file:
+        baseline = json.load(file)["summary"]
+
+    for time in ["cpu_ms", "gpu_ms"]:
+        current = result[time]["median"]
+        previous = baseline[time]["median"]
+        change = (current - previous) / previous if previous > 0 else 0
+        print("  {} median {:.3f} ms, baseline {:.3f} ms ({:+.1f}%)".format(time, current, previous, change * 100))
+        if change > args.tolerance:
+            regressions.append("{} {} {:+.1f}%".format(program, time, change * 100))
+
+for program in failed:
+    print("Failed: " + program)
+for regression in regressions:
+    print("Regression: " + regression)
+
+# Samples without results only fail the run if they have a baseline.
+failed = [program for program in failed if os.path.exists(os.path.join(args.baseline_dir, program + ".json"))]
+sys.exit(1 if regressions or failed else 0)
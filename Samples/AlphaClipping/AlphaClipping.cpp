@@ -41,9 +41,7 @@ namespace glsample {
 
 		/*	Uniform buffer.	*/
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		MeshObject planGeometry;
 
@@ -87,9 +85,6 @@ namespace glsample {
 			/*	Delete texture.	*/
 			glDeleteTextures(1, (const GLuint *)&this->diffuse_texture);
 
-			/*	Delete uniform buffer.	*/
-			glDeleteBuffers(1, &this->uniform_buffer);
-
 			/*	Delete geometry data.	*/
 			glDeleteVertexArrays(1, &this->planGeometry.vao);
 			glDeleteBuffers(1, &this->planGeometry.vbo);
@@ -130,17 +125,6 @@ namespace glsample {
 			TextureImporter textureImporter(this->getFileSystem());
 			this->diffuse_texture = textureImporter.loadImage2D(texturePath, ColorSpace::SRGB);
 
-			/*	Align the uniform buffer size to hardware specific.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformSize = Math::align<size_t>(this->uniformSize, (size_t)minMapBufferSize);
-
-			/*	Create uniform buffer, with round robin support.	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformSize * this->nrUniformBuffer, nullptr, GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	Load geometry.	*/
 			Common::loadCube(this->planGeometry, 1, 1, 1);
 		}
@@ -164,9 +148,8 @@ namespace glsample {
 
 			{
 				/*	Bind subset of the uniform buffer, that the graphic pipeline will use.	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformSize,
-								  this->uniformSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 				/*	Activate texture graphic pipeline.	*/
 				glUseProgram(this->texture_program);
@@ -199,12 +182,7 @@ namespace glsample {
 				(this->uniform_stage_buffer.proj * this->camera.getViewMatrix());
 
 			/*	Update uniform buffer.	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			void *uniformMappedMemory = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformSize,
-				this->uniformSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			memcpy(uniformMappedMemory, &this->uniform_stage_buffer, sizeof(this->uniform_stage_buffer));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniform_stage_buffer);
 		}
 	};
 
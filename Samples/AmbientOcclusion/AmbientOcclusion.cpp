@@ -101,13 +101,8 @@ namespace glsample {
 		/*	Uniform buffer.	*/
 		unsigned int uniform_buffer_binding = 0;
 		unsigned int uniform_ssao_buffer_binding = 1;
-		unsigned int uniform_buffer{};
-		unsigned int uniform_ssao_buffer{};
-		const size_t nrUniformBuffer = 3;
-
-		/*	*/
-		size_t uniformBufferAlignedSize = sizeof(uniform_buffer_block);
-		size_t uniformSSAOBufferAlignSize = sizeof(UniformSSAOBufferBlock);
+		FrameRingAllocator::Allocation uniform_allocation{};
+		FrameRingAllocator::Allocation uniform_ssao_allocation{};
 
 		CameraController camera;
 
@@ -191,9 +186,6 @@ namespace glsample {
 			glDeleteTextures(1, &this->white_texture);
 			glDeleteTextures(1, &this->ssaoTexture);
 
-			/*	Delete uniform buffer.	*/
-			glDeleteBuffers(1, &this->uniform_buffer);
-
 			/*	Delete geometry data.	*/
 			glDeleteVertexArrays(1, &this->plan.vao);
 			glDeleteBuffers(1, &this->plan.vbo);
@@ -233,21 +225,31 @@ namespace glsample {
 				const std::vector<uint32_t> texture_fragment_binary =
 					IOUtil::readFileData<uint32_t>(this->fragmentOverlayTextureShaderPath, this->getFileSystem());
 
+				/*	Compile all programs concurrently.	*/
+				ShaderProgramBatch programBatch;
+
 				/*	Load shader	*/
-				this->ssao_world_program =
-					ShaderLoader::loadGraphicProgram(compilerOptions, &vertex_ssao_binary, &fragment_ssao_binary);
+				const size_t ssao_world_index =
+					programBatch.addGraphicProgram(compilerOptions, &vertex_ssao_binary, &fragment_ssao_binary);
 
 				/*	Load shader	*/
-				this->ssao_depth_program = ShaderLoader::loadGraphicProgram(
+				const size_t ssao_depth_index = programBatch.addGraphicProgram(
 					compilerOptions, &vertex_ssao_depth_only_binary, &fragment_ssao_depth_onlysource);
 
 				/*	Load shader	*/
-				this->multipass_program = ShaderLoader::loadGraphicProgram(compilerOptions, &vertex_multi_pass_binary,
-																		   &fragment_multi_pass_binary);
+				const size_t multipass_index = programBatch.addGraphicProgram(
+					compilerOptions, &vertex_multi_pass_binary, &fragment_multi_pass_binary);
 
 				/*	Load shader	*/
-				this->texture_program =
-					ShaderLoader::loadGraphicProgram(compilerOptions, &texture_vertex_binary, &texture_fragment_binary);
+				const size_t texture_index =
+					programBatch.addGraphicProgram(compilerOptions, &texture_vertex_binary, &texture_fragment_binary);
+
+				programBatch.submit();
+
+				this->ssao_world_program = programBatch.getProgram(ssao_world_index);
+				this->ssao_depth_program = programBatch.getProgram(ssao_depth_index);
+				this->multipass_program = programBatch.getProgram(multipass_index);
+				this->texture_program = programBatch.getProgram(texture_index);
 			}
 
 			/*	Setup graphic ambient occlusion pipeline.	*/
@@ -289,28 +291,6 @@ namespace glsample {
 			glUniform1i(glGetUniformLocation(this->texture_program, "ColorTexture"), 0);
 			glUseProgram(0);
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformBufferAlignedSize =
-				fragcore::Math::align<size_t>(this->uniformBufferAlignedSize, (size_t)minMapBufferSize);
-			this->uniformSSAOBufferAlignSize =
-				fragcore::Math::align<size_t>(this->uniformSSAOBufferAlignSize, (size_t)minMapBufferSize);
-
-			/*	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBufferARB(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformBufferAlignedSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBufferARB(GL_UNIFORM_BUFFER, 0);
-
-			/*	*/
-			glGenBuffers(1, &this->uniform_ssao_buffer);
-			glBindBufferARB(GL_UNIFORM_BUFFER, this->uniform_ssao_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformSSAOBufferAlignSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBufferARB(GL_UNIFORM_BUFFER, 0);
-
 			/*	*/
 			ModelImporter modelLoader(FileSystem::getFileSystem());
 			modelLoader.loadContent(modelPath, 0);
@@ -523,9 +503,8 @@ namespace glsample {
 			/*	G-Buffer extraction.	*/
 			{
 				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformBufferAlignedSize,
-								  this->uniformBufferAlignedSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 				glBindFramebuffer(GL_FRAMEBUFFER, this->multipass_framebuffer);
 				glViewport(0, 0, this->multipass_texture_width, this->multipass_texture_height);
@@ -547,9 +526,9 @@ namespace glsample {
 			/*	Draw post processing effect - Screen Space Ambient Occlusion.	*/
 			if (this->ambientOcclusionSettingComponent->useAO) {
 
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_ssao_buffer_binding, this->uniform_ssao_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformSSAOBufferAlignSize,
-								  this->uniformSSAOBufferAlignSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_ssao_buffer_binding,
+								  this->uniform_ssao_allocation.buffer, this->uniform_ssao_allocation.offset,
+								  this->uniform_ssao_allocation.size);
 
 				glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->ssao_framebuffer);
 
@@ -706,24 +685,10 @@ namespace glsample {
 
 			/*	Update uniform buffers.	*/
 			{
-				glBindBufferARB(GL_UNIFORM_BUFFER, this->uniform_buffer);
-				void *uniformPointer = glMapBufferRange(
-					GL_UNIFORM_BUFFER,
-					((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformBufferAlignedSize,
-					this->uniformBufferAlignedSize,
-					GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-				memcpy(uniformPointer, &this->uniformStageBlock, sizeof(uniformStageBlock));
-				glUnmapBufferARB(GL_UNIFORM_BUFFER);
+				this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBlock);
 
 				/*	*/
-				glBindBufferARB(GL_UNIFORM_BUFFER, this->uniform_ssao_buffer);
-				void *uniformSSAOPointer = glMapBufferRange(
-					GL_UNIFORM_BUFFER,
-					((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformSSAOBufferAlignSize,
-					this->uniformSSAOBufferAlignSize,
-					GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-				memcpy(uniformSSAOPointer, &this->uniformStageBlockSSAO, sizeof(uniformStageBlockSSAO));
-				glUnmapBufferARB(GL_UNIFORM_BUFFER);
+				this->uniform_ssao_allocation = this->getFrameAllocator().allocate(this->uniformStageBlockSSAO);
 			}
 		}
 	};
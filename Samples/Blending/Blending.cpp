@@ -64,11 +64,8 @@ namespace glsample {
 		/*	Uniform buffer.	*/
 		unsigned int uniform_instance_buffer_binding = 1;
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_share_buffer{};
-		unsigned int uniform_instance_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
-		size_t uniformInstanceSize = 0;
+		FrameRingAllocator::Allocation uniform_share_allocation{};
+		FrameRingAllocator::Allocation uniform_instance_allocation{};
 
 		CameraController camera;
 
@@ -106,9 +103,6 @@ namespace glsample {
 			/*	Delete texture.	*/
 			glDeleteTextures(1, (const GLuint *)&this->diffuse_texture);
 
-			/*	Delete uniform buffer.	*/
-			glDeleteBuffers(1, &this->uniform_share_buffer);
-
 			/*	Delete geometry data.	*/
 			glDeleteVertexArrays(1, &this->geometry.vao);
 			glDeleteBuffers(1, &this->geometry.vbo);
@@ -152,26 +146,6 @@ namespace glsample {
 			this->diffuse_texture = textureImporter.loadImage2D(diffuseTexturePath);
 			this->ground_diffuse_texture = textureImporter.loadImage2D(diffuseGroundTexturePath);
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize = Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
-			/*	Create uniform buffer.	*/
-			glGenBuffers(1, &this->uniform_share_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_share_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
-			/*	*/
-			this->uniformInstanceSize = fragcore::Math::align<size_t>(sizeof(instanceBuffer), (size_t)minMapBufferSize);
-			glGenBuffers(1, &this->uniform_instance_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_instance_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformInstanceSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	Load geometry.	*/
 			glsample::Common::loadCube(this->geometry, 1);
 			glsample::Common::loadPlan(this->plan, 1);
@@ -192,14 +166,13 @@ namespace glsample {
 			// TODO draw multiple instance with various position and color to show the blending.
 
 			/*	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_share_buffer,
-							  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_share_allocation.buffer,
+							  this->uniform_share_allocation.offset, this->uniform_share_allocation.size);
 
 			/*	Bind Model Instance Uniform Buffer.	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_instance_buffer_binding, this->uniform_instance_buffer,
-							  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformInstanceSize,
-							  this->uniformInstanceSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_instance_buffer_binding,
+							  this->uniform_instance_allocation.buffer, this->uniform_instance_allocation.offset,
+							  this->uniform_instance_allocation.size);
 
 			/*	*/
 			glViewport(0, 0, width, height);
@@ -209,9 +182,9 @@ namespace glsample {
 			/*	Draw plan.	*/
 			{
 				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_share_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding,
+								  this->uniform_share_allocation.buffer, this->uniform_share_allocation.offset,
+								  this->uniform_share_allocation.size);
 
 				glUseProgram(this->blending_program);
 
@@ -299,21 +272,10 @@ namespace glsample {
 			}
 
 			/*	Update uniform.	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_share_buffer);
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize,
-				GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_share_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 
 			/*	Update instance buffer.	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_instance_buffer);
-			void *uniformInstance = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformInstanceSize,
-				this->uniformInstanceSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			memcpy(uniformInstance, &instanceBuffer, sizeof(this->instanceBuffer));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_instance_allocation = this->getFrameAllocator().allocate(instanceBuffer);
 		}
 	};
 
@@ -68,9 +68,7 @@ namespace glsample {
 
 		/*	*/
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		/*	Particle.	*/
 		const std::string particleVertexShaderPath = "Shaders/vectorfield/particle.vert.spv";
@@ -179,18 +177,6 @@ namespace glsample {
 			glGetProgramiv(this->circle_packing_program, GL_COMPUTE_WORK_GROUP_SIZE, this->localWorkGroupSize);
 			glUseProgram(0);
 
-			/*	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize = Math::align<size_t>(this->uniformAlignBufferSize, minMapBufferSize);
-
-			/*	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, uniformAlignBufferSize * this->nrUniformBuffer, nullptr, GL_DYNAMIC_DRAW);
-			glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(uniformStageBuffer), &uniformStageBuffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			GLint minStorageMapBufferSize = 0;
 			glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &minStorageMapBufferSize);
 
@@ -255,9 +241,8 @@ namespace glsample {
 				glUseProgram(this->circle_packing_program);
 
 				/*	Bind uniform buffer.	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 				/*	Bind read particle buffer.	*/
 				glBindBufferRange(GL_SHADER_STORAGE_BUFFER, this->circle_packing_read_buffer_binding,
@@ -341,14 +326,7 @@ namespace glsample {
 			}
 
 			/*	Bind buffer and update region with new data.	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-
-			memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 		}
 	};
 
@@ -71,11 +71,10 @@ namespace glsample {
 		unsigned int uniform_buffer_binding = 0;
 		unsigned int uniform_instance_buffer_binding = 1;
 		/*	*/
-		unsigned int uniform_buffer{};
+		FrameRingAllocator::Allocation uniform_allocation{};
 		unsigned int uniform_instance_buffer{};
 		unsigned int indirect_buffer{};
 		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
 		size_t uniformInstanceMemorySize = 0;
 		const size_t maxGroupSize[3] = {24, 24, 24};
 
@@ -117,7 +116,6 @@ namespace glsample {
 			glDeleteProgram(this->compute_group_visual_compute_program);
 
 			/*	*/
-			glDeleteBuffers(1, &this->uniform_buffer);
 			glDeleteBuffers(1, &this->uniform_instance_buffer);
 			glDeleteBuffers(1, &this->indirect_buffer);
 		}
@@ -199,21 +197,9 @@ namespace glsample {
 			maxWorkGroupCount[1] = Math::min<int>(maxGroupSize[1], maxWorkGroupCount[1]);
 			maxWorkGroupCount[2] = Math::min<int>(maxGroupSize[2], maxWorkGroupCount[2]);
 
-			/*	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize = Math::align<size_t>(this->uniformAlignBufferSize, minMapBufferSize);
-
 			GLint SSBO_align_offset = 0;
 			glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &SSBO_align_offset);
 
-			/*	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, uniformAlignBufferSize * this->nrUniformBuffer, nullptr, GL_DYNAMIC_DRAW);
-			glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(uniformStageBuffer), &this->uniformStageBuffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	*/
 			glGenBuffers(1, &this->indirect_buffer);
 			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, this->indirect_buffer);
@@ -252,14 +238,15 @@ namespace glsample {
 			int width = 0, height = 0;
 			this->getSize(&width, &height);
 
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			if (this->computeGroupVisualSettingComponent->needUpdate) {
 
-				refreshWholeRoundRobinBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer, this->nrUniformBuffer,
-											 &this->uniformStageBuffer, this->uniformAlignBufferSize);
+				/*	Settings changed after the update, use them directly.	*/
+				this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 				glUseProgram(this->compute_group_visual_compute_program);
 
@@ -353,15 +340,7 @@ namespace glsample {
 			}
 
 			/*	Bind buffer and update region with new data.	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-
-			memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 		}
 	};
 
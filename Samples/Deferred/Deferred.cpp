@@ -1,3 +1,4 @@
+#include "ClusteredLights.h"
 #include "GLUIComponent.h"
 #include "SampleHelper.h"
 #include "Scene.h"
@@ -10,9 +11,16 @@
 #include <ModelImporter.h>
 #include <ShaderLoader.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <magic_enum.hpp>
+#include <random>
 
 namespace glsample {
 
+	enum class PointLightPass : unsigned int {
+		LightVolume = 0, /*	Instanced sphere per light, scaled by the light radius.	*/
+		Clustered = 1,	 /*	Fullscreen pass over the lights of each pixel cluster.	*/
+	};
+
 	/**
 	 * Deferred Rendering Path Sample.
 	 **/
@@ -56,6 +64,10 @@ namespace glsample {
 		Scene scene;	   /*	World Scene.	*/
 		Skybox skybox;	   /*	*/
 
+		/*	Point lights binned into view space clusters, the light buffer is shared by both passes.	*/
+		ClusteredLights clusteredLights;
+		static constexpr int maxPointLights = 16384;
+
 		/*	*/
 		unsigned int deferred_framebuffer{};
 		unsigned int deferred_texture_width{};
@@ -67,6 +79,7 @@ namespace glsample {
 		unsigned int deferred_pointlight_program{};
 		unsigned int deferred_pointlight_debug_program{};
 		unsigned int deferred_directional_program{};
+		unsigned int deferred_clustered_program{};
 		unsigned int multipass_program{};
 		unsigned int instance_program{};
 		unsigned int skybox_program{};
@@ -74,11 +87,11 @@ namespace glsample {
 		/*	*/
 		unsigned int uniform_buffer_binding = 0;
 		unsigned int uniform_pointlight_buffer_binding = 1;
-		unsigned int uniform_buffer{};
-		unsigned int uniform_light_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
-		size_t uniformLightBufferSize = 0;
+		unsigned int uniform_cluster_buffer_binding = 6;
+		unsigned int storage_light_buffer_binding = 7;
+		unsigned int storage_cluster_buffer_binding = 8;
+		unsigned int storage_index_buffer_binding = 9;
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		/*	*/
 		CameraController camera;
@@ -91,6 +104,7 @@ namespace glsample {
 		const std::string vertexDeferredPointShaderPath = "Shaders/deferred/deferred_point.vert.spv";
 		const std::string fragmentDeferredPointShaderPath = "Shaders/deferred/deferred_point.frag.spv";
 		const std::string fragmentDeferredPointDebugShaderPath = "Shaders/deferred/deferred_point_debug.frag.spv";
+		const std::string fragmentDeferredClusteredShaderPath = "Shaders/deferred/deferred_clustered.frag.spv";
 
 		/*	Directional light.	*/
 		const std::string vertexDeferredDirectionalShaderPath = "Shaders/deferred/deferred_directional.vert.spv";
@@ -125,19 +139,39 @@ namespace glsample {
 
 				// ImGui::ColorEdit4("Light", &this->uniform.lightColor[0], ImGuiColorEditFlags_Float);
 
-				if (ImGui::DragInt("Number of PointLights", &nrPointLights, 1, 0, 64)) {
-					// TODO add
+				if (ImGui::DragInt("Number of PointLights", &nrPointLights, 1, 0, Deferred::maxPointLights)) {
+					this->getRefSample().generatePointLights();
 				}
-				for (int i = 0; i < nrPointLights; i++) {
+				if (ImGui::DragFloat("Light Radius", &lightRadius, 0.1f, 0.1f, 100.0f)) {
+					this->getRefSample().generatePointLights();
+				}
+
+				if (ImGui::BeginCombo("Point Light Pass", magic_enum::enum_name(this->lightPass).data())) {
+					for (const auto &[pass, name] : magic_enum::enum_entries<PointLightPass>()) {
+						if (ImGui::Selectable(name.data(), pass == this->lightPass)) {
+							this->lightPass = pass;
+						}
+					}
+					ImGui::EndCombo();
+				}
+				if (ImGui::Checkbox("Compute Light Assignment", &this->computeAssignment)) {
+					this->getRefSample().clusteredLights.setUseCompute(this->computeAssignment);
+				}
+				ImGui::Text("Light Indices %zu", this->getRefSample().clusteredLights.getNrLightIndices());
+
+				/*	Only the first lights are editable.	*/
+				for (int i = 0; i < std::min(nrPointLights, 64); i++) {
 					ImGui::PushID(1000 + i);
 					if (ImGui::CollapsingHeader(fmt::format("Light {}", i).c_str())) {
 
-						ImGui::ColorEdit4("Color", &this->getRefSample().pointLights[i].color[0],
-										  ImGuiColorEditFlags_HDR | ImGuiColorEditFlags_Float);
-						ImGui::DragFloat3("Position", &this->getRefSample().pointLights[i].position[0]);
-						ImGui::DragFloat3("Attenuation", &this->getRefSample().pointLights[i].constant_attenuation);
-						ImGui::DragFloat("Range", &this->getRefSample().pointLights[i].range);
-						ImGui::DragFloat("Intensity", &this->getRefSample().pointLights[i].intensity);
+						PointLightInstance &pointLight = this->getRefSample().pointLights[i];
+						bool changed = ImGui::ColorEdit4("Color", &pointLight.color[0],
+														 ImGuiColorEditFlags_HDR | ImGuiColorEditFlags_Float);
+						changed |= ImGui::DragFloat3("Position", &pointLight.position[0]);
+						changed |= ImGui::DragFloat3("Attenuation", &pointLight.constant_attenuation);
+						changed |= ImGui::DragFloat("Range", &pointLight.range);
+						changed |= ImGui::DragFloat("Intensity", &pointLight.intensity);
+						this->lightsChanged |= changed;
 					}
 					ImGui::PopID();
 				}
@@ -155,8 +189,12 @@ namespace glsample {
 			bool showGBuffers = false;
 			bool showLight = false;
 
-			int nrPointLights = 1;
+			int nrPointLights = 4096;
 			int nrDirectionalLights = 1;
+			float lightRadius = 6.0f;
+			PointLightPass lightPass = PointLightPass::Clustered;
+			bool computeAssignment = false;
+			bool lightsChanged = false;
 
 		  private:
 		};
@@ -165,6 +203,8 @@ namespace glsample {
 		void Release() override {
 			glDeleteProgram(this->deferred_pointlight_program);
 			glDeleteProgram(this->deferred_directional_program);
+			glDeleteProgram(this->deferred_pointlight_debug_program);
+			glDeleteProgram(this->deferred_clustered_program);
 
 			glDeleteProgram(this->multipass_program);
 			glDeleteProgram(this->skybox_program);
@@ -174,7 +214,7 @@ namespace glsample {
 			glDeleteTextures(this->deferred_textures.size(), this->deferred_textures.data());
 
 			/*	*/
-			glDeleteBuffers(1, &this->uniform_buffer);
+			this->clusteredLights.release();
 
 			/*	*/
 			glDeleteVertexArrays(1, &this->plan.vao);
@@ -187,8 +227,6 @@ namespace glsample {
 			const std::string modelPath = this->getResult()["model"].as<std::string>();
 			const std::string panoramicPath = this->getResult()["skybox"].as<std::string>();
 
-			this->pointLights.resize(64);
-
 			{
 				/*	*/
 				const std::vector<uint32_t> vertex_binary =
@@ -206,6 +244,8 @@ namespace glsample {
 					IOUtil::readFileData<uint32_t>(fragmentDeferredPointShaderPath, this->getFileSystem());
 				const std::vector<uint32_t> fragment_binary_deferred_point_debug =
 					IOUtil::readFileData<uint32_t>(fragmentDeferredPointDebugShaderPath, this->getFileSystem());
+				const std::vector<uint32_t> fragment_binary_deferred_clustered =
+					IOUtil::readFileData<uint32_t>(fragmentDeferredClusteredShaderPath, this->getFileSystem());
 
 				const std::vector<uint32_t> vertex_binary_deferred_light =
 					IOUtil::readFileData<uint32_t>(vertexDeferredDirectionalShaderPath, this->getFileSystem());
@@ -228,25 +268,41 @@ namespace glsample {
 				compilerOptions.target = fragcore::ShaderLanguage::GLSL;
 				compilerOptions.glslVersion = this->getShaderVersion();
 
+				/*	Compile all programs concurrently.	*/
+				ShaderProgramBatch programBatch;
+
 				/*	Create .	*/
-				this->instance_program = ShaderLoader::loadGraphicProgram(compilerOptions, &vertex_instance_binary,
-																		  &fragment_instance_binary);
+				const size_t instance_index = programBatch.addGraphicProgram(compilerOptions, &vertex_instance_binary,
+																			 &fragment_instance_binary);
 
 				/*	Load shader	*/
-				this->deferred_pointlight_program = ShaderLoader::loadGraphicProgram(
+				const size_t deferred_pointlight_index = programBatch.addGraphicProgram(
 					compilerOptions, &vertex_binary_deferred_point, &fragment_binary_deferred_point);
 
-				this->deferred_pointlight_debug_program = ShaderLoader::loadGraphicProgram(
+				const size_t deferred_pointlight_debug_index = programBatch.addGraphicProgram(
 					compilerOptions, &vertex_binary_deferred_point, &fragment_binary_deferred_point_debug);
 
-				this->deferred_directional_program = ShaderLoader::loadGraphicProgram(
+				const size_t deferred_directional_index = programBatch.addGraphicProgram(
 					compilerOptions, &vertex_binary_deferred_light, &fragment_binary_deferred_light);
 
+				/*	Fullscreen, same vertex stage as the directional light.	*/
+				const size_t deferred_clustered_index = programBatch.addGraphicProgram(
+					compilerOptions, &vertex_binary_deferred_light, &fragment_binary_deferred_clustered);
+
 				/*	Load shader	*/
-				this->multipass_program =
-					ShaderLoader::loadGraphicProgram(compilerOptions, &vertex_binary, &fragment_binary);
+				const size_t multipass_index =
+					programBatch.addGraphicProgram(compilerOptions, &vertex_binary, &fragment_binary);
+
+				programBatch.submit();
 
 				this->skybox_program = Skybox::loadDefaultProgram(this->getFileSystem());
+
+				this->instance_program = programBatch.getProgram(instance_index);
+				this->deferred_pointlight_program = programBatch.getProgram(deferred_pointlight_index);
+				this->deferred_pointlight_debug_program = programBatch.getProgram(deferred_pointlight_debug_index);
+				this->deferred_directional_program = programBatch.getProgram(deferred_directional_index);
+				this->deferred_clustered_program = programBatch.getProgram(deferred_clustered_index);
+				this->multipass_program = programBatch.getProgram(multipass_index);
 			}
 
 			/*	Setup graphic pipeline.	*/
@@ -258,32 +314,32 @@ namespace glsample {
 			glUniformBlockBinding(this->multipass_program, uniform_buffer_index, this->uniform_buffer_binding);
 			glUseProgram(0);
 
-			/*	Setup graphic pipeline.	*/
-			glUseProgram(this->deferred_pointlight_program);
-			uniform_buffer_index = glGetUniformBlockIndex(this->deferred_pointlight_program, "UniformBufferBlock");
-			int uniform_buffer_pointlight_index =
-				glGetUniformBlockIndex(this->deferred_pointlight_program, "UniformBufferLight");
-			glUniform1i(glGetUniformLocation(this->deferred_pointlight_program, "AlbedoTexture"), 0);
-			glUniform1i(glGetUniformLocation(this->deferred_pointlight_program, "WorldTexture"), 1);
-			glUniform1i(glGetUniformLocation(this->deferred_pointlight_program, "NormalTexture"), 3);
-
-			glUniformBlockBinding(this->deferred_pointlight_program, uniform_buffer_index,
-								  this->uniform_buffer_binding);
-			glUniformBlockBinding(this->deferred_pointlight_program, uniform_buffer_pointlight_index,
-								  this->uniform_pointlight_buffer_binding);
-			glUseProgram(0);
-
-			/*	Setup graphic pipeline.	*/
-			glUseProgram(this->deferred_pointlight_debug_program);
-			uniform_buffer_index =
-				glGetUniformBlockIndex(this->deferred_pointlight_debug_program, "UniformBufferBlock");
-			uniform_buffer_pointlight_index =
-				glGetUniformBlockIndex(this->deferred_pointlight_program, "UniformBufferLight");
-
-			glUniformBlockBinding(this->deferred_pointlight_program, uniform_buffer_index,
-								  this->uniform_buffer_binding);
-			glUniformBlockBinding(this->deferred_pointlight_program, uniform_buffer_pointlight_index,
-								  this->uniform_pointlight_buffer_binding);
+			/*	Setup graphic pipeline, the point light passes read the lights and clusters from storage buffers.	*/
+			for (const unsigned int program : {this->deferred_pointlight_program,
+											   this->deferred_pointlight_debug_program,
+											   this->deferred_clustered_program}) {
+				glUseProgram(program);
+				uniform_buffer_index = glGetUniformBlockIndex(program, "UniformBufferBlock");
+				const int uniform_cluster_index = glGetUniformBlockIndex(program, "UniformClusterBufferBlock");
+				glUniform1i(glGetUniformLocation(program, "AlbedoTexture"), 0);
+				glUniform1i(glGetUniformLocation(program, "WorldTexture"), 1);
+				glUniform1i(glGetUniformLocation(program, "NormalTexture"), 3);
+
+				glUniformBlockBinding(program, uniform_buffer_index, this->uniform_buffer_binding);
+				glUniformBlockBinding(program, uniform_cluster_index, this->uniform_cluster_buffer_binding);
+
+				const std::pair<const char *, unsigned int> storageBlocks[] = {
+					{"ClusterLightBuffer", this->storage_light_buffer_binding},
+					{"ClusterRangeBuffer", this->storage_cluster_buffer_binding},
+					{"ClusterIndexBuffer", this->storage_index_buffer_binding}};
+				for (const auto &block : storageBlocks) {
+					const unsigned int block_index =
+						glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, block.first);
+					if (block_index != GL_INVALID_INDEX) {
+						glShaderStorageBlockBinding(program, block_index, block.second);
+					}
+				}
+			}
 			glUseProgram(0);
 
 			/*	Setup graphic pipeline.	*/
@@ -307,28 +363,8 @@ namespace glsample {
 			glUniformBlockBinding(this->instance_program, uniform_buffer_index, 0);
 			glUseProgram(0);
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-			this->uniformLightBufferSize = (sizeof(pointLights[0]) * pointLights.size());
-			this->uniformLightBufferSize =
-				fragcore::Math::align<size_t>(uniformLightBufferSize, (size_t)minMapBufferSize);
-
 			/*	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
-			/*	*/
-			glGenBuffers(1, &this->uniform_light_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_light_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformLightBufferSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			this->clusteredLights.init(this->getFileSystem());
 
 			/*	load Textures	*/
 			TextureImporter textureImporter(this->getFileSystem());
@@ -419,18 +455,44 @@ namespace glsample {
 			}
 
 			/*	Setup init lights.	*/
+			this->generatePointLights();
+			this->directionalLights.emplace_back();
+		}
+
+		/**
+		 * @brief Scatter the point lights over the scene, with the quadratic attenuation chosen to reach the
+		 * cluster threshold at the light radius of the settings.
+		 */
+		void generatePointLights() {
+			const int nrPointLights = std::clamp(this->deferredSettingComponent->nrPointLights, 0, maxPointLights);
+			const float radius = this->deferredSettingComponent->lightRadius;
+
+			std::mt19937 generator(1234);
+			std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+			this->pointLights.resize(nrPointLights);
 			for (size_t i = 0; i < this->pointLights.size(); i++) {
+				PointLightInstance &pointLight = this->pointLights[i];
+
 				/*	*/
-				this->pointLights[i].range = 20.0f;
-				this->pointLights[i].position = glm::vec3(i * -2.0f, 0.5f, i * -2.5f) * 5.0f + glm::vec3(2.0f);
-				this->pointLights[i].color =
-					glm::vec4(std::fabs(std::cos(i)), std::fabs(std::sin(i)) + 0.1, std::fabs(cos(i)), 1);
-				this->pointLights[i].constant_attenuation = 1.7f;
-				this->pointLights[i].linear_attenuation = 1.5f;
-				this->pointLights[i].quadratic_attenuation = 0.19f;
-				this->pointLights[i].intensity = 1.5f;
+				const glm::vec3 random = glm::vec3(unit(generator), unit(generator), unit(generator));
+				pointLight.position = (random - glm::vec3(0.5f, 0.0f, 0.5f)) * glm::vec3(60.0f, 25.0f, 30.0f);
+				pointLight.color =
+					glm::vec4(std::fabs(std::cos(i)), std::fabs(std::sin(i)) + 0.1, std::fabs(std::cos(i * 0.5f)), 1);
+				pointLight.range = 1.0f;
+				pointLight.intensity = 1.5f;
+
+				/*	peak / (constant + quadratic * radius^2) = threshold.	*/
+				const float peak = std::max(std::max(pointLight.color.r, pointLight.color.g), pointLight.color.b) *
+								   pointLight.range * pointLight.intensity;
+				pointLight.constant_attenuation = 1.0f;
+				pointLight.linear_attenuation = 0.0f;
+				pointLight.quadratic_attenuation =
+					std::max(peak / this->clusteredLights.getThreshold() - pointLight.constant_attenuation, 0.0f) /
+					(radius * radius);
 			}
-			this->directionalLights.emplace_back();
+
+			this->clusteredLights.setPointLights(this->pointLights.data(), this->pointLights.size());
 		}
 
 		void onResize(int width, int height) override {
@@ -488,7 +550,9 @@ namespace glsample {
 			this->camera.setAspect((float)width / (float)height);
 		}
 
-		float computePointLightRadius(const PointLightInstance &pointLight) const noexcept { return 0; }
+		float computePointLightRadius(const PointLightInstance &pointLight) const noexcept {
+			return ClusteredLights::computePointLightRadius(pointLight, this->clusteredLights.getThreshold());
+		}
 
 		void draw() override {
 
@@ -497,9 +561,8 @@ namespace glsample {
 			this->getSize(&width, &height);
 
 			/*	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  (this->getFrameCount() % nrUniformBuffer) * this->uniformAlignBufferSize,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			/*	Multipass.	*/
 			{
@@ -538,15 +601,13 @@ namespace glsample {
 								  height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
 
 				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % nrUniformBuffer) * this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 
-				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_pointlight_buffer_binding,
-								  this->uniform_light_buffer,
-								  (this->getFrameCount() % nrUniformBuffer) * this->uniformLightBufferSize,
-								  this->uniformLightBufferSize);
+				/*	Assign the lights to the clusters of the camera.	*/
+				this->clusteredLights.update(this->camera.getViewMatrix(), this->camera.getProjectionMatrix(),
+											 this->camera.getNear(), this->camera.getFar(), width, height);
+				this->clusteredLights.bind();
 
 				/*	*/
 				glViewport(0, 0, width, height);
@@ -583,16 +644,24 @@ namespace glsample {
 				}
 
 				/*	Draw point lights.	*/
-				if (this->deferredSettingComponent->nrPointLights > 0) {
-					glEnable(GL_DEPTH_TEST);
-					glEnable(GL_CULL_FACE);
-					glCullFace(GL_FRONT);
-
-					glUseProgram(this->deferred_pointlight_program);
-					glDrawElementsInstancedBaseVertex(GL_TRIANGLES, this->sphere.nrIndicesElements, GL_UNSIGNED_INT,
-													  (void *)this->sphere.indices_offset,
-													  this->deferredSettingComponent->nrPointLights,
-													  this->sphere.vertex_offset);
+				if (!this->pointLights.empty()) {
+					if (this->deferredSettingComponent->lightPass == PointLightPass::Clustered) {
+						glDisable(GL_DEPTH_TEST);
+						glDisable(GL_CULL_FACE);
+						glUseProgram(this->deferred_clustered_program);
+						glDrawElementsInstancedBaseVertex(GL_TRIANGLES, this->plan.nrIndicesElements, GL_UNSIGNED_INT,
+														  (void *)this->plan.indices_offset, 1,
+														  this->plan.vertex_offset);
+					} else {
+						glEnable(GL_DEPTH_TEST);
+						glEnable(GL_CULL_FACE);
+						glCullFace(GL_FRONT);
+
+						glUseProgram(this->deferred_pointlight_program);
+						glDrawElementsInstancedBaseVertex(GL_TRIANGLES, this->sphere.nrIndicesElements,
+														  GL_UNSIGNED_INT, (void *)this->sphere.indices_offset,
+														  this->pointLights.size(), this->sphere.vertex_offset);
+					}
 				}
 
 				glBindVertexArray(0);
@@ -619,15 +688,14 @@ namespace glsample {
 				}
 
 				/*	Draw point lights.	*/
-				if (this->deferredSettingComponent->nrPointLights > 0) {
+				if (!this->pointLights.empty()) {
 					glEnable(GL_DEPTH_TEST);
 					glEnable(GL_CULL_FACE);
 					glCullFace(GL_BACK);
 
 					glUseProgram(this->deferred_pointlight_debug_program);
 					glDrawElementsInstancedBaseVertex(GL_TRIANGLES, this->sphere.nrIndicesElements, GL_UNSIGNED_INT,
-													  (void *)this->sphere.indices_offset,
-													  this->deferredSettingComponent->nrPointLights,
+													  (void *)this->sphere.indices_offset, this->pointLights.size(),
 													  this->sphere.vertex_offset);
 				}
 
@@ -696,28 +764,13 @@ namespace glsample {
 
 			/*	*/
 			{
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-				void *uniformPointer = glMapBufferRange(
-					GL_UNIFORM_BUFFER,
-					((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-					this->uniformAlignBufferSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-				memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-				glUnmapBuffer(GL_UNIFORM_BUFFER);
+				this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 			}
 
-			/*	Point lights.	*/
-			{
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_light_buffer);
-
-				void *uniformLightPointer = glMapBufferRange(
-					GL_UNIFORM_BUFFER,
-					((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformLightBufferSize,
-					this->uniformLightBufferSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-
-				memcpy(uniformLightPointer, this->pointLights.data(),
-					   this->pointLights.size() * sizeof(this->pointLights[0]));
-
-				glUnmapBuffer(GL_UNIFORM_BUFFER);
+			/*	Point lights, uploaded only when changed.	*/
+			if (this->deferredSettingComponent->lightsChanged) {
+				this->clusteredLights.setPointLights(this->pointLights.data(), this->pointLights.size());
+				this->deferredSettingComponent->lightsChanged = false;
 			}
 		}
 	};
@@ -59,9 +59,7 @@ namespace glsample {
 
 		/*	Uniform Buffer.	*/
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		CameraController camera;
 
@@ -106,7 +104,6 @@ namespace glsample {
 
 		void Release() override {
 			glDeleteProgram(this->graphic_fog_program);
-			glDeleteBuffers(1, &this->uniform_buffer);
 		}
 
 		void Initialize() override {
@@ -136,19 +133,7 @@ namespace glsample {
 			glUniformBlockBinding(this->graphic_fog_program, uniform_buffer_index, this->uniform_buffer_binding);
 			glUseProgram(0);
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
 			// Create uniform buffer.
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	*/
 			ModelImporter modelLoader(FileSystem::getFileSystem());
 			modelLoader.loadContent(modelPath, 0);
@@ -179,9 +164,8 @@ namespace glsample {
 			/*	*/
 			{
 
-				// glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-				// 				  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				// 				  this->uniformAlignBufferSize);
+				// glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+				// 				  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 				glUseProgram(this->graphic_fog_program);
 
@@ -206,12 +190,7 @@ namespace glsample {
 				this->uniform_stage_buffer.proj * this->uniform_stage_buffer.view * this->uniform_stage_buffer.model;
 
 			/*	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				uniformAlignBufferSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			memcpy(uniformPointer, &this->uniform_stage_buffer, sizeof(uniform_stage_buffer));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniform_stage_buffer);
 		}
 	};
 
@@ -101,11 +101,8 @@ namespace glsample {
 		/*	*/
 		unsigned int uniform_buffer_binding = 0;
 		unsigned int uniform_instance_buffer_binding = 1;
-		unsigned int uniform_buffer{};
-		unsigned int uniform_instance_buffer{};
-		const size_t nrUniformBuffers = 3;
-		const size_t nrCameras = 2;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
+		FrameRingAllocator::Allocation uniform_observe_allocation{};
 		size_t uniformInstanceSize = 0;
 
 		/*	*/
@@ -174,10 +171,6 @@ namespace glsample {
 			glDeleteProgram(this->bounding_program);
 			glDeleteProgram(this->wireframe_program);
 
-			/*	*/
-			glDeleteBuffers(1, &this->uniform_buffer);
-			glDeleteBuffers(1, &this->uniform_instance_buffer);
-
 			/*	*/
 			glDeleteVertexArrays(1, &this->frustum.vao);
 			glDeleteBuffers(1, &this->frustum.vbo);
@@ -245,19 +238,6 @@ namespace glsample {
 								  uniform_instance_buffer_binding);
 			glUseProgram(0);
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
-			/*	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffers * this->nrCameras,
-						 nullptr, GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	Setup instance buffer.	*/
 			{
 				/*	*/
@@ -265,13 +245,7 @@ namespace glsample {
 				glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &uniformMaxSize);
 				this->instanceBatch = std::min<size_t>(uniformMaxSize / sizeof(glm::mat4), 512);
 
-				this->uniformInstanceSize =
-					fragcore::Math::align<size_t>(this->instanceBatch * sizeof(glm::mat4), (size_t)minMapBufferSize);
-				glGenBuffers(1, &this->uniform_instance_buffer);
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_instance_buffer);
-				glBufferData(GL_UNIFORM_BUFFER, this->uniformInstanceSize * this->nrUniformBuffers, nullptr,
-							 GL_DYNAMIC_DRAW);
-				glBindBuffer(GL_UNIFORM_BUFFER, 0);
+				this->uniformInstanceSize = this->instanceBatch * sizeof(glm::mat4);
 			}
 
 			/*	*/
@@ -317,10 +291,8 @@ namespace glsample {
 			this->getSize(&width, &height);
 
 			/*	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  ((this->getFrameCount() % nrUniformBuffers)) * this->uniformAlignBufferSize *
-								  this->nrCameras,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			/*	*/
 			this->secondCameraNodeQueue = this->mainCameraNodeQueue;
@@ -347,11 +319,8 @@ namespace glsample {
 			}
 
 			/*	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  ((this->getFrameCount() % nrUniformBuffers)) * this->uniformAlignBufferSize *
-									  this->nrCameras +
-								  this->uniformAlignBufferSize,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_observe_allocation.buffer,
+							  this->uniform_observe_allocation.offset, this->uniform_observe_allocation.size);
 
 			if (this->frustumCullingSettingComponent->showSecondCameraView) {
 
@@ -416,37 +385,28 @@ namespace glsample {
 				copy.view = this->camera_observe_frustum.getViewMatrix();
 				copy.modelViewProjection = copy.proj * copy.view * copy.model;
 
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-				uint8_t *uniformPointer = (uint8_t *)glMapBufferRange(
-					GL_UNIFORM_BUFFER,
-					((this->getFrameCount() + 1) % this->nrUniformBuffers) * this->uniformAlignBufferSize *
-						this->nrCameras,
-					this->uniformAlignBufferSize * this->nrCameras, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-
 				/*	*/
-				memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-				memcpy(&uniformPointer[this->uniformAlignBufferSize], &copy, sizeof(copy));
-
-				glUnmapBuffer(GL_UNIFORM_BUFFER);
+				this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
+				this->uniform_observe_allocation = this->getFrameAllocator().allocate(copy);
 			}
 
 			/*	Compute frustum culling.	*/
 			mainCameraNodeQueue = std::queue<const NodeObject *>();
 			secondCameraNodeQueue = std::queue<const NodeObject *>();
-			for (size_t x = 0; x < this->scene.getNodes().size(); x++) {
+			if (this->frustumCullingSettingComponent->useSphereCulling) {
+				for (size_t x = 0; x < this->scene.getNodes().size(); x++) {
 
-				const NodeObject *node = this->scene.getNodes()[x];
+					const NodeObject *node = this->scene.getNodes()[x];
 
-				for (size_t i = 0; i < node->geometryObjectIndex.size(); i++) {
+					for (size_t i = 0; i < node->geometryObjectIndex.size(); i++) {
 
-					/*	Compute world space AABB.	*/
-					const AABB aabb = GeometryUtility::computeBoundingBox(
-						fragcore::AABB::createMinMax(
-							Vector3(node->bound.aabb.min[0], node->bound.aabb.min[1], node->bound.aabb.min[2]),
-							Vector3(node->bound.aabb.max[0], node->bound.aabb.max[1], node->bound.aabb.max[2])),
-						GLM2E<float, 4, 4>(node->modelGlobalTransform));
+						/*	Compute world space AABB.	*/
+						const AABB aabb = GeometryUtility::computeBoundingBox(
+							fragcore::AABB::createMinMax(
+								Vector3(node->bound.aabb.min[0], node->bound.aabb.min[1], node->bound.aabb.min[2]),
+								Vector3(node->bound.aabb.max[0], node->bound.aabb.max[1], node->bound.aabb.max[2])),
+							GLM2E<float, 4, 4>(node->modelGlobalTransform));
 
-					if (this->frustumCullingSettingComponent->useSphereCulling) {
 						BoundingSphere sphere = BoundingSphere(aabb.getCenter(), aabb.getSize().norm());
 
 						if (this->camera.intersectionSphere(sphere) == Frustum::In ||
@@ -460,20 +420,20 @@ namespace glsample {
 							/*	*/
 							secondCameraNodeQueue.push(node);
 						}
-					} else {
+					}
+				}
+			} else {
+				/*	AABB culling against the bounding volume hierarchy of the scene.	*/
+				this->scene.setFrustumCulling(this->frustumCullingSettingComponent->useFrustumCulling);
 
-						if (this->camera.intersectionAABB(aabb) == Frustum::In ||
-							!this->frustumCullingSettingComponent->useFrustumCulling) {
-							/*	*/
-							mainCameraNodeQueue.push(node);
-						}
+				this->scene.culling(&this->camera);
+				for (const NodeObject *node : this->scene.getVisibleNodes()) {
+					mainCameraNodeQueue.push(node);
+				}
 
-						if (this->camera_observe_frustum.intersectionAABB(aabb) == Frustum::In ||
-							!this->frustumCullingSettingComponent->useFrustumCulling) {
-							/*	*/
-							secondCameraNodeQueue.push(node);
-						}
-					}
+				this->scene.culling(&this->camera_observe_frustum);
+				for (const NodeObject *node : this->scene.getVisibleNodes()) {
+					secondCameraNodeQueue.push(node);
 				}
 			}
 
@@ -491,7 +451,6 @@ namespace glsample {
 
 		void renderBoundingBox(const CameraController &camera, std::queue<const NodeObject *> &queue) {
 
-			// TODO: fix if more than buffer size.
 			std::vector<glm::mat4> instance_model_matrices;
 
 			while (!queue.empty()) {
@@ -520,20 +479,6 @@ namespace glsample {
 				}
 			}
 
-			/*	Transfer new */
-			{
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_instance_buffer);
-				uint8_t *uniform_instance_buffer_pointer = static_cast<uint8_t *>(glMapBufferRange(
-					GL_UNIFORM_BUFFER, ((this->getFrameCount()) % this->nrUniformBuffers) * this->uniformInstanceSize,
-					this->uniformInstanceSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
-
-				/*	*/
-				memcpy(uniform_instance_buffer_pointer, instance_model_matrices.data(),
-					   instance_model_matrices.size() * sizeof(instance_model_matrices[0]));
-
-				glUnmapBuffer(GL_UNIFORM_BUFFER);
-			}
-
 			glBindVertexArray(this->boundingBox.vao);
 
 			/*	*/
@@ -547,10 +492,8 @@ namespace glsample {
 			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 			/*	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  ((this->getFrameCount() % nrUniformBuffers)) * this->uniformAlignBufferSize *
-								  this->nrCameras,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			for (size_t x = 0; x < instance_model_matrices.size(); x += this->instanceBatch) {
 
@@ -558,10 +501,13 @@ namespace glsample {
 				const NodeObject *node = this->scene.getNodes()[x];
 				const size_t nrDrawInstances = std::min(instance_model_matrices.size() - x, this->instanceBatch);
 
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_instance_buffer_binding,
-								  this->uniform_instance_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffers) * this->uniformInstanceSize,
-								  this->uniformInstanceSize);
+				/*	Transfer the batch, the whole block is bound regardless of the number of instances.	*/
+				const FrameRingAllocator::Allocation instanceAllocation =
+					this->getFrameAllocator().allocate(this->uniformInstanceSize);
+				memcpy(instanceAllocation.data, &instance_model_matrices[x], nrDrawInstances * sizeof(glm::mat4));
+
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_instance_buffer_binding, instanceAllocation.buffer,
+								  instanceAllocation.offset, instanceAllocation.size);
 
 				glDrawElementsInstanced(GL_TRIANGLES, this->boundingBox.nrIndicesElements, GL_UNSIGNED_INT, nullptr,
 										nrDrawInstances);
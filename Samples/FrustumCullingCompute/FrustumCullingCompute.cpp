@@ -60,9 +60,7 @@ namespace glsample {
 		/*	Uniform buffer.	*/
 		unsigned int uniform_buffer_index;
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer;
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		CameraController camera;
 
@@ -113,8 +111,6 @@ namespace glsample {
 			glDeleteFramebuffers(1, &this->shadowFramebuffer);
 			glDeleteTextures(1, &this->shadowTexture);
 
-			glDeleteBuffers(1, &this->uniform_buffer);
-
 			glDeleteVertexArrays(1, &this->refObj[0].vao);
 			glDeleteBuffers(1, &this->refObj[0].vbo);
 			glDeleteBuffers(1, &this->refObj[0].ibo);
@@ -161,19 +157,7 @@ namespace glsample {
 			glUniformBlockBinding(this->graphic_program, this->uniform_buffer_index, this->uniform_buffer_binding);
 			glUseProgram(0);
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
 			// Create uniform buffer.
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBufferARB(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBufferARB(GL_UNIFORM_BUFFER, 0);
-
 			{
 				/*	Create shadow map.	*/
 				glGenFramebuffers(1, &shadowFramebuffer);
@@ -230,9 +214,8 @@ namespace glsample {
 			/*  Perform frustum culling.    */
 
 			/*	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_index, uniform_buffer,
-							  (getFrameCount() % nrUniformBuffer) * this->uniformAlignBufferSize,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_index, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			{
 
@@ -300,13 +283,7 @@ namespace glsample {
 			this->uniform.cameraPosition = this->camera.getPosition();
 
 			/*	*/
-			glBindBufferARB(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize,
-				GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			memcpy(uniformPointer, &this->uniform, sizeof(uniform));
-			glUnmapBufferARB(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniform);
 		}
 	};
 
@@ -87,9 +87,7 @@ namespace glsample {
 		/*	Uniform buffers.	*/
 		unsigned int uniform_buffer_index;
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer;
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		/*	*/
 		MeshObject sphere;
@@ -117,8 +115,6 @@ namespace glsample {
 			glDeleteProgram(this->gouraud_catmull_program);
 			glDeleteProgram(this->gouraud_tessellation_program);
 
-			glDeleteBuffers(1, &this->uniform_buffer);
-
 			/*	*/
 			glDeleteVertexArrays(1, &this->sphere.vao);
 			glDeleteBuffers(1, &this->sphere.vbo);
@@ -172,18 +168,6 @@ namespace glsample {
 			glUniformBlockBinding(this->gouraud_catmull_program, this->uniform_buffer_index, 0);
 			glUseProgram(0);
 
-			/*	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize = Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
-			/*	Create uniform buffer.	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	Load geometry.	*/
 			Common::loadSphere(this->sphere, 1, 8, 8);
 		}
@@ -202,9 +186,8 @@ namespace glsample {
 
 			/*	*/
 			{
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 				/*	*/
 				if (this->gouraudSettingComponent->useSubdivionsCatmullClark) {
@@ -261,13 +244,7 @@ namespace glsample {
 			this->uniformStageBuffer.eyePos = glm::vec4(this->camera.getPosition(), 0);
 
 			{
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-				void *uniformPointer = glMapBufferRange(
-					GL_UNIFORM_BUFFER,
-					((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-					this->uniformAlignBufferSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
-				memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-				glUnmapBuffer(GL_UNIFORM_BUFFER);
+				this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 			}
 		}
 	};
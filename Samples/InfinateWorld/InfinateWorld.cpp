@@ -70,11 +70,10 @@ namespace glsample {
 		unsigned int uniform_instance_buffer_binding = 1;
 
 		/*	*/
-		unsigned int uniform_buffer;
+		FrameRingAllocator::Allocation uniform_allocation{};
 		unsigned int uniform_instance_buffer;
 		unsigned int indirect_buffer;
 		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
 		size_t uniformInstanceMemorySize = 0;
 		const size_t maxGroupSize[3] = {16, 16, 16};
 		const size_t indirect_buffer_element_count = 32;
@@ -113,7 +112,6 @@ namespace glsample {
 			glDeleteProgram(this->infinate_world_chunck_constructor_compute_program);
 
 			/*	*/
-			glDeleteBuffers(1, &this->uniform_buffer);
 			glDeleteBuffers(1, &this->uniform_instance_buffer);
 			glDeleteBuffers(1, &this->indirect_buffer);
 		}
@@ -195,24 +193,12 @@ namespace glsample {
 			maxWorkGroupCount[1] = Math::min<int>(maxGroupSize[1], maxWorkGroupCount[1]);
 			maxWorkGroupCount[2] = Math::min<int>(maxGroupSize[2], maxWorkGroupCount[2]);
 
-			/*	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize = Math::align<size_t>(this->uniformAlignBufferSize, minMapBufferSize);
-
 			GLint SSBO_align_offset = 0;
 			glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &SSBO_align_offset);
 
 			size_t indirect_buffer_size =
 				indirect_buffer_element_count * sizeof(DrawElementsIndirectCommand) * this->nrUniformBuffer;
 
-			/*	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, uniformAlignBufferSize * this->nrUniformBuffer, nullptr, GL_DYNAMIC_DRAW);
-			glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(uniformStageBuffer), &this->uniformStageBuffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	*/
 			glGenBuffers(1, &this->indirect_buffer);
 			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, this->indirect_buffer);
@@ -248,9 +234,8 @@ namespace glsample {
 			int width = 0, height = 0;
 			this->getSize(&width, &height);
 
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			{
 				glUseProgram(this->infinate_world_chunck_constructor_compute_program);
@@ -334,14 +319,7 @@ namespace glsample {
 			}
 
 			/*	Bind buffer and update region with new data.	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-
-			memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 		}
 	};
 
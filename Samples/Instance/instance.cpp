@@ -63,12 +63,8 @@ namespace glsample {
 		/*	*/
 		unsigned int uniform_buffer_binding = 0;
 		unsigned int uniform_instance_buffer_binding = 1;
-		unsigned int uniform_mvp_buffer{};
-		unsigned int uniform_instance_buffer{};
-		const size_t nrUniformBuffers = 3;
-
-		size_t uniformSharedBufferSize = sizeof(uniform_buffer_block);
-		size_t uniformInstanceSize = 0;
+		FrameRingAllocator::Allocation uniform_mvp_allocation{};
+		FrameRingAllocator::Allocation uniform_instance_allocation{};
 
 		CameraController camera;
 
@@ -109,8 +105,6 @@ namespace glsample {
 			/*	*/
 			glDeleteTextures(1, (const GLuint *)&this->diffuse_texture);
 
-			glDeleteBuffers(1, &this->uniform_mvp_buffer);
-
 			/*	*/
 			glDeleteVertexArrays(1, &this->instanceGeometry.vao);
 			glDeleteBuffers(1, &this->instanceGeometry.vbo);
@@ -148,34 +142,13 @@ namespace glsample {
 								  this->uniform_instance_buffer_binding);
 			glUseProgram(0);
 
-			/*	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformSharedBufferSize =
-				fragcore::Math::align<size_t>(this->uniformSharedBufferSize, (size_t)minMapBufferSize);
-
-			/*	*/
-			glGenBuffers(1, &this->uniform_mvp_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_mvp_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformSharedBufferSize * this->nrUniformBuffers, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	*/
 			GLint uniformMaxSize = 0;
 			glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &uniformMaxSize);
 			this->instanceBatch = uniformMaxSize / sizeof(glm::mat4);
 
 			/*	*/
-			this->uniformInstanceSize =
-				fragcore::Math::align<size_t>(this->nrInstances * sizeof(glm::mat4), (size_t)minMapBufferSize);
 			this->instance_model_matrices.resize(this->nrInstances);
-			glGenBuffers(1, &this->uniform_instance_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_instance_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformInstanceSize * this->nrUniformBuffers, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	*/
 			{
 				ModelImporter modelLoader(FileSystem::getFileSystem());
@@ -237,9 +210,8 @@ namespace glsample {
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 			/*	Bind MVP Uniform Buffer.	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_mvp_buffer,
-							  (this->getFrameCount() % this->nrUniformBuffers) * this->uniformSharedBufferSize,
-							  this->uniformSharedBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_mvp_allocation.buffer,
+							  this->uniform_mvp_allocation.offset, this->uniform_mvp_allocation.size);
 
 			/*	Optional - to display wireframe.	*/
 			glPolygonMode(GL_FRONT_AND_BACK, this->instanceSettingComponent->showWireFrame ? GL_LINE : GL_FILL);
@@ -260,9 +232,8 @@ namespace glsample {
 				/*	Bind Model Instance Uniform Buffer.	*/
 
 				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_instance_buffer_binding,
-								  this->uniform_instance_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffers) * this->uniformInstanceSize +
-									  i * (instanceBatch * sizeof(glm::mat4)),
+								  this->uniform_instance_allocation.buffer,
+								  this->uniform_instance_allocation.offset + i * sizeof(glm::mat4),
 								  nrDrawInstances * sizeof(glm::mat4));
 
 				glDrawElementsInstanced(GL_TRIANGLES, this->instanceGeometry.nrIndicesElements, GL_UNSIGNED_INT,
@@ -300,23 +271,11 @@ namespace glsample {
 			this->uniformData.viewPos = glm::vec4(this->camera.getPosition(), 0);
 
 			/*	Update uniform.	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_mvp_buffer);
-			void *uniformMVP =
-				glMapBufferRange(GL_UNIFORM_BUFFER,
-								 ((this->getFrameCount() + 1) % this->nrUniformBuffers) * this->uniformSharedBufferSize,
-								 this->uniformSharedBufferSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			memcpy(uniformMVP, &this->uniformData, sizeof(this->uniformData));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
-
-			/*	Update instance buffer.	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_instance_buffer);
-			void *uniformInstance = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffers) * this->uniformInstanceSize,
-				this->uniformInstanceSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			memcpy(uniformInstance, this->instance_model_matrices.data(),
-				   sizeof(this->instance_model_matrices[0]) * this->instance_model_matrices.size());
-
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_mvp_allocation = this->getFrameAllocator().allocate(this->uniformData);
+
+			/*	Update instance buffer, each batch is bound as a sub range.	*/
+			this->uniform_instance_allocation = this->getFrameAllocator().allocate(
+				this->instance_model_matrices.data(), this->instance_model_matrices.size() * sizeof(glm::mat4));
 		}
 	};
 
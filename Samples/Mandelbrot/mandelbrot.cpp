@@ -47,9 +47,7 @@ namespace glsample {
 
 		/*	*/
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer;
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		class MandelBrotSettingComponent : public nekomimi::UIComponent {
 
@@ -81,7 +79,6 @@ namespace glsample {
 			glDeleteProgram(this->mandelbrot_program);
 			glDeleteProgram(this->julia_program);
 			glDeleteFramebuffers(1, &this->mandelbrot_framebuffer);
-			glDeleteBuffers(1, &this->uniform_buffer);
 			glDeleteTextures(1, (const GLuint *)&this->mandelbrot_texture);
 		}
 
@@ -123,18 +120,6 @@ namespace glsample {
 			glGetProgramiv(this->julia_program, GL_COMPUTE_WORK_GROUP_SIZE, this->localWorkGroupSize);
 			glUseProgram(0);
 
-			/*	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize = Math::align<size_t>(this->uniformAlignBufferSize, minMapBufferSize);
-
-			/*	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	*/
 			{
 				glGenFramebuffers(1, &this->mandelbrot_framebuffer);
@@ -181,9 +166,8 @@ namespace glsample {
 			glViewport(0, 0, width, height);
 
 			/*	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
 			{
@@ -221,12 +205,7 @@ namespace glsample {
 		void update() override {
 
 			/*	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount()) % nrUniformBuffer) * uniformAlignBufferSize,
-				uniformAlignBufferSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
-			memcpy(uniformPointer, &stageBuffer, sizeof(stageBuffer));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->stageBuffer);
 
 			/*	Update Position.	*/
 			{
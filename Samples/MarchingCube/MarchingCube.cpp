@@ -89,10 +89,8 @@ namespace glsample {
 		unsigned int irradiance_texture{};
 
 		/*	*/
-		unsigned int uniform_buffer{};
+		FrameRingAllocator::Allocation uniform_allocation{};
 
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
 		size_t marchingCubeSize = 0;
 		size_t marchingTotalCubeSize = 0;
 		const size_t maxWorldChunkSize[3] = {static_cast<long>(16) * 2, 8, static_cast<long>(16) * 2};
@@ -168,7 +166,6 @@ namespace glsample {
 			glDeleteProgram(this->marching_cube_transform_program);
 			glDeleteProgram(this->marching_cube_generate_compute_program);
 			/*	*/
-			glDeleteBuffers(1, &this->uniform_buffer);
 		}
 
 		void Initialize() override {
@@ -262,18 +259,6 @@ namespace glsample {
 
 			glCreateQueries(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN, 1, &this->query);
 
-			/*	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, minMapBufferSize);
-
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, uniformAlignBufferSize * this->nrUniformBuffer, nullptr, GL_DYNAMIC_DRAW);
-			glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(uniformStageBuffer), &this->uniformStageBuffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	*/
 			{
 
@@ -355,31 +340,24 @@ namespace glsample {
 			this->getSize(&width, &height);
 
 			/*	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			/*	*/
 			if (this->marchingCubeSettingComponent->needUpdate) {
 
-				refreshWholeRoundRobinBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer, this->nrUniformBuffer,
-											 &this->uniformStageBuffer, this->uniformAlignBufferSize);
-
 				glUseProgram(this->marching_cube_generate_compute_program);
 
 				for (size_t chunk_index = 0; chunk_index < this->chunks.size(); chunk_index++) {
 
 					const Chunk &chunk = this->chunks[chunk_index];
 
-					uniform_buffer_block *uniformPointer = (uniform_buffer_block *)glMapBufferRange(
-						GL_UNIFORM_BUFFER,
-						((this->getFrameCount()) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-						this->uniformAlignBufferSize, GL_MAP_WRITE_BIT);
-					uniformPointer->settings.position_offset = glm::vec4(chunk.position, 0);
-					glUnmapBuffer(GL_UNIFORM_BUFFER);
-
-					/*	Wait in till the */
-					glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT | GL_UNIFORM_BARRIER_BIT);
+					/*	Each chunk gets its own copy of the settings, with its offset.	*/
+					const FrameRingAllocator::Allocation chunkAllocation =
+						this->getFrameAllocator().allocate(this->uniformStageBuffer);
+					chunkAllocation.as<uniform_buffer_block>()->settings.position_offset = glm::vec4(chunk.position, 0);
+					glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, chunkAllocation.buffer,
+									  chunkAllocation.offset, chunkAllocation.size);
 
 					glBindBufferRange(GL_SHADER_STORAGE_BUFFER, this->vertex_dat_buffer_binding,
 									  chunk.marchingCube->vbo, chunk_index * this->marchingCubeSize,
@@ -390,6 +368,10 @@ namespace glsample {
 
 				glUseProgram(0);
 
+				/*	Restore the frame settings.	*/
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
+
 				this->marchingCubeSettingComponent->needUpdate = false;
 
 				glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT |
@@ -484,15 +466,7 @@ namespace glsample {
 			}
 
 			/*	Bind buffer and update region with new data.	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize, GL_MAP_WRITE_BIT);
-
-			memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 		}
 	};
 
@@ -74,9 +74,7 @@ namespace glsample {
 
 		/*	Uniform buffer.	*/
 		unsigned int uniform_graphic_buffer_binding = 0;
-		unsigned int uniform_buffer;
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		CameraController camera;
 
@@ -116,7 +114,6 @@ namespace glsample {
 		void Release() override {
 			glDeleteProgram(this->mipmap_graphic_program);
 
-			glDeleteBuffers(1, &this->uniform_buffer);
 			glDeleteTextures(1, &this->mipmap_texture);
 			glDeleteSamplers(1, &this->mipmap_sampler);
 		}
@@ -149,19 +146,7 @@ namespace glsample {
 								  this->uniform_graphic_buffer_binding);
 			glUseProgram(0);
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
 			// Create uniform buffer.
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			{
 				/*	Create mipmap vector.	*/
 				const size_t noiseW = 1 << (mip_levels + 1);
@@ -220,9 +205,9 @@ namespace glsample {
 
 			{
 				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_graphic_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_graphic_buffer_binding,
+								  this->uniform_allocation.buffer, this->uniform_allocation.offset,
+								  this->uniform_allocation.size);
 
 				glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
 				/*	*/
@@ -260,13 +245,7 @@ namespace glsample {
 			this->uniformStageBuffer.modelViewProjection = proj * view * model;
 
 			/*	Update uniform buffer.	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize,
-				GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(uniformStageBuffer));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 		}
 	};
 
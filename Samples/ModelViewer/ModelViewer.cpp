@@ -87,20 +87,13 @@ namespace glsample {
 
 		/*	*/
 		ModelImporter *modelLoader = new ModelImporter(this->getFileSystem());
+		modelLoader->setVertexLayout(VertexLayout::Compact);
 		modelLoader->loadContent(modelPath, 0);
 		this->scene = Scene::loadFrom(*modelLoader);
+		this->scene.setFrustumCulling(true);
+		this->scene.setIndirectDraw(true);
+		this->scene.initGPUCulling(this->getFileSystem());
 
-		/*	Align uniform buffer in respect to driver requirement.	*/
-		GLint minMapBufferSize = 0;
-		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-		this->uniformAlignBufferSize =
-			fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
-		/*	Create uniform buffer.	*/
-		glGenBuffers(1, &this->uniform_buffer);
-		glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-		glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr, GL_DYNAMIC_DRAW);
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 	}
 
 	void ModelViewer::draw() {
@@ -109,9 +102,8 @@ namespace glsample {
 		this->getSize(&width, &height);
 
 		/*	*/
-		glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-						  (this->getFrameCount() % nrUniformBuffer) * this->uniformAlignBufferSize,
-						  this->uniformAlignBufferSize);
+		glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+						  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 		/*	Set render viewport size in pixels.	*/
 		glViewport(0, 0, width, height);
@@ -153,12 +145,7 @@ namespace glsample {
 
 		/*	*/
 		{
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 		}
 	}
 
@@ -43,16 +43,14 @@ namespace glsample {
 
 		/*	*/
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer;
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		/*	Simple	*/
 		const std::string vertexPBRShaderPath = "Shaders/pbr/simplephysicalbasedrendering.vert.spv";
 		const std::string fragmentPBRShaderPath = "Shaders/pbr/simplephysicalbasedrendering.frag.spv";
 
-		/*	Advanced.	*/
-		const std::string PBRvertexShaderPath = "Shaders/pbr/physicalbasedrendering.vert.spv";
+		/*	Advanced, with the compact vertex layout.	*/
+		const std::string PBRvertexShaderPath = "Shaders/pbr/physicalbasedrendering_compact.vert.spv";
 		const std::string PBRfragmentShaderPath = "Shaders/pbr/physicalbasedrendering.frag.spv";
 		const std::string PBRControlShaderPath = "Shaders/pbr/physicalbasedrendering.tesc.spv";
 		const std::string PBREvoluationShaderPath = "Shaders/pbr/physicalbasedrendering.tese.spv";
@@ -7,33 +7,28 @@
 #include <GL/glew.h>
 #include <GLSampleWindow.h>
 #include <ImageImport.h>
+#include <ModelImporter.h>
 #include <Scene.h>
 #include <ShaderLoader.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <magic_enum.hpp>
 
 namespace glsample {
 
 	/**
-	 * @brief
-	 *
+	 * @brief Occlusion culling of the scene, by a hierarchical depth buffer of the previous frame tested on the
+	 * GPU, or by bounding box occlusion queries with conditional rendering.
 	 */
-	class ConditionalScene : public Scene {
-	  public:
-	};
-
-	/**
-	 * @brief
-	 *
-	 */
-	// TODO: based it on frustum culling base.
 	class OcclusionCulling : public GLSampleWindow {
 	  public:
 		OcclusionCulling() : GLSampleWindow() {
 			this->setTitle("OcclusionCulling Draw");
-			this->conditionalSettingComponent =
-				std::make_shared<ConditionalDrawSettingComponent>(this->uniformStageBuffer);
-
+			this->conditionalSettingComponent = std::make_shared<ConditionalDrawSettingComponent>(*this);
 			this->addUIComponent(this->conditionalSettingComponent);
+
+			/*	Default camera position and orientation.	*/
+			this->camera.setPosition(glm::vec3(-2.5f));
+			this->camera.lookAt(glm::vec3(0.f));
 		}
 
 		struct uniform_buffer_block {
@@ -41,99 +36,108 @@ namespace glsample {
 			glm::mat4 view{};
 			glm::mat4 proj{};
 			glm::mat4 modelView{};
-			glm::mat4 ViewProj{};
+			glm::mat4 viewProjection{};
 			glm::mat4 modelViewProjection{};
 
-			/*	*/
-			glm::vec4 tintColor = glm::vec4(1, 1, 1, 1);
-
 			/*	light source.	*/
 			glm::vec4 direction = glm::vec4(1.0f / sqrt(2.0f), -1.0f / sqrt(2.0f), 0.0f, 0.0f);
 			glm::vec4 lightColor = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
 			glm::vec4 ambientColor = glm::vec4(0.2, 0.2, 0.2, 1.0f);
 
-			/*	Normal attirbutes.	*/
-			float normalStrength = 1.0f;
-
 		} uniformStageBuffer;
 
 		/*	*/
-		MeshObject plan;
-		ConditionalScene scene;
+		Scene scene;
 
-		/*	Textures.	*/
-		unsigned int diffuse_texture{};
-		unsigned int normal_texture{};
+		/*	Framebuffer with a depth texture, the source of the depth pyramid.	*/
+		unsigned int occlusion_framebuffer{};
+		unsigned int color_texture{};
+		unsigned int depth_texture{};
+		unsigned int occlusion_texture_width{};
+		unsigned int occlusion_texture_height{};
 
 		/*	*/
-		unsigned int normalMapping_program{};
+		unsigned int graphic_program{};
 
 		/*	Uniform buffer.	*/
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		CameraController camera;
 
-		class ConditionalDrawSettingComponent : public nekomimi::UIComponent {
+		class ConditionalDrawSettingComponent : public GLUIComponent<OcclusionCulling> {
 		  public:
-			ConditionalDrawSettingComponent(struct uniform_buffer_block &uniform) : uniform(uniform) {
-				this->setName("Conditional Draw");
-			}
+			ConditionalDrawSettingComponent(OcclusionCulling &sample)
+				: GLUIComponent(sample, "Occlusion Culling"), uniform(this->getRefSample().uniformStageBuffer) {}
 
 			void draw() override {
-				ImGui::ColorEdit4("Tint Color", &this->uniform.tintColor[0],
-								  ImGuiColorEditFlags_HDR | ImGuiColorEditFlags_Float);
 				ImGui::TextUnformatted("Light Setting");
 				ImGui::ColorEdit4("Light", &this->uniform.lightColor[0],
 								  ImGuiColorEditFlags_HDR | ImGuiColorEditFlags_Float);
 				ImGui::DragFloat3("Direction", &this->uniform.direction[0]);
 				ImGui::ColorEdit4("Ambient", &this->uniform.ambientColor[0],
 								  ImGuiColorEditFlags_HDR | ImGuiColorEditFlags_Float);
-				ImGui::TextUnformatted("Normal Setting");
-				ImGui::DragFloat("Strength", &this->uniform.normalStrength);
+
+				ImGui::TextUnformatted("Occlusion Setting");
+				Scene &scene = this->getRefSample().scene;
+				const OcclusionMode mode = scene.getOcclusionMode();
+				const std::string combo_preview_value = std::string(magic_enum::enum_name(mode));
+				if (ImGui::BeginCombo("Occlusion Mode", combo_preview_value.c_str(), 0)) {
+					for (const OcclusionMode option : magic_enum::enum_values<OcclusionMode>()) {
+						const bool is_selected = (mode == option);
+
+						if (ImGui::Selectable(magic_enum::enum_name(option).data(), is_selected)) {
+							this->getRefSample().setOcclusionMode(option);
+						}
+
+						if (is_selected) {
+							ImGui::SetItemDefaultFocus();
+						}
+					}
+					ImGui::EndCombo();
+				}
+				ImGui::Text("Frustum Visible Nodes %lu", scene.getVisibleNodes().size());
+
 				ImGui::TextUnformatted("Debug Setting");
 				ImGui::Checkbox("WireFrame", &this->showWireFrame);
+
+				scene.renderUI();
 			}
 
 			bool showWireFrame = false;
-			bool showBoundingBoxes = false;
-			bool showOverlapping = false;
 
 		  private:
 			struct uniform_buffer_block &uniform;
 		};
 		std::shared_ptr<ConditionalDrawSettingComponent> conditionalSettingComponent;
 
-		const std::string vertexShaderPath = "Shaders/normalmap/normalmap.vert.spv";
-		const std::string fragmentShaderPath = "Shaders/normalmap/normalmap.frag.spv";
+		const std::string vertexShaderPath = "Shaders/occlusionculling/occlusionculling.vert.spv";
+		const std::string fragmentShaderPath = "Shaders/occlusionculling/occlusionculling.frag.spv";
+
+		void setOcclusionMode(const OcclusionMode mode) {
+			/*	The occlusion queries are issued by the per node draw path.	*/
+			this->scene.setGPUCulling(mode != OcclusionMode::ConditionalRender);
+			this->scene.setOcclusionMode(mode);
+		}
 
 		void Release() override {
 			this->scene.release();
 
 			/*	*/
-			glDeleteProgram(this->normalMapping_program);
+			glDeleteProgram(this->graphic_program);
 
 			/*	*/
-			glDeleteTextures(1, (const GLuint *)&this->diffuse_texture);
-			glDeleteTextures(1, (const GLuint *)&this->normal_texture);
+			glDeleteFramebuffers(1, &this->occlusion_framebuffer);
+			glDeleteTextures(1, &this->color_texture);
+			glDeleteTextures(1, &this->depth_texture);
 
 			/*	*/
-			glDeleteBuffers(1, &this->uniform_buffer);
-
-			/*	*/
-			glDeleteVertexArrays(1, &this->plan.vao);
-			glDeleteBuffers(1, &this->plan.vbo);
-			glDeleteBuffers(1, &this->plan.ibo);
 		}
 
 		void Initialize() override {
 
 			/*	*/
 			const std::string modelPath = this->getResult()["model"].as<std::string>();
-			const std::string diffuseTexturePath = this->getResult()["texture"].as<std::string>();
-			const std::string normalTexturePath = this->getResult()["normal-texture"].as<std::string>();
 
 			/*	*/
 			{
@@ -149,29 +153,69 @@ namespace glsample {
 				compilerOptions.glslVersion = this->getShaderVersion();
 
 				/*	Load shader	*/
-				this->normalMapping_program =
+				this->graphic_program =
 					ShaderLoader::loadGraphicProgram(compilerOptions, &vertex_binary, &fragment_binary);
 			}
 
 			/*	Setup graphic pipeline.	*/
-			glUseProgram(this->normalMapping_program);
-			unsigned int uniform_buffer_index =
-				glGetUniformBlockIndex(this->normalMapping_program, "UniformBufferBlock");
-			glUniform1i(glGetUniformLocation(this->normalMapping_program, "DiffuseTexture"), 0);
-			glUniform1i(glGetUniformLocation(this->normalMapping_program, "NormalTexture"), 1);
-			glUniformBlockBinding(this->normalMapping_program, uniform_buffer_index, this->uniform_buffer_binding);
+			glUseProgram(this->graphic_program);
+			unsigned int uniform_buffer_index = glGetUniformBlockIndex(this->graphic_program, "UniformBufferBlock");
+			glUniform1i(glGetUniformLocation(this->graphic_program, "DiffuseTexture"), TextureType::Diffuse);
+			glUniform1i(glGetUniformLocation(this->graphic_program, "AlphaMaskedTexture"), TextureType::AlphaMask);
+			glUniformBlockBinding(this->graphic_program, uniform_buffer_index, this->uniform_buffer_binding);
 			glUseProgram(0);
 
-			/*	load Textures	*/
-			TextureImporter textureImporter(this->getFileSystem());
-			this->diffuse_texture = textureImporter.loadImage2D(diffuseTexturePath);
-			this->normal_texture = textureImporter.loadImage2D(normalTexturePath);
+			/*	*/
+			ModelImporter modelLoader(this->getFileSystem());
+			modelLoader.loadContent(modelPath, 0);
+			this->scene = Scene::loadFrom(modelLoader);
+			this->scene.setFrustumCulling(true);
+			this->scene.initGPUCulling(this->getFileSystem());
+			this->scene.initOcclusionCulling(this->getFileSystem());
+			this->setOcclusionMode(OcclusionMode::HierarchicalZ);
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
+			/*	*/
+			glGenFramebuffers(1, &this->occlusion_framebuffer);
+			glGenTextures(1, &this->color_texture);
+			glGenTextures(1, &this->depth_texture);
+			this->onResize(this->width(), this->height());
+		}
+
+		void onResize(int width, int height) override {
+
+			this->occlusion_texture_width = width;
+			this->occlusion_texture_height = height;
+
+			glBindFramebuffer(GL_FRAMEBUFFER, this->occlusion_framebuffer);
+
+			/*	*/
+			glBindTexture(GL_TEXTURE_2D, this->color_texture);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, this->color_texture, 0);
+
+			/*	Sampled by the depth pyramid reduction.	*/
+			glBindTexture(GL_TEXTURE_2D, this->depth_texture);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT,
+						 nullptr);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, this->depth_texture, 0);
+			glBindTexture(GL_TEXTURE_2D, 0);
+
+			/*  Validate if created properly.*/
+			const int frameStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+			if (frameStatus != GL_FRAMEBUFFER_COMPLETE) {
+				throw RuntimeException("Failed to create framebuffer, {}", frameStatus);
+			}
+
+			glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
+
+			/*	*/
+			this->camera.setFar(2000.0f);
+			this->camera.setAspect((float)width / (float)height);
 		}
 
 		void draw() override {
@@ -180,66 +224,67 @@ namespace glsample {
 			this->getSize(&width, &height);
 
 			/*	*/
-			glViewport(0, 0, width, height);
-			glClearColor(0.095f, 0.095f, 0.095f, 1.0f);
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			{
+				glBindFramebuffer(GL_FRAMEBUFFER, this->occlusion_framebuffer);
+
 				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
+				glViewport(0, 0, this->occlusion_texture_width, this->occlusion_texture_height);
+				glClearColor(0.095f, 0.095f, 0.095f, 1.0f);
+				glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-				glUseProgram(this->normalMapping_program);
+				/*	Optional - to display wireframe.	*/
+				glPolygonMode(GL_FRONT_AND_BACK, conditionalSettingComponent->showWireFrame ? GL_LINE : GL_FILL);
 
-				glDisable(GL_CULL_FACE);
+				glUseProgram(this->graphic_program);
 
-				/*	*/
-				glActiveTexture(GL_TEXTURE0);
-				glBindTexture(GL_TEXTURE_2D, this->diffuse_texture);
+				glEnable(GL_DEPTH_TEST);
+				glCullFace(GL_BACK);
+				glDisable(GL_CULL_FACE);
 
-				/*	*/
-				glActiveTexture(GL_TEXTURE0 + 1);
-				glBindTexture(GL_TEXTURE_2D, this->normal_texture);
+				this->scene.render(&this->camera);
 
-				/*	Optional - to display wireframe.	*/
-				glPolygonMode(GL_FRONT_AND_BACK, conditionalSettingComponent->showWireFrame ? GL_LINE : GL_FILL);
+				glUseProgram(0);
 
-				/*	Draw triangle.	*/
-				glBindVertexArray(this->plan.vao);
-				glDrawElements(GL_TRIANGLES, this->plan.nrIndicesElements, GL_UNSIGNED_INT, nullptr);
-				glBindVertexArray(0);
+				glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 			}
+
+			/*	Occluders of the next frame.	*/
+			this->scene.updateDepthPyramid(this->depth_texture, this->occlusion_texture_width,
+										   this->occlusion_texture_height);
+
+			/*	Blit image targets to screen.	*/
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->getDefaultFramebuffer());
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, this->occlusion_framebuffer);
+
+			glReadBuffer(GL_COLOR_ATTACHMENT0);
+			glBlitFramebuffer(0, 0, this->occlusion_texture_width, this->occlusion_texture_height, 0, 0, width, height,
+							  GL_COLOR_BUFFER_BIT, GL_NEAREST);
+			glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
 		}
 
 		void update() override {
 
 			/*	Update Camera.	*/
-			const float elapsedTime = this->getTimer().getElapsed<float>();
 			this->camera.update(this->getTimer().deltaTime<float>());
+			this->scene.update(this->getTimer().deltaTime<float>());
 
 			{
 				/*	*/
 				this->uniformStageBuffer.model = glm::mat4(1.0f);
-				this->uniformStageBuffer.model = glm::rotate(
-					this->uniformStageBuffer.model, glm::radians(elapsedTime * 45.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-				this->uniformStageBuffer.model = glm::scale(this->uniformStageBuffer.model, glm::vec3(10.95f));
 				this->uniformStageBuffer.view = this->camera.getViewMatrix();
+				this->uniformStageBuffer.proj = this->camera.getProjectionMatrix();
+				this->uniformStageBuffer.modelView = this->uniformStageBuffer.view * this->uniformStageBuffer.model;
+				this->uniformStageBuffer.viewProjection = this->uniformStageBuffer.proj * this->uniformStageBuffer.view;
 				this->uniformStageBuffer.modelViewProjection =
-					this->uniformStageBuffer.proj * this->uniformStageBuffer.view * this->uniformStageBuffer.model;
-				this->uniformStageBuffer.ViewProj = this->uniformStageBuffer.proj * this->uniformStageBuffer.view;
+					this->uniformStageBuffer.viewProjection * this->uniformStageBuffer.model;
 			}
 
 			{
 				/*	*/
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-				void *uniformPointer = glMapBufferRange(
-					GL_UNIFORM_BUFFER,
-					((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-					this->uniformAlignBufferSize,
-					GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-				memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-				glUnmapBuffer(GL_UNIFORM_BUFFER);
+				this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 			}
 		}
 	};
@@ -267,4 +312,4 @@ int main(int argc, const char **argv) {
 		return EXIT_FAILURE;
 	}
 	return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -78,9 +78,7 @@ namespace glsample {
 
 		/*	Uniform buffer.	*/
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		CameraController camera;
 
@@ -134,7 +132,6 @@ namespace glsample {
 			glDeleteFramebuffers(1, &this->panoramicFrameBuffer);
 			glDeleteTextures(1, &this->panoramicCubeMapTexture);
 
-			glDeleteBuffers(1, &this->uniform_buffer);
 		}
 
 		void Initialize() override {
@@ -196,19 +193,6 @@ namespace glsample {
 			glUniform1i(glGetUniformLocation(this->graphic_cubemap_program, "textureCubeMap"), 0);
 			glUseProgram(0);
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
-			/*	 Create uniform buffer.	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	Create panoramic layered cubemap.	*/
 			{
 
@@ -310,9 +294,8 @@ namespace glsample {
 			{
 
 				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-								  ((this->getFrameCount() % this->nrUniformBuffer)) * this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 				/*	*/
 				glViewport(0, 0, panoramicWidth, panoramicHeight);
 				glClear(GL_DEPTH_BUFFER_BIT);
@@ -356,13 +339,6 @@ namespace glsample {
 			/*	*/
 			this->uniformStageBuffer.proj = this->camera.getProjectionMatrix();
 
-			/*	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			uint8_t *uniformPointer = (uint8_t *)glMapBufferRange(
-				GL_UNIFORM_BUFFER,
-				(((this->getFrameCount() + 1) % this->nrUniformBuffer)) * this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize, GL_MAP_WRITE_BIT);
-
 			/*	Compute light matrices.	*/
 			this->camera.setFOV(90);
 			const glm::mat4 pointPer = glm::perspective(
@@ -405,9 +381,7 @@ namespace glsample {
 			this->uniformStageBuffer.camera.viewDir = glm::vec4(this->camera.getLookDirection(), 0);
 			this->uniformStageBuffer.camera.position = glm::vec4(this->camera.getPosition(), 0);
 
-			memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 		}
 	};
 
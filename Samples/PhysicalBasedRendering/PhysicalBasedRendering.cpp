@@ -46,10 +46,7 @@ namespace glsample {
 
 		/*  Uniform buffers.    */
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer;
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
-		size_t skyboxUniformSize = 0;
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		const NodeObject *rootNode;
 		CameraController camera;
@@ -197,18 +194,6 @@ namespace glsample {
 			this->reflection_texture = textureImporter.loadImage2D(panoramicPath);
 			skybox.Init(this->reflection_texture, this->skybox_program);
 
-			/*	*/
-			GLint minMapBufferSize;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
-			/*	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBufferARB(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * nrUniformBuffer, nullptr, GL_DYNAMIC_DRAW);
-			glBindBufferARB(GL_UNIFORM_BUFFER, 0);
-
 			ModelImporter modelLoader(FileSystem::getFileSystem());
 			modelLoader.loadContent(modelPath, 0);
 			this->scene = PBRScene::loadFrom(modelLoader);
@@ -220,9 +205,8 @@ namespace glsample {
 
 			int width, height;
 			this->getSize(&width, &height);
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  (this->getFrameCount() % nrUniformBuffer) * this->uniformAlignBufferSize,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			glClear(GL_COLOR_BUFFER_BIT);
 
@@ -242,12 +226,7 @@ namespace glsample {
 			this->uniform_stage_buffer.proj = this->camera.getProjectionMatrix();
 			this->uniform_stage_buffer.modelViewProjection = (this->uniform_stage_buffer.proj * camera.getViewMatrix());
 
-			glBindBufferARB(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % nrUniformBuffer) * this->skyboxUniformSize,
-				this->skyboxUniformSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
-			memcpy(uniformPointer, &this->uniform_stage_buffer, sizeof(uniform_stage_buffer));
-			glUnmapBufferARB(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniform_stage_buffer);
 		}
 	};
 
@@ -74,11 +74,9 @@ namespace glsample {
 
 		/*	*/
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformPhongAlignSize{};
-		size_t uniformProjectShadowAlignSize{};
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_model_allocation{};
+		FrameRingAllocator::Allocation uniform_plane_allocation{};
+		FrameRingAllocator::Allocation uniform_shadow_allocation{};
 
 		CameraController camera;
 
@@ -130,8 +128,6 @@ namespace glsample {
 			/*	*/
 			glDeleteTextures(1, (const GLuint *)&this->diffuse_texture);
 
-			glDeleteBuffers(1, &this->uniform_buffer);
-
 			/*	*/
 			glDeleteVertexArrays(1, &this->plan.vao);
 			glDeleteBuffers(1, &this->plan.vbo);
@@ -193,25 +189,6 @@ namespace glsample {
 			glUniformBlockBinding(this->shadow_program, uniform_buffer_index, this->uniform_buffer_binding);
 			glUseProgram(0);
 
-			/*	Align the uniform buffer size to hardware specific.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			/*	*/
-			this->uniformPhongAlignSize =
-				fragcore::Math::align<size_t>(sizeof(this->uniformStageBuffer[0]), (size_t)minMapBufferSize);
-			this->uniformProjectShadowAlignSize =
-				fragcore::Math::align<size_t>(sizeof(this->projectShadowUniformBuffer), (size_t)minMapBufferSize);
-			/*	*/
-			this->uniformAlignBufferSize =
-				(this->uniformPhongAlignSize * this->uniformStageBuffer.size()) + this->uniformProjectShadowAlignSize;
-
-			/*	Create uniform buffer.	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	load Textures	*/
 			TextureImporter textureImporter(this->getFileSystem());
 			this->diffuse_texture = textureImporter.loadImage2D(texturePath);
@@ -320,11 +297,9 @@ namespace glsample {
 				{
 
 					/*	*/
-					const size_t plane_buffer_offset =
-						(this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize +
-						this->uniformPhongAlignSize * 1;
-					glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-									  plane_buffer_offset, this->uniformPhongAlignSize);
+					glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding,
+									  this->uniform_plane_allocation.buffer, this->uniform_plane_allocation.offset,
+									  this->uniform_plane_allocation.size);
 
 					glUseProgram(this->phongblinn_program);
 
@@ -345,11 +320,9 @@ namespace glsample {
 				{
 
 					/*	*/
-					const size_t main_object_buffer_offset =
-						(this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize +
-						this->uniformPhongAlignSize * 0;
-					glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-									  main_object_buffer_offset, this->uniformPhongAlignSize);
+					glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding,
+									  this->uniform_model_allocation.buffer, this->uniform_model_allocation.offset,
+									  this->uniform_model_allocation.size);
 					glUseProgram(this->phongblinn_program);
 
 					/*	Bind texture.   */
@@ -368,11 +341,9 @@ namespace glsample {
 				/*	Draw Shadow, projected onto the plane.	*/
 				{
 					/*	*/
-					const size_t shadow_buffer_offset =
-						(this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize +
-						this->uniformPhongAlignSize * this->uniformStageBuffer.size();
-					glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-									  shadow_buffer_offset, this->uniformProjectShadowAlignSize);
+					glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding,
+									  this->uniform_shadow_allocation.buffer, this->uniform_shadow_allocation.offset,
+									  this->uniform_shadow_allocation.size);
 
 					glUseProgram(this->shadow_program);
 
@@ -441,24 +412,9 @@ namespace glsample {
 
 			/*	Update next uniform buffer region.	*/
 			{
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-				uint8_t *uniformPointer = (uint8_t *)glMapBufferRange(
-					GL_UNIFORM_BUFFER,
-					((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-					this->uniformAlignBufferSize,
-					GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-
-				/*	*/
-				for (size_t i = 0; i < this->uniformStageBuffer.size(); i++) {
-					memcpy(&uniformPointer[i * this->uniformPhongAlignSize], &this->uniformStageBuffer[i],
-						   sizeof(this->uniformStageBuffer[0]));
-				}
-
-				/*	*/
-				memcpy(&uniformPointer[this->uniformPhongAlignSize * this->uniformStageBuffer.size()],
-					   &this->projectShadowUniformBuffer, sizeof(this->projectShadowUniformBuffer));
-
-				glUnmapBuffer(GL_UNIFORM_BUFFER);
+				this->uniform_model_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer[0]);
+				this->uniform_plane_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer[1]);
+				this->uniform_shadow_allocation = this->getFrameAllocator().allocate(this->projectShadowUniformBuffer);
 			}
 		}
 
@@ -65,10 +65,8 @@ namespace glsample {
 		/*	*/
 		unsigned int uniform_buffer_binding = 0;
 		unsigned int uniform_pointlight_buffer_binding = 1;
-		unsigned int uniform_buffer{};
+		FrameRingAllocator::Allocation uniform_allocation{};
 		unsigned int uniform_pointlight_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
 		size_t uniformLightBufferSize = 0;
 
 		/*	*/
@@ -143,22 +141,6 @@ namespace glsample {
 			glUniformBlockBinding(this->raytracing_program, uniform_buffer_index, this->uniform_buffer_binding);
 			glUseProgram(0);
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-			// this->uniformLightBufferSize = (sizeof(pointLights[0]) * pointLights.size());
-			// this->uniformLightBufferSize = fragcore::Math::align<size_t>(uniformLightBufferSize,
-			// (size_t)minMapBufferSize);
-
-			/*	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	Create sampler distrubution.	*/
 
 			/*	*/
@@ -219,9 +201,8 @@ namespace glsample {
 			int width = 0, height = 0;
 			this->getSize(&width, &height);
 
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  (this->getFrameCount() % nrUniformBuffer) * this->uniformAlignBufferSize,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
 
@@ -281,13 +262,7 @@ namespace glsample {
 
 			/*	*/
 			{
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-				void *uniformPointer = glMapBufferRange(
-					GL_UNIFORM_BUFFER,
-					((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-					this->uniformAlignBufferSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-				memcpy(uniformPointer, &this->uniformBuffer, sizeof(this->uniformBuffer));
-				glUnmapBuffer(GL_UNIFORM_BUFFER);
+				this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformBuffer);
 			}
 		}
 	};
@@ -0,0 +1,224 @@
+#include "PhysicSimulation.h"
+#include "Util/TaskParallel.h"
+#include <algorithm>
+
+using namespace fragcore;
+
+namespace glsample {
+
+	PhysicSimulation::PhysicSimulation(fragcore::PhysicInterface *physicInterface,
+									   const std::vector<fragcore::RigidBody *> &bodies)
+		: physicInterface(physicInterface), bodies(bodies) {}
+
+	PhysicSimulation::~PhysicSimulation() { this->stop(); }
+
+	void PhysicSimulation::start() {
+		if (this->thread.joinable()) {
+			return;
+		}
+
+		this->stopping = false;
+		this->thread = std::thread(&PhysicSimulation::simulationThread, this);
+	}
+
+	void PhysicSimulation::stop() {
+		{
+			std::lock_guard<std::mutex> guard(this->controlLock);
+			this->stopping = true;
+		}
+		this->stopCondition.notify_all();
+
+		if (this->thread.joinable()) {
+			this->thread.join();
+		}
+	}
+
+	void PhysicSimulation::exportTransforms(const fragcore::RigidBody *const *bodies, const size_t nrBodies,
+											BodyTransform *transforms) {
+		/*	Serial on the physics thread, the physic interface is not safe for concurrent reads.	*/
+		for (size_t i = 0; i < nrBodies; i++) {
+			RigidBody *body = const_cast<RigidBody *>(bodies[i]);
+			const auto position = body->getPosition();
+			const auto orientation = body->getOrientation();
+
+			transforms[i].position = glm::vec3(position.x(), position.y(), position.z());
+			transforms[i].orientation = glm::quat(orientation.w(), orientation.x(), orientation.y(), orientation.z());
+		}
+	}
+
+	bool PhysicSimulation::interpolateTransforms(glm::mat4 *models) {
+
+		/*	Latest published snapshot, the previous front is handed back to the simulation.	*/
+		{
+			std::lock_guard<std::mutex> guard(this->snapshotLock);
+			if (this->readyFresh) {
+				std::swap(this->frontIndex, this->readyIndex);
+				this->readyFresh = false;
+				this->hasFront = true;
+			}
+			if (!this->hasFront) {
+				return false;
+			}
+		}
+
+		/*	Only the render thread accesses the front.	*/
+		const Snapshot &snapshot = this->snapshots[this->frontIndex];
+
+		/*	Rendered one step behind the simulation, between the previous and current step.	*/
+		const float elapsed = std::chrono::duration<float>(Clock::now() - snapshot.time).count();
+		const float alpha = snapshot.timeStep > 0 ? std::clamp(elapsed / snapshot.timeStep, 0.0f, 1.0f) : 1.0f;
+
+		parallelFor(snapshot.current.size(), 1024, [&](const size_t begin, const size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				const BodyTransform &from = snapshot.previous[i];
+				const BodyTransform &to = snapshot.current[i];
+
+				const glm::vec3 position = glm::mix(from.position, to.position, alpha);
+				const glm::quat orientation = glm::slerp(from.orientation, to.orientation, alpha);
+
+				glm::mat4 model = glm::mat4_cast(orientation);
+				model[3] = glm::vec4(position, 1.0f);
+				models[i] = model;
+			}
+		});
+
+		return true;
+	}
+
+	void PhysicSimulation::setFixedTimeStep(const float timeStep) noexcept {
+		std::lock_guard<std::mutex> guard(this->controlLock);
+		this->controls.fixedTimeStep = std::max(timeStep, 1.0f / 1000.0f);
+	}
+
+	void PhysicSimulation::setMaxSubSteps(const int maxSubSteps) noexcept {
+		std::lock_guard<std::mutex> guard(this->controlLock);
+		this->controls.maxSubSteps = std::max(maxSubSteps, 1);
+	}
+
+	void PhysicSimulation::setSpeed(const float speed) noexcept {
+		std::lock_guard<std::mutex> guard(this->controlLock);
+		this->controls.speed = std::max(speed, 0.0f);
+	}
+
+	void PhysicSimulation::setSimulate(const bool simulate) noexcept {
+		std::lock_guard<std::mutex> guard(this->controlLock);
+		this->controls.simulate = simulate;
+	}
+
+	void PhysicSimulation::setGravity(const glm::vec3 &gravity) noexcept {
+		std::lock_guard<std::mutex> guard(this->controlLock);
+		this->controls.gravity = gravity;
+	}
+
+	void PhysicSimulation::setKinematicPosition(fragcore::RigidBody *body, const glm::vec3 &position) noexcept {
+		std::lock_guard<std::mutex> guard(this->controlLock);
+		this->controls.kinematicBody = body;
+		this->controls.kinematicPosition = position;
+	}
+
+	void PhysicSimulation::addForce(const size_t begin, const size_t end, const glm::vec3 &force) noexcept {
+		std::lock_guard<std::mutex> guard(this->controlLock);
+		this->controls.force += force;
+		this->controls.forceBegin = begin;
+		this->controls.forceEnd = std::min(end, this->bodies.size());
+	}
+
+	void PhysicSimulation::applyControls(Controls &controls) {
+		this->physicInterface->setGravity(Vector3(controls.gravity.x, controls.gravity.y, controls.gravity.z));
+
+		if (controls.kinematicBody) {
+			const glm::vec3 &position = controls.kinematicPosition;
+			controls.kinematicBody->setPosition(Vector3(position.x, position.y, position.z));
+		}
+
+		/*	Consumed once.	*/
+		if (controls.force != glm::vec3(0)) {
+			const Vector3 force = Vector3(controls.force.x, controls.force.y, controls.force.z);
+			for (size_t i = controls.forceBegin; i < controls.forceEnd; i++) {
+				this->bodies[i]->addForce(force);
+			}
+		}
+	}
+
+	void PhysicSimulation::publish() {
+		Snapshot &snapshot = this->snapshots[this->backIndex];
+		snapshot.previous.assign(this->previous.begin(), this->previous.end());
+		snapshot.current.assign(this->current.begin(), this->current.end());
+		snapshot.time = Clock::now();
+
+		std::lock_guard<std::mutex> guard(this->snapshotLock);
+		std::swap(this->backIndex, this->readyIndex);
+		this->readyFresh = true;
+	}
+
+	void PhysicSimulation::simulationThread() {
+
+		/*	Initial state, no interpolation until the first step.	*/
+		this->current.resize(this->bodies.size());
+		PhysicSimulation::exportTransforms(this->bodies.data(), this->bodies.size(), this->current.data());
+		this->previous = this->current;
+		this->publish();
+
+		Clock::time_point last = Clock::now();
+		float accumulator = 0;
+
+		while (true) {
+			Controls stepControls;
+			{
+				std::unique_lock<std::mutex> guard(this->controlLock);
+				if (this->stopping) {
+					break;
+				}
+				stepControls = this->controls;
+			}
+
+			const Clock::time_point now = Clock::now();
+			accumulator += std::chrono::duration<float>(now - last).count() * stepControls.speed;
+			last = now;
+
+			if (!stepControls.simulate) {
+				accumulator = 0;
+			}
+
+			/*	Drop the time that can not be caught up with, rather than spiral behind.	*/
+			const float timeStep = stepControls.fixedTimeStep;
+			accumulator = std::min(accumulator, timeStep * stepControls.maxSubSteps);
+
+			if (accumulator >= timeStep) {
+				this->applyControls(stepControls);
+
+				/*	Forces are only applied once, keep the forces added since the copy.	*/
+				{
+					std::lock_guard<std::mutex> guard(this->controlLock);
+					this->controls.force -= stepControls.force;
+				}
+
+				unsigned int nrSubSteps = 0;
+				while (accumulator >= timeStep) {
+					this->physicInterface->simulate(timeStep, 1, timeStep);
+					this->physicInterface->sync();
+					accumulator -= timeStep;
+					nrSubSteps++;
+				}
+				this->nrSteps += nrSubSteps;
+
+				/*	Bulk export, the previous state is kept for the interpolation.	*/
+				std::swap(this->previous, this->current);
+				PhysicSimulation::exportTransforms(this->bodies.data(), this->bodies.size(), this->current.data());
+				this->snapshots[this->backIndex].timeStep =
+					(nrSubSteps * timeStep) / std::max(stepControls.speed, 1e-6f);
+				this->publish();
+			}
+
+			/*	Sleep until the next step is due.	*/
+			const float remaining = (timeStep - accumulator) / std::max(stepControls.speed, 1e-6f);
+			const Clock::time_point wakeup =
+				now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(
+						  stepControls.simulate ? std::min(remaining, 0.1f) : 0.01f));
+
+			std::unique_lock<std::mutex> guard(this->controlLock);
+			this->stopCondition.wait_until(guard, wakeup, [this]() { return this->stopping; });
+		}
+	}
+
+} // namespace glsample
@@ -0,0 +1,130 @@
+#pragma once
+#include <PhysicInterface.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace glsample {
+
+	/**
+	 * @brief Simulate the physics on its own thread at a fixed timestep, decoupled from the frame rate.
+	 *
+	 * After each step the transforms of all bodies are exported in bulk into a snapshot, published through a
+	 * triple buffer. A snapshot holds the previous and the current step, the render thread interpolates
+	 * between them without ever waiting on the simulation. The physic interface must not be used by any
+	 * other thread while the simulation is running, changes are passed with the setters instead.
+	 */
+	class PhysicSimulation {
+	  public:
+		using BodyTransform = struct body_transform_t {
+			glm::vec3 position;
+			glm::quat orientation;
+		};
+
+		/**
+		 * @param bodies exported in order, the index of a body is the index of its transform.
+		 */
+		PhysicSimulation(fragcore::PhysicInterface *physicInterface, const std::vector<fragcore::RigidBody *> &bodies);
+		PhysicSimulation(const PhysicSimulation &) = delete;
+		PhysicSimulation &operator=(const PhysicSimulation &) = delete;
+		virtual ~PhysicSimulation();
+
+		void start();
+		void stop();
+
+		/**
+		 * @brief Copy the transform of each body into the contiguous array, serially on the calling thread.
+		 */
+		static void exportTransforms(const fragcore::RigidBody *const *bodies, const size_t nrBodies,
+									 BodyTransform *transforms);
+
+		/**
+		 * @brief Model matrices interpolated between the last two published steps, at the current time. Split over
+		 * the task scheduler workers.
+		 *
+		 * @param models array of getNrBodies matrices, may be mapped buffer memory.
+		 * @return false if no step has been published yet.
+		 */
+		bool interpolateTransforms(glm::mat4 *models);
+
+		size_t getNrBodies() const noexcept { return this->bodies.size(); }
+		uint64_t getNrSteps() const noexcept { return this->nrSteps; }
+
+		void setFixedTimeStep(const float timeStep) noexcept;
+		void setMaxSubSteps(const int maxSubSteps) noexcept;
+		void setSpeed(const float speed) noexcept;
+		void setSimulate(const bool simulate) noexcept;
+		void setGravity(const glm::vec3 &gravity) noexcept;
+
+		/**
+		 * @brief Move the kinematic body before the next step.
+		 */
+		void setKinematicPosition(fragcore::RigidBody *body, const glm::vec3 &position) noexcept;
+
+		/**
+		 * @brief Force applied to the bodies [begin, end) on the next step.
+		 */
+		void addForce(const size_t begin, const size_t end, const glm::vec3 &force) noexcept;
+
+	  private:
+		using Clock = std::chrono::steady_clock;
+
+		/*	Previous and current step, with the time the current step was published.	*/
+		using Snapshot = struct snapshot_t {
+			std::vector<BodyTransform> previous;
+			std::vector<BodyTransform> current;
+			Clock::time_point time;
+			float timeStep = 0;
+		};
+
+		/*	Written by the render thread, applied by the simulation thread before each step.	*/
+		using Controls = struct controls_t {
+			float fixedTimeStep = 1.0f / 60.0f;
+			int maxSubSteps = 1;
+			float speed = 1.0f;
+			bool simulate = true;
+			glm::vec3 gravity = glm::vec3(0, -9.82f, 0);
+			fragcore::RigidBody *kinematicBody = nullptr;
+			glm::vec3 kinematicPosition = glm::vec3(0);
+			glm::vec3 force = glm::vec3(0);
+			size_t forceBegin = 0;
+			size_t forceEnd = 0;
+		};
+
+		void simulationThread();
+		void applyControls(Controls &controls);
+		void publish();
+
+		fragcore::PhysicInterface *physicInterface;
+		std::vector<fragcore::RigidBody *> bodies;
+
+		/*	Only accessed by the simulation thread.	*/
+		std::vector<BodyTransform> previous;
+		std::vector<BodyTransform> current;
+
+		/*	Triple buffer, the simulation writes the back, the render thread reads the front.	*/
+		std::array<Snapshot, 3> snapshots;
+		unsigned int backIndex = 0;
+		unsigned int readyIndex = 1;
+		unsigned int frontIndex = 2;
+		bool readyFresh = false;
+		bool hasFront = false;
+		std::mutex snapshotLock;
+
+		Controls controls;
+		std::mutex controlLock;
+
+		std::thread thread;
+		std::condition_variable stopCondition;
+		bool stopping = false;
+		std::atomic<uint64_t> nrSteps{0};
+	};
+
+} // namespace glsample
@@ -2,6 +2,7 @@
 #include "GLSampleSession.h"
 #include "Math3D/Math3D.h"
 #include "PhysicDesc.h"
+#include "PhysicSimulation.h"
 #include "SampleHelper.h"
 #include "Util/CameraController.h"
 #include <GL/glew.h>
@@ -11,11 +12,13 @@
 #include <ModelImporter.h>
 #include <PhysicInterface.h>
 #include <ShaderLoader.h>
+#include <algorithm>
 #include <array>
 #include <bulletPhysicInterface.h>
 #include <cstdint>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
+#include <memory>
 
 namespace glsample {
 
@@ -61,7 +64,7 @@ namespace glsample {
 		fragcore::RigidBody *planeRigibody{};
 		fragcore::RigidBody *sphere_camera_collider_rig{};
 
-		const std::array<size_t, 3> grid_aray = {8, 16, 8};
+		std::array<size_t, 3> grid_aray = {8, 16, 8};
 
 		/*	*/
 		MeshObject hyerplane;
@@ -78,12 +81,10 @@ namespace glsample {
 		unsigned int uniform_buffer_binding = 0;
 		unsigned int uniform_instance_buffer_binding = 1;
 
-		unsigned int uniform_buffer{};
-		unsigned int ssbo_instance_buffer{};
+		FrameRingAllocator::Allocation uniform_allocation{};
+		FrameRingAllocator::Allocation instance_allocation{};
+		bool hasInstanceTransforms = false;
 
-		const size_t nrUniformBuffers = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
-		size_t uniformLightBufferSize = sizeof(uniform_buffer_block);
 		size_t uniformInstanceSize = 0;
 
 		/*	*/
@@ -92,6 +93,8 @@ namespace glsample {
 		size_t instanceBatch = 0;
 
 		PhysicInterface *physic_interface{};
+		/*	Simulated on its own thread, boxes followed by spheres.	*/
+		std::unique_ptr<PhysicSimulation> simulation;
 
 		/*	RigidBody Rendering Path.	*/
 		const std::string vertexInstanceShaderPath = "Shaders/instance/instance_ssbo.vert.spv";
@@ -148,16 +151,20 @@ namespace glsample {
 
 		void Release() override {
 
+			/*	Before the rigidbodies are released.	*/
+			this->simulation.reset();
+
 			glDeleteProgram(this->graphic_program);
 			glDeleteProgram(this->hyperplane_program);
 
-			/*	*/
-			glDeleteBuffers(1, &this->uniform_buffer);
-			glDeleteBuffers(1, &this->ssbo_instance_buffer);
 		}
 
 		void Initialize() override {
 
+			/*	Number of bodies along the x and z axis.	*/
+			const size_t gridSize = std::max(this->getResult()["grid-size"].as<int>(), 1);
+			this->grid_aray = {gridSize, 16, gridSize};
+
 			/*	Preallocate.	*/
 			this->rigidbodies_box.resize(fragcore::Math::product<size_t>(grid_aray.data(), grid_aray.size()));
 			this->rigidbodies_sphere.resize(fragcore::Math::product<size_t>(grid_aray.data(), grid_aray.size()));
@@ -216,36 +223,14 @@ namespace glsample {
 			/*	Create white texture.	*/
 			this->white_texture = Common::createColorTexture(1, 1, Color::white());
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
-			/*	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffers, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	Setup instance buffer.	*/
 			{
 				/*	*/
-				GLint storageMaxSize = 0;
-				glGetIntegerv(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &storageMaxSize);
-				GLint minStorageAlignSize = 0;
-				glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &minStorageAlignSize);
 				this->instanceBatch = this->rigidbodies_box.size() + this->rigidbodies_sphere.size();
+				this->uniformInstanceSize = this->instanceBatch * sizeof(glm::mat4);
 
-				this->uniformInstanceSize =
-					fragcore::Math::align<size_t>(this->instanceBatch * sizeof(glm::mat4), (size_t)minStorageAlignSize);
-
-				glGenBuffers(1, &this->ssbo_instance_buffer);
-				glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->ssbo_instance_buffer);
-				glBufferData(GL_SHADER_STORAGE_BUFFER, this->uniformInstanceSize * this->nrUniformBuffers, nullptr,
-							 GL_DYNAMIC_DRAW);
-				glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+				/*	Large grids do not fit in the default frame size.	*/
+				this->getFrameAllocator().reserve(this->getFrameAllocator().getFrameSize() + this->uniformInstanceSize);
 			}
 
 			/*	*/
@@ -349,6 +334,12 @@ namespace glsample {
 			}
 
 			this->physic_interface->sync();
+
+			/*	The physic interface is only accessed by the simulation thread from now on.	*/
+			std::vector<fragcore::RigidBody *> bodies = this->rigidbodies_box;
+			bodies.insert(bodies.end(), this->rigidbodies_sphere.begin(), this->rigidbodies_sphere.end());
+			this->simulation = std::make_unique<PhysicSimulation>(this->physic_interface, bodies);
+			this->simulation->start();
 		}
 
 		void onResize(int width, int height) override {
@@ -365,17 +356,16 @@ namespace glsample {
 			this->getSize(&width, &height);
 
 			/*	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  ((this->getFrameCount() % nrUniformBuffers)) * this->uniformAlignBufferSize,
-							  this->uniformAlignBufferSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			/*	Draw from main camera */
 			glViewport(0, 0, width, height);
 			glClearColor(0.05f, 0.05f, 0.05f, 0.0f);
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-			/*	Draw rigidbodies.	*/
-			{
+			/*	Draw rigidbodies, once the simulation has published the first transforms.	*/
+			if (this->hasInstanceTransforms) {
 
 				glUseProgram(this->graphic_program);
 
@@ -391,9 +381,8 @@ namespace glsample {
 
 				/*	*/
 				glBindBufferRange(GL_SHADER_STORAGE_BUFFER, this->uniform_instance_buffer_binding,
-								  this->ssbo_instance_buffer,
-								  ((this->getFrameCount()) % this->nrUniformBuffers) * this->uniformInstanceSize,
-								  this->uniformInstanceSize);
+								  this->instance_allocation.buffer, this->instance_allocation.offset,
+								  this->rigidbodies_box.size() * sizeof(glm::mat4));
 
 				/*	*/
 				glBindVertexArray(this->boxMesh.vao);
@@ -403,10 +392,9 @@ namespace glsample {
 
 				/*	*/
 				glBindBufferRange(GL_SHADER_STORAGE_BUFFER, this->uniform_instance_buffer_binding,
-								  this->ssbo_instance_buffer,
-								  ((this->getFrameCount()) % this->nrUniformBuffers) * this->uniformInstanceSize +
-									  this->rigidbodies_box.size() * sizeof(glm::mat4),
-								  this->uniformInstanceSize);
+								  this->instance_allocation.buffer,
+								  this->instance_allocation.offset + this->rigidbodies_box.size() * sizeof(glm::mat4),
+								  this->rigidbodies_sphere.size() * sizeof(glm::mat4));
 
 				/*	*/
 				glBindVertexArray(this->sphereMesh.vao);
@@ -446,15 +434,18 @@ namespace glsample {
 
 		void update() override {
 
-			if (this->rigidBodySettingComponent->usePhysic) {
-				this->physic_interface->sync();
-			}
-
 			/*	Update Camera.	*/
 			this->camera.update(this->getTimer().deltaTime<float>());
+
+			/*	Physic settings, applied by the simulation thread on the next step.	*/
+			this->simulation->setSimulate(this->rigidBodySettingComponent->usePhysic);
+			this->simulation->setSpeed(this->rigidBodySettingComponent->speed);
+			this->simulation->setFixedTimeStep(this->rigidBodySettingComponent->fixedTimeStep);
+			this->simulation->setMaxSubSteps(this->rigidBodySettingComponent->maxSubStep);
+			this->simulation->setGravity(this->rigidBodySettingComponent->useGravity ? glm::vec3(0, -9.82, 0)
+																					  : glm::vec3(0, 0, 0));
 			/*	Update Camera collider.	*/
-			this->sphere_camera_collider_rig->setPosition(
-				Vector3(this->camera.getPosition().x, this->camera.getPosition().y, this->camera.getPosition().z));
+			this->simulation->setKinematicPosition(this->sphere_camera_collider_rig, this->camera.getPosition());
 
 			/*	*/
 			{
@@ -467,77 +458,21 @@ namespace glsample {
 				this->uniformStageBuffer.viewPos = glm::vec4(camera.getPosition(), 0);
 
 				/*	Update uniform buffer.	*/
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-				void *uniformMappedMemory = glMapBufferRange(
-					GL_UNIFORM_BUFFER,
-					((this->getFrameCount() + 1) % this->nrUniformBuffers) * this->uniformAlignBufferSize,
-					this->uniformAlignBufferSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-				memcpy(uniformMappedMemory, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-				glUnmapBuffer(GL_UNIFORM_BUFFER);
+				this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 			}
 
-			/*	Update rigidbodies model matrix.	*/
+			/*	Update rigidbodies model matrix, interpolated between the last two physic steps.	*/
 			{
-				glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->ssbo_instance_buffer);
-				uint8_t *uniform_instance_buffer_pointer = (uint8_t *)glMapBufferRange(
-					GL_SHADER_STORAGE_BUFFER,
-					((this->getFrameCount() + 1) % this->nrUniformBuffers) * this->uniformInstanceSize,
-					this->uniformInstanceSize, GL_MAP_WRITE_BIT);
-
-				size_t offset = 0;
-				for (size_t i = 0; i < rigidbodies_box.size(); i++) {
-					glm::mat4 model = glm::mat4(1);
-					model = glm::translate(model, glm::vec3(rigidbodies_box[i]->getPosition().x(),
-															rigidbodies_box[i]->getPosition().y(),
-															rigidbodies_box[i]->getPosition().z()));
-
-					const glm::quat roat(
-						rigidbodies_box[i]->getOrientation().w(), rigidbodies_box[i]->getOrientation().x(),
-						rigidbodies_box[i]->getOrientation().y(), rigidbodies_box[i]->getOrientation().z());
-
-					model = model * glm::toMat4(roat);
-
-					memcpy(&uniform_instance_buffer_pointer[i * sizeof(glm::mat4)], &model[0][0], sizeof(model));
-					offset++;
-				}
-
-				for (size_t i = 0; i < rigidbodies_sphere.size(); i++) {
-					glm::mat4 model = glm::mat4(1);
-					model = glm::translate(model, glm::vec3(rigidbodies_sphere[i]->getPosition().x(),
-															rigidbodies_sphere[i]->getPosition().y(),
-															rigidbodies_sphere[i]->getPosition().z()));
-
-					const glm::quat roat(
-						rigidbodies_sphere[i]->getOrientation().w(), rigidbodies_sphere[i]->getOrientation().x(),
-						rigidbodies_sphere[i]->getOrientation().y(), rigidbodies_sphere[i]->getOrientation().z());
-
-					model = model * glm::toMat4(roat);
-
-					memcpy(&uniform_instance_buffer_pointer[(offset + i) * sizeof(glm::mat4)], &model[0][0],
-						   sizeof(model));
-				}
+				this->instance_allocation = this->getFrameAllocator().allocate(
+					this->uniformInstanceSize, FrameRingAllocator::Usage::Storage);
 
-				glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
-			}
-
-			if (this->rigidBodySettingComponent->useGravity) {
-				this->physic_interface->setGravity(Vector3(0, -9.82, 0));
-			} else {
-				this->physic_interface->setGravity(Vector3(0, 0, 0));
+				this->hasInstanceTransforms =
+					this->simulation->interpolateTransforms(this->instance_allocation.as<glm::mat4>());
 			}
 
 			if (this->getInput().getMouseDown(Input::MouseButton::LEFT_BUTTON)) {
-				for (size_t i = 0; i < rigidbodies_box.size(); i++) {
-					const glm::vec3 force = camera.getLookDirection() * 150.0f;
-					rigidbodies_box[i]->addForce(GLM2E(force));
-				}
-			}
-
-			/*	Simulate.	*/
-			if (this->rigidBodySettingComponent->usePhysic) {
-				this->physic_interface->simulate(
-					this->getTimer().deltaTime<float>() * this->rigidBodySettingComponent->speed,
-					this->rigidBodySettingComponent->maxSubStep, this->rigidBodySettingComponent->fixedTimeStep);
+				const glm::vec3 force = camera.getLookDirection() * 150.0f;
+				this->simulation->addForce(0, this->rigidbodies_box.size(), force);
 			}
 		}
 	};
@@ -545,7 +480,10 @@ namespace glsample {
 	class RigidBodyGLSample : public GLSample<RigidBody> {
 	  public:
 		RigidBodyGLSample() : GLSample<RigidBody>() {}
-		void customOptions(cxxopts::OptionAdder &options) override {}
+		void customOptions(cxxopts::OptionAdder &options) override {
+			options("N,grid-size", "Number of bodies along the x and z axis, per body type",
+					cxxopts::value<int>()->default_value("8"));
+		}
 	};
 
 } // namespace glsample
@@ -1,3 +1,4 @@
+#include "Profiler.h"
 #include "SampleHelper.h"
 #include "Skybox.h"
 #include <GL/glew.h>
@@ -8,9 +9,14 @@
 #include <Importer/Scene.h>
 #include <ModelImporter.h>
 #include <ShaderLoader.h>
+#include <Util/Light.h>
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <fmt/core.h>
 #include <glm/fwd.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <limits>
 
 namespace glsample {
 
@@ -34,8 +40,8 @@ namespace glsample {
 	};
 
 	/**
-	 * @brief
-	 *
+	 * @brief Directional shadow from cascaded shadow maps, each cascade covers a slice of the view frustum and
+	 * is stored in a layer of a single 2D array depth texture.
 	 */
 	class ShadowMapping : public GLSampleWindow {
 	  public:
@@ -49,9 +55,13 @@ namespace glsample {
 			this->camera.lookAt(glm::vec3(0.f));
 		}
 
+		static constexpr int maxCascades = 8;
+
 		struct alignas(16) uniform_buffer_block {
 
-			glm::mat4 lightModelProject{};
+			glm::mat4 lightSpaceMatrix[maxCascades]{};
+			/*	View depth of the far plane of each cascade.	*/
+			glm::vec4 cascadeSplits[maxCascades / 4]{};
 
 			/*	light source.	*/
 			DirectionalLight directional;
@@ -59,13 +69,35 @@ namespace glsample {
 			float bias = 0.00050f;
 			float shadowStrength = 1.0f;
 			float pcfRadius = 1.0f;
+			int nrCascades = 0;
+			int showCascades = 0;
 		} uniformStageBuffer;
 
+		/*	Matches the uniform block of the shadowmap shaders, one per cascade.	*/
+		struct alignas(16) uniform_shadow_block {
+			glm::mat4 lightSpaceMatrix{};
+			DirectionalLight directional;
+			float bias;
+			float shadowStrength;
+			float pcfRadius;
+		};
+
+		struct Cascade {
+			unsigned int framebuffer = 0;
+			/*	Layer view without the depth comparison, for the UI.	*/
+			unsigned int previewTexture = 0;
+			glm::mat4 lightSpaceMatrix{1.0f};
+			size_t nrRenderedNodes = 0;
+			/*	Content of the previous frame is reused.	*/
+			bool cached = false;
+			bool valid = false;
+			bool alphaClip = false;
+		};
+
 		/*	*/
-		unsigned int shadowFramebuffer{};
 		unsigned int shadowTexture{};
-		size_t shadowWidth = static_cast<long>(4096) * 2 * 2;
-		size_t shadowHeight = static_cast<long>(4096) * 2 * 2;
+		size_t shadowResolution = 2048;
+		std::vector<Cascade> cascades;
 
 		SceneShadow scene;
 		Skybox skybox;
@@ -82,9 +114,7 @@ namespace glsample {
 		/*	Uniform buffer.	*/
 		unsigned int uniform_shadow_buffer_binding = 0;
 		unsigned int uniform_graphic_buffer_binding = 0;
-		unsigned int uniform_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
 		const int shadowBinding = 15;
 
 		CameraController camera;
@@ -92,7 +122,7 @@ namespace glsample {
 		class BasicShadowMapSettingComponent : public GLUIComponent<ShadowMapping> {
 		  public:
 			BasicShadowMapSettingComponent(ShadowMapping &sample)
-				: GLUIComponent(sample, "Basic Shadow Mapping Settings"), depth(this->getRefSample().shadowTexture),
+				: GLUIComponent(sample, "Basic Shadow Mapping Settings"),
 				  uniform(this->getRefSample().uniformStageBuffer) {}
 
 			void draw() override {
@@ -104,18 +134,41 @@ namespace glsample {
 								  ImGuiColorEditFlags_HDR | ImGuiColorEditFlags_Float);
 				ImGui::DragFloat3("Direction", &this->uniform.directional.lightDirection[0]);
 
-				ImGui::DragFloat("Distance", &this->distance);
+				ImGui::SliderInt("Cascades", &this->nrCascades, 2, maxCascades);
+				ImGui::SliderFloat("Split Lambda", &this->splitLambda, 0.0f, 1.0f);
+				ImGui::DragFloat("Shadow Distance", &this->distance, 1, 1.0f, 10000.0f);
+				ImGui::Checkbox("Stabilize Cascades", &this->stabilize);
+				ImGui::Checkbox("Cache Static Cascades", &this->cacheStaticCascades);
+				ImGui::Checkbox("Show Cascades", &this->showCascades);
 				ImGui::Checkbox("WireFrame", &this->showWireFrame);
 				ImGui::Checkbox("PCF Shadow", &this->use_pcf);
 				ImGui::Checkbox("Shadow Alpha Clipping", &this->useShadowClip);
-				ImGui::TextUnformatted("Depth Texture");
-				ImGui::Image(static_cast<ImTextureID>(this->depth), ImVec2(512, 512), ImVec2(1, 1), ImVec2(0, 0));
+
+				const std::vector<Cascade> &cascades = this->getRefSample().cascades;
+				for (size_t i = 0; i < cascades.size(); i++) {
+					ImGui::Text("Cascade %zu: %.2f, %zu nodes%s", i, this->uniform.cascadeSplits[i / 4][i % 4],
+								cascades[i].nrRenderedNodes, cascades[i].cached ? " (cached)" : "");
+				}
+
+				if (!cascades.empty()) {
+					const int lastCascade = static_cast<int>(cascades.size()) - 1;
+					this->previewCascade = std::min(this->previewCascade, lastCascade);
+					ImGui::SliderInt("Preview Cascade", &this->previewCascade, 0, lastCascade);
+					ImGui::TextUnformatted("Depth Texture");
+					ImGui::Image(static_cast<ImTextureID>(cascades[this->previewCascade].previewTexture),
+								 ImVec2(512, 512), ImVec2(1, 1), ImVec2(0, 0));
+				}
 
 				this->getRefSample().scene.renderUI();
 			}
 
-			float distance = 50.0;
-			unsigned int &depth;
+			float distance = 150.0;
+			int nrCascades = 4;
+			float splitLambda = 0.9f;
+			bool stabilize = true;
+			bool cacheStaticCascades = false;
+			bool showCascades = false;
+			int previewCascade = 0;
 			bool showWireFrame = false;
 			bool use_pcf = false;
 			bool useShadowClip = false;
@@ -139,16 +192,76 @@ namespace glsample {
 			glDeleteProgram(this->graphic_program);
 			glDeleteProgram(this->graphic_pfc_program);
 			glDeleteProgram(this->shadow_program);
+			glDeleteProgram(this->shadow_alpha_clip_program);
+
+			this->releaseShadowMap();
+		}
+
+		void releaseShadowMap() {
+			for (const Cascade &cascade : this->cascades) {
+				glDeleteFramebuffers(1, &cascade.framebuffer);
+				glDeleteTextures(1, &cascade.previewTexture);
+			}
+			this->cascades.clear();
 
-			glDeleteFramebuffers(1, &this->shadowFramebuffer);
 			glDeleteTextures(1, &this->shadowTexture);
+			this->shadowTexture = 0;
+		}
+
+		void createShadowMap(const unsigned int nrCascades) {
+			this->releaseShadowMap();
+
+			/*	One layer per cascade.	*/
+			glGenTextures(1, &this->shadowTexture);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, this->shadowTexture);
+			glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_DEPTH_COMPONENT32, this->shadowResolution,
+						   this->shadowResolution, nrCascades);
+			/*	*/
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+			/*	Border clamped to max value, it makes the outside area.	*/
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+			float borderColor[] = {1.0f, 1.0f, 1.0f, 1.0f};
+			glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+			this->cascades.resize(nrCascades);
+			for (size_t i = 0; i < this->cascades.size(); i++) {
+				Cascade &cascade = this->cascades[i];
+
+				glGenFramebuffers(1, &cascade.framebuffer);
+				glBindFramebuffer(GL_FRAMEBUFFER, cascade.framebuffer);
+				glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, this->shadowTexture, 0, i);
+				glDrawBuffer(GL_NONE);
+				glReadBuffer(GL_NONE);
+
+				int frstat = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+				if (frstat != GL_FRAMEBUFFER_COMPLETE) {
+					throw RuntimeException("Failed to create framebuffer, {}",
+										   (const char *)glewGetErrorString(frstat));
+				}
 
-			glDeleteBuffers(1, &this->uniform_buffer);
+				glGenTextures(1, &cascade.previewTexture);
+				glTextureView(cascade.previewTexture, GL_TEXTURE_2D, this->shadowTexture, GL_DEPTH_COMPONENT32, 0, 1,
+							  i, 1);
+				glBindTexture(GL_TEXTURE_2D, cascade.previewTexture);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+				glBindTexture(GL_TEXTURE_2D, 0);
+			}
+
+			glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
 		}
 
 		void Initialize() override {
 			const std::string modelPath = this->getResult()["model"].as<std::string>();
 			const std::string skyboxPath = this->getResult()["skybox"].as<std::string>();
+			const int nrCascades = this->getResult()["cascades"].as<int>();
+			const int resolution = this->getResult()["shadow-resolution"].as<int>();
 
 			{
 				/*	*/
@@ -228,72 +341,23 @@ namespace glsample {
 				glUseProgram(0);
 			}
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
-			// Create uniform buffer.
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr,
-						 GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
 			{
-				/*	Create shadow map.	*/
-				glGenFramebuffers(1, &shadowFramebuffer);
-				glBindFramebuffer(GL_FRAMEBUFFER, shadowFramebuffer);
-
 				/*	Clamp texture size to valid size.	*/
 				int max_texture_size = 0;
 				glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
-				this->shadowWidth = fragcore::Math::min<int>(this->shadowWidth, max_texture_size);
-				this->shadowHeight = fragcore::Math::min<int>(this->shadowHeight, max_texture_size);
-
-				/*	*/
-				glGenTextures(1, &this->shadowTexture);
-				glBindTexture(GL_TEXTURE_2D, this->shadowTexture);
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32, shadowWidth, shadowHeight, 0, GL_DEPTH_COMPONENT,
-							 GL_FLOAT, nullptr);
-				/*	*/
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-				/*	Border clamped to max value, it makes the outside area.	*/
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-				float borderColor[] = {1.0f, 1.0f, 1.0f, 1.0f};
-				glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
-
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+				this->shadowResolution = std::clamp<int>(resolution, 1, max_texture_size);
 
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LOD, 0);
-				glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, 0.0f);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
-				glBindTexture(GL_TEXTURE_2D, 0);
-
-				glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, shadowTexture, 0);
-				int frstat = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-				if (frstat != GL_FRAMEBUFFER_COMPLETE) {
-
-					/*  Delete  */
-					glDeleteFramebuffers(1, &shadowFramebuffer);
-					throw RuntimeException("Failed to create framebuffer, {}",
-										   (const char *)glewGetErrorString(frstat));
-				}
-				glDrawBuffer(GL_NONE);
-				glReadBuffer(GL_NONE);
-
-				glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
+				this->shadowSettingComponent->nrCascades = std::clamp<int>(nrCascades, 2, maxCascades);
+				this->createShadowMap(this->shadowSettingComponent->nrCascades);
 			}
 
 			/*	*/
 			ModelImporter *modelLoader = new ModelImporter(this->getFileSystem());
 			modelLoader->loadContent(modelPath, 0);
 			this->scene = Scene::loadFrom<SceneShadow>(*modelLoader);
+			/*	Culled against the camera and each cascade.	*/
+			this->scene.setFrustumCulling(true);
 
 			/*	load Skybox Textures	*/
 			TextureImporter textureImporter(this->getFileSystem());
@@ -310,48 +374,173 @@ namespace glsample {
 			this->camera.setAspect((float)width / (float)height);
 		}
 
+		/**
+		 * @brief Split the view frustum with the practical split scheme and fit the light projection of each
+		 * cascade to its slice.
+		 */
+		void updateCascades() {
+			const BasicShadowMapSettingComponent &settings = *this->shadowSettingComponent;
+			const size_t nrCascades = this->cascades.size();
+
+			const float cameraNear = this->camera.getNear();
+			const float cameraFar = this->camera.getFar();
+			const float shadowFar = std::clamp(settings.distance, cameraNear + 0.01f, cameraFar);
+
+			/*	Corners of the whole view frustum, each cascade is interpolated along the corner rays.	*/
+			const glm::mat4 inverseViewProj =
+				glm::inverse(this->camera.getProjectionMatrix() * this->camera.getViewMatrix());
+			glm::vec3 nearCorners[4];
+			glm::vec3 farCorners[4];
+			for (int i = 0; i < 4; i++) {
+				const glm::vec2 ndc((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f);
+				const glm::vec4 nearCorner = inverseViewProj * glm::vec4(ndc, -1.0f, 1.0f);
+				const glm::vec4 farCorner = inverseViewProj * glm::vec4(ndc, 1.0f, 1.0f);
+				nearCorners[i] = glm::vec3(nearCorner) / nearCorner.w;
+				farCorners[i] = glm::vec3(farCorner) / farCorner.w;
+			}
+
+			/*	Light looks along the light direction, from the origin to keep it fixed while the camera moves.	*/
+			const glm::vec3 lightDirection =
+				glm::normalize(glm::vec3(this->uniformStageBuffer.directional.lightDirection));
+			const glm::vec3 up =
+				std::abs(lightDirection.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+			const glm::mat4 lightView = glm::lookAt(glm::vec3(0.0f), lightDirection, up);
+
+			/*	Depth range of the scene in light space, casters in front of a cascade are still included.	*/
+			float sceneMinZ = -std::numeric_limits<float>::max();
+			float sceneMaxZ = -std::numeric_limits<float>::max();
+			glm::vec3 sceneMin, sceneMax;
+			if (this->scene.computeBounds(sceneMin, sceneMax)) {
+				sceneMinZ = std::numeric_limits<float>::max();
+				for (int i = 0; i < 8; i++) {
+					const glm::vec3 corner((i & 1) ? sceneMax.x : sceneMin.x, (i & 2) ? sceneMax.y : sceneMin.y,
+										   (i & 4) ? sceneMax.z : sceneMin.z);
+					const float z = (lightView * glm::vec4(corner, 1.0f)).z;
+					sceneMinZ = std::min(sceneMinZ, z);
+					sceneMaxZ = std::max(sceneMaxZ, z);
+				}
+			}
+
+			float splitNear = cameraNear;
+			for (size_t i = 0; i < nrCascades; i++) {
+				Cascade &cascade = this->cascades[i];
+
+				/*	Blend of the logarithmic and uniform split.	*/
+				const float p = static_cast<float>(i + 1) / static_cast<float>(nrCascades);
+				const float logSplit = cameraNear * std::pow(shadowFar / cameraNear, p);
+				const float uniformSplit = cameraNear + (shadowFar - cameraNear) * p;
+				const float splitFar = settings.splitLambda * logSplit + (1.0f - settings.splitLambda) * uniformSplit;
+
+				const float t0 = (splitNear - cameraNear) / (cameraFar - cameraNear);
+				const float t1 = (splitFar - cameraNear) / (cameraFar - cameraNear);
+				glm::vec3 corners[8];
+				for (int c = 0; c < 4; c++) {
+					corners[c] = glm::mix(nearCorners[c], farCorners[c], t0);
+					corners[c + 4] = glm::mix(nearCorners[c], farCorners[c], t1);
+				}
+
+				glm::vec3 lightMin, lightMax;
+				if (settings.stabilize) {
+					/*	Bounding sphere does not change size with the camera rotation, and the center is snapped
+					 * to whole texels, to prevent the shadow edges from shimmering.	*/
+					glm::vec3 center(0.0f);
+					for (const glm::vec3 &corner : corners) {
+						center += corner / 8.0f;
+					}
+					float radius = 0;
+					for (const glm::vec3 &corner : corners) {
+						radius = std::max(radius, glm::length(corner - center));
+					}
+					radius = std::ceil(radius * 16.0f) / 16.0f;
+
+					glm::vec3 lightCenter = glm::vec3(lightView * glm::vec4(center, 1.0f));
+					const float texelSize = (2.0f * radius) / static_cast<float>(this->shadowResolution);
+					lightCenter.x = std::floor(lightCenter.x / texelSize) * texelSize;
+					lightCenter.y = std::floor(lightCenter.y / texelSize) * texelSize;
+
+					lightMin = lightCenter - glm::vec3(radius);
+					lightMax = lightCenter + glm::vec3(radius);
+				} else {
+					/*	Tight bounds of the slice.	*/
+					lightMin = glm::vec3(std::numeric_limits<float>::max());
+					lightMax = glm::vec3(-std::numeric_limits<float>::max());
+					for (const glm::vec3 &corner : corners) {
+						const glm::vec3 lightCorner = glm::vec3(lightView * glm::vec4(corner, 1.0f));
+						lightMin = glm::min(lightMin, lightCorner);
+						lightMax = glm::max(lightMax, lightCorner);
+					}
+				}
+
+				/*	Extend toward the light to the scene bounds, and clip away the empty depth behind it.	*/
+				lightMax.z = std::max(lightMax.z, sceneMaxZ);
+				lightMin.z = std::min(std::max(lightMin.z, sceneMinZ), lightMax.z - 0.01f);
+
+				const glm::mat4 lightProjection =
+					glm::ortho(lightMin.x, lightMax.x, lightMin.y, lightMax.y, -lightMax.z, -lightMin.z);
+				const glm::mat4 lightSpaceMatrix = lightProjection * lightView;
+
+				/*	Far cascades are reused as long as neither the light nor the cascade has moved.	*/
+				const bool cacheable = settings.cacheStaticCascades && i >= nrCascades / 2;
+				cascade.cached = cacheable && cascade.valid && cascade.lightSpaceMatrix == lightSpaceMatrix &&
+								 cascade.alphaClip == settings.useShadowClip;
+				cascade.lightSpaceMatrix = lightSpaceMatrix;
+
+				this->uniformStageBuffer.lightSpaceMatrix[i] = lightSpaceMatrix;
+				this->uniformStageBuffer.cascadeSplits[i / 4][i % 4] = splitFar;
+				splitNear = splitFar;
+			}
+
+			this->uniformStageBuffer.nrCascades = static_cast<int>(nrCascades);
+			this->uniformStageBuffer.showCascades = settings.showCascades;
+		}
+
 		void draw() override {
 
 			int width = 0, height = 0;
 			this->getSize(&width, &height);
 
 			{
+				GLSAMPLE_PROFILE_SCOPE("Shadow Cascades");
 
-				/*	Compute light matrix.	*/
-				const float near_plane = -(this->shadowSettingComponent->distance / 2.0f) * 2;
-				const float far_plane = (this->shadowSettingComponent->distance / 2.0f) * 2;
-				glm::mat4 lightProjection =
-					glm::ortho(-this->shadowSettingComponent->distance, this->shadowSettingComponent->distance,
-							   -this->shadowSettingComponent->distance, this->shadowSettingComponent->distance,
-							   near_plane, far_plane);
-				glm::mat4 lightView = glm::lookAt(glm::vec3(-2.0f, 4.0f, -1.0f),
-												  glm::vec3(this->uniformStageBuffer.directional.lightDirection.x,
-															this->uniformStageBuffer.directional.lightDirection.y,
-															this->uniformStageBuffer.directional.lightDirection.z),
-												  glm::vec3(0.0f, 1.0f, 0.0f));
-				glm::mat4 lightSpaceMatrix = lightProjection * lightView;
-
-				glm::mat4 biasMatrix(0.5, 0.0, 0.0, 0.0, 0.0, 0.5, 0.0, 0.0, 0.0, 0.0, 0.5, 0.0, 0.5, 0.5, 0.5, 1.0);
-				this->uniformStageBuffer.lightModelProject = lightSpaceMatrix;
-
-				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_shadow_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
-
-				glBindFramebuffer(GL_FRAMEBUFFER, this->shadowFramebuffer);
-
-				glClear(GL_DEPTH_BUFFER_BIT);
-				glViewport(0, 0, shadowWidth, shadowHeight);
+				glViewport(0, 0, this->shadowResolution, this->shadowResolution);
 				if (this->shadowSettingComponent->useShadowClip) {
 					glUseProgram(this->shadow_alpha_clip_program);
 				} else {
 					glUseProgram(this->shadow_program);
 				}
 
-				/*	Render shadow.	*/
 				this->scene.shadowPass = true;
-				this->scene.render(nullptr);
+				for (size_t i = 0; i < this->cascades.size(); i++) {
+					Cascade &cascade = this->cascades[i];
+					if (cascade.cached) {
+						continue;
+					}
+
+					GLSAMPLE_PROFILE_SCOPE(fmt::format("Cascade {}", i));
+
+					const uniform_shadow_block shadowBlock = {
+						cascade.lightSpaceMatrix, this->uniformStageBuffer.directional, this->uniformStageBuffer.bias,
+						this->uniformStageBuffer.shadowStrength, this->uniformStageBuffer.pcfRadius};
+					const FrameRingAllocator::Allocation shadow_allocation =
+						this->getFrameAllocator().allocate(shadowBlock);
+					glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_shadow_buffer_binding, shadow_allocation.buffer,
+									  shadow_allocation.offset, shadow_allocation.size);
+
+					glBindFramebuffer(GL_FRAMEBUFFER, cascade.framebuffer);
+					glClear(GL_DEPTH_BUFFER_BIT);
+
+					/*	Only the nodes inside the cascade.	*/
+					Light cascadeFrustum;
+					cascadeFrustum.calcFrustumPlanes(cascade.lightSpaceMatrix);
+					this->scene.culling(&cascadeFrustum);
+					cascade.nrRenderedNodes = this->scene.getVisibleNodes().size();
+
+					/*	Render shadow.	*/
+					this->scene.render();
+
+					cascade.valid = true;
+					cascade.alphaClip = this->shadowSettingComponent->useShadowClip;
+				}
 
 				glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
 			}
@@ -359,9 +548,9 @@ namespace glsample {
 			/*	Render Graphic.	*/
 			{
 				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_graphic_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_graphic_buffer_binding,
+								  this->uniform_allocation.buffer, this->uniform_allocation.offset,
+								  this->uniform_allocation.size);
 
 				glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
 				/*	*/
@@ -379,7 +568,7 @@ namespace glsample {
 
 				/*	*/
 				glActiveTexture(GL_TEXTURE0 + shadowBinding);
-				glBindTexture(GL_TEXTURE_2D, this->shadowTexture);
+				glBindTexture(GL_TEXTURE_2D_ARRAY, this->shadowTexture);
 
 				glActiveTexture(GL_TEXTURE0 + TextureType::Irradiance);
 				glBindTexture(GL_TEXTURE_2D, this->irradiance_texture);
@@ -398,14 +587,14 @@ namespace glsample {
 			this->camera.update(this->getTimer().deltaTime<float>());
 			this->scene.update(this->getTimer().deltaTime<float>());
 
+			/*	Recreate the shadow map once the number of cascades has changed.	*/
+			if (static_cast<size_t>(this->shadowSettingComponent->nrCascades) != this->cascades.size()) {
+				this->createShadowMap(this->shadowSettingComponent->nrCascades);
+			}
+			this->updateCascades();
+
 			/*	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize,
-				GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(uniformStageBuffer));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 		}
 	};
 
@@ -415,7 +604,10 @@ namespace glsample {
 		void customOptions(cxxopts::OptionAdder &options) override {
 			options("M,model", "Model Path", cxxopts::value<std::string>()->default_value("asset/sponza/sponza.obj"))(
 				"S,skybox", "Skybox Texture File Path",
-				cxxopts::value<std::string>()->default_value("asset/snowy_forest_4k.exr"));
+				cxxopts::value<std::string>()->default_value("asset/snowy_forest_4k.exr"))(
+				"C,cascades", "Number of Shadow Cascades, 2 to 8", cxxopts::value<int>()->default_value("4"))(
+				"shadow-resolution", "Shadow Map Resolution of each Cascade",
+				cxxopts::value<int>()->default_value("2048"));
 		}
 	};
 
@@ -1,3 +1,4 @@
+#include "Profiler.h"
 #include "Scene.h"
 #include "Skybox.h"
 #include <GL/glew.h>
@@ -7,14 +8,86 @@
 #include <ImportHelper.h>
 #include <ModelImporter.h>
 #include <ShaderLoader.h>
+#include <Util/Light.h>
+#include <algorithm>
 #include <cstring>
+#include <glm/gtc/constants.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <limits>
 
 namespace glsample {
 
 	/**
-	 * @brief
-	 *
+	 * @brief Scene drawn once for the shadow of all the point lights, each node instanced over the cube map
+	 * faces it is visible in.
+	 */
+	class SceneLayeredShadow : public Scene {
+	  public:
+		SceneLayeredShadow() = default;
+
+		/*	Range of the node in the face layers.	*/
+		using LayeredDraw = struct layered_draw_t {
+			const NodeObject *node;
+			unsigned int offset;
+			unsigned int count;
+		};
+
+		void bindMaterial(const MaterialObject *material) override {
+			Scene::bindMaterial(material);
+			if (shadowPass) {
+				/*	Transparent materials still cast shadow.	*/
+				glCullFace(GL_FRONT);
+				glEnable(GL_CULL_FACE);
+				glDisable(GL_BLEND);
+				glEnable(GL_DEPTH_TEST);
+				glDepthMask(GL_TRUE);
+			}
+		}
+
+		void renderLayered(const std::vector<LayeredDraw> &draws) {
+
+			/*	Reset States.	*/
+			this->currentNodeBlock = std::numeric_limits<size_t>::max();
+			this->currentBindedMaterial = nullptr;
+
+			/*	Bind common data for all drawcall.	*/
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->UBOStructure.common_buffer_binding,
+							  this->UBOStructure.node_and_common_uniform_buffer, this->UBOStructure.common_offset,
+							  this->UBOStructure.common_size_align);
+
+			for (const LayeredDraw &draw : draws) {
+				const auto nodeData = this->nodeDataIndex.find(draw.node);
+				if (nodeData == this->nodeDataIndex.end()) {
+					continue;
+				}
+
+				for (size_t geo_index = 0; geo_index < draw.node->geometryObjectIndex.size(); geo_index++) {
+					const size_t node_data_index = nodeData->second + geo_index;
+
+					this->bindNodeBlock(node_data_index / this->UBOStructure.max_node_per_binding);
+
+					const int material_index = draw.node->materialIndex[geo_index];
+					this->bindMaterial(&this->materials[material_index]);
+
+					const MeshObject &refMesh = this->refGeometry[draw.node->geometryObjectIndex[geo_index]];
+					glBindVertexArray(refMesh.vao);
+					/*	Material, model matrix and the first face layer.	*/
+					glVertexAttribI2i(8, material_index, node_data_index % this->UBOStructure.max_node_per_binding);
+					glVertexAttribI1i(9, draw.offset);
+					glDrawElementsInstancedBaseVertex(refMesh.primitiveType, refMesh.nrIndicesElements,
+													  refMesh.indices_type,
+													  (void *)(refMesh.indices_stride * refMesh.indices_offset),
+													  draw.count, refMesh.vertex_offset);
+				}
+			}
+		}
+
+		bool shadowPass = false;
+	};
+
+	/**
+	 * @brief Omnidirectional shadows of the point lights, all the cube faces rendered in a single layered pass
+	 * into a cube map array.
 	 */
 	class PointLightShadow : public GLSampleWindow {
 	  public:
@@ -43,14 +116,10 @@ namespace glsample {
 			float padding1{};
 		};
 
-		static constexpr size_t nrPointLights = 4;
+		static constexpr size_t maxPointLights = 64;
 		struct alignas(16) uniform_buffer_block {
-			glm::mat4 model{};
 			glm::mat4 view{};
 			glm::mat4 proj{};
-			glm::mat4 modelView{};
-			glm::mat4 ViewProjection[6]{};
-			glm::mat4 modelViewProjection{};
 
 			/*	light source.	*/
 			glm::vec4 direction = glm::vec4(1.0f / std::sqrt(2.0f), -1.0f / std::sqrt(2.0f), 0, 0.0f);
@@ -59,23 +128,53 @@ namespace glsample {
 			glm::vec4 ambientColor = glm::vec4(0.2, 0.2, 0.2, 1.0f);
 			glm::vec4 lightPosition{};
 
-			PointLight pointLights[nrPointLights];
-
 			/*	*/
 			glm::vec4 pcfFilters[20]{};
 			float diskRadius = 25.0f;
 			int samples = 1;
+			int nrPointLights = 0;
+			int padding{};
+
+			PointLight pointLights[maxPointLights];
 		} uniform;
 
-		/*	Point light shadow maps.	*/
-		std::vector<unsigned int> pointShadowFrameBuffers;
-		std::vector<unsigned int> pointShadowTextures;
+		size_t nrPointLights = 16;
+
+		/*	Six layers per point light.	*/
+		unsigned int pointShadowFrameBuffer = 0;
+		unsigned int pointShadowTexture = 0;
 
 		/*	*/
-		unsigned int shadowWidth = 1024 * 2;
-		unsigned int shadowHeight = 1024 * 2;
+		unsigned int shadowWidth = 1024;
+		unsigned int shadowHeight = 1024;
+
+		/*	Node with geometry, and its world bounds of the previous frame.	*/
+		using ShadowNode = struct shadow_node_t {
+			const NodeObject *node;
+			glm::mat4 transform;
+			glm::vec3 min;
+			glm::vec3 max;
+		};
+		std::vector<ShadowNode> shadowNodes;
+		std::vector<std::pair<glm::vec3, glm::vec3>> movedBounds;
 
-		Scene scene;
+		/*	State the shadow of the light was last rendered with.	*/
+		using LightShadow = struct light_shadow_t {
+			glm::vec3 position{};
+			float range = 0;
+			bool alphaClip = false;
+			bool valid = false;
+			bool cached = false;
+		};
+		std::vector<LightShadow> lightShadows;
+
+		std::vector<glm::mat4> faceViewProjections;
+		std::vector<glm::vec4> facePlanes;
+		std::vector<int> faceLayers;
+		std::vector<SceneLayeredShadow::LayeredDraw> layeredDraws;
+		size_t nrCachedLights = 0;
+
+		SceneLayeredShadow scene;
 		Skybox skybox;
 
 		/*	*/
@@ -87,16 +186,24 @@ namespace glsample {
 
 		/*	Uniform buffer.	*/
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
+
+		/*	Storage of the layered shadow pass.	*/
+		unsigned int face_matrix_buffer_binding = 10;
+		unsigned int face_layer_buffer_binding = 11;
+		FrameRingAllocator::Allocation face_matrix_allocation{};
+		FrameRingAllocator::Allocation face_layer_allocation{};
+
+		const int shadowBinding = 16;
 
 		CameraController camera;
 
 		class PointLightShadowSettingComponent : public GLUIComponent<PointLightShadow> {
 		  public:
 			PointLightShadowSettingComponent(PointLightShadow &sample)
-				: GLUIComponent(sample, "Point Light Shadow Settings"), uniform(sample.uniform) {}
+				: GLUIComponent(sample, "Point Light Shadow Settings"), uniform(sample.uniform) {
+				std::fill(std::begin(this->lightvisible), std::end(this->lightvisible), true);
+			}
 
 			void draw() override {
 
@@ -106,9 +213,12 @@ namespace glsample {
 				ImGui::DragFloat("Disk Radius", &this->uniform.diskRadius, 1, 0.0f, 1000.0f);
 				ImGui::DragInt("PCF Samples ", &this->uniform.samples, 1, 0, 16);
 				ImGui::Checkbox("Shadow Alpha Clipping", &this->useShadowClip);
-				ImGui::TextUnformatted("Depth Texture");
+				ImGui::Checkbox("Cache Static Shadows", &this->cacheShadows);
+				ImGui::Text("Shadow Faces Rendered: %zu", this->getRefSample().faceLayers.size());
+				ImGui::Text("Cached Lights: %zu/%zu", this->getRefSample().nrCachedLights,
+							this->getRefSample().nrPointLights);
 
-				for (size_t i = 0; i < sizeof(uniform.pointLights) / sizeof(uniform.pointLights[0]); i++) {
+				for (size_t i = 0; i < this->getRefSample().nrPointLights; i++) {
 					ImGui::PushID(1000 + i);
 					if (ImGui::CollapsingHeader(fmt::format("Light {}", i).c_str(), &lightvisible[i],
 												ImGuiTreeNodeFlags_CollapsingHeader)) {
@@ -135,8 +245,9 @@ namespace glsample {
 			bool animate = false;
 			bool use_pcf = false;
 			bool useShadowClip = false;
+			bool cacheShadows = true;
 
-			bool lightvisible[4] = {true, true, true, true};
+			bool lightvisible[maxPointLights];
 
 		  private:
 			struct uniform_buffer_block &uniform;
@@ -150,7 +261,6 @@ namespace glsample {
 
 		/*	Shadow shader paths.	*/
 		const std::string vertexShadowShaderPath = "Shaders/shadowpointlight/pointlightshadow.vert.spv";
-		const std::string geomtryShadowShaderPath = "Shaders/shadowpointlight/pointlightshadow.geom.spv";
 		const std::string fragmentShadowShaderPath = "Shaders/shadowpointlight/pointlightshadow.frag.spv";
 		const std::string fragmentShadowAlphaClipShaderPath =
 			"Shaders/shadowpointlight/pointlightshadow_alphaclip.frag.spv";
@@ -162,16 +272,16 @@ namespace glsample {
 			glDeleteProgram(this->shadow_alpha_clip_program);
 			glDeleteProgram(this->graphic_pfc_program);
 
-			glDeleteFramebuffers(this->pointShadowFrameBuffers.size(), this->pointShadowFrameBuffers.data());
-			glDeleteTextures(this->pointShadowTextures.size(), this->pointShadowTextures.data());
-
-			glDeleteBuffers(1, &this->uniform_buffer);
+			glDeleteFramebuffers(1, &this->pointShadowFrameBuffer);
+			glDeleteTextures(1, &this->pointShadowTexture);
 		}
 
 		void Initialize() override {
 
 			const std::string modelPath = this->getResult()["model"].as<std::string>();
 			const std::string skyboxPath = this->getResult()["skybox"].as<std::string>();
+			this->nrPointLights = std::clamp<int>(this->getResult()["lights"].as<int>(), 1, maxPointLights);
+			this->shadowWidth = this->shadowHeight = this->getResult()["shadow-resolution"].as<int>();
 			{
 				/*	*/
 				const std::vector<uint32_t> vertex_binary =
@@ -184,8 +294,6 @@ namespace glsample {
 				/*	*/
 				const std::vector<uint32_t> vertex_shadow_binary =
 					IOUtil::readFileData<uint32_t>(this->vertexShadowShaderPath, this->getFileSystem());
-				const std::vector<uint32_t> geometry_shadow_binary =
-					IOUtil::readFileData<uint32_t>(this->geomtryShadowShaderPath, this->getFileSystem());
 				const std::vector<uint32_t> fragment_shadow_binary =
 					IOUtil::readFileData<uint32_t>(this->fragmentShadowShaderPath, this->getFileSystem());
 				const std::vector<uint32_t> fragment_shadow_alpha_clip_binary =
@@ -201,11 +309,10 @@ namespace glsample {
 				this->graphic_pfc_program =
 					ShaderLoader::loadGraphicProgram(compilerOptions, &vertex_binary, &fragment_pcf_binary);
 
-				this->shadow_program = ShaderLoader::loadGraphicProgram(
-					compilerOptions, &vertex_shadow_binary, &fragment_shadow_binary, &geometry_shadow_binary);
-				this->shadow_alpha_clip_program =
-					ShaderLoader::loadGraphicProgram(compilerOptions, &vertex_shadow_binary,
-													 &fragment_shadow_alpha_clip_binary, &geometry_shadow_binary);
+				this->shadow_program =
+					ShaderLoader::loadGraphicProgram(compilerOptions, &vertex_shadow_binary, &fragment_shadow_binary);
+				this->shadow_alpha_clip_program = ShaderLoader::loadGraphicProgram(
+					compilerOptions, &vertex_shadow_binary, &fragment_shadow_alpha_clip_binary);
 
 				this->skybox_program = Skybox::loadDefaultProgram(this->getFileSystem());
 			}
@@ -224,14 +331,16 @@ namespace glsample {
 			uniform_buffer_shadow_index = glGetUniformBlockIndex(this->shadow_alpha_clip_program, "UniformBufferBlock");
 			glUniformBlockBinding(this->shadow_alpha_clip_program, uniform_buffer_shadow_index,
 								  this->uniform_buffer_binding);
+			glUniform1i(glGetUniformLocation(this->shadow_alpha_clip_program, "DiffuseTexture"), TextureType::Diffuse);
+			glUniform1i(glGetUniformLocation(this->shadow_alpha_clip_program, "AlphaMaskedTexture"),
+						TextureType::AlphaMask);
 			glUseProgram(0);
 
 			/*	*/
 			glUseProgram(this->graphic_program);
 			int uniform_buffer_index = glGetUniformBlockIndex(this->graphic_program, "UniformBufferBlock");
 			glUniform1i(glGetUniformLocation(this->graphic_program, "DiffuseTexture"), TextureType::Diffuse);
-			const int shadowUnits[4] = {16, 17, 18, 19};
-			glUniform1iv(glGetUniformLocation(this->graphic_program, "ShadowTexture"), 4, shadowUnits);
+			glUniform1i(glGetUniformLocation(this->graphic_program, "ShadowTexture"), this->shadowBinding);
 			glUniformBlockBinding(this->graphic_program, uniform_buffer_index, this->uniform_buffer_binding);
 			glUseProgram(0);
 
@@ -239,23 +348,10 @@ namespace glsample {
 			glUseProgram(this->graphic_pfc_program);
 			uniform_buffer_index = glGetUniformBlockIndex(this->graphic_pfc_program, "UniformBufferBlock");
 			glUniform1i(glGetUniformLocation(this->graphic_pfc_program, "DiffuseTexture"), TextureType::Diffuse);
-			glUniform1iv(glGetUniformLocation(this->graphic_pfc_program, "ShadowTexture"), 4, shadowUnits);
+			glUniform1i(glGetUniformLocation(this->graphic_pfc_program, "ShadowTexture"), this->shadowBinding);
 			glUniformBlockBinding(this->graphic_pfc_program, uniform_buffer_index, this->uniform_buffer_binding);
 			glUseProgram(0);
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize =
-				fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
-			/*	 Create uniform buffer.	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer * this->nrPointLights,
-						 nullptr, GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	load Skybox Textures	*/
 			unsigned int skytexture = textureImporter.loadImage2D(skyboxPath);
 			this->skybox.Init(skytexture, this->skybox_program);
@@ -263,63 +359,44 @@ namespace glsample {
 			{
 				/*	Clamp texture size to valid size.	*/
 				int max_texture_size = 0;
-				glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
-				this->shadowWidth = fragcore::Math::min<int>(this->shadowWidth, max_texture_size);
-				this->shadowHeight = fragcore::Math::min<int>(this->shadowHeight, max_texture_size);
-
-				/*	Create shadow map.	*/
-				this->pointShadowFrameBuffers.resize(this->nrPointLights);
-				glGenFramebuffers(this->pointShadowFrameBuffers.size(), this->pointShadowFrameBuffers.data());
-
-				this->pointShadowTextures.resize(this->nrPointLights);
-				glGenTextures(this->pointShadowTextures.size(), this->pointShadowTextures.data());
-
-				for (size_t x = 0; x < this->pointShadowFrameBuffers.size(); x++) {
-					glBindFramebuffer(GL_FRAMEBUFFER, this->pointShadowFrameBuffers[x]);
-
-					/*	*/
-					glBindTexture(GL_TEXTURE_CUBE_MAP, this->pointShadowTextures[x]);
-
-					/*	Setup each face.	*/
-					for (size_t i = 0; i < 6; i++) {
-
-						glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_DEPTH_COMPONENT16, this->shadowWidth,
-									 this->shadowHeight, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
-					}
-
-					/*	*/
-					glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-					glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+				glGetIntegerv(GL_MAX_CUBE_MAP_TEXTURE_SIZE, &max_texture_size);
+				this->shadowWidth = std::clamp<int>(this->shadowWidth, 1, max_texture_size);
+				this->shadowHeight = std::clamp<int>(this->shadowHeight, 1, max_texture_size);
 
-					/*	Border clamped to max value, it makes the outside area.	*/
-					glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-					glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-					glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_BORDER);
+				/*	Create shadow map, the layer of a face is the light index * 6 + face.	*/
+				glGenTextures(1, &this->pointShadowTexture);
+				glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, this->pointShadowTexture);
+				glTexStorage3D(GL_TEXTURE_CUBE_MAP_ARRAY, 1, GL_DEPTH_COMPONENT16, this->shadowWidth,
+							   this->shadowHeight, this->nrPointLights * 6);
 
-					/*	*/
-					const float borderColor[] = {1.0f, 1.0f, 1.0f, 1.0f};
-					glTexParameterfv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BORDER_COLOR, borderColor);
+				/*	*/
+				glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-					/*	*/
-					glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LOD, 0);
-					glTexParameterf(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_LOD_BIAS, 0.0f);
-					glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+				/*	Border clamped to max value, it makes the outside area.	*/
+				glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+				glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+				glTexParameteri(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_BORDER);
 
-					glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+				/*	*/
+				const float borderColor[] = {1.0f, 1.0f, 1.0f, 1.0f};
+				glTexParameterfv(GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+				glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, 0);
 
-					/*	*/
-					glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, this->pointShadowTextures[x], 0);
+				/*	Layered attachment, gl_Layer selects the face.	*/
+				glGenFramebuffers(1, &this->pointShadowFrameBuffer);
+				glBindFramebuffer(GL_FRAMEBUFFER, this->pointShadowFrameBuffer);
+				glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, this->pointShadowTexture, 0);
 
-					glDrawBuffer(GL_NONE);
-					glReadBuffer(GL_NONE);
+				glDrawBuffer(GL_NONE);
+				glReadBuffer(GL_NONE);
 
-					/*	*/
-					int frstat = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-					if (frstat != GL_FRAMEBUFFER_COMPLETE) {
-						/*  Delete  */
-						throw RuntimeException("Failed to create framebuffer, {}",
-											   (const char *)glewGetErrorString(frstat));
-					}
+				/*	*/
+				int frstat = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+				if (frstat != GL_FRAMEBUFFER_COMPLETE) {
+					/*  Delete  */
+					throw RuntimeException("Failed to create framebuffer, {}",
+										   (const char *)glewGetErrorString(frstat));
 				}
 
 				glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
@@ -328,16 +405,32 @@ namespace glsample {
 			/*	*/
 			ModelImporter modelLoader(FileSystem::getFileSystem());
 			modelLoader.loadContent(modelPath, 0);
-			this->scene = Scene::loadFrom(modelLoader);
+			this->scene = Scene::loadFrom<SceneLayeredShadow>(modelLoader);
+
+			for (const NodeObject *node : this->scene.getNodes()) {
+				if (!node->geometryObjectIndex.empty()) {
+					glm::vec3 min, max;
+					Scene::computeWorldBounds(*node, min, max);
+					this->shadowNodes.push_back({node, node->modelGlobalTransform, min, max});
+				}
+			}
+
+			/*	Face matrices and the worst case of the face layers.	*/
+			const size_t nrLayers = this->nrPointLights * 6;
+			this->getFrameAllocator().reserve(this->getFrameAllocator().getFrameSize() +
+											  nrLayers * (sizeof(glm::mat4) + this->shadowNodes.size() * sizeof(int)));
 
 			/*  Init lights.    */
 			const glm::vec4 colors[] = {glm::vec4(1, 0.1, 0.1, 1), glm::vec4(0.1, 1, 0.1, 1), glm::vec4(0.1, 0.1, 1, 1),
 										glm::vec4(1, 0.1, 1, 1)};
 			for (size_t i = 0; i < this->nrPointLights; i++) {
+				const float angle = (2.0f * glm::pi<float>() * i) / this->nrPointLights;
+				const float radius = 6.0f + 12.0f * (i % 2);
+
 				this->uniform.pointLights[i].range = 25.0f;
 				this->uniform.pointLights[i].position =
-					glm::vec3(i * -1.0f, i * 1.0f, i * -1.5f) * 12.0f + glm::vec3(2.0f);
-				this->uniform.pointLights[i].color = colors[i];
+					glm::vec3(radius * std::cos(angle), 2.0f + 8.0f * (i % 3), radius * std::sin(angle));
+				this->uniform.pointLights[i].color = colors[i % 4];
 				this->uniform.pointLights[i].constant_attenuation = 1.7f;
 				this->uniform.pointLights[i].linear_attenuation = 1.5f;
 				this->uniform.pointLights[i].qudratic_attenuation = 0.19f;
@@ -346,6 +439,10 @@ namespace glsample {
 				this->uniform.pointLights[i].bias = 0.01f;
 			}
 
+			this->lightShadows.resize(this->nrPointLights);
+			this->faceViewProjections.resize(nrLayers);
+			this->facePlanes.resize(nrLayers * 6);
+
 			/*	Copy PCF Filters	*/
 			const glm::vec4 samples[20] = {
 				glm::vec4(1, 1, 1, 0),	glm::vec4(1, -1, 1, 0),	 glm::vec4(-1, -1, 1, 0),  glm::vec4(-1, 1, 1, 0),
@@ -358,25 +455,161 @@ namespace glsample {
 
 		void onResize(int width, int height) override { this->camera.setAspect((float)width / (float)height); }
 
+		static bool intersectSphere(const glm::vec3 &min, const glm::vec3 &max, const glm::vec3 &center,
+									const float radius) noexcept {
+			const glm::vec3 closest = glm::clamp(center, min, max);
+			return glm::dot(closest - center, closest - center) <= radius * radius;
+		}
+
+		static bool intersectPlanes(const glm::vec4 *planes, const glm::vec3 &min, const glm::vec3 &max) noexcept {
+			for (unsigned int i = 0; i < 6; i++) {
+				/*	Corner furthest along the plane normal.	*/
+				const glm::vec3 normal = glm::vec3(planes[i]);
+				const glm::vec3 positive = glm::mix(min, max, glm::greaterThanEqual(normal, glm::vec3(0.0f)));
+				if (glm::dot(normal, positive) + planes[i].w < 0) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * @brief Cull the nodes against the cube faces of every point light, once on the CPU for all the lights.
+		 * The shadow of a light is cached while neither the light nor any node within its range has moved.
+		 */
+		void updateShadowLayers() {
+			const PointLightShadowSettingComponent &settings = *this->shadowSettingComponent;
+
+			/*	Bounds of the moved nodes, before and after the move.	*/
+			this->movedBounds.clear();
+			for (ShadowNode &shadowNode : this->shadowNodes) {
+				glm::vec3 min, max;
+				Scene::computeWorldBounds(*shadowNode.node, min, max);
+				if (shadowNode.transform != shadowNode.node->modelGlobalTransform) {
+					this->movedBounds.emplace_back(glm::min(min, shadowNode.min), glm::max(max, shadowNode.max));
+					shadowNode.transform = shadowNode.node->modelGlobalTransform;
+				}
+				shadowNode.min = min;
+				shadowNode.max = max;
+			}
+
+			const glm::vec3 faceDirections[6] = {glm::vec3(1.0, 0.0, 0.0),	glm::vec3(-1.0, 0.0, 0.0),
+												 glm::vec3(0.0, 1.0, 0.0),	glm::vec3(0.0, -1.0, 0.0),
+												 glm::vec3(0.0, 0.0, 1.0),	glm::vec3(0.0, 0.0, -1.0)};
+			const glm::vec3 faceUps[6] = {glm::vec3(0.0, -1.0, 0.0), glm::vec3(0.0, -1.0, 0.0),
+										  glm::vec3(0.0, 0.0, 1.0),	 glm::vec3(0.0, 0.0, -1.0),
+										  glm::vec3(0.0, -1.0, 0.0), glm::vec3(0.0, -1.0, 0.0)};
+
+			this->nrCachedLights = 0;
+			for (size_t i = 0; i < this->nrPointLights; i++) {
+				LightShadow &lightShadow = this->lightShadows[i];
+				const PointLight &pointLight = this->uniform.pointLights[i];
+
+				bool dirty = !settings.cacheShadows || !lightShadow.valid ||
+							 lightShadow.position != pointLight.position || lightShadow.range != pointLight.range ||
+							 lightShadow.alphaClip != settings.useShadowClip;
+				for (size_t m = 0; m < this->movedBounds.size() && !dirty; m++) {
+					dirty = intersectSphere(this->movedBounds[m].first, this->movedBounds[m].second,
+											pointLight.position, pointLight.range);
+				}
+
+				lightShadow.cached = !dirty;
+				lightShadow.valid = true;
+				lightShadow.position = pointLight.position;
+				lightShadow.range = pointLight.range;
+				lightShadow.alphaClip = settings.useShadowClip;
+				if (lightShadow.cached) {
+					this->nrCachedLights++;
+					continue;
+				}
+
+				/*	Compute light matrices.	*/
+				const glm::mat4 pointPer =
+					glm::perspective(glm::radians(90.0f), (float)this->shadowWidth / (float)this->shadowHeight, 0.15f,
+									 pointLight.range);
+
+				for (size_t face = 0; face < 6; face++) {
+					const size_t layer = i * 6 + face;
+					this->faceViewProjections[layer] =
+						pointPer * glm::lookAt(pointLight.position, pointLight.position + faceDirections[face],
+											   faceUps[face]);
+
+					Light faceFrustum;
+					faceFrustum.calcFrustumPlanes(this->faceViewProjections[layer]);
+					std::memcpy(&this->facePlanes[layer * 6], faceFrustum.getPlaneEquations(), sizeof(glm::vec4) * 6);
+				}
+			}
+
+			/*	Faces of each node are consecutive, drawn as the instances of a single draw.	*/
+			this->faceLayers.clear();
+			this->layeredDraws.clear();
+			for (const ShadowNode &shadowNode : this->shadowNodes) {
+				const unsigned int offset = static_cast<unsigned int>(this->faceLayers.size());
+
+				for (size_t i = 0; i < this->nrPointLights; i++) {
+					const PointLight &pointLight = this->uniform.pointLights[i];
+					if (this->lightShadows[i].cached ||
+						!intersectSphere(shadowNode.min, shadowNode.max, pointLight.position, pointLight.range)) {
+						continue;
+					}
+
+					for (size_t face = 0; face < 6; face++) {
+						const size_t layer = i * 6 + face;
+						if (intersectPlanes(&this->facePlanes[layer * 6], shadowNode.min, shadowNode.max)) {
+							this->faceLayers.push_back(static_cast<int>(layer));
+						}
+					}
+				}
+
+				const unsigned int count = static_cast<unsigned int>(this->faceLayers.size()) - offset;
+				if (count > 0) {
+					this->layeredDraws.push_back({shadowNode.node, offset, count});
+				}
+			}
+
+			/*	*/
+			if (!this->faceLayers.empty()) {
+				this->face_matrix_allocation =
+					this->getFrameAllocator().allocate(this->faceViewProjections.data(),
+													   this->faceViewProjections.size() * sizeof(glm::mat4),
+													   FrameRingAllocator::Usage::Storage);
+				this->face_layer_allocation = this->getFrameAllocator().allocate(
+					this->faceLayers.data(), this->faceLayers.size() * sizeof(int), FrameRingAllocator::Usage::Storage);
+			}
+		}
+
 		void draw() override {
 
 			int width = 0, height = 0;
 			this->getSize(&width, &height);
 
-			/*	Draw each point light shadow.	*/
-			{
-				for (size_t i = 0; i < this->nrPointLights; i++) {
+			/*	Draw the shadow of all the point lights.	*/
+			if (this->nrCachedLights < this->nrPointLights) {
+				GLSAMPLE_PROFILE_SCOPE("Point Light Shadows");
 
-					/*	*/
-					glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-									  ((this->getFrameCount() % this->nrUniformBuffer) * this->nrPointLights + i) *
-										  this->uniformAlignBufferSize,
-									  this->uniformAlignBufferSize);
+				/*	*/
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 
-					glBindFramebuffer(GL_FRAMEBUFFER, this->pointShadowFrameBuffers[i]);
+				glBindFramebuffer(GL_FRAMEBUFFER, this->pointShadowFrameBuffer);
+				glViewport(0, 0, this->shadowWidth, this->shadowHeight);
 
-					glClear(GL_DEPTH_BUFFER_BIT);
-					glViewport(0, 0, this->shadowWidth, this->shadowHeight);
+				/*	Only the faces of the lights that are rendered again.	*/
+				const float clearDepth = 1.0f;
+				for (size_t i = 0; i < this->nrPointLights; i++) {
+					if (!this->lightShadows[i].cached) {
+						glClearTexSubImage(this->pointShadowTexture, 0, 0, 0, i * 6, this->shadowWidth,
+										   this->shadowHeight, 6, GL_DEPTH_COMPONENT, GL_FLOAT, &clearDepth);
+					}
+				}
+
+				if (!this->layeredDraws.empty()) {
+					glBindBufferRange(GL_SHADER_STORAGE_BUFFER, this->face_matrix_buffer_binding,
+									  this->face_matrix_allocation.buffer, this->face_matrix_allocation.offset,
+									  this->face_matrix_allocation.size);
+					glBindBufferRange(GL_SHADER_STORAGE_BUFFER, this->face_layer_buffer_binding,
+									  this->face_layer_allocation.buffer, this->face_layer_allocation.offset,
+									  this->face_layer_allocation.size);
 
 					if (this->shadowSettingComponent->useShadowClip) {
 						glUseProgram(this->shadow_alpha_clip_program);
@@ -389,10 +622,9 @@ namespace glsample {
 					/*	Make sure it fills the triangles.	*/
 					glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-					/*	Setup the shadow.	*/
-					glEnableVertexAttribArrayARB(4);
-					glVertexAttribI1i(4, i);
-					this->scene.render();
+					this->scene.shadowPass = true;
+					this->scene.renderLayered(this->layeredDraws);
+					this->scene.shadowPass = false;
 				}
 			}
 
@@ -401,10 +633,8 @@ namespace glsample {
 				glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
 
 				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-								  ((this->getFrameCount() % this->nrUniformBuffer) * this->nrPointLights) *
-									  this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 				/*	*/
 				glViewport(0, 0, width, height);
 
@@ -425,10 +655,8 @@ namespace glsample {
 				glPolygonMode(GL_FRONT_AND_BACK, this->shadowSettingComponent->showWireFrame ? GL_LINE : GL_FILL);
 
 				/*	*/
-				for (size_t j = 0; j < this->nrPointLights; j++) {
-					glActiveTexture(GL_TEXTURE16 + j);
-					glBindTexture(GL_TEXTURE_CUBE_MAP, this->pointShadowTextures[j]);
-				}
+				glActiveTexture(GL_TEXTURE0 + this->shadowBinding);
+				glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, this->pointShadowTexture);
 
 				this->scene.render(&this->camera);
 			}
@@ -452,52 +680,15 @@ namespace glsample {
 				}
 			}
 
-			/*	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			uint8_t *uniformPointer = (uint8_t *)glMapBufferRange(
-				GL_UNIFORM_BUFFER,
-				(((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->nrPointLights) *
-					this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize * this->nrPointLights, GL_MAP_WRITE_BIT);
-			glm::mat4 PointView[6];
+			this->updateShadowLayers();
 
 			/*	*/
-			for (size_t i = 0; i < this->nrPointLights; i++) {
-				const glm::vec3 lightPosition = this->uniform.pointLights[i].position;
-
-				PointView[0] =
-					glm::lookAt(lightPosition, lightPosition + glm::vec3(1.0, 0.0, 0.0), glm::vec3(0.0, -1.0, 0.0));
-				PointView[1] =
-					glm::lookAt(lightPosition, lightPosition + glm::vec3(-1.0, 0.0, 0.0), glm::vec3(0.0, -1.0, 0.0));
-				PointView[2] =
-					glm::lookAt(lightPosition, lightPosition + glm::vec3(0.0, 1.0, 0.0), glm::vec3(0.0, 0.0, 1.0));
-				PointView[3] =
-					glm::lookAt(lightPosition, lightPosition + glm::vec3(0.0, -1.0, 0.0), glm::vec3(0.0, 0.0, -1.0));
-				PointView[4] =
-					glm::lookAt(lightPosition, lightPosition + glm::vec3(0.0, 0.0, 1.0), glm::vec3(0.0, -1.0, 0.0));
-				PointView[5] =
-					glm::lookAt(lightPosition, lightPosition + glm::vec3(0.0, 0.0, -1.0), glm::vec3(0.0, -1.0, 0.0));
-
-				/*	Compute light matrices.	*/
-				const glm::mat4 pointPer =
-					glm::perspective(glm::radians(90.0f), (float)this->shadowWidth / (float)this->shadowHeight, 0.15f,
-									 this->uniform.pointLights[i].range);
-
-				for (size_t j = 0; j < 6; j++) {
-					this->uniform.ViewProjection[j] = pointPer * PointView[j];
-				}
-
-				/*	*/
-				this->uniform.model = glm::mat4(1.0f);
-				this->uniform.proj = this->camera.getProjectionMatrix();
-				this->uniform.view = this->camera.getViewMatrix();
-				this->uniform.modelViewProjection = this->uniform.proj * this->uniform.view * this->uniform.model;
-				this->uniform.lightPosition = glm::vec4(this->camera.getPosition(), 0.0f);
+			this->uniform.proj = this->camera.getProjectionMatrix();
+			this->uniform.view = this->camera.getViewMatrix();
+			this->uniform.lightPosition = glm::vec4(this->camera.getPosition(), 0.0f);
+			this->uniform.nrPointLights = static_cast<int>(this->nrPointLights);
 
-				std::memcpy(&uniformPointer[i * this->uniformAlignBufferSize], &this->uniform, sizeof(this->uniform));
-			}
-
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniform);
 		}
 	};
 
@@ -507,16 +698,22 @@ namespace glsample {
 		void customOptions(cxxopts::OptionAdder &options) override {
 			options("M,model", "Model Path", cxxopts::value<std::string>()->default_value("asset/sponza/sponza.obj"))(
 				"S,skybox", "Skybox Texture File Path",
-				cxxopts::value<std::string>()->default_value("asset/snowy_forest_4k.exr"));
+				cxxopts::value<std::string>()->default_value("asset/snowy_forest_4k.exr"))(
+				"L,lights", "Number of Shadowed Point Lights, up to 64", cxxopts::value<int>()->default_value("16"))(
+				"shadow-resolution", "Cube Map Face Resolution of each Point Light",
+				cxxopts::value<int>()->default_value("1024"));
 		}
 	};
 } // namespace glsample
 
 int main(int argc, const char **argv) {
+
+	const std::vector<const char *> required_extensions = {"GL_ARB_shader_viewport_layer_array"};
+
 	try {
 		glsample::PointLightShadowGLSample sample;
 
-		sample.run(argc, argv);
+		sample.run(argc, argv, required_extensions);
 
 	} catch (const std::exception &ex) {
 
@@ -524,4 +721,4 @@ int main(int argc, const char **argv) {
 		return EXIT_FAILURE;
 	}
 	return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
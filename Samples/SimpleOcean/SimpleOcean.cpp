@@ -93,10 +93,7 @@ namespace glsample {
 
 		/*  Uniform buffers.    */
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer = 0;
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
-		size_t oceanUniformSize = 0;
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		class SimpleOceanSettingComponent : public GLUIComponent<SimpleOcean> {
 		  public:
@@ -202,8 +199,6 @@ namespace glsample {
 			glDeleteTextures(1, (const GLuint *)&this->reflection_texture);
 			glDeleteTextures(1, (const GLuint *)&this->normal_texture);
 
-			glDeleteBuffers(1, &this->uniform_buffer);
-
 			/*	*/
 			glDeleteVertexArrays(1, &this->plan.vao);
 			glDeleteBuffers(1, &this->plan.vbo);
@@ -257,18 +252,6 @@ namespace glsample {
 			/*	*/
 			this->mistprocessing.initialize(this->getFileSystem());
 
-			/*	Align uniform buffer in respect to driver requirement.	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->oceanUniformSize = Math::align<size_t>(sizeof(UniformOceanBufferBlock), (size_t)minMapBufferSize);
-			this->uniformAlignBufferSize = Math::align<size_t>(this->oceanUniformSize, (size_t)minMapBufferSize);
-
-			/*  Create uniform buffer.  */
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * nrUniformBuffer, nullptr, GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			/*	Load geometry.	*/
 			Common::loadPlan(this->plan, 1, 1024, 1024);
 
@@ -304,9 +287,8 @@ namespace glsample {
 			/*	Ocean.	*/
 			{
 				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-								  this->oceanUniformSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 				if (this->simpleOceanSettingComponent->useGerstner) {
 					glUseProgram(this->simpleOceanGerstner_program);
@@ -415,16 +397,7 @@ namespace glsample {
 			this->mistprocessing.mistsettings.viewRotation = glm::inverse(camera.getRotationMatrix());
 
 			/*  */
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			uint8_t *uniformPointer = static_cast<uint8_t *>(glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize,
-				GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
-
-			/*	*/
-			memcpy(uniformPointer, &this->uniform_stage_buffer.ocean, sizeof(this->uniform_stage_buffer.ocean));
-
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniform_stage_buffer.ocean);
 		}
 	}; // namespace glsample
 
@@ -56,10 +56,8 @@ namespace glsample {
 		/*	*/
 		unsigned int uniform_buffer_binding = 0;
 		unsigned int uniform_skeleton_buffer_binding = 3;
-		unsigned int uniform_buffer{};
-		unsigned int uniform_skeleton_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
+		FrameRingAllocator::Allocation uniform_allocation{};
+		FrameRingAllocator::Allocation uniform_skeleton_allocation{};
 		size_t uniformSkeletonBufferSize = 0;
 		SkeletonSystem skeleton;
 
@@ -112,8 +110,6 @@ namespace glsample {
 			glDeleteProgram(this->skinned_debug_weight_program);
 			glDeleteProgram(this->skinned_bone_program);
 			glDeleteProgram(this->axis_orientation_program);
-
-			glDeleteBuffers(1, &this->uniform_buffer);
 		}
 
 		void Initialize() override {
@@ -202,35 +198,16 @@ namespace glsample {
 			glUniformBlockBinding(this->axis_orientation_program, uniform_buffer_index, this->uniform_buffer_binding);
 			glUseProgram(0);
 
-			/*	Create all uniform buffers.	*/
+			/*	Size of the skeleton uniform block.	*/
 			{
-				/*	Align uniform buffer in respect to driver requirement.	*/
-				GLint minMapBufferSize = 0;
-				glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-				this->uniformAlignBufferSize =
-					fragcore::Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-
-				/*	Create uniform buffer.	*/
-				glGenBuffers(1, &this->uniform_buffer);
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-				glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * this->nrUniformBuffer, nullptr,
-							 GL_DYNAMIC_DRAW);
-				glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 				/*	*/
 				GLint uniformMaxSize = 0;
 				glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &uniformMaxSize);
 				int instanceBatch = 1024; // uniformMaxSize / sizeof(glm::mat4);
+				this->uniformSkeletonBufferSize = instanceBatch * sizeof(glm::mat4);
 
-				this->uniformSkeletonBufferSize =
-					fragcore::Math::align<size_t>(instanceBatch * sizeof(glm::mat4), (size_t)minMapBufferSize);
 
 				// Create skeleton buffer.
-				glGenBuffers(1, &this->uniform_skeleton_buffer);
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_skeleton_buffer);
-				glBufferData(GL_UNIFORM_BUFFER, this->uniformSkeletonBufferSize * this->nrUniformBuffer, nullptr,
-							 GL_DYNAMIC_DRAW);
-				glBindBuffer(GL_UNIFORM_BUFFER, 0);
 			}
 
 			/*	*/
@@ -254,14 +231,12 @@ namespace glsample {
 			{
 
 				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_skeleton_buffer_binding,
-								  this->uniform_skeleton_buffer,
-								  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformSkeletonBufferSize,
-								  this->uniformSkeletonBufferSize);
+								  this->uniform_skeleton_allocation.buffer, this->uniform_skeleton_allocation.offset,
+								  this->uniform_skeleton_allocation.size);
 
 				glUseProgram(this->skinned_graphic_program);
 
@@ -322,24 +297,13 @@ namespace glsample {
 			}
 
 			/*	*/
-			{
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-				void *uniformPointer = glMapBufferRange(GL_UNIFORM_BUFFER,
-														((this->getFrameCount() + 1) % this->nrUniformBuffer) *
-															this->uniformAlignBufferSize,
-														this->uniformAlignBufferSize, GL_MAP_WRITE_BIT);
-				memcpy(uniformPointer, &this->uniformStageBuffer, sizeof(this->uniformStageBuffer));
-				glUnmapBuffer(GL_UNIFORM_BUFFER);
-			}
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniformStageBuffer);
 
 			/*	*/
 			{
-				glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_skeleton_buffer);
-				glm::mat4 *uniformPointer = (glm::mat4 *)glMapBufferRange(
-					GL_UNIFORM_BUFFER,
-					((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformSkeletonBufferSize,
+				this->uniform_skeleton_allocation = this->getFrameAllocator().allocate(this->uniformSkeletonBufferSize);
+				glm::mat4 *uniformPointer = this->uniform_skeleton_allocation.as<glm::mat4>();
 
-					this->uniformSkeletonBufferSize, GL_MAP_WRITE_BIT);
 				/*	*/
 				int i = 0;
 				for (auto it = skeleton.bones.begin(); it != skeleton.bones.end(); it++) {
@@ -350,7 +314,6 @@ namespace glsample {
 						   sizeof(uniformPointer[0]));
 				}
 			}
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
 		}
 	};
 
@@ -1,16 +1,22 @@
+#include "GLUIComponent.h"
+#include "GPUSort.h"
 #include <GL/glew.h>
 #include <GLSample.h>
 #include <GLSampleWindow.h>
-#include <Importer/ImageImport.h>
 #include <ShaderCompiler.h>
 #include <ShaderLoader.h>
+#include <algorithm>
+#include <chrono>
 #include <glm/glm.hpp>
+#include <magic_enum.hpp>
+#include <random>
 
 namespace glsample {
 
 	/**
-	 * @brief
+	 * @brief Sort random keys with the GPU radix and bitonic sort, or the CPU fallback, and benchmark them.
 	 *
+	 * The keys are sorted along with their index as the value, and drawn as a bar graph.
 	 */
 	class Sort : public GLSampleWindow {
 	  public:
@@ -18,90 +24,105 @@ namespace glsample {
 			this->setTitle("Sort Compute");
 
 			/*	*/
-			this->sortSettingComponent = std::make_shared<SortSettingComponent>(this->params);
+			this->sortSettingComponent = std::make_shared<SortSettingComponent>(*this);
 			this->addUIComponent(this->sortSettingComponent);
 		}
 
-		using UniformBuferBlock = struct uniform_buffer_block_t {
-			float posX{}, posY{};
-			float mousePosX{}, mousePosY{};
-			float zoom = 1.0f; /*	*/
-			float c = 0;	   /*	*/
-			float ci = 1;	   /*	*/
-			int nrSamples = 128;
+		using UniformBufferBlock = struct uniform_buffer_block_t {
+			uint32_t count;
+		};
+		UniformBufferBlock uniformStageBuffer{};
+
+		using BenchmarkResult = struct benchmark_result_t {
+			GPUSort::Algorithm algorithm;
+			size_t count;
+			double milliseconds;
+			bool sorted;
 		};
-		UniformBuferBlock params;
 
 		/*	*/
-		const size_t round_robin_size = 2;
-		unsigned int mandelbrot_framebuffer{};
-		unsigned int sort_mergesort_program{};
-		unsigned int julia_program{};
-		unsigned int mandelbrot_texture{}; // TODO add round robin.
-		unsigned int mandelbrot_texture_width{};
-		unsigned int mandelbrot_texture_height{};
+		GPUSort gpuSort;
+		unsigned int key_buffer{};
+		unsigned int value_buffer{};
+		size_t bufferCapacity = 0;
+		size_t maxElements = 0;
+		std::vector<uint32_t> keys;
+
+		unsigned int timer_query{};
+		std::vector<BenchmarkResult> results;
+		bool sortRequested = true;
+		bool benchmarkRequested = false;
 
 		/*	*/
-		int localWorkGroupSize[3]{};
+		unsigned int sort_visual_program{};
+		unsigned int vao{};
 
 		/*	Uniform buffer.	*/
-		unsigned int uniform_buffer_binding = 3;
-		unsigned int current_cells_buffer_binding = 0;
-		unsigned int previous_cells_buffer_binding = 1;
-		unsigned int image_output_binding = 2;
+		unsigned int uniform_buffer_binding = 0;
+		unsigned int key_buffer_binding = 0;
 		unsigned int uniform_buffer{};
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block_t);
 
-		class SortSettingComponent : public nekomimi::UIComponent {
+		class SortSettingComponent : public GLUIComponent<Sort> {
 
 		  public:
-			SortSettingComponent(struct uniform_buffer_block_t &uniform) : uniform(uniform) {
-				this->setName("Sort Settings");
-			}
+			SortSettingComponent(Sort &sample) : GLUIComponent<Sort>(sample) { this->setName("Sort Settings"); }
 			void draw() override {
-				ImGui::DragInt("Number of Samples", &this->uniform.nrSamples, 1, 0, 2048);
-				ImGui::DragFloat2("C", &this->uniform.c);
-				ImGui::DragFloat("Zoom", &this->uniform.zoom, 1.0f, 0.001, 10.0f);
-				ImGui::DragInt("Program", &this->program, 1.0f, 0, 1);
+				if (ImGui::BeginCombo("Algorithm", magic_enum::enum_name(this->algorithm).data())) {
+					for (const auto &[algorithm, name] : magic_enum::enum_entries<GPUSort::Algorithm>()) {
+						if (ImGui::Selectable(name.data(), algorithm == this->algorithm)) {
+							this->algorithm = algorithm;
+						}
+					}
+					ImGui::EndCombo();
+				}
+				ImGui::SliderInt("Elements (log2)", &this->elementsLog2, 10, 26);
+				ImGui::Checkbox("Verify", &this->verify);
 
-				if (ImGui::Button("Reset")) {
-					/*	*/
+				if (ImGui::Button("Sort")) {
+					this->getRefSample().sortRequested = true;
+				}
+				ImGui::SameLine();
+				if (ImGui::Button("Benchmark")) {
+					this->getRefSample().benchmarkRequested = true;
 				}
-			}
 
-			bool showWireFrame = false;
-			int program{};
+				/*	*/
+				for (const BenchmarkResult &result : this->getRefSample().results) {
+					ImGui::Text("%s %zu: %.3f ms, %.1f MKeys/s%s", magic_enum::enum_name(result.algorithm).data(),
+								result.count, result.milliseconds,
+								result.count / (result.milliseconds * 1000.0), result.sorted ? "" : " (Not Sorted)");
+				}
+			}
 
-		  private:
-			struct uniform_buffer_block_t &uniform;
+			GPUSort::Algorithm algorithm = GPUSort::Algorithm::Radix;
+			int elementsLog2 = 20;
+			bool verify = true;
 		};
 		std::shared_ptr<SortSettingComponent> sortSettingComponent;
 
 		/*	*/
-		const std::string computeMergeSortShaderPath = "Shaders/sort/merge.comp.spv";
-		const std::string computeJuliaShaderPath = "Shaders/sort/julia.comp.spv";
-
-		/*	Particle.	*/
-		const std::string sortLineVertexShaderPath = "Shaders/sort/line.vert.spv";
-		const std::string sortLineGeometryShaderPath = "Shaders/sort/line.geom.spv";
-		const std::string sortLineFragmentShaderPath = "Shaders/sort/line.frag.spv";
+		const std::string vertexShaderPath = "Shaders/postprocessingeffects/postprocessing.vert.spv";
+		const std::string fragmentShaderPath = "Shaders/sort/sort_visual.frag.spv";
 
 		void Release() override {
+			this->gpuSort.release();
 
-			glDeleteProgram(this->sort_mergesort_program);
-			glDeleteProgram(this->julia_program);
-			glDeleteFramebuffers(1, &this->mandelbrot_framebuffer);
+			glDeleteProgram(this->sort_visual_program);
+			glDeleteVertexArrays(1, &this->vao);
+			glDeleteQueries(1, &this->timer_query);
 			glDeleteBuffers(1, &this->uniform_buffer);
-			glDeleteTextures(1, (const GLuint *)&this->mandelbrot_texture);
+			glDeleteBuffers(1, &this->key_buffer);
+			glDeleteBuffers(1, &this->value_buffer);
 		}
 
 		void Initialize() override {
 
 			{
 				/*	Load shader binaries.	*/
-				const std::vector<uint32_t> mergesort_binary =
-					IOUtil::readFileData<uint32_t>(this->computeMergeSortShaderPath, this->getFileSystem());
+				const std::vector<uint32_t> vertex_binary =
+					IOUtil::readFileData<uint32_t>(this->vertexShaderPath, this->getFileSystem());
+				const std::vector<uint32_t> fragment_binary =
+					IOUtil::readFileData<uint32_t>(this->fragmentShaderPath, this->getFileSystem());
 
 				/*	*/
 				fragcore::ShaderCompiler::CompilerConvertOption compilerOptions;
@@ -109,164 +130,185 @@ namespace glsample {
 				compilerOptions.glslVersion = this->getShaderVersion();
 
 				/*	Load shader	*/
-				this->sort_mergesort_program = ShaderLoader::loadComputeProgram(compilerOptions, &mergesort_binary);
-
-				const std::vector<uint32_t> julia_binary =
-					IOUtil::readFileData<uint32_t>(this->computeJuliaShaderPath, this->getFileSystem());
-
-				/*	Load shader	*/
-				this->julia_program = ShaderLoader::loadComputeProgram(compilerOptions, &julia_binary);
+				this->sort_visual_program =
+					ShaderLoader::loadGraphicProgram(compilerOptions, &vertex_binary, &fragment_binary);
 			}
 
 			/*	*/
 			{
-				glUseProgram(this->sort_mergesort_program);
-				int uniform_buffer_index = glGetUniformBlockIndex(this->sort_mergesort_program, "UniformBufferBlock");
-				glUniformBlockBinding(this->sort_mergesort_program, uniform_buffer_index, this->uniform_buffer_binding);
-
-				int buffer_read_index =
-					glGetProgramResourceIndex(this->sort_mergesort_program, GL_SHADER_STORAGE_BLOCK, "ReadCells");
-				int buffer_write_index =
-					glGetProgramResourceIndex(this->sort_mergesort_program, GL_SHADER_STORAGE_BLOCK, "WriteCells");
+				glUseProgram(this->sort_visual_program);
+				int uniform_buffer_index = glGetUniformBlockIndex(this->sort_visual_program, "UniformBufferBlock");
+				glUniformBlockBinding(this->sort_visual_program, uniform_buffer_index, this->uniform_buffer_binding);
 
-				/*	*/
-				glShaderStorageBlockBinding(this->sort_mergesort_program, buffer_read_index,
-											this->current_cells_buffer_binding);
-				glShaderStorageBlockBinding(this->sort_mergesort_program, buffer_write_index,
-											this->previous_cells_buffer_binding);
-
-				glGetProgramiv(this->sort_mergesort_program, GL_COMPUTE_WORK_GROUP_SIZE, this->localWorkGroupSize);
-				glUseProgram(0);
-
-				/*	*/
-				glUseProgram(this->julia_program);
-				uniform_buffer_index = glGetUniformBlockIndex(this->julia_program, "UniformBufferBlock");
-				glUniformBlockBinding(this->julia_program, uniform_buffer_index, this->uniform_buffer_binding);
-				glUniform1i(glGetUniformLocation(this->julia_program, "img_output"), 0);
-				glGetProgramiv(this->julia_program, GL_COMPUTE_WORK_GROUP_SIZE, this->localWorkGroupSize);
+				int buffer_key_index =
+					glGetProgramResourceIndex(this->sort_visual_program, GL_SHADER_STORAGE_BLOCK, "SortKeys");
+				glShaderStorageBlockBinding(this->sort_visual_program, buffer_key_index, this->key_buffer_binding);
 				glUseProgram(0);
 			}
 
-			/*	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformAlignBufferSize = Math::align<size_t>(this->uniformAlignBufferSize, minMapBufferSize);
+			this->gpuSort.init(this->getFileSystem());
+
+			/*	Key and value buffers are limited by the storage block size.	*/
+			GLint64 maxStorageBlockSize = 0;
+			glGetInteger64v(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &maxStorageBlockSize);
+			this->maxElements = static_cast<size_t>(maxStorageBlockSize) / sizeof(uint32_t);
 
 			/*	*/
 			glGenBuffers(1, &this->uniform_buffer);
 			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * nrUniformBuffer, nullptr, GL_DYNAMIC_DRAW);
+			glBufferData(GL_UNIFORM_BUFFER, sizeof(UniformBufferBlock), nullptr, GL_DYNAMIC_DRAW);
 			glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
-			/*	*/
-			{
-				glGenFramebuffers(1, &this->mandelbrot_framebuffer);
+			glGenQueries(1, &this->timer_query);
+			glGenVertexArrays(1, &this->vao);
 
-				glGenTextures(1, &this->mandelbrot_texture);
-				this->onResize(this->width(), this->height());
+			if (this->getResult()["benchmark"].as<bool>()) {
+				this->benchmarkRequested = true;
 			}
 		}
 
-		void onResize(int width, int height) override {
+		/*	Random keys, with the index as the value.	*/
+		void generateKeys(const size_t count) {
+			std::mt19937 generator(count);
+			this->keys.resize(count);
+			std::generate(this->keys.begin(), this->keys.end(), generator);
+
+			std::vector<uint32_t> values(count);
+			for (size_t i = 0; i < count; i++) {
+				values[i] = static_cast<uint32_t>(i);
+			}
+
+			if (count > this->bufferCapacity) {
+				this->bufferCapacity = count;
+				for (unsigned int *buffer : {&this->key_buffer, &this->value_buffer}) {
+					if (*buffer == 0) {
+						glGenBuffers(1, buffer);
+					}
+					glBindBuffer(GL_SHADER_STORAGE_BUFFER, *buffer);
+					glBufferData(GL_SHADER_STORAGE_BUFFER, count * sizeof(uint32_t), nullptr, GL_DYNAMIC_DRAW);
+				}
+			}
+
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->key_buffer);
+			glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, count * sizeof(uint32_t), this->keys.data());
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->value_buffer);
+			glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, count * sizeof(uint32_t), values.data());
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
-			this->mandelbrot_texture_width = width;
-			this->mandelbrot_texture_height = height;
+			this->uniformStageBuffer.count = static_cast<uint32_t>(count);
+		}
+
+		BenchmarkResult runSort(const GPUSort::Algorithm algorithm, const size_t count, const bool verify) {
+			this->generateKeys(count);
 
-			glBindFramebuffer(GL_FRAMEBUFFER, this->mandelbrot_framebuffer);
-			/*	Resize the image.	*/
-			glBindTexture(GL_TEXTURE_2D, this->mandelbrot_texture);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_FLOAT, nullptr);
+			BenchmarkResult result = {algorithm, count, 0, true};
+			if (algorithm == GPUSort::Algorithm::CPU) {
+				std::vector<uint32_t> sortedKeys = this->keys;
+				std::vector<uint32_t> values(count);
+				for (size_t i = 0; i < count; i++) {
+					values[i] = static_cast<uint32_t>(i);
+				}
 
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, this->mandelbrot_texture, 0);
+				const auto start = std::chrono::steady_clock::now();
+				GPUSort::sortCPU(sortedKeys.data(), values.data(), count);
+				const auto end = std::chrono::steady_clock::now();
+				result.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+
+				/*	Uploaded for the visualization.	*/
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->key_buffer);
+				glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, count * sizeof(uint32_t), sortedKeys.data());
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->value_buffer);
+				glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, count * sizeof(uint32_t), values.data());
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+			} else {
+				/*	Only the sort is timed, not the upload.	*/
+				glFinish();
+				glBeginQuery(GL_TIME_ELAPSED, this->timer_query);
+				if (algorithm == GPUSort::Algorithm::Radix) {
+					this->gpuSort.sortRadix(this->key_buffer, this->value_buffer, count);
+				} else {
+					this->gpuSort.sortBitonic(this->key_buffer, this->value_buffer, count);
+				}
+				glEndQuery(GL_TIME_ELAPSED);
 
-			const GLenum drawAttach = GL_COLOR_ATTACHMENT0;
-			glDrawBuffers(1, &drawAttach);
+				GLuint64 elapsed = 0;
+				glGetQueryObjectui64v(this->timer_query, GL_QUERY_RESULT, &elapsed);
+				result.milliseconds = elapsed / 1000000.0;
+			}
 
-			/*  Validate if created properly.*/
-			const int frameStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-			if (frameStatus != GL_FRAMEBUFFER_COMPLETE) {
-				throw RuntimeException("Failed to create framebuffer, {}", frameStatus);
+			/*	Keys are ascending, and each value is still the index of its key.	*/
+			if (verify) {
+				std::vector<uint32_t> sortedKeys(count);
+				std::vector<uint32_t> values(count);
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->key_buffer);
+				glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, count * sizeof(uint32_t), sortedKeys.data());
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->value_buffer);
+				glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, count * sizeof(uint32_t), values.data());
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+				result.sorted = std::is_sorted(sortedKeys.begin(), sortedKeys.end());
+				for (size_t i = 0; i < count && result.sorted; i++) {
+					result.sorted = values[i] < count && this->keys[values[i]] == sortedKeys[i];
+				}
 			}
 
-			glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
+			this->getLogger().info("Sort {} {} keys: {:.3f} ms, {:.1f} MKeys/s{}", magic_enum::enum_name(algorithm),
+								   count, result.milliseconds, count / (result.milliseconds * 1000.0),
+								   result.sorted ? "" : " (Not Sorted)");
+			return result;
+		}
+
+		/*	All algorithms from 1M to 64M keys.	*/
+		void benchmark() {
+			this->results.clear();
+			for (size_t count = 1 << 20; count <= (1 << 26) && count <= this->maxElements; count <<= 1) {
+				for (const GPUSort::Algorithm algorithm : magic_enum::enum_values<GPUSort::Algorithm>()) {
+					this->results.push_back(this->runSort(algorithm, count, this->sortSettingComponent->verify));
+				}
+			}
 		}
 
 		void draw() override {
 
+			if (this->benchmarkRequested) {
+				this->benchmarkRequested = false;
+				this->benchmark();
+			}
+			if (this->sortRequested) {
+				this->sortRequested = false;
+				const size_t count =
+					std::min<size_t>(size_t(1) << this->sortSettingComponent->elementsLog2, this->maxElements);
+				this->results = {
+					this->runSort(this->sortSettingComponent->algorithm, count, this->sortSettingComponent->verify)};
+			}
+
 			int width = 0, height = 0;
 			this->getSize(&width, &height);
 
 			/*	*/
 			glViewport(0, 0, width, height);
-
-			/*	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-							  this->uniformAlignBufferSize);
-
 			glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
-			{
-
-				if (this->sortSettingComponent->program == 0) {
-					glUseProgram(this->sort_mergesort_program);
-				} else {
-					glUseProgram(this->julia_program);
-				}
-
-				glBindImageTexture(0, this->mandelbrot_texture, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
-
-				glDispatchCompute(std::ceil(this->mandelbrot_texture_width / (float)localWorkGroupSize[0]),
-								  std::ceil(this->mandelbrot_texture_height / (float)localWorkGroupSize[1]), 1);
-
-				/*	Wait in till image has been written.	*/
-				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
-			}
 
 			/*	Draw sort */
+			glBindBufferBase(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->key_buffer_binding, this->key_buffer);
+
+			glDisable(GL_CULL_FACE);
+			glDisable(GL_DEPTH_TEST);
+			glDisable(GL_BLEND);
+
+			glUseProgram(this->sort_visual_program);
+			glBindVertexArray(this->vao);
+			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+			glBindVertexArray(0);
+			glUseProgram(0);
 		}
 
 		void update() override {
-			// const float elapsedTime = this->getTimer().getElapsed<float>();
-			// this->camera.update(this->getTimer().deltaTime<float>());
-
-			// /*	*/
-			// {
-			// 	const float xHalf = this->uniformStageBuffer.particleSetting.particleBox.x / 2.f;
-			// 	const float yHalf = this->uniformStageBuffer.particleSetting.particleBox.y / 2.f;
-			// 	glm::mat4 proj = glm::ortho(-xHalf, xHalf, -yHalf, yHalf, -10.0f, 10.0f);
-
-			// 	glm::mat4 viewMatrix = glm::translate(glm::vec3(-xHalf, -yHalf, 0));
-			// 	/*	*/
-			// 	this->uniformStageBuffer.proj = proj;
-
-			// 	this->uniformStageBuffer.delta = this->getTimer().deltaTime<float>();
-
-			// 	this->uniformStageBuffer.model = glm::mat4(1.0f);
-			// 	this->uniformStageBuffer.view = viewMatrix;
-			// 	this->uniformStageBuffer.modelViewProjection =
-			// 		this->uniformStageBuffer.proj * this->uniformStageBuffer.view * this->uniformStageBuffer.model;
-
-			// 	if (this->getInput().getMousePressed(Input::MouseButton::LEFT_BUTTON)) {
-			// 		int x, y;
-			// 		this->getInput().getMousePosition(&x, &y);
-			// 		this->uniformStageBuffer.motion.normalizedPos =
-			// 			glm::vec2(1, 1) - (glm::vec2(x, y) / glm::vec2(this->width(), this->height()));
-			// 		this->uniformStageBuffer.motion.normalizedPos.x =
-			// 			1.0f - this->uniformStageBuffer.motion.normalizedPos.x;
-			// 	}
-			// }
-
 			/*	*/
 			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount()) % nrUniformBuffer) * uniformAlignBufferSize,
-				uniformAlignBufferSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
-			memcpy(uniformPointer, &params, sizeof(params));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(this->uniformStageBuffer), &this->uniformStageBuffer);
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
 		}
 	};
 
@@ -274,7 +316,9 @@ namespace glsample {
 	  public:
 		SortGLSample() : GLSample<Sort>() {}
 
-		void customOptions(cxxopts::OptionAdder &options) override {}
+		void customOptions(cxxopts::OptionAdder &options) override {
+			options("B,benchmark", "Run the sort benchmark on startup", cxxopts::value<bool>()->default_value("false"));
+		}
 	};
 
 } // namespace glsample
@@ -70,9 +70,7 @@ namespace glsample {
 		int texture_program{};
 		unsigned int uniform_buffer_binding = 0;
 
-		unsigned int uniform_buffer = 0;
-		const size_t nrUniformBuffer = 3;
-		size_t uniformSize = sizeof(UniformBuffer);
+		FrameRingAllocator::Allocation uniform_allocation{};
 
 		unsigned int subgroup_area_program = 0;
 		unsigned int subgroup_uniform_buffer_binding = 0;
@@ -85,8 +83,7 @@ namespace glsample {
 		size_t result_buffer_size = sizeof(ResultBuffer);
 
 		/*	*/
-		unsigned int subgroup_area_uniform_buffer = 0;
-		size_t subgroup_area_uniform_buffer_size = sizeof(SubGroupAreaUniform);
+		FrameRingAllocator::Allocation subgroup_area_uniform_allocation{};
 
 		/*	*/
 		MeshObject cubeGeometry;
@@ -104,7 +101,6 @@ namespace glsample {
 		std::shared_ptr<SubGroupAreaSettingComponent> subgroupSettingComponent;
 
 		void Release() override {
-			glDeleteBuffers(1, &this->uniform_buffer);
 			glDeleteBuffers(1, &this->result_buffer);
 		}
 
@@ -174,22 +170,7 @@ namespace glsample {
 			/*	Align the uniform buffer size to hardware specific.	*/
 			GLint minMapBufferSize = 0;
 			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->uniformSize = Math::align<size_t>(this->uniformSize, (size_t)minMapBufferSize);
 			this->result_buffer_size = Math::align<size_t>(this->result_buffer_size, (size_t)minMapBufferSize);
-			this->subgroup_area_uniform_buffer_size =
-				Math::align<size_t>(this->subgroup_area_uniform_buffer_size, (size_t)minMapBufferSize);
-
-			/*	Create uniform buffer.	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformSize * this->nrUniformBuffer, nullptr, GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
-			/*	Create uniform buffer.	*/
-			glGenBuffers(1, &this->subgroup_area_uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->subgroup_area_uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->subgroup_area_uniform_buffer_size, nullptr, GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
 			/*	Create uniform buffer.	*/
 			glGenBuffers(1, &this->result_buffer);
@@ -215,8 +196,8 @@ namespace glsample {
 			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
 			/*	Bind subset of the uniform buffer, that the graphic pipeline will use.	*/
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  (this->getFrameCount() % this->nrUniformBuffer) * this->uniformSize, this->uniformSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+							  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 			int width = 0, height = 0;
 			this->getSize(&width, &height);
@@ -253,7 +234,9 @@ namespace glsample {
 
 				/*	Bind subset of the uniform buffer, that the graphic pipeline will use.	*/
 				glBindBufferRange(GL_UNIFORM_BUFFER, this->subgroup_uniform_buffer_binding,
-								  this->subgroup_area_uniform_buffer, 0, this->subgroup_area_uniform_buffer_size);
+								  this->subgroup_area_uniform_allocation.buffer,
+								  this->subgroup_area_uniform_allocation.offset,
+								  this->subgroup_area_uniform_allocation.size);
 
 				glBindBufferRange(GL_SHADER_STORAGE_BUFFER, this->uniform_vertices_binding, this->cubeGeometry.vbo, 0,
 								  this->cubeGeometry.stride * this->cubeGeometry.nrVertices);
@@ -291,19 +274,10 @@ namespace glsample {
 			this->subgroupArea.view = this->camera.getViewMatrix();
 
 			/*	Update uniform buffer.	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			void *uniformMappedMemory = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformSize,
-				this->uniformSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			memcpy(uniformMappedMemory, &this->uniform_stage_buffer, sizeof(this->uniform_stage_buffer));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniform_stage_buffer);
 
 			/*	Update uniform buffer.	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->subgroup_area_uniform_buffer);
-			SubGroupAreaUniform *suggroup = (SubGroupAreaUniform *)glMapBufferRange(
-				GL_UNIFORM_BUFFER, 0, this->subgroup_area_uniform_buffer_size, GL_MAP_WRITE_BIT);
-			*suggroup = this->subgroupArea;
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->subgroup_area_uniform_allocation = this->getFrameAllocator().allocate(this->subgroupArea);
 		}
 	};
 
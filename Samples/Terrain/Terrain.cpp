@@ -102,14 +102,11 @@ namespace glsample {
 		/*  Uniform buffers.    */
 		unsigned int uniform_buffer_binding = 0;
 		unsigned int uniform_light_buffer_binding = 1;
-		unsigned int uniform_buffer{};
+		FrameRingAllocator::Allocation uniform_allocation{};
 		unsigned int uniform_light_buffer{};
-		const size_t nrUniformBuffer = 3;
 
 		/*	Uniform align buffer sizes.	*/
-		size_t uniformAlignBufferSize = sizeof(uniform_buffer_block);
 		size_t terrainUniformSize = 0;
-		size_t oceanUniformSize = 0;
 
 		unsigned int terrain_diffuse_texture = 0;
 		unsigned int terrain_heightMap = 0;
@@ -281,18 +278,6 @@ namespace glsample {
 			this->terrain_diffuse_texture = textureImporter.loadImage2D(panoramicPath);
 			this->color_texture = Common::createColorTexture(1, 1, Color(0, 1, 0, 1));
 
-			/*	*/
-			GLint minMapBufferSize = 0;
-			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-			this->oceanUniformSize = Math::align<size_t>(this->uniformAlignBufferSize, (size_t)minMapBufferSize);
-			this->uniformAlignBufferSize = Math::align<size_t>(this->oceanUniformSize, (size_t)minMapBufferSize);
-
-			/*	Create uniform buffer.	*/
-			glGenBuffers(1, &this->uniform_buffer);
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignBufferSize * nrUniformBuffer, nullptr, GL_DYNAMIC_DRAW);
-			glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 			ProcessData util = ProcessData(this->getFileSystem());
 
 			/*	Generate HeightMap.	*/
@@ -344,9 +329,8 @@ namespace glsample {
 			/*	Terrain.	*/
 			if (this->terrainSettingComponent->showTerrain) {
 				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % nrUniformBuffer) * this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 
 				/*	Draw terrain.	*/
 				glUseProgram(this->terrain_program);
@@ -418,9 +402,8 @@ namespace glsample {
 			// Ocean/Water
 			if (this->terrainSettingComponent->showOcean) {
 				/*	*/
-				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-								  (this->getFrameCount() % nrUniformBuffer) * this->uniformAlignBufferSize,
-								  this->uniformAlignBufferSize);
+				glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_allocation.buffer,
+								  this->uniform_allocation.offset, this->uniform_allocation.size);
 				/*	*/
 				glEnable(GL_DEPTH_TEST);
 				glDepthMask(GL_FALSE);
@@ -499,12 +482,7 @@ namespace glsample {
 			this->mistprocessing.mistsettings.viewRotation = camera.getRotationMatrix();
 
 			/*	*/
-			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-			void *uniformPointer = glMapBufferRange(
-				GL_UNIFORM_BUFFER, ((this->getFrameCount() + 1) % this->nrUniformBuffer) * this->uniformAlignBufferSize,
-				this->uniformAlignBufferSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
-			memcpy(uniformPointer, &this->uniform_stage_buffer, sizeof(this->uniform_stage_buffer));
-			glUnmapBuffer(GL_UNIFORM_BUFFER);
+			this->uniform_allocation = this->getFrameAllocator().allocate(this->uniform_stage_buffer);
 		}
 	};
 
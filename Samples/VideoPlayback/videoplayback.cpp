@@ -8,11 +8,16 @@
 #include <OpenALAudioInterface.h>
 #include <ShaderLoader.h>
 #include <Util/CameraController.h>
+#include <Util/SPSCQueue.h>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <fmt/core.h>
 #include <glm/glm.hpp>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <thread>
 
 #ifdef __cplusplus
@@ -23,6 +28,7 @@ extern "C" {
 #include <libavutil/channel_layout.h>
 #include <libavutil/frame.h>
 #include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
 #include <libavutil/samplefmt.h>
 #include <libavutil/time.h>
 #include <libswresample/swresample.h>
@@ -39,8 +45,12 @@ extern "C" {
 namespace glsample {
 
 	/**
-	 * @brief
+	 * @brief Video playback, demuxed and decoded on background threads.
 	 *
+	 * The demux thread feeds packet queues of the video and audio decode threads. The Y'CbCr planes of the
+	 * decoded video frames are copied directly into free slots of a persistently mapped pixel unpack buffer,
+	 * and queued with their presentation time. The render thread only picks the frame due at the current
+	 * playback time, uploads its planes and converts them to RGB with a compute shader.
 	 */
 	class VideoPlayback : public GLSampleWindow {
 	  public:
@@ -50,6 +60,7 @@ namespace glsample {
 		}
 
 		static const size_t nrVideoFrames = 2;
+		static const size_t nrStagingFrames = 4;
 		int nthVideoFrame = 0;
 		int frameSize = 0;
 
@@ -69,8 +80,6 @@ namespace glsample {
 		size_t audio_channels{};
 
 		/*  */
-		struct AVFrame *frame = nullptr;
-		struct AVFrame *frameoutput = nullptr;
 		struct AVStream *video_st = nullptr;
 		struct AVStream *audio_st = nullptr;
 		struct SwsContext *sws_ctx = nullptr;
@@ -78,11 +87,41 @@ namespace glsample {
 		uint8_t **destBuffer = nullptr;
 
 		int destBufferLinesize{};
-		unsigned int flag{};
-		double video_clock{};
-		double frame_timer{};
-		double frame_last_pts{};
-		double frame_last_delay{};
+		static const int nrDestSamples = 4096;
+
+		/*	Plane layout of the staging slots, formats not supported are converted to the fallback by swscale.	*/
+		static const AVPixelFormat fallbackPixelFormat = AV_PIX_FMT_YUV420P;
+		AVPixelFormat planePixelFormat = fallbackPixelFormat;
+		bool semiPlanar = false;
+		size_t bytesPerComponent = 1;
+		static const size_t maxPlanes = 3;
+		size_t nrPlanes = 3;
+		std::array<size_t, maxPlanes> planeOffset{};
+		std::array<size_t, maxPlanes> planeWidth{};
+		std::array<size_t, maxPlanes> planeHeight{};
+		std::array<unsigned int, maxPlanes> planeTextures{};
+
+		/*	Decoded frame in a staging slot, with its presentation time in seconds. A NaN presentation time hands
+		 *	the slot back unused, the render thread is the only producer of the free slots.	*/
+		using DecodedFrame = struct decoded_frame_t {
+			unsigned int slot;
+			double pts;
+		};
+
+		/*	Packets owned by the queue until popped, nullptr marks the end of the stream.	*/
+		SPSCQueue<AVPacket *> videoPackets{256};
+		SPSCQueue<AVPacket *> audioPackets{256};
+		SPSCQueue<unsigned int> freeStagingSlots{nrStagingFrames};
+		SPSCQueue<DecodedFrame> decodedFrames{nrStagingFrames};
+
+		std::thread demux_thread;
+		std::thread video_decode_thread;
+		std::thread audio_decode_thread;
+		std::atomic<bool> playing{false};
+
+		/*	Render thread only.	*/
+		std::optional<double> playbackTime;
+		std::vector<unsigned int> uploadedSlots;
 
 		/*  */
 		unsigned int videoFramebuffer{};
@@ -102,11 +141,20 @@ namespace glsample {
 
 		/*  */
 		unsigned int videoplayback_program{};
+		unsigned int yuv2rgb_program{};
+		unsigned int uniform_buffer{};
+		int localWorkGroupSize[3]{};
+
+		using UniformBufferBlock = struct uniform_buffer_block {
+			glm::mat4 colorMatrix;
+			glm::ivec4 chromaLayout; /*	Semi planar chroma.	*/
+		} uniformStageBuffer{};
 
 		/*  */
 		size_t videoStageBufferMemorySize = 0;
 		std::array<unsigned int, nrVideoFrames> videoFrameTextures{};
-		std::array<void *, nrVideoFrames> videoMapBuffer{};
+		std::array<void *, nrStagingFrames> videoMapBuffer{};
+		std::array<GLsync, nrStagingFrames> videoStagingFences{};
 		unsigned int videoStagingTextureBuffer{}; // PBO buffers
 
 		class VideoPlaybackSettingComponent : public nekomimi::UIComponent {
@@ -129,6 +177,7 @@ namespace glsample {
 		/*	*/
 		const std::string vertexShaderPath = "Shaders/postprocessingeffects/postprocessing.vert.spv";
 		const std::string fragmentShaderPath = "Shaders/postprocessingeffects/overlay.frag.spv";
+		const std::string computeShaderPath = "Shaders/videoplayback/yuv2rgb.comp.spv";
 
 		std::string error_message(const int result) {
 			char buf[AV_ERROR_MAX_STRING_SIZE];
@@ -137,9 +186,24 @@ namespace glsample {
 		}
 
 		void Release() override {
+			/*	Stop decoding before the contexts are released.	*/
+			this->playing = false;
+			for (std::thread *thread : {&this->demux_thread, &this->video_decode_thread, &this->audio_decode_thread}) {
+				if (thread->joinable()) {
+					thread->join();
+				}
+			}
+			AVPacket *packet = nullptr;
+			while (this->videoPackets.pop(packet) || this->audioPackets.pop(packet)) {
+				av_packet_free(&packet);
+			}
+
 			/*	Release Video Data.	*/
-			if (this->frame) {
-				av_frame_free(&this->frame);
+			sws_freeContext(this->sws_ctx);
+			swr_free(&this->swrContext);
+			if (this->destBuffer) {
+				av_freep(&this->destBuffer[0]);
+				av_freep(&this->destBuffer);
 			}
 			avcodec_free_context(&this->pAudioCtx);
 			avcodec_free_context(&this->pVideoCtx);
@@ -148,6 +212,8 @@ namespace glsample {
 			avformat_free_context(this->pformatCtx);
 			/*	*/
 			glDeleteProgram(this->videoplayback_program);
+			glDeleteProgram(this->yuv2rgb_program);
+			glDeleteBuffers(1, &this->uniform_buffer);
 			glDeleteVertexArrays(1, &this->vao);
 			glDeleteBuffers(1, &this->vbo);
 
@@ -155,8 +221,116 @@ namespace glsample {
 			glDeleteFramebuffers(1, &this->videoFramebuffer);
 
 			/*	*/
+			for (GLsync &fence : this->videoStagingFences) {
+				if (fence) {
+					glDeleteSync(fence);
+					fence = nullptr;
+				}
+			}
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, this->videoStagingTextureBuffer);
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER_ARB);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
 			glDeleteBuffers(1, &videoStagingTextureBuffer);
 			glDeleteTextures(this->videoFrameTextures.size(), this->videoFrameTextures.data());
+			glDeleteTextures(this->planeTextures.size(), this->planeTextures.data());
+		}
+
+		/*	Row size in bytes of the plane in the staging slot.	*/
+		size_t getPlaneRowSize(const size_t plane) const noexcept {
+			const size_t components = (this->semiPlanar && plane > 0) ? 2 : 1;
+			return this->planeWidth[plane] * components * this->bytesPerComponent;
+		}
+
+		/*	Select the plane layout the decoded frames are uploaded with.	*/
+		void setupPlaneLayout(const AVPixelFormat format) {
+			switch (format) {
+			case AV_PIX_FMT_YUV420P:
+			case AV_PIX_FMT_YUVJ420P:
+				this->planePixelFormat = format;
+				break;
+			case AV_PIX_FMT_NV12:
+				this->planePixelFormat = format;
+				this->semiPlanar = true;
+				break;
+			case AV_PIX_FMT_P010LE:
+				this->planePixelFormat = format;
+				this->semiPlanar = true;
+				this->bytesPerComponent = 2;
+				break;
+			default:
+				this->getLogger().info("Pixel format {} converted on the CPU to {}", av_get_pix_fmt_name(format),
+									   av_get_pix_fmt_name(fallbackPixelFormat));
+				this->planePixelFormat = fallbackPixelFormat;
+				break;
+			}
+
+			/*	4:2:0 chroma subsampling for all supported layouts.	*/
+			this->nrPlanes = this->semiPlanar ? 2 : 3;
+			size_t offset = 0;
+			for (size_t i = 0; i < this->nrPlanes; i++) {
+				this->planeWidth[i] = i == 0 ? this->video_width : (this->video_width + 1) / 2;
+				this->planeHeight[i] = i == 0 ? this->video_height : (this->video_height + 1) / 2;
+				this->planeOffset[i] = offset;
+				offset += this->getPlaneRowSize(i) * this->planeHeight[i];
+			}
+			this->videoStageBufferMemorySize = fragcore::Math::align<size_t>(offset, 256);
+		}
+
+		/*	Y'CbCr to RGB matrix of the stream, BT.601, BT.709 or BT.2020 in limited or full range.	*/
+		glm::mat4 computeColorMatrix() const {
+			float Kr = 0, Kb = 0;
+			switch (this->pVideoCtx->colorspace) {
+			case AVCOL_SPC_BT470BG:
+			case AVCOL_SPC_SMPTE170M:
+				Kr = 0.299f;
+				Kb = 0.114f;
+				break;
+			case AVCOL_SPC_BT2020_NCL:
+			case AVCOL_SPC_BT2020_CL:
+				Kr = 0.2627f;
+				Kb = 0.0593f;
+				break;
+			case AVCOL_SPC_BT709:
+				Kr = 0.2126f;
+				Kb = 0.0722f;
+				break;
+			default:
+				/*	Unspecified, HD content is assumed to be BT.709.	*/
+				Kr = this->video_height >= 720 ? 0.2126f : 0.299f;
+				Kb = this->video_height >= 720 ? 0.0722f : 0.114f;
+				break;
+			}
+			const float Kg = 1.0f - Kr - Kb;
+
+			/*	Normalized code values, P010 stores the 10 bits in the most significant bits.	*/
+			const bool fullRange =
+				this->pVideoCtx->color_range == AVCOL_RANGE_JPEG || this->planePixelFormat == AV_PIX_FMT_YUVJ420P;
+			const unsigned int bitDepth = this->bytesPerComponent == 2 ? 10 : 8;
+			const float maxCode = static_cast<float>((1u << bitDepth) - 1);
+			const float sampleScale = this->bytesPerComponent == 2 ? 65535.0f / (64.0f * maxCode) : 1.0f;
+
+			float lumaOffset = 0, lumaScale = 1, chromaScale = 1;
+			const float chromaOffset = static_cast<float>(1u << (bitDepth - 1)) / maxCode;
+			if (!fullRange) {
+				lumaOffset = static_cast<float>(16u << (bitDepth - 8)) / maxCode;
+				lumaScale = maxCode / static_cast<float>(219u << (bitDepth - 8));
+				chromaScale = maxCode / static_cast<float>(224u << (bitDepth - 8));
+			}
+
+			/*	Column major, columns are the Y', Cb, Cr and the constant term.	*/
+			const glm::mat3 toRGB(glm::vec3(1.0f, 1.0f, 1.0f),
+								  glm::vec3(0.0f, -2.0f * Kb * (1.0f - Kb) / Kg, 2.0f * (1.0f - Kb)),
+								  glm::vec3(2.0f * (1.0f - Kr), -2.0f * Kr * (1.0f - Kr) / Kg, 0.0f));
+			const glm::vec3 scale = glm::vec3(lumaScale, chromaScale, chromaScale) * sampleScale;
+			const glm::vec3 bias = -glm::vec3(lumaScale * lumaOffset, chromaScale * chromaOffset,
+											  chromaScale * chromaOffset);
+
+			glm::mat4 colorMatrix = glm::mat4(1.0f);
+			for (int i = 0; i < 3; i++) {
+				colorMatrix[i] = glm::vec4(toRGB[i] * scale[i], 0.0f);
+			}
+			colorMatrix[3] = glm::vec4(toRGB * bias, 1.0f);
+			return colorMatrix;
 		}
 
 		void loadVideo(const char *path) {
@@ -264,6 +438,10 @@ namespace glsample {
 					av_strerror(result, buf, sizeof(buf));
 					throw cxxexcept::RuntimeException("Failed to set codec parameters : {}", buf);
 				}
+				/*	Decode multiple frames and slices concurrently, with as many threads as cores.	*/
+				this->pVideoCtx->thread_count = 0;
+				this->pVideoCtx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
 				/*	*/
 				if ((result = avcodec_open2(this->pVideoCtx, pVideoCodec, nullptr)) != 0) {
 					char buf[AV_ERROR_MAX_STRING_SIZE];
@@ -274,47 +452,30 @@ namespace glsample {
 				this->video_width = this->pVideoCtx->width;
 				this->video_height = this->pVideoCtx->height;
 
-				this->frame = av_frame_alloc();
-				this->frameoutput = av_frame_alloc();
-
-				if (this->frame == nullptr || this->frameoutput == nullptr) {
-					throw cxxexcept::RuntimeException("Failed to allocate frame");
-				}
-
-				/*	*/
-				const size_t m_bufferSize =
-					av_image_get_buffer_size(AV_PIX_FMT_RGBA, this->pVideoCtx->width, this->pVideoCtx->height, 4);
-				av_image_alloc(this->frameoutput->data, this->frameoutput->linesize, this->pVideoCtx->width,
-							   this->pVideoCtx->height, AV_PIX_FMT_RGBA, 4);
+				/*	Planes are copied by the video decode thread, directly into the staging memory.	*/
+				this->setupPlaneLayout(this->pVideoCtx->pix_fmt);
 
-				/*	*/
-				this->sws_ctx = sws_getContext(
-					this->pVideoCtx->width, this->pVideoCtx->height, this->pVideoCtx->pix_fmt, this->pVideoCtx->width,
-					this->pVideoCtx->height, AV_PIX_FMT_RGBA, SWS_BICUBIC, nullptr, nullptr, nullptr);
-				if (this->sws_ctx == nullptr) {
-				}
-				// Initialize SWR context
-				this->swrContext = swr_alloc_set_opts(nullptr, pAudioCtx->channel_layout, AV_SAMPLE_FMT_FLT,
-													  pAudioCtx->sample_rate, pAudioCtx->channel_layout,
-													  pAudioCtx->sample_fmt, pAudioCtx->sample_rate, 0, nullptr);
-				if ((result = swr_init(swrContext)) != 0) {
-					char buf[AV_ERROR_MAX_STRING_SIZE];
-					av_strerror(result, buf, sizeof(buf));
-					throw cxxexcept::RuntimeException("Failed to init SWR : {}", buf);
-				}
+				if (this->pAudioCtx) {
+					// Initialize SWR context
+					this->swrContext = swr_alloc_set_opts(nullptr, pAudioCtx->channel_layout, AV_SAMPLE_FMT_FLT,
+														  pAudioCtx->sample_rate, pAudioCtx->channel_layout,
+														  pAudioCtx->sample_fmt, pAudioCtx->sample_rate, 0, nullptr);
+					if ((result = swr_init(swrContext)) != 0) {
+						char buf[AV_ERROR_MAX_STRING_SIZE];
+						av_strerror(result, buf, sizeof(buf));
+						throw cxxexcept::RuntimeException("Failed to init SWR : {}", buf);
+					}
 
-				result =
-					av_samples_alloc_array_and_samples(&destBuffer, &destBufferLinesize, 2, 4096, AV_SAMPLE_FMT_FLT, 0);
-				if (result < 0) {
-					char buf[AV_ERROR_MAX_STRING_SIZE];
-					av_strerror(result, buf, sizeof(buf));
-					throw cxxexcept::RuntimeException("Failed to allocate ({}) : {}", result, buf);
+					result = av_samples_alloc_array_and_samples(&destBuffer, &destBufferLinesize, 2, nrDestSamples,
+																AV_SAMPLE_FMT_FLT, 0);
+					if (result < 0) {
+						char buf[AV_ERROR_MAX_STRING_SIZE];
+						av_strerror(result, buf, sizeof(buf));
+						throw cxxexcept::RuntimeException("Failed to allocate ({}) : {}", result, buf);
+					}
 				}
 			}
 
-			/*	*/
-			this->frame_timer = av_gettime() / 1000000.0;
-
 			this->setColorSpace(ColorSpace::RawLinear);
 		}
 
@@ -364,6 +525,37 @@ namespace glsample {
 					ShaderLoader::loadGraphicProgram(compilerOptions, &vertex_binary, &fragment_binary);
 			}
 
+			{
+				const std::vector<uint32_t> compute_binary =
+					IOUtil::readFileData<uint32_t>(this->computeShaderPath, this->getFileSystem());
+
+				fragcore::ShaderCompiler::CompilerConvertOption compilerOptions;
+				compilerOptions.target = fragcore::ShaderLanguage::GLSL;
+				compilerOptions.glslVersion = this->getShaderVersion();
+
+				this->yuv2rgb_program = ShaderLoader::loadComputeProgram(compilerOptions, &compute_binary);
+			}
+
+			/*	Setup compute pipeline.	*/
+			glUseProgram(this->yuv2rgb_program);
+			glUniform1i(glGetUniformLocation(this->yuv2rgb_program, "LumaTexture"), 0);
+			glUniform1i(glGetUniformLocation(this->yuv2rgb_program, "ChromaBTexture"), 1);
+			glUniform1i(glGetUniformLocation(this->yuv2rgb_program, "ChromaRTexture"), 2);
+			glUniform1i(glGetUniformLocation(this->yuv2rgb_program, "renderTexture"), 3);
+			int uniform_buffer_index = glGetUniformBlockIndex(this->yuv2rgb_program, "UniformBufferBlock");
+			glUniformBlockBinding(this->yuv2rgb_program, uniform_buffer_index, 0);
+			glGetProgramiv(this->yuv2rgb_program, GL_COMPUTE_WORK_GROUP_SIZE, this->localWorkGroupSize);
+			glUseProgram(0);
+
+			/*	The color matrix is constant for the stream.	*/
+			this->uniformStageBuffer.colorMatrix = this->computeColorMatrix();
+			this->uniformStageBuffer.chromaLayout = glm::ivec4(this->semiPlanar ? 1 : 0, 0, 0, 0);
+			glGenBuffers(1, &this->uniform_buffer);
+			glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
+			glBufferData(GL_UNIFORM_BUFFER, sizeof(this->uniformStageBuffer), &this->uniformStageBuffer,
+						 GL_STATIC_DRAW);
+			glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
 			/*	Setup graphic pipeline.	*/
 			glUseProgram(this->videoplayback_program);
 			glUniform1i(glGetUniformLocation(this->videoplayback_program, "diffuse"), 0);
@@ -375,16 +567,36 @@ namespace glsample {
 			glBindVertexArray(this->vao);
 			glBindVertexArray(0);
 
-			/*	Allocate buffers.	*/
-			const size_t pixelSize = 4;
-			this->videoStageBufferMemorySize = this->video_width * this->video_height * pixelSize;
+			/*	Allocate buffers, persistently mapped, written by the video decode thread.	*/
 			glGenBuffers(1, &videoStagingTextureBuffer);
 			glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, this->videoStagingTextureBuffer);
-			glBufferData(GL_PIXEL_UNPACK_BUFFER_ARB,
-						 this->videoStageBufferMemorySize * glsample::VideoPlayback::nrVideoFrames, nullptr,
-						 GL_DYNAMIC_COPY);
+			const size_t stagingSize = this->videoStageBufferMemorySize * glsample::VideoPlayback::nrStagingFrames;
+			const GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glBufferStorage(GL_PIXEL_UNPACK_BUFFER_ARB, stagingSize, nullptr, mapFlags);
+			uint8_t *stagingMapped =
+				static_cast<uint8_t *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER_ARB, 0, stagingSize, mapFlags));
 			glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
 
+			for (size_t i = 0; i < this->videoMapBuffer.size(); i++) {
+				this->videoMapBuffer[i] = stagingMapped + i * this->videoStageBufferMemorySize;
+				this->freeStagingSlots.push(i);
+			}
+
+			/*	Y'CbCr plane textures, R8 or R16 for single components and RG8 or RG16 for interleaved chroma.	*/
+			glGenTextures(this->planeTextures.size(), this->planeTextures.data());
+			for (size_t i = 0; i < this->nrPlanes; i++) {
+				const bool interleaved = this->semiPlanar && i > 0;
+				const bool wide = this->bytesPerComponent == 2;
+				const GLenum internalFormat = interleaved ? (wide ? GL_RG16 : GL_RG8) : (wide ? GL_R16 : GL_R8);
+
+				glBindTexture(GL_TEXTURE_2D, this->planeTextures[i]);
+				glTexStorage2D(GL_TEXTURE_2D, 1, internalFormat, this->planeWidth[i], this->planeHeight[i]);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			}
+
 			/*	Create round robin texture array.	*/
 			glGenTextures(this->videoFrameTextures.size(), this->videoFrameTextures.data());
 			for (size_t i = 0; i < this->videoFrameTextures.size(); i++) {
@@ -422,6 +634,14 @@ namespace glsample {
 			}
 
 			glBindFramebuffer(GL_FRAMEBUFFER, this->getDefaultFramebuffer());
+
+			/*	*/
+			this->playing = true;
+			this->demux_thread = std::thread(&VideoPlayback::demux, this);
+			this->video_decode_thread = std::thread(&VideoPlayback::decodeVideo, this);
+			if (this->pAudioCtx) {
+				this->audio_decode_thread = std::thread(&VideoPlayback::decodeAudio, this);
+			}
 		}
 
 		void onResize(int width, int height) override {}
@@ -464,174 +684,303 @@ namespace glsample {
 
 		void update() override {
 
-			/*  */
-			AVPacket pkt = {nullptr};
-			AVPacket *packet = av_packet_alloc();
-			if (!packet) {
-				throw cxxexcept::RuntimeException("failed to allocated memory for AVPacket");
+			/*	Staging slots whose upload has completed.	*/
+			for (size_t i = 0; i < this->uploadedSlots.size();) {
+				const unsigned int slot = this->uploadedSlots[i];
+				const GLenum status = glClientWaitSync(this->videoStagingFences[slot], 0, 0);
+				if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+					glDeleteSync(this->videoStagingFences[slot]);
+					this->videoStagingFences[slot] = nullptr;
+					this->freeStagingSlots.push(slot);
+					this->uploadedSlots.erase(this->uploadedSlots.begin() + i);
+				} else {
+					i++;
+				}
 			}
 
-			int res = 0, result = 0;
+			/*	Playback clock, starts at the first decoded frame.	*/
+			if (this->playbackTime) {
+				*this->playbackTime +=
+					this->getTimer().deltaTime<double>() * this->videoplaybackSettingComponent->speed;
+			}
+
+			/*	Latest frame due, the frames presented late are skipped without being uploaded.	*/
+			std::optional<DecodedFrame> present;
+			const DecodedFrame *next = nullptr;
+			while ((next = this->decodedFrames.front()) != nullptr) {
+				/*	Slot returned without a frame.	*/
+				if (std::isnan(next->pts)) {
+					DecodedFrame unused{};
+					this->decodedFrames.pop(unused);
+					this->freeStagingSlots.push(unused.slot);
+					continue;
+				}
+				if (!this->playbackTime) {
+					this->playbackTime = next->pts;
+				}
+				if (next->pts > *this->playbackTime) {
+					break;
+				}
 
-			res = av_read_frame(this->pformatCtx, packet);
+				DecodedFrame frame{};
+				this->decodedFrames.pop(frame);
+				if (present) {
+					this->freeStagingSlots.push(present->slot);
+				}
+				present = frame;
+			}
 
-			if (res == 0) {
+			if (present) {
+				this->nthVideoFrame = (this->nthVideoFrame + 1) % glsample::VideoPlayback::nrVideoFrames;
 
-				/*	*/
-				if (packet->stream_index == this->videoStream) {
+				/*	Upload the planes from the slot the frame was decoded into.	*/
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, this->videoStagingTextureBuffer);
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+				for (size_t i = 0; i < this->nrPlanes; i++) {
+					const size_t offset = present->slot * this->videoStageBufferMemorySize + this->planeOffset[i];
+					const GLenum format = (this->semiPlanar && i > 0) ? GL_RG : GL_RED;
+					const GLenum type = this->bytesPerComponent == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_BYTE;
 
-					result = avcodec_send_packet(this->pVideoCtx, packet);
-					if (result < 0) {
-						throw cxxexcept::RuntimeException("Failed to send packet for decoding image frame : {}",
-														  error_message(result));
+					glBindTexture(GL_TEXTURE_2D, this->planeTextures[i]);
+					glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, this->planeWidth[i], this->planeHeight[i], format, type,
+									reinterpret_cast<void *>(offset));
+				}
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+				glBindTexture(GL_TEXTURE_2D, 0);
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+
+				/*	Convert to RGB.	*/
+				{
+					glUseProgram(this->yuv2rgb_program);
+					glBindBufferBase(GL_UNIFORM_BUFFER, 0, this->uniform_buffer);
+
+					for (size_t i = 0; i < this->planeTextures.size(); i++) {
+						glActiveTexture(GL_TEXTURE0 + i);
+						glBindTexture(GL_TEXTURE_2D, this->planeTextures[std::min(i, this->nrPlanes - 1)]);
 					}
+					glBindImageTexture(3, this->videoFrameTextures[this->nthVideoFrame], 0, GL_FALSE, 0,
+									   GL_WRITE_ONLY, GL_RGBA8);
 
-					while (result >= 0) {
-						result = avcodec_receive_frame(this->pVideoCtx, this->frame);
-						if (result == AVERROR(EAGAIN) || result == AVERROR_EOF) {
-							this->getLogger().debug("Failed to recv videoframe {}", error_message(result));
-							continue;
-						}
-						if (result < 0) {
-							throw cxxexcept::RuntimeException(" : {}", error_message(result));
-						}
+					glDispatchCompute(std::ceil(this->video_width / (float)this->localWorkGroupSize[0]),
+									  std::ceil(this->video_height / (float)this->localWorkGroupSize[1]), 1);
 
-						if (this->frame->format == AV_PIX_FMT_YUV420P) {
-
-							/*	*/
-							this->frame->data[0] =
-								this->frame->data[0] +
-								static_cast<ptrdiff_t>(this->frame->linesize[0] * (this->pVideoCtx->height - 1));
-							this->frame->data[1] =
-								this->frame->data[1] + this->frame->linesize[0] * this->pVideoCtx->height / 4 - 1;
-							this->frame->data[2] =
-								this->frame->data[2] + this->frame->linesize[0] * this->pVideoCtx->height / 4 - 1;
-
-							/*	*/
-							this->frame->linesize[0] *= -1;
-							this->frame->linesize[1] *= -1;
-							this->frame->linesize[2] *= -1;
-
-							sws_scale(this->sws_ctx, this->frame->data, this->frame->linesize, 0, this->frame->height,
-									  this->frameoutput->data, this->frameoutput->linesize);
-
-							/*	*/
-							glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, this->videoStagingTextureBuffer);
-							void *uniformPointer = glMapBufferRange(
-								GL_PIXEL_UNPACK_BUFFER_ARB, this->nthVideoFrame * this->videoStageBufferMemorySize,
-								this->videoStageBufferMemorySize,
-								GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-
-							/*	Upload the image to staging.	*/
-							memcpy(uniformPointer, this->frameoutput->data[0], this->videoStageBufferMemorySize);
-							glFlushMappedBufferRange(GL_PIXEL_UNPACK_BUFFER_ARB, 0, this->videoStageBufferMemorySize);
-							glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER_ARB);
-
-							glBindTexture(GL_TEXTURE_2D, this->videoFrameTextures[this->nthVideoFrame]);
-							glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, this->video_width, this->video_height, GL_RGBA,
-											GL_UNSIGNED_BYTE, nullptr);
-							glBindTexture(GL_TEXTURE_2D, 0);
-							glBindBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
-
-							this->nthVideoFrame = (this->nthVideoFrame + 1) % glsample::VideoPlayback::nrVideoFrames;
-						}
+					/*	Wait in till image has been written.	*/
+					glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
+					glUseProgram(0);
+				}
+
+				/*	The slot is handed back to the decoder once the upload has been consumed.	*/
+				this->videoStagingFences[present->slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				this->uploadedSlots.push_back(present->slot);
+			}
+
+			/*	*/
+			this->listener->setVolume(this->videoplaybackSettingComponent->volume);
+		}
+
+		/*	Wait for space in the queue, false if the playback was stopped.	*/
+		template <typename T> bool pushWait(SPSCQueue<T> &queue, const T &item) {
+			while (!queue.push(item)) {
+				if (!this->playing) {
+					return false;
+				}
+				std::this_thread::sleep_for(1ms);
+			}
+			return true;
+		}
+
+		/*	Wait for an item in the queue, false if the playback was stopped.	*/
+		template <typename T> bool popWait(SPSCQueue<T> &queue, T &item) {
+			while (!queue.pop(item)) {
+				if (!this->playing) {
+					return false;
+				}
+				std::this_thread::sleep_for(1ms);
+			}
+			return true;
+		}
+
+		void demux() {
+			while (this->playing) {
+				AVPacket *packet = av_packet_alloc();
+				if (!packet) {
+					this->getLogger().error("failed to allocated memory for AVPacket");
+					break;
+				}
+
+				const int result = av_read_frame(this->pformatCtx, packet);
+				if (result < 0) {
+					av_packet_free(&packet);
+					this->getLogger().debug("Failed to read package {}", error_message(result));
+
+					/*	End of stream, drain the decoders.	*/
+					this->pushWait<AVPacket *>(this->videoPackets, nullptr);
+					if (this->pAudioCtx) {
+						this->pushWait<AVPacket *>(this->audioPackets, nullptr);
 					}
-				} else if (packet->stream_index == this->audioStream) {
+					break;
+				}
+
+				SPSCQueue<AVPacket *> *queue = nullptr;
+				if (packet->stream_index == this->videoStream) {
+					queue = &this->videoPackets;
+				} else if (packet->stream_index == this->audioStream && this->pAudioCtx) {
+					queue = &this->audioPackets;
+				}
+
+				if (!queue || !this->pushWait(*queue, packet)) {
+					av_packet_free(&packet);
+				}
+			}
+		}
+
+		void decodeVideo() {
+			AVFrame *frame = av_frame_alloc();
 
-					result = avcodec_send_packet(this->pAudioCtx, packet);
+			AVPacket *packet = nullptr;
+			while (this->popWait(this->videoPackets, packet)) {
+
+				int result = avcodec_send_packet(this->pVideoCtx, packet);
+				const bool endOfStream = packet == nullptr;
+				av_packet_free(&packet);
+				if (result < 0) {
+					this->getLogger().error("Failed to send packet for decoding image frame : {}",
+											error_message(result));
+					continue;
+				}
+
+				while (this->playing) {
+					result = avcodec_receive_frame(this->pVideoCtx, frame);
+					if (result == AVERROR(EAGAIN) || result == AVERROR_EOF) {
+						break;
+					}
 					if (result < 0) {
-						throw cxxexcept::RuntimeException("Failed to send packet for decoding audio frame : {}",
-														  error_message(result));
+						this->getLogger().error("Failed to recv videoframe {}", error_message(result));
+						break;
 					}
 
-					/*	*/
-					while (result >= 0) {
-						result = avcodec_receive_frame(this->pAudioCtx, this->frame);
-						if (result == AVERROR(EAGAIN) || result == AVERROR_EOF) {
-							this->getLogger().debug("Failed to recv audio frame {}", error_message(result));
-							continue;
-						}
-						if (result < 0) {
-							throw cxxexcept::RuntimeException(" : {}", error_message(result));
-						}
+					unsigned int slot = 0;
+					if (!this->popWait(this->freeStagingSlots, slot)) {
+						break;
+					}
+
+					/*	Tightly packed planes, flipped vertically by the conversion shader.	*/
+					uint8_t *destination[4] = {nullptr, nullptr, nullptr, nullptr};
+					int destinationStride[4] = {0, 0, 0, 0};
+					for (size_t i = 0; i < this->nrPlanes; i++) {
+						destination[i] = static_cast<uint8_t *>(this->videoMapBuffer[slot]) + this->planeOffset[i];
+						destinationStride[i] = static_cast<int>(this->getPlaneRowSize(i));
+					}
 
-						/*	*/
-						ALenum alFormat = 0;
-						if (this->frame->format == AV_SAMPLE_FMT_U8) {
-							alFormat = AL_FORMAT_STEREO8;
-						} else if (this->frame->format == AV_SAMPLE_FMT_S16) {
-							alFormat = AL_FORMAT_STEREO16;
-						} else if (this->frame->format == AV_SAMPLE_FMT_FLT) {
-							alFormat = AL_FORMAT_STEREO_FLOAT32;
+					if (frame->format == this->planePixelFormat && frame->width == (int)this->video_width &&
+						frame->height == (int)this->video_height) {
+						for (size_t i = 0; i < this->nrPlanes; i++) {
+							av_image_copy_plane(destination[i], destinationStride[i], frame->data[i],
+												frame->linesize[i], destinationStride[i], this->planeHeight[i]);
 						}
+					} else {
+						this->sws_ctx = sws_getCachedContext(
+							this->sws_ctx, frame->width, frame->height, static_cast<AVPixelFormat>(frame->format),
+							this->video_width, this->video_height, this->planePixelFormat, SWS_BICUBIC, nullptr,
+							nullptr, nullptr);
+						if (this->sws_ctx == nullptr) {
+							this->getLogger().error("Failed to create the image conversion context");
+							this->decodedFrames.push({slot, std::numeric_limits<double>::quiet_NaN()});
+							av_frame_unref(frame);
+							continue;
+						}
+						sws_scale(this->sws_ctx, frame->data, frame->linesize, 0, frame->height, destination,
+								  destinationStride);
+					}
 
-						const int outputSamples =
-							swr_convert(this->swrContext, this->destBuffer, destBufferLinesize,
-										(const uint8_t **)frame->extended_data, frame->nb_samples);
+					const double pts = frame->best_effort_timestamp * av_q2d(this->video_st->time_base);
+					this->decodedFrames.push({slot, pts});
 
-						/*	*/
-						const size_t channels = 2;
-						const int bufferSize =
-							av_get_bytes_per_sample((AVSampleFormat)this->frame->format) * channels * outputSamples;
-						alFormat = AL_FORMAT_STEREO_FLOAT32;
+					av_frame_unref(frame);
+				}
 
-						ALint processed = 0, queued = 0, currentBuffer = 0;
-						FAOPAL_VALIDATE(alGetSourcei((ALuint)this->mSource, AL_BUFFERS_PROCESSED, &processed));
-						FAOPAL_VALIDATE(alGetSourcei((ALuint)this->mSource, AL_BUFFERS_QUEUED, &queued));
+				if (endOfStream) {
+					break;
+				}
+			}
 
-						while (processed > 0) {
-							ALuint bid = 0;
-							FAOPAL_VALIDATE(alSourceUnqueueBuffers(this->mSource, 1, &bid));
-							--processed;
-						}
+			av_frame_free(&frame);
+		}
 
-						if (static_cast<ALuint>(queued) < this->mAudioBuffers.size()) {
+		void decodeAudio() {
+			AVFrame *frame = av_frame_alloc();
 
-							this->getLogger().info("{} {} {}", bufferSize, frame->sample_rate, alFormat);
+			AVPacket *packet = nullptr;
+			while (this->popWait(this->audioPackets, packet)) {
 
-							const ALuint current_audio_buffer = {this->mAudioBuffers[this->bufferIndex]};
-							FAOPAL_VALIDATE(alBufferData(current_audio_buffer, alFormat, this->destBuffer[0],
-														 bufferSize, frame->sample_rate));
+				int result = avcodec_send_packet(this->pAudioCtx, packet);
+				const bool endOfStream = packet == nullptr;
+				av_packet_free(&packet);
+				if (result < 0) {
+					this->getLogger().error("Failed to send packet for decoding audio frame : {}",
+											error_message(result));
+					continue;
+				}
 
-							FAOPAL_VALIDATE(alSourceQueueBuffers(this->mSource, 1, &current_audio_buffer));
+				/*	*/
+				while (this->playing) {
+					result = avcodec_receive_frame(this->pAudioCtx, frame);
+					if (result == AVERROR(EAGAIN) || result == AVERROR_EOF) {
+						break;
+					}
+					if (result < 0) {
+						this->getLogger().error("Failed to recv audio frame {}", error_message(result));
+						break;
+					}
 
-							this->bufferIndex = (this->bufferIndex + 1) % this->mAudioBuffers.size();
+					const int outputSamples = swr_convert(this->swrContext, this->destBuffer, nrDestSamples,
+														  (const uint8_t **)frame->extended_data, frame->nb_samples);
 
-							/* Check that the source is playing. */
-							int state = 0;
-							FAOPAL_VALIDATE(alGetSourcei(this->mSource, AL_SOURCE_STATE, &state));
-							if (state == AL_STOPPED) {
-								alSourceRewind(this->mSource);
+					/*	*/
+					const size_t channels = 2;
+					const int bufferSize = av_get_bytes_per_sample(AV_SAMPLE_FMT_FLT) * channels * outputSamples;
+					const ALenum alFormat = AL_FORMAT_STEREO_FLOAT32;
 
-								FAOPAL_VALIDATE(alSourcePlay(this->mSource));
-							}
+					/*	Wait for a processed buffer, rather than dropping the samples.	*/
+					ALint processed = 0, queued = 0;
+					while (this->playing) {
+						FAOPAL_VALIDATE(alGetSourcei((ALuint)this->mSource, AL_BUFFERS_PROCESSED, &processed));
+						FAOPAL_VALIDATE(alGetSourcei((ALuint)this->mSource, AL_BUFFERS_QUEUED, &queued));
+						if (processed > 0 || static_cast<ALuint>(queued) < this->mAudioBuffers.size()) {
+							break;
 						}
+						std::this_thread::sleep_for(2ms);
+					}
 
-						/*	*/
-						ALint playStatus = 0;
-						FAOPAL_VALIDATE(alGetSourcei(this->mSource, AL_SOURCE_STATE, &playStatus));
-						if (playStatus != AL_PLAYING) {
-							FAOPAL_VALIDATE(alSourcePlay(this->mSource));
-						}
+					while (processed > 0) {
+						ALuint bid = 0;
+						FAOPAL_VALIDATE(alSourceUnqueueBuffers(this->mSource, 1, &bid));
+						--processed;
 					}
-				}
-			} else {
-				this->getLogger().debug("Failed to read package {}", error_message(res));
-			}
 
-			av_packet_unref(packet);
-			av_packet_free(&packet);
+					const ALuint current_audio_buffer = {this->mAudioBuffers[this->bufferIndex]};
+					FAOPAL_VALIDATE(alBufferData(current_audio_buffer, alFormat, this->destBuffer[0], bufferSize,
+												 frame->sample_rate));
+					FAOPAL_VALIDATE(alSourceQueueBuffers(this->mSource, 1, &current_audio_buffer));
 
-			// res = av_seek_frame(this->pformatCtx, -1, timestamp, AVSEEK_FLAG_ANY);
-			if (res < 0) {
-				this->getLogger().debug("Failed to seek {}", error_message(res));
-				return;
-			}
+					this->bufferIndex = (this->bufferIndex + 1) % this->mAudioBuffers.size();
 
-			/*	*/
-			this->listener->setVolume(this->videoplaybackSettingComponent->volume);
+					/* Check that the source is playing. */
+					ALint playStatus = 0;
+					FAOPAL_VALIDATE(alGetSourcei(this->mSource, AL_SOURCE_STATE, &playStatus));
+					if (playStatus != AL_PLAYING) {
+						FAOPAL_VALIDATE(alSourcePlay(this->mSource));
+					}
+
+					av_frame_unref(frame);
+				}
+
+				if (endOfStream) {
+					break;
+				}
+			}
 
-			std::this_thread::sleep_for(8ms);
+			av_frame_free(&frame);
 		}
 
 	}; // namespace glsample
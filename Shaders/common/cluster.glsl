@@ -0,0 +1,52 @@
+#ifndef _COMMON_CLUSTER_H_
+#define _COMMON_CLUSTER_H_ 1
+
+#include "light.glsl"
+
+/*	Clustered point lights, see ClusteredLights.	*/
+layout(set = 2, binding = 6, std140) uniform UniformClusterBufferBlock {
+	mat4 view;
+	mat4 inverseProj;
+	uvec4 gridSize; /*	Tiles, slices and number of lights.	*/
+	vec4 screen;	/*	Width, height, near and far.	*/
+	vec4 slice;		/*	Depth slice scale, bias, threshold and max lights per cluster.	*/
+}
+clusterUBO;
+
+layout(set = 2, binding = 7, std430) readonly buffer ClusterLightBuffer { PointLight lights[]; }
+ClusterLights;
+
+/*	Offset and number of light indices of each cluster.	*/
+layout(set = 2, binding = 8, std430) readonly buffer ClusterRangeBuffer { uvec2 ranges[]; }
+ClusterRanges;
+
+layout(set = 2, binding = 9, std430) readonly buffer ClusterIndexBuffer { uint indices[]; }
+ClusterIndices;
+
+uint getClusterSlice(const in float viewDepth) {
+	const float slice = floor(log(viewDepth) * clusterUBO.slice.x + clusterUBO.slice.y);
+	return uint(clamp(slice, 0.0, float(clusterUBO.gridSize.z - 1)));
+}
+
+/*	Cluster of the fragment, viewDepth is the positive distance along the view direction.	*/
+uint getClusterIndex(const in vec2 fragCoord, const in float viewDepth) {
+	const vec2 tileSize = clusterUBO.screen.xy / vec2(clusterUBO.gridSize.xy);
+	const uvec2 tile = min(uvec2(fragCoord / tileSize), clusterUBO.gridSize.xy - 1);
+
+	return (getClusterSlice(viewDepth) * clusterUBO.gridSize.y + tile.y) * clusterUBO.gridSize.x + tile.x;
+}
+
+/*	Sum of the point lights of the fragment cluster.	*/
+vec3 computeClusteredPointLights(const in vec2 fragCoord, const in vec3 worldPosition, const in vec3 normal) {
+	const float viewDepth = -(clusterUBO.view * vec4(worldPosition, 1.0)).z;
+	const uvec2 range = ClusterRanges.ranges[getClusterIndex(fragCoord, viewDepth)];
+
+	vec3 lightColor = vec3(0.0);
+	for (uint i = 0; i < range.y; i++) {
+		const PointLight light = ClusterLights.lights[ClusterIndices.indices[range.x + i]];
+		lightColor += computePoint(light, normal, worldPosition, 0.0, vec3(0.0)).rgb;
+	}
+	return lightColor;
+}
+
+#endif
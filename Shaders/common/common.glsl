@@ -128,6 +128,16 @@ vec2 inverse_equirectangular(const in vec3 direction) {
 	return uv;
 }
 
+/**
+ *	Direction from the octahedral encoding of the compact vertex layout.
+ */
+vec3 decodeOctahedral(const in vec2 oct) {
+	vec3 direction = vec3(oct.xy, 1.0 - abs(oct.x) - abs(oct.y));
+	const float t = max(-direction.z, 0.0);
+	direction.xy += vec2(direction.x >= 0.0 ? -t : t, direction.y >= 0.0 ? -t : t);
+	return normalize(direction);
+}
+
 /**
  *
  */
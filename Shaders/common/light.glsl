@@ -47,6 +47,25 @@ vec4 computePoint(const in PointLight light, const in vec3 normal, const in vec3
 	return vec4(pointLightColors.rgb, 1);
 }
 
+/*	Distance where the attenuated peak contribution falls below the threshold, see ClusteredLights.	*/
+float computeLightRadius(const in PointLight light, const in float threshold) {
+	const float peak = max(max(light.color.r, light.color.g), light.color.b) * light.range * light.intensity;
+	const float constant = light.constant_attenuation - peak / threshold;
+
+	if (constant >= 0.0) {
+		return 0.0;
+	}
+	if (light.qudratic_attenuation > 0.0) {
+		const float linear = light.linear_attenuation;
+		return (-linear + sqrt(linear * linear - 4.0 * light.qudratic_attenuation * constant)) /
+			   (2.0 * light.qudratic_attenuation);
+	}
+	if (light.linear_attenuation > 0.0) {
+		return -constant / light.linear_attenuation;
+	}
+	return uintBitsToFloat(0x7F800000u); /*	Infinity.	*/
+}
+
 // Shadow.
 
 float ShadowCalculation(const in sampler2DShadow ShadowTexture0, const in vec4 fragPosLightSpace, const in vec3 normal,
@@ -0,0 +1,9 @@
+#version 460
+#extension GL_ARB_separate_shader_objects : enable
+
+/*	Only the samples passed are counted, the color writes are disabled.	*/
+layout(early_fragment_tests) in;
+
+layout(location = 0) out vec4 fragColor;
+
+void main() { fragColor = vec4(1); }
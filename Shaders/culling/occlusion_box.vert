@@ -0,0 +1,20 @@
+#version 460
+#extension GL_ARB_separate_shader_objects : enable
+
+/*	World space bound of the box, one per instance.	*/
+layout(location = 0) in vec3 BoundMin;
+layout(location = 1) in vec3 BoundMax;
+
+layout(set = 0, binding = 7, std140) uniform UniformBufferBlock { mat4 viewProjection; }
+ubo;
+
+/*	Two triangles for each of the six faces.	*/
+const int BoxIndices[36] = {0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4,
+							2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5};
+
+void main() {
+	const int corner = BoxIndices[gl_VertexID];
+	const vec3 position = mix(BoundMin, BoundMax, vec3(corner & 1, (corner >> 1) & 1, (corner >> 2) & 1));
+
+	gl_Position = ubo.viewProjection * vec4(position, 1.0);
+}
@@ -0,0 +1,28 @@
+#version 460
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_include : enable
+#extension GL_GOOGLE_include_directive : enable
+
+layout(location = 0) out vec4 fragColor;
+
+layout(location = 1) in flat int InstanceID;
+
+layout(binding = 0) uniform sampler2D AlbedoTexture;
+layout(binding = 1) uniform sampler2D WorldTexture;
+layout(binding = 2) uniform sampler2D DepthTexture;
+
+#include "deferred_base.glsl"
+#include "cluster.glsl"
+
+void main() {
+
+	const vec2 uv = gl_FragCoord.xy / vec2(textureSize(AlbedoTexture, 0).xy);
+
+	const vec4 color = vec4(texture(AlbedoTexture, uv).rgb, 1);
+	const vec3 world = texture(WorldTexture, uv).xyz;
+	const vec3 normal = texture(NormalTexture, uv).xyz;
+
+	/*	Only the lights of the pixel cluster, instead of a light volume per light.	*/
+	fragColor = color * vec4(computeClusteredPointLights(gl_FragCoord.xy, world, normal), 1);
+	fragColor.a = 1;
+}
@@ -12,10 +12,8 @@ layout(binding = 1) uniform sampler2D WorldTexture;
 layout(binding = 2) uniform sampler2D DepthTexture;
 //layout(binding = 3) uniform sampler2D NormalTexture;
 
-#include"deferred_base.glsl"
-
-layout(set = 0, binding = 1, std140) uniform UniformBufferLight { PointLight point_light[64]; }
-pointlightUBO;
+#include "deferred_base.glsl"
+#include "cluster.glsl"
 
 vec2 CalcTexCoord(const in vec2 screenSize) { return gl_FragCoord.xy / screenSize; }
 
@@ -27,21 +25,8 @@ void main() {
 	const vec3 world = texture(WorldTexture, uv).xyz;
 	const vec3 normal = texture(NormalTexture, uv).xyz;
 
-	/*	*/
-	const vec3 diffVertex = (pointlightUBO.point_light[InstanceID].position - world.xyz);
-	const float dist = length(diffVertex);
-
-	/*	*/
-	const float attenuation = 1.0 / (pointlightUBO.point_light[InstanceID].constant_attenuation +
-									 pointlightUBO.point_light[InstanceID].linear_attenuation * dist +
-									 pointlightUBO.point_light[InstanceID].qudratic_attenuation * (dist * dist));
-
-	/*	*/
-	const float contribution = max(dot(normal, -normalize(diffVertex)), 0.0);
-
-	const vec4 pointLightColors = attenuation * pointlightUBO.point_light[InstanceID].color * contribution *
-								  pointlightUBO.point_light[InstanceID].range *
-								  pointlightUBO.point_light[InstanceID].intensity;
+	/*	Same light model as the clustered pass.	*/
+	const vec4 pointLightColors = computePoint(ClusterLights.lights[InstanceID], normal, world, 0.0, vec3(0.0));
 
 	fragColor = color * pointLightColors;
 	fragColor.a = 1;
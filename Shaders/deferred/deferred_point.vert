@@ -7,7 +7,7 @@ layout(location = 0) in vec3 Vertex;
 layout(location = 1) out flat int InstanceID;
 
 #include "deferred_base.glsl"
-#include "light.glsl"
+#include "cluster.glsl"
 
 layout(binding = 0, std140) uniform UniformBufferBlock {
 	mat4 model;
@@ -20,17 +20,16 @@ layout(binding = 0, std140) uniform UniformBufferBlock {
 }
 ubo;
 
-layout(set = 0, binding = 1, std140) uniform UniformBufferLight { PointLight point_light[64]; }
-pointlightUBO;
-
 void main() {
 
 	InstanceID = int(gl_InstanceID);
 
-	const float range = pointlightUBO.point_light[InstanceID].range;
-	const vec3 position = pointlightUBO.point_light[InstanceID].position;
+	/*	Volume of the light, where the attenuated light is above the cluster threshold.	*/
+	const PointLight light = ClusterLights.lights[InstanceID];
+	const float range = computeLightRadius(light, clusterUBO.slice.z);
+	const vec3 position = light.position;
 
-	/*	Construct model matrix from position and point light range.	*/
+	/*	Construct model matrix from position and point light radius.	*/
 	mat4 transform = mat4(1);
 	transform[3][0] = position.x;
 	transform[3][1] = position.y;
@@ -7,13 +7,11 @@ layout(location = 0) out vec4 fragColor;
 
 layout(location = 1) in flat int InstanceID;
 
-#include"deferred_base.glsl"
-
-layout(set = 0, binding = 1, std140) uniform UniformBufferLight { PointLight point_light[64]; }
-pointlightUBO;
+#include "deferred_base.glsl"
+#include "cluster.glsl"
 
 void main() {
 
-	fragColor = pointlightUBO.point_light[InstanceID].color;
+	fragColor = ClusterLights.lights[InstanceID].color;
 	fragColor.a = 1;
 }
@@ -0,0 +1,30 @@
+#version 460
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_include : enable
+#extension GL_GOOGLE_include_directive : enable
+
+layout(location = 0) in vec3 Vertex;
+layout(location = 1) in vec2 TextureCoord;
+layout(location = 2) in vec3 Normal;
+layout(location = 3) in vec3 Tangent;
+/*	*/
+layout(location = 8) in ivec2 vAssigns;
+
+layout(location = 0) out vec2 UV;
+layout(location = 1) out vec3 normal;
+layout(location = 8) flat out ivec2 fAssigns;
+
+#include "common.glsl"
+#include "scene.glsl"
+
+void main() {
+
+	const mat4 model = getModel(vAssigns.y);
+	const mat4 viewProj = getCamera().viewProj;
+
+	gl_Position = (viewProj * model) * vec4(Vertex, 1.0);
+	normal = (model * vec4(Normal, 0.0)).xyz;
+	UV = TextureCoord;
+
+	fAssigns = vAssigns;
+}
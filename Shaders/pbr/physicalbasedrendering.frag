@@ -13,6 +13,7 @@ layout(location = 8) flat in ivec2 fAssigns;
 
 #include "pbr.glsl"
 #include "pbr_common.glsl"
+#include "cluster.glsl"
 
 void main() {
 
@@ -35,8 +36,8 @@ void main() {
 	vec3 F0 = vec3(0.04);
 	F0 = mix(F0, albedo, metallic);
 
-	// TODO: add light
-	vec3 Lo = vec3(0.0);
+	/*	Diffuse contribution of the point lights of the fragment cluster.	*/
+	vec3 Lo = albedo * mat.diffuseColor.rgb * computeClusteredPointLights(gl_FragCoord.xy, WorldPos, N);
 
 	// ambient lighting (we now use IBL as the ambient term)
 	vec3 F = fresnelSchlickRoughness(max(dot(N, V), 0.0), F0, roughness);
@@ -22,7 +22,7 @@ layout(location = 8) flat invariant out ivec2 fAssigns;
 
 void main() {
 
-	const mat4 model = getModel();
+	const mat4 model = getModel(vAssigns.y);
 	const mat4 viewProj = getCamera().viewProj;
 
 	/*	*/
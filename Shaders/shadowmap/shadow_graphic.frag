@@ -13,10 +13,11 @@ layout(location = 0) in vec3 vertex;
 layout(location = 1) in vec2 UV;
 layout(location = 2) in vec3 normal;
 layout(location = 3) in vec3 tangent;
-layout(location = 4) in vec4 lightSpace;
 layout(location = 8) flat in ivec2 fAssigns;
 
-layout(binding = 9) uniform sampler2DShadow ShadowTexture;
+layout(binding = 9) uniform sampler2DArrayShadow ShadowTexture;
+
+#define MAX_CASCADES 8
 
 #include "common.glsl"
 #include "pbr.glsl"
@@ -24,34 +25,51 @@ layout(binding = 9) uniform sampler2DShadow ShadowTexture;
 #include "scene.glsl"
 
 layout(binding = 0, std140) uniform UniformBufferBlock {
-	mat4 lightSpaceMatrix;
+	mat4 lightSpaceMatrix[MAX_CASCADES];
+	/*	View depth of the far plane of each cascade.	*/
+	vec4 cascadeSplits[MAX_CASCADES / 4];
 
 	/*	Light source.	*/
 	DirectionalLight directional;
 	float bias;
 	float shadowStrength;
 	float radius;
+	int nrCascades;
+	int showCascades;
 }
 ubo;
 
-float ShadowCalculation(const in vec4 fragPosLightSpace) {
+/*	Cascade of the view depth, -1 beyond the last cascade.	*/
+int getCascadeIndex(const in float viewDepth) {
+	for (int i = 0; i < ubo.nrCascades; i++) {
+		if (viewDepth < ubo.cascadeSplits[i / 4][i % 4]) {
+			return i;
+		}
+	}
+	return -1;
+}
 
-	// perform perspective divide
-	vec4 projCoords = fragPosLightSpace.xyzw / fragPosLightSpace.w;
+vec3 getCascadeColor(const in int cascade) {
+	const vec3 colors[4] = vec3[](vec3(1.0, 0.4, 0.4), vec3(0.4, 1.0, 0.4), vec3(0.4, 0.4, 1.0), vec3(1.0, 1.0, 0.4));
+	return colors[cascade % 4];
+}
 
-	if (fragPosLightSpace.w > 1.0) {
-		return 1;
+float ShadowCalculation(const in int cascade) {
+	if (cascade < 0) {
+		return 0;
 	}
 
+	const vec4 fragPosLightSpace = ubo.lightSpaceMatrix[cascade] * vec4(vertex, 1.0);
+
 	/*	transform from NDC to Screen Space [0,1] range	*/
-	projCoords = projCoords * 0.5 + 0.5;
+	vec3 projCoords = (fragPosLightSpace.xyz / fragPosLightSpace.w) * 0.5 + 0.5;
 
 	const float bias =
 		clamp(0.005 * (1.0 - dot(normalize(normal), normalize(-ubo.directional.direction).xyz)), 0.0005, ubo.bias);
 	projCoords.z *= (1 - bias);
 
 	/*	*/
-	const float shadow = textureProj(ShadowTexture, projCoords, 0).r;
+	const float shadow = texture(ShadowTexture, vec4(projCoords.xy, cascade, projCoords.z));
 
 	return (1.0 - shadow);
 }
@@ -65,7 +83,9 @@ void main() {
 
 	const vec3 viewDir = normalize(getCamera().position.xyz - vertex);
 
-	const float shadow = max(1 - ShadowCalculation(lightSpace) * ubo.shadowStrength, 0);
+	const float viewDepth = -(getCamera().view * vec4(vertex, 1.0)).z;
+	const int cascade = getCascadeIndex(viewDepth);
+	const float shadow = max(1 - ShadowCalculation(cascade) * ubo.shadowStrength, 0);
 
 	/*	*/
 	const vec4 SpecularColor = vec4(mat.specular_roughness.rgb, 1) * texture(RoughnessTexture, UV).r;
@@ -84,6 +104,10 @@ void main() {
 	fragColor *= mat.transparency.rgba;
 	fragColor.rgb += mat.emission.rgb * texture(EmissionTexture, UV).rgb;
 
+	if (ubo.showCascades != 0 && cascade >= 0) {
+		fragColor.rgb *= getCascadeColor(cascade);
+	}
+
 	if (fragColor.a < mat.clip_.x) {
 		discard;
 	}
@@ -16,7 +16,6 @@ layout(location = 0) out vec3 vertex;
 layout(location = 1) out vec2 UV;
 layout(location = 2) out vec3 normal;
 layout(location = 3) out vec3 tangent;
-layout(location = 4) out vec4 lightSpace;
 /*	*/
 layout(location = 8) flat invariant out ivec2 fAssigns;
 
@@ -24,17 +23,6 @@ layout(location = 8) flat invariant out ivec2 fAssigns;
 #include "phongblinn.glsl"
 #include "scene.glsl"
 
-layout(binding = 0, std140) uniform UniformBufferBlock {
-	mat4 lightSpaceMatrix;
-
-	/*	Light source.	*/
-	DirectionalLight directional;
-	float bias;
-	float shadowStrength;
-	float radius;
-}
-ubo;
-
 void main() {
 	const mat4 model = getModel(vAssigns.y);
 	const mat4 viewProj = getCamera().viewProj;
@@ -43,7 +31,6 @@ void main() {
 	vertex = (model * vec4(Vertex, 1.0)).xyz;
 	normal = (model * vec4(Normal, 0.0)).xyz;
 	tangent = (model * vec4(Tangent, 0.0)).xyz;
-	lightSpace = ubo.lightSpaceMatrix * (model * vec4(Vertex, 1.0));
 	UV = TextureCoord;
 
 	/*	*/
@@ -19,7 +19,10 @@ layout(location = 3) in vec3 tangent;
 
 #include "phongblinn.glsl"
 
-layout(binding = 16) uniform samplerCube ShadowTexture[4];
+/*	Six faces of each point light.	*/
+layout(binding = 16) uniform samplerCubeArray ShadowTexture;
+
+#define MAX_POINT_LIGHTS 64
 
 struct point_light {
 	vec3 position;
@@ -37,12 +40,8 @@ struct point_light {
 };
 
 layout(binding = 0, std140) uniform UniformBufferBlock {
-	mat4 model;
 	mat4 view;
 	mat4 proj;
-	mat4 modelView;
-	mat4 ViewProjection[6];
-	mat4 modelViewProjection;
 
 	/*	Light source.	*/
 	vec4 direction;
@@ -50,18 +49,21 @@ layout(binding = 0, std140) uniform UniformBufferBlock {
 	vec4 ambientColor;
 	vec4 cameraPosition;
 
-	point_light point_light[4];
 	vec4 PCFFilters[20];
 	float diskRadius;
 	int samples;
+	int nrPointLights;
+	int padding;
+
+	point_light point_light[MAX_POINT_LIGHTS];
 }
 ubo;
 
-float ShadowCalculation(const in vec3 fragPosLightSpace, const in samplerCube ShadowTexture, const in uint index) {
+float ShadowCalculation(const in vec3 fragPosLightSpace, const in int index) {
 
 	const vec3 frag2Light = (fragPosLightSpace - ubo.point_light[index].position);
 
-	float closestDepth = texture(ShadowTexture, normalize(frag2Light)).r;
+	float closestDepth = texture(ShadowTexture, vec4(normalize(frag2Light), index)).r;
 	closestDepth *= ubo.point_light[index].range;
 
 	// float bias = ubo.point_light[0].bias;
@@ -85,7 +87,7 @@ void main() {
 
 	vec4 pointLightColors = vec4(0);
 
-	[[unroll]] for (uint i = 0; i < 4; i++) {
+	for (int i = 0; i < ubo.nrPointLights; i++) {
 		/*	*/
 		vec3 diffVertex = (ubo.point_light[i].position - vertex);
 
@@ -99,7 +101,7 @@ void main() {
 
 		float contribution = max(dot(normal, normalize(diffVertex)), 0.0);
 
-		float shadow = ShadowCalculation(vertex, ShadowTexture[i], i);
+		float shadow = ShadowCalculation(vertex, i);
 
 		/*	*/
 		pointLightColors += (attenuation * ubo.point_light[i].color * contribution * ubo.point_light[i].range *
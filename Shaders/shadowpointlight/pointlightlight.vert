@@ -2,17 +2,26 @@
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_explicit_attrib_location : enable
 #extension GL_ARB_uniform_buffer_object : enable
+#extension GL_ARB_shading_language_include : enable
+#extension GL_GOOGLE_include_directive : enable
 
 layout(location = 0) in vec3 Vertex;
 layout(location = 1) in vec2 TextureCoord;
 layout(location = 2) in vec3 Normal;
 layout(location = 3) in vec3 Tangent;
+/*	*/
+layout(location = 8) in ivec2 vAssigns;
 
 layout(location = 0) out vec3 vertex;
 layout(location = 1) out vec2 UV;
 layout(location = 2) out vec3 normal;
 layout(location = 3) out vec3 tangent;
 
+#include "common.glsl"
+#include "scene.glsl"
+
+#define MAX_POINT_LIGHTS 64
+
 struct point_light {
 	vec3 position;
 	float range;
@@ -29,12 +38,8 @@ struct point_light {
 };
 
 layout(binding = 0, std140) uniform UniformBufferBlock {
-	mat4 model;
 	mat4 view;
 	mat4 proj;
-	mat4 modelView;
-	mat4 ViewProjection[6];
-	mat4 modelViewProjection;
 
 	/*	Light source.	*/
 	vec4 direction;
@@ -42,17 +47,22 @@ layout(binding = 0, std140) uniform UniformBufferBlock {
 	vec4 ambientColor;
 	vec4 cameraPosition;
 
-	point_light point_light[4];
 	vec4 PCFFilters[20];
 	float diskRadius;
 	int samples;
+	int nrPointLights;
+	int padding;
+
+	point_light point_light[MAX_POINT_LIGHTS];
 }
 ubo;
 
 void main() {
-	gl_Position = ubo.modelViewProjection * vec4(Vertex, 1.0);
-	vertex = (ubo.model * vec4(Vertex, 1.0)).xyz;
-	normal = (ubo.model * vec4(Normal, 0.0)).xyz;
-	tangent = (ubo.model * vec4(Tangent, 0.0)).xyz;
+	const mat4 model = getModel(vAssigns.y);
+
+	gl_Position = ubo.proj * ubo.view * model * vec4(Vertex, 1.0);
+	vertex = (model * vec4(Vertex, 1.0)).xyz;
+	normal = (model * vec4(Normal, 0.0)).xyz;
+	tangent = (model * vec4(Tangent, 0.0)).xyz;
 	UV = TextureCoord;
 }
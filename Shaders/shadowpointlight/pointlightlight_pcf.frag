@@ -18,7 +18,10 @@ layout(location = 3) in vec3 tangent;
 
 #include "phongblinn.glsl"
 
-layout(binding = 16) uniform samplerCube ShadowTexture[4];
+/*	Six faces of each point light.	*/
+layout(binding = 16) uniform samplerCubeArray ShadowTexture;
+
+#define MAX_POINT_LIGHTS 64
 
 struct point_light {
 	vec3 position;
@@ -36,12 +39,8 @@ struct point_light {
 };
 
 layout(binding = 0, std140) uniform UniformBufferBlock {
-	mat4 model;
 	mat4 view;
 	mat4 proj;
-	mat4 modelView;
-	mat4 ViewProjection[6];
-	mat4 modelViewProjection;
 
 	/*	Light source.	*/
 	vec4 direction;
@@ -49,14 +48,17 @@ layout(binding = 0, std140) uniform UniformBufferBlock {
 	vec4 ambientColor;
 	vec4 cameraPosition;
 
-	point_light point_light[4];
 	vec4 PCFFilters[20];
 	float diskRadius;
 	int samples;
+	int nrPointLights;
+	int padding;
+
+	point_light point_light[MAX_POINT_LIGHTS];
 }
 ubo;
 
-float ShadowCalculation(const in vec3 fragPosLightSpace, const in samplerCube ShadowTexture, const in uint index) {
+float ShadowCalculation(const in vec3 fragPosLightSpace, const in int index) {
 
 	const vec3 frag2Light = (fragPosLightSpace - ubo.point_light[index].position);
 
@@ -66,7 +68,6 @@ float ShadowCalculation(const in vec3 fragPosLightSpace, const in samplerCube Sh
 	float currentDepth = length(frag2Light);
 
 	float shadowFactor = 0;
-	const ivec2 gMapSize = textureSize(ShadowTexture, 0);
 
 	/*	*/
 	if (currentDepth > ubo.point_light[index].range) {
@@ -80,8 +81,8 @@ float ShadowCalculation(const in vec3 fragPosLightSpace, const in samplerCube Sh
 
 	[[unroll]] for (uint i = 0; i < samples; i++) {
 		/*	*/
-		float closestDepth = texture(ShadowTexture, frag2Light + ubo.PCFFilters[i].xyz * diskRadius).r;
-		closestDepth *= far_plane; // undo mapping [0;1]
+		float closestDepth = texture(ShadowTexture, vec4(frag2Light + ubo.PCFFilters[i].xyz * diskRadius, index)).r;
+		closestDepth *= ubo.point_light[index].range; // undo mapping [0;1]
 
 		shadowFactor += currentDepth - bias > closestDepth ? 0.0 : 1.0;
 	}
@@ -96,7 +97,7 @@ void main() {
 
 	vec4 pointLightColors = vec4(0);
 
-	[[unroll]] for (uint i = 0; i < 4; i++) {
+	for (int i = 0; i < ubo.nrPointLights; i++) {
 		/*	*/
 		vec3 diffVertex = (ubo.point_light[i].position - vertex);
 
@@ -110,7 +111,7 @@ void main() {
 
 		float contribution = max(dot(normal, normalize(diffVertex)), 0.0);
 
-		float shadow = ShadowCalculation(vertex, ShadowTexture[i], i);
+		float shadow = ShadowCalculation(vertex, i);
 
 		/*	*/
 		pointLightColors += (attenuation * ubo.point_light[i].color * contribution * ubo.point_light[i].range *
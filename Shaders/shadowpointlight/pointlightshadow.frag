@@ -6,6 +6,8 @@
 layout(location = 0) in vec4 FragVertex;
 layout(location = 1) in flat int FIndex;
 
+#define MAX_POINT_LIGHTS 64
+
 struct point_light {
 	vec3 position;
 	float range;
@@ -21,12 +23,8 @@ struct point_light {
 };
 
 layout(binding = 0, std140) uniform UniformBufferBlock {
-	mat4 model;
 	mat4 view;
 	mat4 proj;
-	mat4 modelView;
-	mat4 ViewProjection[6];
-	mat4 modelViewProjection;
 
 	/*	Light source.	*/
 	vec4 direction;
@@ -34,10 +32,13 @@ layout(binding = 0, std140) uniform UniformBufferBlock {
 	vec4 ambientColor;
 	vec4 cameraPosition;
 
-	point_light point_light[4];
 	vec4 PCFFilters[20];
 	float diskRadius;
 	int samples;
+	int nrPointLights;
+	int padding;
+
+	point_light point_light[MAX_POINT_LIGHTS];
 }
 ubo;
 
@@ -2,14 +2,25 @@
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_explicit_attrib_location : enable
 #extension GL_ARB_uniform_buffer_object : enable
+#extension GL_ARB_shader_viewport_layer_array : require
+#extension GL_ARB_shading_language_include : enable
+#extension GL_GOOGLE_include_directive : enable
 
-layout(location = 0) in vec3 vertex;
+layout(location = 0) in vec3 Vertex;
 layout(location = 1) in vec2 TextureCoord;
+/*	*/
+layout(location = 8) in ivec2 vAssigns;
+/*	First layer of the node in the face layers, one instance per layer.	*/
+layout(location = 9) in int layerOffset;
 
-layout(location = 4) in int index;
+layout(location = 0) out vec4 FragVertex;
+layout(location = 1) out invariant flat int FIndex;
+layout(location = 2) out vec2 FragTextureCoord;
 
-layout(location = 0) out invariant flat int GIndex;
-layout(location = 1) out vec2 OutTextureCoord;
+#include "common.glsl"
+#include "scene.glsl"
+
+#define MAX_POINT_LIGHTS 64
 
 struct point_light {
 	vec3 position;
@@ -26,12 +37,8 @@ struct point_light {
 };
 
 layout(binding = 0, std140) uniform UniformBufferBlock {
-	mat4 model;
 	mat4 view;
 	mat4 proj;
-	mat4 modelView;
-	mat4 ViewProjection[6];
-	mat4 modelViewProjection;
 
 	/*	Light source.	*/
 	vec4 direction;
@@ -39,15 +46,30 @@ layout(binding = 0, std140) uniform UniformBufferBlock {
 	vec4 ambientColor;
 	vec4 cameraPosition;
 
-	point_light point_light[4];
 	vec4 PCFFilters[20];
 	float diskRadius;
 	int samples;
+	int nrPointLights;
+	int padding;
+
+	point_light point_light[MAX_POINT_LIGHTS];
 }
 ubo;
 
+/*	View projection of each cube face, indexed by the light index * 6 + face.	*/
+layout(binding = 10, std430) readonly buffer FaceViewProjectionBuffer { mat4 faceViewProjection[]; };
+
+/*	Cube faces each node is visible in, culled on the CPU.	*/
+layout(binding = 11, std430) readonly buffer FaceLayerBuffer { int faceLayers[]; };
+
 void main() {
-	gl_Position = ubo.model * vec4(vertex, 1.0);
-	GIndex = index;
-	OutTextureCoord = TextureCoord;
-}
\ No newline at end of file
+	const int layer = faceLayers[layerOffset + gl_InstanceID];
+	const vec4 worldVertex = getModel(vAssigns.y) * vec4(Vertex, 1.0);
+
+	gl_Position = faceViewProjection[layer] * worldVertex;
+	gl_Layer = layer;
+
+	FragVertex = worldVertex;
+	FIndex = layer / 6;
+	FragTextureCoord = TextureCoord;
+}
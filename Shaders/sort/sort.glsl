@@ -1,6 +1,38 @@
-layout(binding = 0) uniform UniformBufferBlock {
-    uint nrValues;
-	/*	*/
-	float deltaTime;
+#ifndef _COMMON_SORT_H_
+#define _COMMON_SORT_H_ 1
+
+/*	Radix digit of 4 bits, with 16 elements per thread in blocks of 4096 elements.	*/
+#define SORT_WORK_GROUP_SIZE 256
+#define RADIX_BITS 4
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define RADIX_ITEMS_PER_THREAD 16
+#define RADIX_BLOCK_SIZE (SORT_WORK_GROUP_SIZE * RADIX_ITEMS_PER_THREAD)
+
+/*	Exclusive scan of 4 elements per thread.	*/
+#define SCAN_ITEMS_PER_THREAD 4
+#define SCAN_BLOCK_SIZE (SORT_WORK_GROUP_SIZE * SCAN_ITEMS_PER_THREAD)
+
+/*	Bitonic sort of 2 elements per thread, in blocks of 1024 elements in shared memory.	*/
+#define BITONIC_WORK_GROUP_SIZE 512
+#define BITONIC_BLOCK_SIZE (BITONIC_WORK_GROUP_SIZE * 2)
+
+#define BITONIC_MODE_LOCAL_SORT 0
+#define BITONIC_MODE_GLOBAL_STEP 1
+#define BITONIC_MODE_LOCAL_MERGE 2
+
+/*	Parameters of a single sort pass.	*/
+layout(set = 0, binding = 8, std140) uniform UniformSortBufferBlock {
+	uint count;			  /*	Number of elements of the pass.	*/
+	uint hasValues;		  /*	Values are sorted along the keys.	*/
+	uint shift;			  /*	Radix digit shift.	*/
+	uint nrBlocks;		  /*	Radix blocks.	*/
+	uint sequenceSize;	  /*	Bitonic sequence size.	*/
+	uint compareDistance; /*	Bitonic compare distance.	*/
+	uint mode;			  /*	Bitonic mode.	*/
+	uint _pad;
 }
-ubo;
\ No newline at end of file
+ubo;
+
+uint getRadixDigit(const uint key) { return (key >> ubo.shift) & (RADIX_SIZE - 1); }
+
+#endif
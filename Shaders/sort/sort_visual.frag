@@ -0,0 +1,23 @@
+#version 460
+#extension GL_ARB_separate_shader_objects : enable
+
+precision highp float;
+precision highp int;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 0) in vec2 screenUV;
+
+layout(set = 0, binding = 0, std140) uniform UniformBufferBlock { uint count; }
+ubo;
+
+layout(set = 0, binding = 0, std430) readonly buffer SortKeys { uint keys[]; }
+sortKeys;
+
+/*	Keys as a bar graph, sorted keys result in a ramp.	*/
+void main() {
+	const uint index = min(uint(screenUV.x * float(ubo.count)), ubo.count - 1);
+	const float key = float(sortKeys.keys[index]) / 4294967295.0;
+
+	const float bar = step(screenUV.y, key);
+	fragColor = vec4(mix(vec3(0.05), vec3(screenUV.x, key, 1.0 - screenUV.x), bar), 1.0);
+}
@@ -0,0 +1,116 @@
+#include "BenchmarkRecorder.h"
+#include "IOUtil.h"
+#include <Exception.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fmt/core.h>
+#include <fstream>
+#include <numeric>
+
+namespace glsample {
+
+	BenchmarkRecorder::BenchmarkRecorder(const size_t warmupFrames, const size_t nrFrames)
+		: warmupFrames(warmupFrames), records(nrFrames) {}
+
+	BenchmarkRecorder::FrameRecord *BenchmarkRecorder::getRecord(const size_t frame) noexcept {
+		if (frame < this->warmupFrames || frame - this->warmupFrames >= this->records.size()) {
+			return nullptr;
+		}
+		return &this->records[frame - this->warmupFrames];
+	}
+
+	void BenchmarkRecorder::setInfo(const std::string &key, const std::string &value) {
+		this->info.emplace_back(key, value);
+	}
+
+	BenchmarkRecorder::Summary BenchmarkRecorder::computeSummary(std::vector<double> values) {
+		if (values.empty()) {
+			return {0, 0, 0, 0, 0};
+		}
+		std::sort(values.begin(), values.end());
+
+		/*	Nearest rank.	*/
+		auto percentile = [&values](const double p) {
+			const size_t rank = static_cast<size_t>(std::ceil(p * values.size()));
+			return values[std::min(std::max<size_t>(rank, 1), values.size()) - 1];
+		};
+
+		Summary summary{};
+		summary.mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+		summary.median = percentile(0.5);
+		summary.percentile95 = percentile(0.95);
+		summary.min = values.front();
+		summary.max = values.back();
+		return summary;
+	}
+
+	void BenchmarkRecorder::save(const std::string &path) const {
+		std::ofstream file(path, std::ios::trunc);
+		if (!file.is_open()) {
+			throw cxxexcept::RuntimeException("Failed to open benchmark output {}", path);
+		}
+
+		const bool csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+		if (csv) {
+			this->saveCSV(file);
+		} else {
+			this->saveJSON(file);
+		}
+	}
+
+	void BenchmarkRecorder::saveCSV(std::ostream &stream) const {
+		stream << "frame,cpu_ms,gpu_ms,samples,primitives,cs_invocations,fs_invocations,vs_invocations,"
+				  "gs_invocations\n";
+		for (size_t i = 0; i < this->records.size(); i++) {
+			const FrameRecord &record = this->records[i];
+			stream << fmt::format("{},{:.6f},{:.6f},{},{},{},{},{},{}\n", this->warmupFrames + i, record.cpuTime,
+								  record.gpuTime, record.samples, record.primitives, record.computeInvocations,
+								  record.fragmentInvocations, record.vertexInvocations, record.geometryInvocations);
+		}
+	}
+
+	void BenchmarkRecorder::saveJSON(std::ostream &stream) const {
+		std::vector<double> cpuTimes;
+		std::vector<double> gpuTimes;
+		for (const FrameRecord &record : this->records) {
+			cpuTimes.push_back(record.cpuTime);
+			if (record.hasGPU) {
+				gpuTimes.push_back(record.gpuTime);
+			}
+		}
+
+		auto writeSummary = [&stream](const char *name, const Summary &summary) {
+			stream << fmt::format("    \"{}\": {{\"mean\": {:.6f}, \"median\": {:.6f}, \"p95\": {:.6f}, "
+								  "\"min\": {:.6f}, \"max\": {:.6f}}}",
+								  name, summary.mean, summary.median, summary.percentile95, summary.min, summary.max);
+		};
+
+		stream << "{\n  \"info\": {";
+		for (size_t i = 0; i < this->info.size(); i++) {
+			stream << fmt::format("{}\n    \"{}\": \"{}\"", i > 0 ? "," : "", IOUtil::escapeJSON(this->info[i].first),
+								  IOUtil::escapeJSON(this->info[i].second));
+		}
+		stream << "\n  },\n";
+		stream << fmt::format("  \"warmup_frames\": {},\n  \"frames\": {},\n", this->warmupFrames,
+							  this->records.size());
+
+		stream << "  \"summary\": {\n";
+		writeSummary("cpu_ms", computeSummary(cpuTimes));
+		stream << ",\n";
+		writeSummary("gpu_ms", computeSummary(gpuTimes));
+		stream << "\n  },\n";
+
+		stream << "  \"frame_records\": [";
+		for (size_t i = 0; i < this->records.size(); i++) {
+			const FrameRecord &record = this->records[i];
+			stream << fmt::format("{}\n    {{\"frame\": {}, \"cpu_ms\": {:.6f}, \"gpu_ms\": {:.6f}, \"samples\": {}, "
+								  "\"primitives\": {}, \"cs_invocations\": {}, \"fs_invocations\": {}, "
+								  "\"vs_invocations\": {}, \"gs_invocations\": {}}}",
+								  i > 0 ? "," : "", this->warmupFrames + i, record.cpuTime, record.gpuTime,
+								  record.samples, record.primitives, record.computeInvocations,
+								  record.fragmentInvocations, record.vertexInvocations, record.geometryInvocations);
+		}
+		stream << "\n  ]\n}\n";
+	}
+
+} // namespace glsample
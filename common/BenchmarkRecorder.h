@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "FragDef.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace glsample {
+
+	/**
+	 * @brief Per frame CPU time, GPU time and pipeline statistics of a benchmark run.
+	 *
+	 * The first frames are warm-up frames and are not recorded. The GPU results arrive frames after the CPU
+	 * time, from the debug queries of the sample window. The results are saved as JSON, with a summary of
+	 * each time, or as CSV.
+	 */
+	class FVDECLSPEC BenchmarkRecorder {
+	  public:
+		using FrameRecord = struct frame_record_t {
+			double cpuTime = 0; /*	Milliseconds.	*/
+			double gpuTime = 0; /*	Milliseconds.	*/
+			uint64_t samples = 0;
+			uint64_t primitives = 0;
+			uint64_t computeInvocations = 0;
+			uint64_t fragmentInvocations = 0;
+			uint64_t vertexInvocations = 0;
+			uint64_t geometryInvocations = 0;
+			bool hasGPU = false;
+		};
+
+		using Summary = struct summary_t {
+			double mean;
+			double median;
+			double percentile95;
+			double min;
+			double max;
+		};
+
+		BenchmarkRecorder(const size_t warmupFrames, const size_t nrFrames);
+
+		/**
+		 * @brief Record of the frame, nullptr for warm-up frames.
+		 */
+		FrameRecord *getRecord(const size_t frame) noexcept;
+
+		/**
+		 * @brief Check if all recorded frames have been rendered.
+		 */
+		bool isFinished(const size_t nrRenderedFrames) const noexcept {
+			return nrRenderedFrames >= this->warmupFrames + this->records.size();
+		}
+
+		/**
+		 * @brief Additional information saved with the results, such as the renderer.
+		 */
+		void setInfo(const std::string &key, const std::string &value);
+
+		/**
+		 * @brief Save as CSV if the path ends with .csv, JSON otherwise.
+		 */
+		void save(const std::string &path) const;
+
+		static Summary computeSummary(std::vector<double> values);
+
+	  private:
+		void saveJSON(std::ostream &stream) const;
+		void saveCSV(std::ostream &stream) const;
+
+		size_t warmupFrames;
+		std::vector<FrameRecord> records;
+		std::vector<std::pair<std::string, std::string>> info;
+	};
+
+} // namespace glsample
@@ -0,0 +1,414 @@
+#include "ClusteredLights.h"
+#include "IOUtil.h"
+#include "Profiler.h"
+#include "Util/TaskParallel.h"
+#include <GL/glew.h>
+#include <ShaderLoader.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+using namespace fragcore;
+
+namespace glsample {
+
+	/*	Grow the storage buffer to at least the size, the content is not preserved.	*/
+	static void reserveStorageBuffer(unsigned int &buffer, size_t &capacity, const size_t size) {
+		if (buffer != 0 && size <= capacity) {
+			return;
+		}
+		if (buffer == 0) {
+			glGenBuffers(1, &buffer);
+		}
+
+		capacity = std::max<size_t>(std::max<size_t>(size, capacity + capacity / 2), 64);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, capacity, nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	ClusteredLights::~ClusteredLights() { this->release(); }
+
+	void ClusteredLights::init(fragcore::IFileSystem *filesystem) {
+
+		if (filesystem) {
+			/*	*/
+			const std::string computeAssignShaderPath = "Shaders/clustered/cluster_assign.comp.spv";
+
+			/*	Load shader binaries.	*/
+			const std::vector<uint32_t> assign_binary =
+				IOUtil::readFileData<uint32_t>(computeAssignShaderPath, filesystem);
+
+			/*	*/
+			fragcore::ShaderCompiler::CompilerConvertOption compilerOptions;
+			compilerOptions.target = fragcore::ShaderLanguage::GLSL;
+			compilerOptions.glslVersion = 460;
+
+			this->assign_program = ShaderLoader::loadComputeProgram(compilerOptions, &assign_binary);
+
+			/*	Setup compute pipeline.	*/
+			glUseProgram(this->assign_program);
+			const int uniform_buffer_index = glGetUniformBlockIndex(this->assign_program, "UniformClusterBufferBlock");
+			glUniformBlockBinding(this->assign_program, uniform_buffer_index, this->uniform_buffer_binding);
+
+			const std::pair<const char *, unsigned int> storageBlocks[] = {
+				{"ClusterLightBuffer", this->light_buffer_binding},
+				{"ClusterRangeBuffer", this->cluster_buffer_binding},
+				{"ClusterIndexBuffer", this->index_buffer_binding}};
+			for (const auto &block : storageBlocks) {
+				const unsigned int block_index =
+					glGetProgramResourceIndex(this->assign_program, GL_SHADER_STORAGE_BLOCK, block.first);
+				glShaderStorageBlockBinding(this->assign_program, block_index, block.second);
+			}
+			glUseProgram(0);
+		}
+
+		/*	Valid grid without lights until the first update, shaders may read the block before.	*/
+		this->uniformStage.view = glm::mat4(1.0f);
+		this->uniformStage.inverseProj = glm::mat4(1.0f);
+		this->uniformStage.gridSize = glm::uvec4(this->gridSize, 0);
+		this->uniformStage.screen = glm::vec4(1.0f, 1.0f, 0.1f, 1.0f);
+		this->uniformStage.slice = glm::vec4(0.0f, 0.0f, this->threshold, maxLightsPerCluster);
+
+		glGenBuffers(1, &this->uniform_buffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(UniformBlock), &this->uniformStage, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		/*	Empty clusters until the first update, shaders may read the buffers before.	*/
+		this->clearClusters();
+
+		reserveStorageBuffer(this->light_buffer, this->lightCapacity, sizeof(PointLightInstance));
+		reserveStorageBuffer(this->index_buffer, this->indexCapacity, sizeof(uint32_t));
+	}
+
+	void ClusteredLights::clearClusters() {
+		this->clusterRanges.assign(this->getNrClusters(), {0, 0});
+		reserveStorageBuffer(this->cluster_buffer, this->clusterCapacity,
+							 this->clusterRanges.size() * sizeof(ClusterRange));
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->cluster_buffer);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, this->clusterRanges.size() * sizeof(ClusterRange),
+						this->clusterRanges.data());
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	void ClusteredLights::release() {
+		if (this->assign_program > 0) {
+			glDeleteProgram(this->assign_program);
+			this->assign_program = 0;
+		}
+
+		/*	*/
+		for (unsigned int *buffer :
+			 {&this->uniform_buffer, &this->light_buffer, &this->cluster_buffer, &this->index_buffer}) {
+			if (*buffer) {
+				glDeleteBuffers(1, buffer);
+				*buffer = 0;
+			}
+		}
+		this->lightCapacity = 0;
+		this->clusterCapacity = 0;
+		this->indexCapacity = 0;
+	}
+
+	void ClusteredLights::setGridSize(const glm::uvec3 &size) {
+		this->gridSize = glm::max(size, glm::uvec3(1));
+		this->boundsProj = glm::mat4(0.0f);
+	}
+
+	void ClusteredLights::setThreshold(const float threshold) noexcept {
+		this->threshold = std::max(threshold, std::numeric_limits<float>::min());
+
+		for (size_t i = 0; i < this->lights.size(); i++) {
+			this->lightRadius[i] = ClusteredLights::computePointLightRadius(this->lights[i], this->threshold);
+		}
+	}
+
+	float ClusteredLights::computePointLightRadius(const PointLightInstance &light, const float threshold) noexcept {
+
+		/*	Solve peak / (constant + linear * d + quadratic * d^2) = threshold for the distance d.	*/
+		const float peak =
+			std::max(std::max(light.color.r, light.color.g), light.color.b) * light.range * light.intensity;
+		const float constant = light.constant_attenuation - peak / threshold;
+
+		/*	Below the threshold at the light position.	*/
+		if (constant >= 0) {
+			return 0;
+		}
+
+		if (light.quadratic_attenuation > 0) {
+			const float linear = light.linear_attenuation;
+			const float discriminant = linear * linear - 4.0f * light.quadratic_attenuation * constant;
+			return (-linear + std::sqrt(discriminant)) / (2.0f * light.quadratic_attenuation);
+		}
+		if (light.linear_attenuation > 0) {
+			return -constant / light.linear_attenuation;
+		}
+		return std::numeric_limits<float>::infinity();
+	}
+
+	void ClusteredLights::setPointLights(const PointLightInstance *lights, const size_t nrLights) {
+
+		this->lights.assign(lights, lights + nrLights);
+		this->lightRadius.resize(nrLights);
+		for (size_t i = 0; i < nrLights; i++) {
+			this->lightRadius[i] = ClusteredLights::computePointLightRadius(lights[i], this->threshold);
+		}
+
+		/*	Not updated without lights, the clusters of the previous lights are emptied once.	*/
+		if (nrLights == 0) {
+			this->clearClusters();
+			return;
+		}
+
+		reserveStorageBuffer(this->light_buffer, this->lightCapacity, nrLights * sizeof(PointLightInstance));
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->light_buffer);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, nrLights * sizeof(PointLightInstance), lights);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	unsigned int ClusteredLights::getSlice(const float depth) const noexcept {
+		const float slice = std::floor(std::log(depth) * this->uniformStage.slice.x + this->uniformStage.slice.y);
+		return static_cast<unsigned int>(std::clamp<float>(slice, 0, this->gridSize.z - 1));
+	}
+
+	void ClusteredLights::computeClusterBounds() {
+
+		const glm::mat4 inverseProj = glm::inverse(this->boundsProj);
+		const glm::vec3 tileSize = glm::vec3(2.0f / this->gridSize.x, 2.0f / this->gridSize.y, 0);
+
+		this->clusterMin.resize(this->getNrClusters());
+		this->clusterMax.resize(this->getNrClusters());
+
+		for (unsigned int z = 0; z < this->gridSize.z; z++) {
+			/*	Exponential slices, equal ratio between the far and near depth of each slice.	*/
+			const float ratio = this->boundsFar / this->boundsNear;
+			const float sliceNear = this->boundsNear * std::pow(ratio, z / (float)this->gridSize.z);
+			const float sliceFar = this->boundsNear * std::pow(ratio, (z + 1) / (float)this->gridSize.z);
+
+			for (unsigned int y = 0; y < this->gridSize.y; y++) {
+				for (unsigned int x = 0; x < this->gridSize.x; x++) {
+
+					/*	Rays through the tile corners on the near plane, scaled to the slice depths.	*/
+					const glm::vec3 ndcMin = glm::vec3(x * tileSize.x - 1.0f, y * tileSize.y - 1.0f, -1.0f);
+					const glm::vec3 ndcMax = ndcMin + glm::vec3(tileSize.x, tileSize.y, 0);
+
+					const glm::vec4 rayMin = inverseProj * glm::vec4(ndcMin, 1.0f);
+					const glm::vec4 rayMax = inverseProj * glm::vec4(ndcMax, 1.0f);
+					const glm::vec3 dirMin = glm::vec3(rayMin) / -rayMin.z;
+					const glm::vec3 dirMax = glm::vec3(rayMax) / -rayMax.z;
+
+					const glm::vec3 points[4] = {dirMin * sliceNear, dirMin * sliceFar, dirMax * sliceNear,
+												 dirMax * sliceFar};
+
+					glm::vec3 min = points[0];
+					glm::vec3 max = points[0];
+					for (const glm::vec3 &point : points) {
+						min = glm::min(min, point);
+						max = glm::max(max, point);
+					}
+
+					const size_t cluster = (z * this->gridSize.y + y) * this->gridSize.x + x;
+					this->clusterMin[cluster] = min;
+					this->clusterMax[cluster] = max;
+				}
+			}
+		}
+	}
+
+	void ClusteredLights::assignSlice(const unsigned int slice) {
+
+		const std::vector<uint32_t> &candidates = this->sliceLights[slice];
+		std::vector<uint32_t> &indices = this->sliceIndices[slice];
+		indices.clear();
+
+		/*	Candidate spheres as a structure of arrays.	*/
+		const size_t nrCandidates = candidates.size();
+		std::vector<float> sphereX(nrCandidates), sphereY(nrCandidates), sphereZ(nrCandidates),
+			sphereRadius(nrCandidates);
+		for (size_t i = 0; i < nrCandidates; i++) {
+			const glm::vec4 &sphere = this->viewSpheres[candidates[i]];
+			sphereX[i] = sphere.x;
+			sphereY[i] = sphere.y;
+			sphereZ[i] = sphere.z;
+			sphereRadius[i] = sphere.w * sphere.w;
+		}
+
+		const size_t sliceOffset = static_cast<size_t>(slice) * this->gridSize.x * this->gridSize.y;
+		for (size_t tile = 0; tile < static_cast<size_t>(this->gridSize.x) * this->gridSize.y; tile++) {
+			const size_t cluster = sliceOffset + tile;
+			const glm::vec3 &min = this->clusterMin[cluster];
+			const glm::vec3 &max = this->clusterMax[cluster];
+
+			const size_t begin = indices.size();
+			size_t i = 0;
+
+#if defined(__AVX__)
+			/*	Squared distance from the sphere center to the box, eight spheres at a time.	*/
+			const __m256 minx = _mm256_set1_ps(min.x), miny = _mm256_set1_ps(min.y), minz = _mm256_set1_ps(min.z);
+			const __m256 maxx = _mm256_set1_ps(max.x), maxy = _mm256_set1_ps(max.y), maxz = _mm256_set1_ps(max.z);
+			const __m256 zero = _mm256_setzero_ps();
+
+			for (; i + 8 <= nrCandidates; i += 8) {
+				const __m256 cx = _mm256_loadu_ps(&sphereX[i]);
+				const __m256 cy = _mm256_loadu_ps(&sphereY[i]);
+				const __m256 cz = _mm256_loadu_ps(&sphereZ[i]);
+
+				const __m256 dx = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(minx, cx), _mm256_sub_ps(cx, maxx)), zero);
+				const __m256 dy = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(miny, cy), _mm256_sub_ps(cy, maxy)), zero);
+				const __m256 dz = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(minz, cz), _mm256_sub_ps(cz, maxz)), zero);
+
+				__m256 distance = _mm256_mul_ps(dx, dx);
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(dy, dy));
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(dz, dz));
+
+				unsigned int mask = static_cast<unsigned int>(
+					_mm256_movemask_ps(_mm256_cmp_ps(distance, _mm256_loadu_ps(&sphereRadius[i]), _CMP_LE_OQ)));
+				while (mask) {
+					const unsigned int lane = __builtin_ctz(mask);
+					indices.push_back(candidates[i + lane]);
+					mask &= mask - 1;
+				}
+			}
+#endif
+			for (; i < nrCandidates; i++) {
+				const float dx = std::max(std::max(min.x - sphereX[i], sphereX[i] - max.x), 0.0f);
+				const float dy = std::max(std::max(min.y - sphereY[i], sphereY[i] - max.y), 0.0f);
+				const float dz = std::max(std::max(min.z - sphereZ[i], sphereZ[i] - max.z), 0.0f);
+				if (dx * dx + dy * dy + dz * dz <= sphereRadius[i]) {
+					indices.push_back(candidates[i]);
+				}
+			}
+
+			/*	Same limit as the compute path.	*/
+			const size_t count = std::min<size_t>(indices.size() - begin, maxLightsPerCluster);
+			indices.resize(begin + count);
+			this->clusterRanges[cluster] = {static_cast<uint32_t>(begin), static_cast<uint32_t>(count)};
+		}
+	}
+
+	void ClusteredLights::assignLights() {
+
+		const glm::mat4 &view = this->uniformStage.view;
+		const float near = this->uniformStage.screen.z;
+		const float far = this->uniformStage.screen.w;
+
+		this->sliceLights.resize(this->gridSize.z);
+		this->sliceIndices.resize(this->gridSize.z);
+		for (std::vector<uint32_t> &candidates : this->sliceLights) {
+			candidates.clear();
+		}
+
+		/*	Candidates of each slice, from the depth range of the light sphere.	*/
+		this->viewSpheres.resize(this->lights.size());
+		for (size_t i = 0; i < this->lights.size(); i++) {
+			const float radius = this->lightRadius[i];
+			const glm::vec3 position = glm::vec3(view * glm::vec4(this->lights[i].position, 1.0f));
+			this->viewSpheres[i] = glm::vec4(position, radius);
+
+			const float depth = -position.z;
+			if (radius <= 0 || depth + radius < near || depth - radius > far) {
+				continue;
+			}
+
+			const unsigned int first = this->getSlice(std::max(depth - radius, near));
+			const unsigned int last = this->getSlice(std::min(depth + radius, far));
+			for (unsigned int slice = first; slice <= last; slice++) {
+				this->sliceLights[slice].push_back(static_cast<uint32_t>(i));
+			}
+		}
+
+		/*	Each slice is independent, assigned on the task scheduler workers.	*/
+		this->clusterRanges.resize(this->getNrClusters());
+		parallelFor(this->gridSize.z, 1, [&](const size_t begin, const size_t end) {
+			for (size_t slice = begin; slice < end; slice++) {
+				this->assignSlice(static_cast<unsigned int>(slice));
+			}
+		});
+
+		/*	Concatenate the slices, offsets made relative to the whole index list.	*/
+		this->lightIndices.clear();
+		const size_t nrTiles = static_cast<size_t>(this->gridSize.x) * this->gridSize.y;
+		for (unsigned int slice = 0; slice < this->gridSize.z; slice++) {
+			const uint32_t offset = static_cast<uint32_t>(this->lightIndices.size());
+			for (size_t tile = 0; tile < nrTiles; tile++) {
+				this->clusterRanges[slice * nrTiles + tile].offset += offset;
+			}
+			this->lightIndices.insert(this->lightIndices.end(), this->sliceIndices[slice].begin(),
+									  this->sliceIndices[slice].end());
+		}
+	}
+
+	void ClusteredLights::update(const glm::mat4 &view, const glm::mat4 &proj, const float near, const float far,
+								 const unsigned int width, const unsigned int height) {
+
+		/*	Slice of a depth, log(depth) * scale + bias.	*/
+		const float sliceScale = this->gridSize.z / std::log(far / near);
+		const float sliceBias = -std::log(near) * sliceScale;
+
+		this->uniformStage.view = view;
+		this->uniformStage.inverseProj = glm::inverse(proj);
+		this->uniformStage.gridSize = glm::uvec4(this->gridSize, static_cast<unsigned int>(this->lights.size()));
+		this->uniformStage.screen = glm::vec4(width, height, near, far);
+		this->uniformStage.slice = glm::vec4(sliceScale, sliceBias, this->threshold, maxLightsPerCluster);
+
+		glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(this->uniformStage), &this->uniformStage);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		const size_t nrClusters = this->getNrClusters();
+		reserveStorageBuffer(this->cluster_buffer, this->clusterCapacity, nrClusters * sizeof(ClusterRange));
+
+		if (this->isUsingCompute()) {
+			/*	Fixed range of maxLightsPerCluster indices per cluster.	*/
+			reserveStorageBuffer(this->index_buffer, this->indexCapacity,
+								 nrClusters * maxLightsPerCluster * sizeof(uint32_t));
+
+			Profiler::pushScope("Cluster Light Assignment");
+
+			glUseProgram(this->assign_program);
+			this->bind();
+			glDispatchCompute(std::ceil(nrClusters / (float)this->localWorkGroupSize), 1, 1);
+			glUseProgram(0);
+
+			/*	Consumed by the shading.	*/
+			glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+			Profiler::popScope();
+			return;
+		}
+
+		if (proj != this->boundsProj || near != this->boundsNear || far != this->boundsFar) {
+			this->boundsProj = proj;
+			this->boundsNear = near;
+			this->boundsFar = far;
+			this->computeClusterBounds();
+		}
+
+		this->assignLights();
+
+		/*	*/
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->cluster_buffer);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, nrClusters * sizeof(ClusterRange), this->clusterRanges.data());
+
+		if (!this->lightIndices.empty()) {
+			reserveStorageBuffer(this->index_buffer, this->indexCapacity, this->lightIndices.size() * sizeof(uint32_t));
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->index_buffer);
+			glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, this->lightIndices.size() * sizeof(uint32_t),
+							this->lightIndices.data());
+		}
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	void ClusteredLights::bind() const {
+		glBindBufferBase(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->light_buffer_binding, this->light_buffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->cluster_buffer_binding, this->cluster_buffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->index_buffer_binding, this->index_buffer);
+	}
+
+} // namespace glsample
@@ -0,0 +1,161 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "FragDef.h"
+#include "GLSampleSession.h"
+#include "SampleHelper.h"
+#include <IO/FileSystem.h>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace glsample {
+
+	/**
+	 * @brief Clustered light assignment, point lights binned into a grid of view space froxels.
+	 *
+	 * The view frustum is split into screen tiles and exponential depth slices. Each cluster references the
+	 * lights whose range intersects it, so the shading cost of a pixel follows the number of lights near it
+	 * rather than the total number of lights. The lights are assigned on the CPU over multiple threads, or by
+	 * a compute shader. See Shaders/common/cluster.glsl for the shading side.
+	 */
+	class FVDECLSPEC ClusteredLights {
+	  public:
+		static const unsigned int maxLightsPerCluster = 256;
+
+		/*	Light index range of a cluster, matches the shader.	*/
+		using ClusterRange = struct cluster_range_t {
+			uint32_t offset;
+			uint32_t count;
+		};
+
+		ClusteredLights() = default;
+		ClusteredLights(const ClusteredLights &) = delete;
+		ClusteredLights &operator=(const ClusteredLights &) = delete;
+		virtual ~ClusteredLights();
+
+		/**
+		 * @brief Create the buffers, and load the assignment compute program.
+		 *
+		 * @param filesystem nullptr to only support the CPU assignment.
+		 */
+		void init(fragcore::IFileSystem *filesystem);
+
+		void release();
+
+		/**
+		 * @brief Number of tiles along the screen width, height and depth slices.
+		 */
+		void setGridSize(const glm::uvec3 &size);
+		const glm::uvec3 &getGridSize() const noexcept { return this->gridSize; }
+
+		/**
+		 * @brief Light contribution below the threshold is ignored, it determines the radius of each light.
+		 */
+		void setThreshold(const float threshold) noexcept;
+		float getThreshold() const noexcept { return this->threshold; }
+
+		void setUseCompute(const bool enable) noexcept { this->useCompute = enable; }
+		bool isUsingCompute() const noexcept { return this->useCompute && this->assign_program > 0; }
+
+		/**
+		 * @brief Upload the point lights, required each time the lights are changed.
+		 */
+		void setPointLights(const PointLightInstance *lights, const size_t nrLights);
+
+		/**
+		 * @brief Assign the lights to the clusters of the view.
+		 *
+		 * @param width size of the viewport the clusters are tiled over.
+		 */
+		void update(const glm::mat4 &view, const glm::mat4 &proj, const float near, const float far,
+					const unsigned int width, const unsigned int height);
+
+		/**
+		 * @brief Bind the cluster uniform and storage buffers.
+		 */
+		void bind() const;
+
+		/**
+		 * @brief Distance where the attenuated light falls below the threshold, the same as
+		 * computeLightRadius in light.glsl. Infinite if the light is never attenuated below it.
+		 */
+		static float computePointLightRadius(const PointLightInstance &light, const float threshold) noexcept;
+
+		size_t getNrLights() const noexcept { return this->lights.size(); }
+		size_t getNrClusters() const noexcept { return this->gridSize.x * this->gridSize.y * this->gridSize.z; }
+		size_t getNrLightIndices() const noexcept { return this->lightIndices.size(); }
+		unsigned int getLightBuffer() const noexcept { return this->light_buffer; }
+
+	  private:
+		void clearClusters();
+		void computeClusterBounds();
+		void assignLights();
+		void assignSlice(const unsigned int slice);
+		unsigned int getSlice(const float depth) const noexcept;
+
+		using UniformBlock = struct alignas(16) uniform_block_t {
+			glm::mat4 view;
+			glm::mat4 inverseProj;
+			glm::uvec4 gridSize; /*	Tiles, slices and number of lights.	*/
+			glm::vec4 screen;	 /*	Width, height, near and far.	*/
+			glm::vec4 slice;	 /*	Depth slice scale, bias, threshold and max lights per cluster.	*/
+		};
+
+		UniformBlock uniformStage{};
+
+		glm::uvec3 gridSize = glm::uvec3(16, 9, 24);
+		float threshold = 1.0f / 256.0f;
+		bool useCompute = false;
+
+		/*	Projection the cluster bounds were computed with.	*/
+		glm::mat4 boundsProj = glm::mat4(0.0f);
+		float boundsNear = 0;
+		float boundsFar = 0;
+
+		std::vector<PointLightInstance> lights;
+		std::vector<float> lightRadius;
+
+		/*	View space spheres, and the candidate lights of each depth slice.	*/
+		std::vector<glm::vec4> viewSpheres;
+		std::vector<std::vector<uint32_t>> sliceLights;
+		std::vector<std::vector<uint32_t>> sliceIndices;
+
+		/*	View space bounds of each cluster, x varies fastest, then y and the slice.	*/
+		std::vector<glm::vec3> clusterMin;
+		std::vector<glm::vec3> clusterMax;
+		std::vector<ClusterRange> clusterRanges;
+		std::vector<uint32_t> lightIndices;
+
+		int assign_program = 0;
+		unsigned int uniform_buffer = 0;
+		unsigned int light_buffer = 0;
+		unsigned int cluster_buffer = 0;
+		unsigned int index_buffer = 0;
+		size_t lightCapacity = 0;
+		size_t clusterCapacity = 0;
+		size_t indexCapacity = 0;
+
+		const unsigned int localWorkGroupSize = 64;
+
+		/*	Not shared with the scene bindings.	*/
+		unsigned int uniform_buffer_binding = 6;
+		unsigned int light_buffer_binding = 7;
+		unsigned int cluster_buffer_binding = 8;
+		unsigned int index_buffer_binding = 9;
+	};
+
+} // namespace glsample
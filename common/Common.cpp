@@ -312,20 +312,3 @@ void Common::updateFrameBuffer(FrameBuffer *framebuffer, const std::initializer_
 	}
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
-
-void glsample::refreshWholeRoundRobinBuffer(unsigned int bufferType, unsigned int buffer, const unsigned int robin,
-											const void *data, const size_t alignSize, const size_t bufferSize,
-											const size_t offset) {
-
-	/*	Bind buffer and update region with new data.	*/
-	glBindBuffer(bufferType, buffer);
-
-	uint8_t *mappedData = (uint8_t *)glMapBufferRange(bufferType, offset, alignSize * robin,
-													  GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-
-	for (size_t i = 0; i < robin; i++) {
-		memcpy(&mappedData[i * alignSize], data, bufferSize);
-	}
-
-	glUnmapBuffer(bufferType);
-}
\ No newline at end of file
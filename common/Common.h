@@ -51,14 +51,4 @@ namespace glsample {
 									  const fragcore::TextureDesc &depthstencil);
 	};
 
-	extern void refreshWholeRoundRobinBuffer(unsigned int bufferType, unsigned int buffer, const unsigned int robin,
-											 const void *data, const size_t alignSize, const size_t bufferSize,
-											 const size_t offset = 0);
-	template <typename T>
-	void refreshWholeRoundRobinBuffer(unsigned int bufferType, unsigned int buffer, const unsigned int robin,
-									  const T *data, const size_t alignSize, const size_t bufferSize = sizeof(T),
-									  const size_t offset = 0) {
-		refreshWholeRoundRobinBuffer(bufferType, buffer, robin, (const void *)data, alignSize, bufferSize, offset);
-	}
-
 } // namespace glsample
\ No newline at end of file
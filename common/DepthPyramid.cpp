@@ -0,0 +1,179 @@
+#include "DepthPyramid.h"
+#include "Common.h"
+#include "IOUtil.h"
+#include "Profiler.h"
+#include <GL/glew.h>
+#include <ShaderLoader.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace fragcore;
+
+namespace glsample {
+
+	DepthPyramid::~DepthPyramid() { this->release(); }
+
+	void DepthPyramid::init(fragcore::IFileSystem *filesystem) {
+
+		/*	*/
+		const std::string computeReduceShaderPath = "Shaders/culling/depth_pyramid.comp.spv";
+
+		/*	Load shader binaries.	*/
+		const std::vector<uint32_t> reduce_binary = IOUtil::readFileData<uint32_t>(computeReduceShaderPath, filesystem);
+
+		/*	*/
+		fragcore::ShaderCompiler::CompilerConvertOption compilerOptions;
+		compilerOptions.target = fragcore::ShaderLanguage::GLSL;
+		compilerOptions.glslVersion = 460;
+
+		this->reduce_program = ShaderLoader::loadComputeProgram(compilerOptions, &reduce_binary);
+
+		/*	Setup compute pipeline.	*/
+		glUseProgram(this->reduce_program);
+		const int uniform_buffer_index = glGetUniformBlockIndex(this->reduce_program, "UniformBufferBlock");
+		glUniformBlockBinding(this->reduce_program, uniform_buffer_index, this->uniform_buffer_binding);
+		glUniform1i(glGetUniformLocation(this->reduce_program, "DepthTexture"), this->depth_texture_binding);
+		glUniform1i(glGetUniformLocation(this->reduce_program, "SourceLevel"), this->source_image_binding);
+		glUniform1i(glGetUniformLocation(this->reduce_program, "DestinationLevel"), this->destination_image_binding);
+		glUseProgram(0);
+
+		/*	Raw depth values, independent of the compare mode of the depth texture.	*/
+		glCreateSamplers(1, &this->depth_sampler);
+		glSamplerParameteri(this->depth_sampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glSamplerParameteri(this->depth_sampler, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glSamplerParameteri(this->depth_sampler, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glSamplerParameteri(this->depth_sampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glSamplerParameteri(this->depth_sampler, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+
+		/*	Align uniform buffer in respect to driver requirement.	*/
+		GLint minMapBufferSize = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
+		this->uniformAlignSize = Math::align<size_t>(this->uniformAlignSize, (size_t)minMapBufferSize);
+	}
+
+	void DepthPyramid::release() {
+		if (this->reduce_program > 0) {
+			glDeleteProgram(this->reduce_program);
+			this->reduce_program = 0;
+		}
+		if (this->depth_sampler) {
+			glDeleteSamplers(1, &this->depth_sampler);
+			this->depth_sampler = 0;
+		}
+		if (this->pyramid_texture) {
+			glDeleteTextures(1, &this->pyramid_texture);
+			this->pyramid_texture = 0;
+		}
+		if (this->uniform_buffer) {
+			glDeleteBuffers(1, &this->uniform_buffer);
+			this->uniform_buffer = 0;
+		}
+		this->width = 0;
+		this->height = 0;
+		this->nrLevels = 0;
+	}
+
+	void DepthPyramid::resize(const unsigned int width, const unsigned int height) {
+
+		if (this->pyramid_texture) {
+			glDeleteTextures(1, &this->pyramid_texture);
+			this->pyramid_texture = 0;
+		}
+		if (this->uniform_buffer) {
+			glDeleteBuffers(1, &this->uniform_buffer);
+			this->uniform_buffer = 0;
+		}
+
+		this->width = width;
+		this->height = height;
+		this->nrLevels = static_cast<unsigned int>(std::ceil(std::log2(std::max(width, height)))) + 1;
+
+		/*	Levels are ceil sized, each texel covers exactly 2x2 texels of the previous level. The storage is
+		 *	padded to a power of two, where the mip chain sizes are equal to the ceil sizes or larger.	*/
+		const unsigned int storageWidth = 1u << static_cast<unsigned int>(std::ceil(std::log2(width)));
+		const unsigned int storageHeight = 1u << static_cast<unsigned int>(std::ceil(std::log2(height)));
+
+		/*	Immutable storage, each level is bound as an image.	*/
+		glGenTextures(1, &this->pyramid_texture);
+		glBindTexture(GL_TEXTURE_2D, this->pyramid_texture);
+		glTexStorage2D(GL_TEXTURE_2D, this->nrLevels, GL_R32F, storageWidth, storageHeight);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		/*	The level sizes only change with the pyramid, uploaded once.	*/
+		std::vector<uint8_t> uniforms(this->uniformAlignSize * this->nrLevels);
+		glm::ivec2 sourceSize = glm::ivec2(width, height);
+		for (unsigned int level = 0; level < this->nrLevels; level++) {
+			const glm::ivec2 destinationSize = level == 0 ? sourceSize : (sourceSize + 1) / 2;
+
+			UniformBlock *block = reinterpret_cast<UniformBlock *>(&uniforms[level * this->uniformAlignSize]);
+			block->sourceSize = sourceSize;
+			block->destinationSize = destinationSize;
+			block->level = level;
+
+			sourceSize = destinationSize;
+		}
+
+		glGenBuffers(1, &this->uniform_buffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
+		glBufferStorage(GL_UNIFORM_BUFFER, uniforms.size(), uniforms.data(), 0);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	void DepthPyramid::build(const unsigned int depthTexture, const unsigned int width, const unsigned int height,
+							 const glm::mat4 &viewProjection) {
+		if (this->reduce_program <= 0 || width == 0 || height == 0) {
+			return;
+		}
+
+		if (width != this->width || height != this->height) {
+			this->resize(width, height);
+		}
+		this->viewProjection = viewProjection;
+
+		Profiler::pushScope("Depth Pyramid");
+
+		glUseProgram(this->reduce_program);
+
+		glActiveTexture(GL_TEXTURE0 + this->depth_texture_binding);
+		glBindTexture(GL_TEXTURE_2D, depthTexture);
+		glBindSampler(this->depth_texture_binding, this->depth_sampler);
+
+		unsigned int levelWidth = width;
+		unsigned int levelHeight = height;
+		for (unsigned int level = 0; level < this->nrLevels; level++) {
+			if (level > 0) {
+				levelWidth = (levelWidth + 1) / 2;
+				levelHeight = (levelHeight + 1) / 2;
+
+				/*	Reduce the previous level.	*/
+				glBindImageTexture(this->source_image_binding, this->pyramid_texture, level - 1, GL_FALSE, 0,
+								   GL_READ_ONLY, GL_R32F);
+			}
+			glBindImageTexture(this->destination_image_binding, this->pyramid_texture, level, GL_FALSE, 0,
+							   GL_WRITE_ONLY, GL_R32F);
+
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
+							  level * this->uniformAlignSize, this->uniformAlignSize);
+
+			glDispatchCompute(std::ceil(levelWidth / (float)this->localWorkGroupSize[0]),
+							  std::ceil(levelHeight / (float)this->localWorkGroupSize[1]), 1);
+
+			/*	Previous level written before the next level is reduced.	*/
+			glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+		}
+
+		/*	Sampled by the culling.	*/
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+		glBindSampler(this->depth_texture_binding, 0);
+		glUseProgram(0);
+
+		Profiler::popScope();
+	}
+
+} // namespace glsample
@@ -0,0 +1,94 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "FragDef.h"
+#include "GLSampleSession.h"
+#include <IO/FileSystem.h>
+#include <glm/glm.hpp>
+
+namespace glsample {
+
+	/**
+	 * @brief Hierarchical depth buffer, built from a depth texture by a compute reduction.
+	 *
+	 * Level 0 is a copy of the depth texture, each following level stores the farthest depth of the texels
+	 * it covers in the previous level. The levels are ceil sized, texel (x, y) of level n covers the level 0
+	 * texels (x << n, y << n) to ((x + 1) << n) - 1, clamped to the size of the depth texture. A bound whose
+	 * nearest depth is farther than the pyramid texels it covers is hidden behind the geometry of the depth
+	 * texture.
+	 */
+	class FVDECLSPEC DepthPyramid {
+	  public:
+		DepthPyramid() = default;
+		DepthPyramid(const DepthPyramid &) = delete;
+		DepthPyramid &operator=(const DepthPyramid &) = delete;
+		virtual ~DepthPyramid();
+
+		/**
+		 * @brief Load the reduction compute program.
+		 */
+		void init(fragcore::IFileSystem *filesystem);
+
+		void release();
+
+		/**
+		 * @brief Build all levels of the pyramid, the pyramid is recreated if the size has changed.
+		 *
+		 * @param depthTexture depth attachment of the framebuffer, sampled without compare mode.
+		 * @param viewProjection view projection the depth texture was rendered with.
+		 */
+		void build(const unsigned int depthTexture, const unsigned int width, const unsigned int height,
+				   const glm::mat4 &viewProjection);
+
+		unsigned int getTexture() const noexcept { return this->pyramid_texture; }
+		/*	Size of level 0, the storage of the texture is padded to a power of two.	*/
+		unsigned int getWidth() const noexcept { return this->width; }
+		unsigned int getHeight() const noexcept { return this->height; }
+		unsigned int getNrLevels() const noexcept { return this->nrLevels; }
+		const glm::mat4 &getViewProjection() const noexcept { return this->viewProjection; }
+
+	  private:
+		void resize(const unsigned int width, const unsigned int height);
+
+		using UniformBlock = struct alignas(16) uniform_block_t {
+			glm::ivec2 sourceSize;
+			glm::ivec2 destinationSize;
+			unsigned int level;
+		};
+
+		glm::mat4 viewProjection = glm::mat4(1.0f);
+		unsigned int width = 0;
+		unsigned int height = 0;
+		unsigned int nrLevels = 0;
+
+		int reduce_program = 0;
+		unsigned int pyramid_texture = 0;
+		unsigned int depth_sampler = 0;
+
+		/*	One aligned uniform block per level.	*/
+		unsigned int uniform_buffer = 0;
+		size_t uniformAlignSize = sizeof(UniformBlock);
+
+		const unsigned int localWorkGroupSize[2] = {8, 8};
+
+		/*	*/
+		unsigned int uniform_buffer_binding = 0;
+		unsigned int depth_texture_binding = 0;
+		unsigned int source_image_binding = 1;
+		unsigned int destination_image_binding = 2;
+	};
+
+} // namespace glsample
@@ -0,0 +1,247 @@
+#include "FrameRingAllocator.h"
+#include "Common.h"
+#include <Exception.hpp>
+#include <GL/glew.h>
+#include <algorithm>
+#include <chrono>
+
+using namespace fragcore;
+using namespace glsample;
+
+FrameRingAllocator *FrameRingAllocator::active = nullptr;
+
+FrameRingAllocator::~FrameRingAllocator() { this->release(); }
+
+unsigned int FrameRingAllocator::createMappedBuffer(const size_t size, uint8_t *&mapped) {
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	unsigned int buffer = 0;
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+	glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, flags);
+	mapped = static_cast<uint8_t *>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags));
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	if (mapped == nullptr) {
+		glDeleteBuffers(1, &buffer);
+		return 0;
+	}
+	return buffer;
+}
+
+static void destroyMappedBuffer(unsigned int buffer) {
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+	glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	glDeleteBuffers(1, &buffer);
+}
+
+void FrameRingAllocator::init(const size_t frameSize, const size_t nrFrames) {
+	this->release();
+
+	GLint uniformAlignment = 0;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+	GLint storageAlignment = 0;
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+	this->uniformAlignment = Math::max<size_t>(1, uniformAlignment);
+	this->storageAlignment = Math::max<size_t>(1, storageAlignment);
+
+	/*	Each region starts aligned for both usages.	*/
+	this->frameSize = Math::align<size_t>(frameSize, Math::max<size_t>(this->uniformAlignment, this->storageAlignment));
+	this->fences.assign(nrFrames, nullptr);
+	this->frameIndex = 0;
+	this->frameOffset = 0;
+	this->requiredFrameSize = 0;
+
+	const size_t bufferSize = this->frameSize * nrFrames;
+	this->buffer = FrameRingAllocator::createMappedBuffer(bufferSize, this->mappedBuffer);
+	if (this->buffer == 0) {
+		throw cxxexcept::RuntimeException("Failed to map frame ring buffer of {} bytes", bufferSize);
+	}
+}
+
+void FrameRingAllocator::release() {
+	for (void *&fence : this->fences) {
+		if (fence) {
+			glDeleteSync(static_cast<GLsync>(fence));
+			fence = nullptr;
+		}
+	}
+	if (this->buffer) {
+		destroyMappedBuffer(this->buffer);
+		this->buffer = 0;
+	}
+	this->mappedBuffer = nullptr;
+
+	for (const unsigned int overflow : this->frameOverflowBuffers) {
+		destroyMappedBuffer(overflow);
+	}
+	this->frameOverflowBuffers.clear();
+	this->overflowBuffer = 0;
+	this->overflowMapped = nullptr;
+	this->overflowSize = 0;
+	this->overflowOffset = 0;
+
+	this->releaseRetired(true);
+}
+
+void FrameRingAllocator::reserve(const size_t frameSize) {
+	if (frameSize <= this->frameSize) {
+		return;
+	}
+
+	/*	All frames have to be completed before the buffer can be replaced.	*/
+	glFinish();
+	this->init(frameSize, Math::max<size_t>(1, this->fences.size()));
+}
+
+void FrameRingAllocator::retire(const unsigned int buffer) {
+	this->retiredBuffers.push_back({buffer, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+}
+
+void FrameRingAllocator::releaseRetired(const bool all) {
+	auto completed = [all](const RetiredBuffer &retired) {
+		if (!all) {
+			const GLenum status = glClientWaitSync(static_cast<GLsync>(retired.fence), 0, 0);
+			if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+				return false;
+			}
+		}
+		glDeleteSync(static_cast<GLsync>(retired.fence));
+		destroyMappedBuffer(retired.buffer);
+		return true;
+	};
+	this->retiredBuffers.erase(std::remove_if(this->retiredBuffers.begin(), this->retiredBuffers.end(), completed),
+							   this->retiredBuffers.end());
+}
+
+void FrameRingAllocator::grow(const size_t frameSize) {
+	const size_t alignedSize =
+		Math::align<size_t>(frameSize, Math::max<size_t>(this->uniformAlignment, this->storageAlignment));
+
+	uint8_t *mapped = nullptr;
+	const unsigned int grownBuffer = FrameRingAllocator::createMappedBuffer(alignedSize * this->fences.size(), mapped);
+	if (grownBuffer == 0) {
+		/*	Keep the current regions, the frames continue to overflow.	*/
+		return;
+	}
+
+	/*	The previous frames are covered by a single fence of the replaced buffer, no region of the grown
+	 *	buffer is in use by the GPU.	*/
+	this->retire(this->buffer);
+	for (void *&fence : this->fences) {
+		if (fence) {
+			glDeleteSync(static_cast<GLsync>(fence));
+			fence = nullptr;
+		}
+	}
+
+	this->buffer = grownBuffer;
+	this->mappedBuffer = mapped;
+	this->frameSize = alignedSize;
+}
+
+void FrameRingAllocator::beginFrame() {
+	this->releaseRetired(false);
+
+	/*	The previous frame overflowed, grow before the next region is used.	*/
+	if (this->requiredFrameSize > this->frameSize) {
+		this->grow(Math::max<size_t>(this->requiredFrameSize, this->frameSize * 2));
+	}
+	this->requiredFrameSize = 0;
+
+	this->frameIndex = (this->frameIndex + 1) % this->fences.size();
+	this->frameOffset = 0;
+	this->stallTime = 0;
+
+	GLsync fence = static_cast<GLsync>(this->fences[this->frameIndex]);
+	if (fence == nullptr) {
+		return;
+	}
+
+	/*	Only stalls if the GPU is more than the number of frames behind.	*/
+	GLenum status = glClientWaitSync(fence, 0, 0);
+	if (status == GL_TIMEOUT_EXPIRED) {
+		const auto start = std::chrono::steady_clock::now();
+		do {
+			status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000 * 1000 * 1000);
+		} while (status == GL_TIMEOUT_EXPIRED);
+
+		this->stallTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		this->totalStallTime += this->stallTime;
+		this->nrStalls++;
+	}
+
+	glDeleteSync(fence);
+	this->fences[this->frameIndex] = nullptr;
+}
+
+void FrameRingAllocator::endFrame() {
+	if (this->fences[this->frameIndex]) {
+		glDeleteSync(static_cast<GLsync>(this->fences[this->frameIndex]));
+	}
+	this->fences[this->frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	/*	Overflow buffers are only used by this frame.	*/
+	for (const unsigned int overflow : this->frameOverflowBuffers) {
+		this->retire(overflow);
+	}
+	this->frameOverflowBuffers.clear();
+	this->overflowBuffer = 0;
+	this->overflowMapped = nullptr;
+	this->overflowSize = 0;
+	this->overflowOffset = 0;
+}
+
+FrameRingAllocator::Allocation FrameRingAllocator::allocateOverflow(const size_t size, const size_t alignment) {
+	size_t offset = Math::align<size_t>(this->overflowOffset, alignment);
+
+	if (this->overflowBuffer == 0 || offset + size > this->overflowSize) {
+		/*	At least a whole frame region, the remaining allocations of the frame likely fit as well.	*/
+		const size_t overflowSize = Math::max<size_t>(size, this->frameSize);
+		uint8_t *mapped = nullptr;
+		const unsigned int overflow = FrameRingAllocator::createMappedBuffer(overflowSize, mapped);
+
+		if (overflow == 0) {
+			/*	Nothing can be made visible to the GPU, the content is written to scratch memory.	*/
+			this->overflowScratch.resize(Math::max<size_t>(this->overflowScratch.size(), size));
+			Allocation allocation;
+			allocation.size = size;
+			allocation.data = this->overflowScratch.data();
+			return allocation;
+		}
+
+		this->frameOverflowBuffers.push_back(overflow);
+		this->overflowBuffer = overflow;
+		this->overflowMapped = mapped;
+		this->overflowSize = overflowSize;
+		offset = 0;
+	}
+	this->overflowOffset = offset + size;
+
+	Allocation allocation;
+	allocation.buffer = this->overflowBuffer;
+	allocation.offset = offset;
+	allocation.size = size;
+	allocation.data = &this->overflowMapped[offset];
+	return allocation;
+}
+
+FrameRingAllocator::Allocation FrameRingAllocator::allocate(const size_t size, const Usage usage) {
+	const size_t alignment = usage == Usage::Storage ? this->storageAlignment : this->uniformAlignment;
+	const size_t offset = Math::align<size_t>(this->frameOffset, alignment);
+	this->frameOffset = offset + size;
+
+	/*	Overflowed, the region is grown for the next frame.	*/
+	if (this->frameOffset > this->frameSize) {
+		this->requiredFrameSize = Math::max<size_t>(this->requiredFrameSize, this->frameOffset);
+		return this->allocateOverflow(size, alignment);
+	}
+
+	Allocation allocation;
+	allocation.buffer = this->buffer;
+	allocation.offset = this->frameIndex * this->frameSize + offset;
+	allocation.size = size;
+	allocation.data = &this->mappedBuffer[allocation.offset];
+	return allocation;
+}
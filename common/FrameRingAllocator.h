@@ -0,0 +1,149 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "FragDef.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace glsample {
+
+	/**
+	 * @brief Per frame uniform and storage data, sub-allocated from a single persistently mapped buffer.
+	 *
+	 * The buffer is split into one region per frame in flight. Each frame allocates linearly from its own
+	 * region, and the region is only reused once the fence of the frame it was written in has signaled.
+	 * The memory is coherent, so writes are visible to the GPU without any map, unmap or flush.
+	 *
+	 * A frame that allocates more than its region is served from an overflow buffer, and the regions are grown
+	 * at the beginning of the next frame. Replaced buffers are released once their fence has signaled.
+	 */
+	class FVDECLSPEC FrameRingAllocator {
+	  public:
+		enum class Usage : unsigned int {
+			Uniform, /*	Aligned to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.	*/
+			Storage	 /*	Aligned to GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT.	*/
+		};
+
+		using Allocation = struct frame_allocation_t {
+			unsigned int buffer = 0;
+			size_t offset = 0;
+			size_t size = 0;
+			void *data = nullptr;
+
+			template <typename T> T *as() const noexcept { return static_cast<T *>(this->data); }
+		};
+
+		FrameRingAllocator() = default;
+		FrameRingAllocator(const FrameRingAllocator &) = delete;
+		FrameRingAllocator &operator=(const FrameRingAllocator &) = delete;
+		virtual ~FrameRingAllocator();
+
+		void init(const size_t frameSize, const size_t nrFrames);
+		void release();
+
+		/**
+		 * @brief Grow the region of each frame, waits for the GPU if the buffer has to be recreated.
+		 * Previous allocations are invalidated, intended to be called before the first frame.
+		 */
+		void reserve(const size_t frameSize);
+
+		/**
+		 * @brief Move to the next frame region, waiting for its fence if the GPU is still using it.
+		 */
+		void beginFrame();
+
+		/**
+		 * @brief Fence the commands of the frame, after the last command that reads its allocations.
+		 */
+		void endFrame();
+
+		/**
+		 * @brief Valid until the end of the frame, the content is undefined. Never throws, allocations beyond
+		 * the frame region are taken from an overflow buffer.
+		 */
+		Allocation allocate(const size_t size, const Usage usage = Usage::Uniform);
+
+		Allocation allocate(const void *data, const size_t size, const Usage usage = Usage::Uniform) {
+			Allocation allocation = this->allocate(size, usage);
+			std::memcpy(allocation.data, data, size);
+			return allocation;
+		}
+
+		template <typename T> Allocation allocate(const T &data, const Usage usage = Usage::Uniform) {
+			return this->allocate(static_cast<const void *>(&data), sizeof(T), usage);
+		}
+
+		/**
+		 * @brief Allocator of the sample window, used by the shared components that have no access to the window.
+		 */
+		static void setActive(FrameRingAllocator *allocator) noexcept { FrameRingAllocator::active = allocator; }
+		static FrameRingAllocator &getActive() noexcept { return *FrameRingAllocator::active; }
+
+		size_t getFrameSize() const noexcept { return this->frameSize; }
+		/*	Bytes requested by the current frame, larger than the frame size if it has overflowed.	*/
+		size_t getFrameUsage() const noexcept { return this->frameOffset; }
+		size_t getNrFrames() const noexcept { return this->fences.size(); }
+
+		/**
+		 * @brief Time waited on the fence at the beginning of the current frame, in milliseconds.
+		 */
+		double getStallTime() const noexcept { return this->stallTime; }
+		double getTotalStallTime() const noexcept { return this->totalStallTime; }
+		size_t getNrStalls() const noexcept { return this->nrStalls; }
+
+	  private:
+		static FrameRingAllocator *active;
+
+		static unsigned int createMappedBuffer(const size_t size, uint8_t *&mapped);
+		void grow(const size_t frameSize);
+		Allocation allocateOverflow(const size_t size, const size_t alignment);
+		void retire(const unsigned int buffer);
+		void releaseRetired(const bool all);
+
+		unsigned int buffer = 0;
+		uint8_t *mappedBuffer = nullptr;
+		size_t frameSize = 0;
+		size_t frameIndex = 0;
+		size_t frameOffset = 0;
+		/*	GLsync of each frame region, nullptr if not in use by the GPU.	*/
+		std::vector<void *> fences;
+
+		/*	Allocations of the current frame that did not fit in its region.	*/
+		std::vector<unsigned int> frameOverflowBuffers;
+		std::vector<uint8_t> overflowScratch;
+		unsigned int overflowBuffer = 0;
+		uint8_t *overflowMapped = nullptr;
+		size_t overflowSize = 0;
+		size_t overflowOffset = 0;
+		size_t requiredFrameSize = 0;
+
+		/*	Buffers replaced or overflowed, deleted once the GPU has completed the commands reading them.	*/
+		using RetiredBuffer = struct retired_buffer_t {
+			unsigned int buffer;
+			void *fence;
+		};
+		std::vector<RetiredBuffer> retiredBuffers;
+
+		size_t uniformAlignment = 256;
+		size_t storageAlignment = 256;
+
+		double stallTime = 0;
+		double totalStallTime = 0;
+		size_t nrStalls = 0;
+	};
+
+} // namespace glsample
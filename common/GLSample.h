@@ -24,9 +24,11 @@
 #include "TaskScheduler/IScheduler.h"
 #include "Util/CameraController.h"
 #include "Util/ProcessDataUtil.h"
+#include "Util/TaskParallel.h"
 #include <GLHelper.h>
 #include <GeometryUtil.h>
 #include <ProceduralGeometry.h>
+#include <SDL2/SDL_hints.h>
 #include <SDLDisplay.h>
 #include <TaskScheduler.h>
 #include <cxxopts.hpp>
@@ -80,7 +82,28 @@ template <typename T = GLSampleWindow> class GLSample : public glsample::GLSampl
 				"s,glsl-version", "Override glsl version from system (110,120,130,140,150,330...)",
 				cxxopts::value<int>()->default_value("-1"))(
 				"I,ignore-requirements", "Ignore extension requirements",
-				cxxopts::value<bool>()->default_value("false"));
+				cxxopts::value<bool>()->default_value("false"))(
+				"shader-cache", "Shader program cache directory, empty to disable",
+				cxxopts::value<std::string>()->default_value(".cache/shaders"))(
+				"texture-cache", "Store block compressed textures next to the source image",
+				cxxopts::value<bool>()->default_value("true"))(
+				"postprocessing-idle-release", "Release disabled post processing after number of frames, 0 never",
+				cxxopts::value<int>()->default_value("0"))(
+				"headless", "Render offscreen, without a display server",
+				cxxopts::value<bool>()->default_value("false"))(
+				"benchmark-frames", "Number of frames to benchmark, then exit, 0 disable",
+				cxxopts::value<int>()->default_value("0"))(
+				"benchmark-warmup", "Number of frames before the benchmark is recorded",
+				cxxopts::value<int>()->default_value("16"))(
+				"benchmark-delta-time", "Simulated time step of each benchmark frame in seconds",
+				cxxopts::value<float>()->default_value("0.016666"))(
+				"benchmark-output", "Benchmark results, .json or .csv, default <sample>.benchmark.json",
+				cxxopts::value<std::string>()->default_value(""))(
+				"profiler", "Enable the CPU and GPU scope profiler", cxxopts::value<bool>()->default_value("false"))(
+				"profiler-trace", "Capture a Chrome trace of the first frames to the file",
+				cxxopts::value<std::string>()->default_value(""))(
+				"profiler-trace-frames", "Number of frames in the captured trace",
+				cxxopts::value<int>()->default_value("64"));
 
 		/*	Append command option for the specific sample.	*/
 		this->customOptions(addr);
@@ -95,10 +118,14 @@ template <typename T = GLSampleWindow> class GLSample : public glsample::GLSampl
 			exit(EXIT_SUCCESS);
 		}
 
+		/*	Benchmarks run in a fixed size window, without waiting for the vertical blank.	*/
+		const bool benchmark = result["benchmark-frames"].as<int>() > 0;
+		const bool headless = result["headless"].as<bool>();
+
 		/*	*/
 		const bool debug = result["debug"].as<bool>();
-		const bool fullscreen = result["fullscreen"].as<bool>();
-		const bool vsync = result["vsync"].as<bool>();
+		const bool fullscreen = result["fullscreen"].as<bool>() && !benchmark;
+		const bool vsync = result["vsync"].as<bool>() && !benchmark;
 		const bool ignore_extension = result["ignore-requirements"].as<bool>();
 		const glsample::ColorSpace gammacorrection = glsample::ColorSpace::SRGB;
 
@@ -109,8 +136,11 @@ template <typename T = GLSampleWindow> class GLSample : public glsample::GLSampl
 		const int msaa = result["multi-sample"].as<int>();
 		const int display_index = result["display"].as<int>();
 
+		/*	Shared by the file system and the parallel loops of the samples.	*/
+		const int nrWorkers = fragcore::Math::max<int>(2, fragcore::SystemInfo::getCPUCoreCount() - 1);
 		fragcore::Ref<fragcore::IScheduler> schedular =
-			fragcore::Ref<fragcore::IScheduler>(new fragcore::TaskScheduler(2));
+			fragcore::Ref<fragcore::IScheduler>(new fragcore::TaskScheduler(nrWorkers));
+		glsample::TaskParallel::setScheduler(schedular.ptr(), nrWorkers);
 
 		/*	Create filesystem that the asset will be read from.	*/
 		this->activeFileSystem = fragcore::FileSystem::createFileSystem(schedular);
@@ -124,6 +154,11 @@ template <typename T = GLSampleWindow> class GLSample : public glsample::GLSampl
 			}
 		}
 
+		/*	Surfaceless EGL context, works without a display or a GPU, such as Mesa llvmpipe.	*/
+		if (headless) {
+			SDL_SetHint(SDL_HINT_VIDEODRIVER, "offscreen");
+		}
+
 		/*	*/
 		this->sampleRef = new T();
 
@@ -175,6 +210,11 @@ template <typename T = GLSampleWindow> class GLSample : public glsample::GLSampl
 			display = fragcore::SDLDisplay::getDisplay(display_index);
 		}
 
+		if (benchmark && (width == -1 || height == -1)) {
+			width = 1280;
+			height = 720;
+		}
+
 		/*	*/
 		if (fullscreen) {
 
@@ -54,6 +54,13 @@ namespace glsample {
 		unsigned int stride = 0;
 		int primitiveType = 0;
 
+		/*	Index type, indices_offset is in number of indices of this type.	*/
+		unsigned int indices_type = GL_UNSIGNED_INT;
+		unsigned int indices_stride = sizeof(unsigned int);
+
+		/*	Position stored as unorm, relative to the bound, see VertexLayout::Compact.	*/
+		bool quantized_position = false;
+
 		/*	*/
 		fragcore::Bound bound{};
 	};
@@ -6,6 +6,7 @@
 #include "GLUIComponent.h"
 
 #include "GraphicFormat.h"
+#include "Importer/TextureCompressor.h"
 #include "PostProcessing/BloomPostProcessing.h"
 #include "PostProcessing/BlurPostProcessing.h"
 #include "PostProcessing/ChromaticAbberationPostProcessing.h"
@@ -22,9 +23,11 @@
 #include "PostProcessing/SobelPostProcessing.h"
 
 #include "PostProcessing/VolumetricScattering.h"
+#include "Profiler.h"
 #include "SDL_scancode.h"
 #include "SDL_video.h"
 #include "SampleHelper.h"
+#include "ShaderCache.h"
 #include "imgui.h"
 #include "magic_enum.hpp"
 #include "spdlog/common.h"
@@ -34,8 +37,10 @@
 #include <SDL2/SDL_events.h>
 #include <SDL2/SDL_keyboard.h>
 #include <SDL2/SDL_mouse.h>
+#include <chrono>
 #include <cstddef>
 #include <exception>
+#include <fmt/core.h>
 #include <memory>
 #include <renderdoc_app.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -71,6 +76,14 @@ class SampleSettingComponent : public GLUIComponent<GLSampleWindow> {
 		ImGui::Text("Frag invocation %zu", this->getRefSample().debug_prev_frame_frag_invocation_count);
 		ImGui::Text("Vertex invocation %zu", this->getRefSample().debug_prev_frame_vertex_invocation_count);
 		ImGui::Text("Geometry invocation %zu", this->getRefSample().debug_prev_frame_geometry_invocation_count);
+		ImGui::Text("Shader Cache Program Hit %zu Miss %zu", ShaderCache::getProgramHitCount(),
+					ShaderCache::getProgramMissCount());
+		ImGui::Text("Shader Cache Source Hit %zu Miss %zu", ShaderCache::getSourceHitCount(),
+					ShaderCache::getSourceMissCount());
+		const FrameRingAllocator &frameAllocator = this->getRefSample().getFrameAllocator();
+		ImGui::Text("Frame Allocator %zu / %zu bytes", frameAllocator.getFrameUsage(), frameAllocator.getFrameSize());
+		ImGui::Text("Frame Allocator Stall %.3f ms Total %.3f ms (%zu)", frameAllocator.getStallTime(),
+					frameAllocator.getTotalStallTime(), frameAllocator.getNrStalls());
 
 		ImGui::EndGroup();
 
@@ -169,6 +182,8 @@ class SampleSettingComponent : public GLUIComponent<GLSampleWindow> {
 			ImGui::BeginGroup();
 			PostProcessingManager *manager = this->getRefSample().getPostProcessingManager();
 
+			ImGui::Text("Scheduled %zu Culled %zu", manager->getNrScheduledPasses(), manager->getNrCulledPasses());
+
 			/*	*/
 			for (size_t post_index = 0; post_index < manager->getNrPostProcessing(); post_index++) {
 				PostProcessing &postEffect = manager->getPostProcessing(post_index);
@@ -188,7 +203,10 @@ class SampleSettingComponent : public GLUIComponent<GLSampleWindow> {
 					postEffect.setItensity(enabled_intensity);
 				}
 
-				postEffect.renderUI();
+				/*	Settings may reference resources, only loaded once enabled.	*/
+				if (manager->isInitialized(post_index)) {
+					postEffect.renderUI();
+				}
 
 				ImGui::EndDisabled();
 				ImGui::PopID();
@@ -197,6 +215,48 @@ class SampleSettingComponent : public GLUIComponent<GLSampleWindow> {
 			ImGui::EndGroup();
 		}
 
+		/*	Per scope timing of the latest resolved frame.	*/
+		if (ImGui::CollapsingHeader("Profiler")) {
+			bool profilerEnabled = Profiler::isEnabled();
+			if (ImGui::Checkbox("Enabled", &profilerEnabled)) {
+				Profiler::setEnabled(profilerEnabled);
+			}
+
+			ImGui::BeginDisabled(Profiler::isCapturingTrace());
+			if (ImGui::Button("Capture Trace")) {
+				Profiler::captureTrace(64);
+			}
+			ImGui::EndDisabled();
+			ImGui::SameLine();
+			ImGui::TextUnformatted(this->getRefSample().getTraceOutput().c_str());
+
+			const Profiler::FrameResult &frame = Profiler::getResolvedFrame();
+			if (Profiler::isEnabled() && !frame.scopes.empty()) {
+				ImGui::Text("Frame %zu", frame.frame);
+				ImGui::TextUnformatted("CPU");
+				this->drawFlameGraph(frame, false);
+				ImGui::TextUnformatted("GPU");
+				this->drawFlameGraph(frame, true);
+
+				if (ImGui::BeginTable("Profiler Scopes", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+					ImGui::TableSetupColumn("Scope");
+					ImGui::TableSetupColumn("CPU ms");
+					ImGui::TableSetupColumn("GPU ms");
+					ImGui::TableHeadersRow();
+					for (const Profiler::ScopeResult &scope : frame.scopes) {
+						ImGui::TableNextRow();
+						ImGui::TableNextColumn();
+						ImGui::Text("%*s%s", (int)scope.depth * 2, "", scope.name.c_str());
+						ImGui::TableNextColumn();
+						ImGui::Text("%.3f", scope.cpuEnd - scope.cpuBegin);
+						ImGui::TableNextColumn();
+						ImGui::Text("%.3f", scope.gpuEnd - scope.gpuBegin);
+					}
+					ImGui::EndTable();
+				}
+			}
+		}
+
 		/*	Display All Framebuffer textures.	*/
 		const glsample::FrameBuffer *framebuffer = this->getRefSample().getFrameBuffer();
 		if (ImGui::CollapsingHeader("FrameBuffer Texture Targets") && framebuffer) {
@@ -210,6 +270,50 @@ class SampleSettingComponent : public GLUIComponent<GLSampleWindow> {
 	}
 
   private:
+	/*	Scopes of each depth on a row, scaled to the duration of the frame.	*/
+	void drawFlameGraph(const Profiler::FrameResult &frame, const bool gpu) {
+		const Profiler::ScopeResult &root = frame.scopes.front();
+		const double frameDuration = gpu ? root.gpuEnd : root.cpuEnd;
+		if (frameDuration <= 0) {
+			return;
+		}
+
+		unsigned int maxDepth = 0;
+		for (const Profiler::ScopeResult &scope : frame.scopes) {
+			maxDepth = Math::max(maxDepth, scope.depth);
+		}
+
+		const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+		const ImVec2 origin = ImGui::GetCursorScreenPos();
+		const float width = ImGui::GetContentRegionAvail().x;
+
+		ImGui::PushID(gpu);
+		ImGui::InvisibleButton("Flame Graph", ImVec2(width, rowHeight * (maxDepth + 1)));
+		ImGui::PopID();
+		const bool hovered = ImGui::IsItemHovered();
+
+		ImDrawList *drawList = ImGui::GetWindowDrawList();
+		for (const Profiler::ScopeResult &scope : frame.scopes) {
+			const double begin = gpu ? scope.gpuBegin : scope.cpuBegin;
+			const double end = gpu ? scope.gpuEnd : scope.cpuEnd;
+
+			const ImVec2 min(origin.x + (float)(begin / frameDuration) * width, origin.y + rowHeight * scope.depth);
+			const ImVec2 max(Math::max(min.x + 1.0f, origin.x + (float)(end / frameDuration) * width),
+							 min.y + rowHeight - 1.0f);
+
+			/*	Same color for the same scope in every frame.	*/
+			const float hue = (float)(std::hash<std::string>{}(scope.name) % 360) / 360.0f;
+			drawList->AddRectFilled(min, max, ImColor::HSV(hue, 0.5f, 0.7f));
+
+			drawList->PushClipRect(min, max, true);
+			drawList->AddText(ImVec2(min.x + 2.0f, min.y), IM_COL32_WHITE, scope.name.c_str());
+			drawList->PopClipRect();
+
+			if (hovered && ImGui::IsMouseHoveringRect(min, max)) {
+				ImGui::SetTooltip("%s %.3f ms", scope.name.c_str(), end - begin);
+			}
+		}
+	}
 };
 
 GLSampleWindow::GLSampleWindow()
@@ -246,8 +350,15 @@ GLSampleWindow::GLSampleWindow()
 				 nullptr, GL_STREAM_READ);
 	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
-	/*	*/
-	glGenQueries(this->queries.size(), this->queries.data());
+	/*	Three frames of per frame data, until the fence of the oldest frame is waited on.	*/
+	this->frameAllocator.init(1 << 20, 3);
+	FrameRingAllocator::setActive(&this->frameAllocator);
+
+	/*	One query set per frame in flight, results are read back once the GPU has caught up.	*/
+	this->debugQueries.resize(Math::max<size_t>(2, this->getFrameBufferCount()));
+	for (DebugQuerySet &querySet : this->debugQueries) {
+		glGenQueries(querySet.queries.size(), querySet.queries.data());
+	}
 	int time_precision = 0;
 	glGetQueryiv(GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &time_precision);
 
@@ -274,8 +385,15 @@ GLSampleWindow::GLSampleWindow()
 }
 
 GLSampleWindow::~GLSampleWindow() {
+	for (DebugQuerySet &querySet : this->debugQueries) {
+		glDeleteQueries(querySet.queries.size(), querySet.queries.data());
+	}
 	delete this->colorSpace;
 	delete this->postprocessingManager;
+	delete this->benchmark;
+	Profiler::release();
+	FrameRingAllocator::setActive(nullptr);
+	this->frameAllocator.release();
 	/*	*/
 }
 
@@ -285,6 +403,10 @@ void GLSampleWindow::internalInit() {
 	const size_t multi_sample_count = this->getResult()["multi-sample"].as<int>();
 	const bool useFBO = multi_sample_count > 0 || use_post_process || true; // TODO: fix conditions.
 
+	/*	Must be assigned before any shader is loaded.	*/
+	ShaderCache::setCacheDirectory(this->getResult()["shader-cache"].as<std::string>());
+	TextureCompressor::setCacheEnabled(this->getResult()["texture-cache"].as<bool>());
+
 	if (this->colorSpace == nullptr) {
 
 		// TODO: add try catch.
@@ -292,55 +414,23 @@ void GLSampleWindow::internalInit() {
 		this->colorSpace->initialize(getFileSystem());
 
 		if (use_post_process) {
-			this->postprocessingManager = new PostProcessingManager();
-
-			SSAOPostProcessing *ssao = new SSAOPostProcessing();
-			ssao->initialize(getFileSystem());
-			this->postprocessingManager->addPostProcessing(*ssao);
-
-			SSSPostProcessing *sss = new SSSPostProcessing();
-			sss->initialize(getFileSystem());
-			this->postprocessingManager->addPostProcessing(*sss);
-
-			SobelProcessing *sobelPostProcessing = new SobelProcessing();
-			sobelPostProcessing->initialize(getFileSystem());
-			this->postprocessingManager->addPostProcessing(*sobelPostProcessing);
-
-			ColorGradePostProcessing *colorgrade = new ColorGradePostProcessing();
-			colorgrade->initialize(getFileSystem());
-			this->postprocessingManager->addPostProcessing(*colorgrade);
-
-			PixelatePostProcessing *pixelate = new PixelatePostProcessing();
-			pixelate->initialize(getFileSystem());
-			this->postprocessingManager->addPostProcessing(*pixelate);
-
-			GrainPostProcessing *grain = new GrainPostProcessing();
-			grain->initialize(getFileSystem());
-			this->postprocessingManager->addPostProcessing(*grain);
-
-			DepthOfFieldProcessing *depthOfField = new DepthOfFieldProcessing();
-			depthOfField->initialize(getFileSystem());
-			this->postprocessingManager->addPostProcessing(*depthOfField);
-
-			MistPostProcessing *mistFog = new MistPostProcessing();
-			mistFog->initialize(getFileSystem());
-			this->postprocessingManager->addPostProcessing(*mistFog);
-
-			VolumetricScatteringPostProcessing *volumetric = new VolumetricScatteringPostProcessing();
-			volumetric->initialize(getFileSystem());
-			this->postprocessingManager->addPostProcessing(*volumetric);
-
-			BlurPostProcessing *blur = new BlurPostProcessing();
-			blur->initialize(getFileSystem());
-			this->postprocessingManager->addPostProcessing(*blur);
-
-			BloomPostProcessing *bloom = new BloomPostProcessing();
-			bloom->initialize(getFileSystem());
-			this->postprocessingManager->addPostProcessing(*bloom);
-
-			ChromaticAbberationPostProcessing *chromatic = new ChromaticAbberationPostProcessing();
-			chromatic->initialize(getFileSystem());
-			this->postprocessingManager->addPostProcessing(*chromatic);
+			this->postprocessingManager = new PostProcessingManager(getFileSystem());
+			this->postprocessingManager->setReleaseIdleFrameCount(
+				this->getResult()["postprocessing-idle-release"].as<int>());
+
+			/*	Resources of each post processing are only loaded once enabled.	*/
+			this->postprocessingManager->addPostProcessing([]() { return new SSAOPostProcessing(); });
+			this->postprocessingManager->addPostProcessing([]() { return new SSSPostProcessing(); });
+			this->postprocessingManager->addPostProcessing([]() { return new SobelProcessing(); });
+			this->postprocessingManager->addPostProcessing([]() { return new ColorGradePostProcessing(); });
+			this->postprocessingManager->addPostProcessing([]() { return new PixelatePostProcessing(); });
+			this->postprocessingManager->addPostProcessing([]() { return new GrainPostProcessing(); });
+			this->postprocessingManager->addPostProcessing([]() { return new DepthOfFieldProcessing(); });
+			this->postprocessingManager->addPostProcessing([]() { return new MistPostProcessing(); });
+			this->postprocessingManager->addPostProcessing([]() { return new VolumetricScatteringPostProcessing(); });
+			this->postprocessingManager->addPostProcessing([]() { return new BlurPostProcessing(); });
+			this->postprocessingManager->addPostProcessing([]() { return new BloomPostProcessing(); });
+			this->postprocessingManager->addPostProcessing([]() { return new ChromaticAbberationPostProcessing(); });
 		}
 	}
 
@@ -363,12 +453,43 @@ void GLSampleWindow::internalInit() {
 	if (getDefaultFramebuffer() > 0) {
 		this->updateDefaultFramebuffer();
 	}
+
+	/*	Post processing targets match the framebuffer from the first frame, not only after a resize.	*/
+	if (this->postprocessingManager) {
+		this->postprocessingManager->setRenderSize(this->width(), this->height());
+	}
+
+	/*	Benchmark with a fixed simulated time step, so each run renders the same frames.	*/
+	const int benchmark_frames = this->getResult()["benchmark-frames"].as<int>();
+	if (this->benchmark == nullptr && benchmark_frames > 0) {
+		const int warmup_frames = Math::max<int>(0, this->getResult()["benchmark-warmup"].as<int>());
+		this->benchmark = new BenchmarkRecorder(warmup_frames, benchmark_frames);
+
+		this->benchmarkOutput = this->getResult()["benchmark-output"].as<std::string>();
+		if (this->benchmarkOutput.empty()) {
+			this->benchmarkOutput = fmt::format("{}.benchmark.json", fragcore::SystemInfo::getApplicationName());
+		}
+		this->getTimer().setFixedDeltaTime(this->getResult()["benchmark-delta-time"].as<float>());
+	}
+
+	/*	*/
+	this->traceOutput = this->getResult()["profiler-trace"].as<std::string>();
+	if (this->traceOutput.empty()) {
+		this->traceOutput = fmt::format("{}.trace.json", fragcore::SystemInfo::getApplicationName());
+	} else {
+		Profiler::captureTrace(Math::max<int>(1, this->getResult()["profiler-trace-frames"].as<int>()));
+	}
+	if (this->getResult()["profiler"].as<bool>()) {
+		Profiler::setEnabled(true);
+	}
 }
 
 void GLSampleWindow::displayMenuBar() {}
 
 void GLSampleWindow::renderUI() {
 
+	const auto frameStart = std::chrono::steady_clock::now();
+
 	/*	Make sure all commands are flush before resizing.	*/
 	if (this->preWidth != this->width() || this->preHeight != this->height()) {
 		/*	Finish all commands before starting resizing buffers and etc.	*/
@@ -377,25 +498,28 @@ void GLSampleWindow::renderUI() {
 		this->onResize(this->width(), this->height());
 
 		this->updateDefaultFramebuffer();
+
+		if (this->postprocessingManager) {
+			this->postprocessingManager->setRenderSize(this->width(), this->height());
+		}
 	}
 
 	/*	*/
 	this->preWidth = this->width();
 	this->preHeight = this->height();
 
+	Profiler::beginFrame(this->frameCount);
+	this->frameAllocator.beginFrame();
+
 	/*	Main Update function.	*/
+	Profiler::pushScope("Update");
 	this->getInput().update();
 	this->update();
+	Profiler::popScope();
 
 	/*	*/
-	if (this->debugGL) {
-		glBeginQuery(GL_TIME_ELAPSED, this->queries[0]);
-		glBeginQuery(GL_SAMPLES_PASSED, this->queries[1]);
-		glBeginQuery(GL_PRIMITIVES_GENERATED, this->queries[2]);
-		glBeginQuery(GL_COMPUTE_SHADER_INVOCATIONS_ARB, this->queries[3]);
-		glBeginQuery(GL_FRAGMENT_SHADER_INVOCATIONS_ARB, this->queries[4]);
-		glBeginQuery(GL_VERTEX_SHADER_INVOCATIONS_ARB, this->queries[5]);
-		glBeginQuery(GL_GEOMETRY_SHADER_INVOCATIONS, this->queries[6]);
+	if (this->debugGL || this->benchmark) {
+		this->beginDebugQueries();
 	}
 
 	{
@@ -408,13 +532,13 @@ void GLSampleWindow::renderUI() {
 		glEnable(GL_DEPTH_TEST);
 
 		/*	Main Draw Callback.	*/
-		glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 1, sizeof("Draw"), "Draw");
+		Profiler::pushScope("Draw");
 		this->draw();
-		glPopDebugGroup();
+		Profiler::popScope();
 
 		/*	Transfer Multisampled texture to FBO.	*/
 		if (this->MMSAFrameBuffer && this->MMSAFrameBuffer->framebuffer == this->getDefaultFramebuffer()) {
-			glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 1, sizeof("MultiSampling to FBO"), "MultiSampling to FBO");
+			Profiler::pushScope("MultiSampling to FBO");
 			/*	*/
 			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->defaultFramebuffer->framebuffer);
 			glBindFramebuffer(GL_READ_FRAMEBUFFER, this->MMSAFrameBuffer->framebuffer);
@@ -429,13 +553,12 @@ void GLSampleWindow::renderUI() {
 			glBlitFramebuffer(0, 0, this->width(), this->height(), 0, 0, this->width(), this->height(),
 							  GL_DEPTH_BUFFER_BIT, GL_NEAREST);
 			glBindFramebuffer(GL_FRAMEBUFFER, 0);
-			glPopDebugGroup();
+			Profiler::popScope();
 		}
 
 		/*	*/
 		if (this->postprocessingManager) {
-			const std::string postStage = "post processing";
-			glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 1, postStage.size(), postStage.data());
+			Profiler::pushScope("post processing");
 			/*	*/
 			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->defaultFramebuffer->framebuffer);
 
@@ -450,17 +573,15 @@ void GLSampleWindow::renderUI() {
 																	  this->defaultFramebuffer->attachments[1]),
 				 std::make_tuple<const GBuffer, const unsigned int &>(GBuffer::IntermediateTarget2,
 																	  this->defaultFramebuffer->attachments[2])});
-			glPopDebugGroup();
+			Profiler::popScope();
 		}
 
 		/*	Transfer last result to the default OpenGL Framebuffer.	*/
 		if (this->defaultFramebuffer) {
 			if (this->colorSpace) {
-				const std::string ColorSpaceConverterStage = "Color Space Conversion";
-				glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 1, ColorSpaceConverterStage.length(),
-								 ColorSpaceConverterStage.c_str());
+				Profiler::pushScope("Color Space Conversion");
 				this->colorSpace->render(this->defaultFramebuffer->attachments[0]);
-				glPopDebugGroup();
+				Profiler::popScope();
 			}
 
 			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
@@ -473,41 +594,44 @@ void GLSampleWindow::renderUI() {
 			glBindFramebuffer(GL_FRAMEBUFFER, 0);
 		}
 
-		glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 1, sizeof("Post Draw"), "Post Draw");
+		Profiler::pushScope("Post Draw");
 		this->postDraw();
-		glPopDebugGroup();
+		Profiler::popScope();
 	}
 
-	/*	Extract debugging information.	*/
-	if (this->debugGL) {
-
-		// glGetQueryObjectiv(queries[N-1], GL_QUERY_RESULT_AVAILABLE, &available);
-		glEndQuery(GL_TIME_ELAPSED);
-		glEndQuery(GL_SAMPLES_PASSED);
-		glEndQuery(GL_PRIMITIVES_GENERATED);
-		glEndQuery(GL_COMPUTE_SHADER_INVOCATIONS_ARB);
-		glEndQuery(GL_FRAGMENT_SHADER_INVOCATIONS_ARB);
-		glEndQuery(GL_VERTEX_SHADER_INVOCATIONS_ARB);
-		glEndQuery(GL_GEOMETRY_SHADER_INVOCATIONS);
+	/*	All commands reading the frame allocations have been issued.	*/
+	this->frameAllocator.endFrame();
 
-		//	glGetQueryObjectui64v
-		glGetQueryObjectui64v(this->queries[0], GL_QUERY_RESULT, &time_elapsed);
-		glGetQueryObjectui64v(this->queries[1], GL_QUERY_RESULT, &nrSamples);
-		glGetQueryObjectui64v(this->queries[2], GL_QUERY_RESULT, &nrPrimitives);
-		glGetQueryObjectui64v(this->queries[3], GL_QUERY_RESULT, &this->debug_prev_frame_cs_invocation_count);
-		glGetQueryObjectui64v(this->queries[4], GL_QUERY_RESULT, &this->debug_prev_frame_frag_invocation_count);
-		glGetQueryObjectui64v(this->queries[5], GL_QUERY_RESULT, &this->debug_prev_frame_vertex_invocation_count);
-		glGetQueryObjectui64v(this->queries[6], GL_QUERY_RESULT, &this->debug_prev_frame_geometry_invocation_count);
+	/*	CPU time of the frame, excluding the buffer swap. Sampled before the debug queries, which
+	 *	wait for the query results.	*/
+	if (this->benchmark) {
+		BenchmarkRecorder::FrameRecord *record = this->benchmark->getRecord(this->frameCount);
+		if (record) {
+			record->cpuTime =
+				std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+		}
+	}
 
-		this->debug_prev_frame_sample_count = nrSamples;
-		this->debug_prev_frame_primitive_count = nrPrimitives;
+	/*	Extract debugging information.	*/
+	if (this->debugGL || this->benchmark) {
+		this->endDebugQueries();
+	}
 
-		this->getLogger().debug("Samples: {} Primitives: {} Elapsed: {} ms", nrSamples, nrPrimitives,
-								(float)time_elapsed / (float)this->time_resolution);
+	Profiler::endFrame();
+	if (Profiler::hasTrace()) {
+		try {
+			Profiler::saveTrace(this->traceOutput);
+			this->getLogger().info("Profiler trace written to {}", this->traceOutput);
+		} catch (const std::exception &ex) {
+			this->getLogger().error(ex.what());
+		}
 	}
 
 	/*	*/
 	this->frameCount++;
+	if (this->benchmark && this->benchmark->isFinished(this->frameCount)) {
+		this->finishBenchmark();
+	}
 	this->frameBufferIndex = (this->frameBufferIndex + 1) % this->getFrameBufferCount();
 
 	{
@@ -536,7 +660,7 @@ void GLSampleWindow::renderUI() {
 		}
 	}
 
-	this->getFPSCounter().update(this->getTimer().getElapsed<float>());
+	this->getFPSCounter().update(this->getTimer().getRealTime().getElapsed<float>());
 
 	/*	*/
 	this->getLogger().info("FPS: {} Elapsed Time: {} ({} ms)", this->getFPSCounter().getFPS(),
@@ -544,6 +668,116 @@ void GLSampleWindow::renderUI() {
 	this->getTimer().update();
 }
 
+void GLSampleWindow::beginDebugQueries() {
+	DebugQuerySet &querySet = this->debugQueries[this->debugQueryIndex];
+	querySet.frame = this->frameCount;
+
+	glBeginQuery(GL_TIME_ELAPSED, querySet.queries[0]);
+	glBeginQuery(GL_SAMPLES_PASSED, querySet.queries[1]);
+	glBeginQuery(GL_PRIMITIVES_GENERATED, querySet.queries[2]);
+	glBeginQuery(GL_COMPUTE_SHADER_INVOCATIONS_ARB, querySet.queries[3]);
+	glBeginQuery(GL_FRAGMENT_SHADER_INVOCATIONS_ARB, querySet.queries[4]);
+	glBeginQuery(GL_VERTEX_SHADER_INVOCATIONS_ARB, querySet.queries[5]);
+	glBeginQuery(GL_GEOMETRY_SHADER_INVOCATIONS, querySet.queries[6]);
+}
+
+void GLSampleWindow::endDebugQueries() {
+
+	glEndQuery(GL_TIME_ELAPSED);
+	glEndQuery(GL_SAMPLES_PASSED);
+	glEndQuery(GL_PRIMITIVES_GENERATED);
+	glEndQuery(GL_COMPUTE_SHADER_INVOCATIONS_ARB);
+	glEndQuery(GL_FRAGMENT_SHADER_INVOCATIONS_ARB);
+	glEndQuery(GL_VERTEX_SHADER_INVOCATIONS_ARB);
+	glEndQuery(GL_GEOMETRY_SHADER_INVOCATIONS);
+
+	this->debugQueries[this->debugQueryIndex].issued = true;
+
+	/*	The oldest set in the ring was issued N-1 frames ago.	*/
+	this->debugQueryIndex = (this->debugQueryIndex + 1) % this->debugQueries.size();
+	DebugQuerySet &querySet = this->debugQueries[this->debugQueryIndex];
+
+	if (!querySet.issued) {
+		return;
+	}
+
+	/*	Only read the results if all are available, otherwise keep the previous values rather than stalling.
+	 *	Benchmarks wait for them instead, so that no frame is missing.	*/
+	for (size_t query_index = 0; query_index < querySet.queries.size() && !this->benchmark; query_index++) {
+		GLint available = 0;
+		glGetQueryObjectiv(querySet.queries[query_index], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available) {
+			return;
+		}
+	}
+
+	this->readDebugQueries(this->debugQueryIndex);
+}
+
+void GLSampleWindow::readDebugQueries(const size_t query_set_index) {
+	DebugQuerySet &querySet = this->debugQueries[query_set_index];
+
+	glGetQueryObjectui64v(querySet.queries[0], GL_QUERY_RESULT, &time_elapsed);
+	glGetQueryObjectui64v(querySet.queries[1], GL_QUERY_RESULT, &nrSamples);
+	glGetQueryObjectui64v(querySet.queries[2], GL_QUERY_RESULT, &nrPrimitives);
+	glGetQueryObjectui64v(querySet.queries[3], GL_QUERY_RESULT, &this->debug_prev_frame_cs_invocation_count);
+	glGetQueryObjectui64v(querySet.queries[4], GL_QUERY_RESULT, &this->debug_prev_frame_frag_invocation_count);
+	glGetQueryObjectui64v(querySet.queries[5], GL_QUERY_RESULT, &this->debug_prev_frame_vertex_invocation_count);
+	glGetQueryObjectui64v(querySet.queries[6], GL_QUERY_RESULT, &this->debug_prev_frame_geometry_invocation_count);
+	querySet.issued = false;
+
+	this->debug_prev_frame_sample_count = nrSamples;
+	this->debug_prev_frame_primitive_count = nrPrimitives;
+
+	this->getLogger().debug("Samples: {} Primitives: {} Elapsed: {} ms", nrSamples, nrPrimitives,
+							(float)time_elapsed / (float)this->time_resolution);
+
+	/*	The results belong to the frame the queries were issued in.	*/
+	BenchmarkRecorder::FrameRecord *record = this->benchmark ? this->benchmark->getRecord(querySet.frame) : nullptr;
+	if (record) {
+		record->gpuTime = (double)time_elapsed / (double)this->time_resolution;
+		record->samples = nrSamples;
+		record->primitives = nrPrimitives;
+		record->computeInvocations = this->debug_prev_frame_cs_invocation_count;
+		record->fragmentInvocations = this->debug_prev_frame_frag_invocation_count;
+		record->vertexInvocations = this->debug_prev_frame_vertex_invocation_count;
+		record->geometryInvocations = this->debug_prev_frame_geometry_invocation_count;
+		record->hasGPU = true;
+	}
+}
+
+void GLSampleWindow::finishBenchmark() {
+
+	/*	Results of the last frames still in flight.	*/
+	glFinish();
+	for (size_t query_set_index = 0; query_set_index < this->debugQueries.size(); query_set_index++) {
+		if (this->debugQueries[query_set_index].issued) {
+			this->readDebugQueries(query_set_index);
+		}
+	}
+
+	this->benchmark->setInfo("sample", fragcore::SystemInfo::getApplicationName());
+	this->benchmark->setInfo("renderer", reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+	this->benchmark->setInfo("version", reinterpret_cast<const char *>(glGetString(GL_VERSION)));
+	this->benchmark->setInfo("resolution", fmt::format("{}x{}", this->width(), this->height()));
+	this->benchmark->setInfo("delta_time", fmt::format("{}", this->getTimer().getFixedDeltaTime()));
+
+	try {
+		this->benchmark->save(this->benchmarkOutput);
+		this->getLogger().info("Benchmark results written to {}", this->benchmarkOutput);
+	} catch (const std::exception &ex) {
+		this->getLogger().error(ex.what());
+	}
+
+	delete this->benchmark;
+	this->benchmark = nullptr;
+
+	/*	Exit the main loop once the frame is completed.	*/
+	SDL_Event event{};
+	event.type = SDL_QUIT;
+	SDL_PushEvent(&event);
+}
+
 void GLSampleWindow::setTitle(const std::string &title) {
 
 	nekomimi::MIMIWindow::setTitle(title + " - OpenGL version " + this->getRenderInterface()->getAPIVersion());
@@ -559,6 +793,14 @@ void GLSampleWindow::debug(const bool enable) {
 
 	fragcore::GLRendererInterface *interface = this->getGLRenderInterface();
 	interface->setDebug(enable);
+
+	/*	Queries issued before the toggle belong to frames long gone, discard them rather than reading stale results.	*/
+	if (this->debugGL != enable && this->benchmark == nullptr) {
+		for (DebugQuerySet &querySet : this->debugQueries) {
+			querySet.issued = false;
+		}
+		this->debugQueryIndex = 0;
+	}
 	this->debugGL = enable;
 
 	if (enable) {
@@ -14,14 +14,16 @@
  * all copies or substantial portions of the Software.
  */
 #pragma once
+#include "BenchmarkRecorder.h"
 #include "FPSCounter.h"
+#include "FrameRingAllocator.h"
 #include "GLRendererInterface.h"
 #include "PostProcessing/ColorSpaceConverter.h"
 #include "PostProcessing/PostProcessingManager.h"
 #include "SDLInput.h"
 #include "SampleHelper.h"
 #include "TaskScheduler/IScheduler.h"
-#include <Core/Time.h>
+#include "Util/SampleTime.h"
 #include <IO/IFileSystem.h>
 #include <MIMIWindow.h>
 #include <ProceduralGeometry.h>
@@ -68,12 +70,19 @@ class FVDECLSPEC GLSampleWindow : public nekomimi::MIMIWindow {
 	glsample::FPSCounter<float> &getFPSCounter() noexcept { return this->fpsCounter; }
 	const glsample::FPSCounter<float> &getFPSCounter() const noexcept { return this->fpsCounter; }
 
-	const fragcore::Time &getTimer() const noexcept { return this->time; }
-	fragcore::Time &getTimer() noexcept { return this->time; }
+	const glsample::SampleTime &getTimer() const noexcept { return this->time; }
+	glsample::SampleTime &getTimer() noexcept { return this->time; }
 
 	size_t getFrameCount() const noexcept { return this->frameCount; }
 
 	size_t getFrameBufferIndex() const noexcept { return this->frameBufferIndex; }
+
+	/**
+	 * @brief Uniform and storage data of the current frame, fenced at the end of the frame.
+	 */
+	glsample::FrameRingAllocator &getFrameAllocator() noexcept { return this->frameAllocator; }
+	const glsample::FrameRingAllocator &getFrameAllocator() const noexcept { return this->frameAllocator; }
+
 	size_t getFrameBufferCount() const noexcept { return this->getNumberFrameBuffers(); }
 
 	bool isDebug() const noexcept;
@@ -119,6 +128,16 @@ class FVDECLSPEC GLSampleWindow : public nekomimi::MIMIWindow {
 	bool isRenderDocEnabled();
 	void captureDebugFrame() noexcept;
 
+	/**
+	 * @brief Benchmark run of the sample, nullptr if not benchmarking.
+	 */
+	glsample::BenchmarkRecorder *getBenchmark() const noexcept { return this->benchmark; }
+
+	/**
+	 * @brief Chrome trace output of the profiler captures.
+	 */
+	const std::string &getTraceOutput() const noexcept { return this->traceOutput; }
+
 	spdlog::logger &getLogger() const noexcept { return *this->logger; }
 
   public:
@@ -144,11 +163,17 @@ class FVDECLSPEC GLSampleWindow : public nekomimi::MIMIWindow {
 
 	void internalInit();
 
+	void beginDebugQueries();
+	void endDebugQueries();
+	void readDebugQueries(const size_t query_set_index);
+	void finishBenchmark();
+
   private:
 	cxxopts::ParseResult parseResult;
 	glsample::FPSCounter<float> fpsCounter;
-	fragcore::Time time;
+	glsample::SampleTime time;
 	fragcore::SDLInput input;
+	glsample::FrameRingAllocator frameAllocator;
 	bool debugGL = true;
 
 	glsample::PostProcessingManager *postprocessingManager = nullptr;
@@ -158,7 +183,16 @@ class FVDECLSPEC GLSampleWindow : public nekomimi::MIMIWindow {
 	size_t frameCount = 0;
 	size_t frameBufferIndex = 0;
 	size_t frameBufferCount = 0;
-	std::array<unsigned int, 10> queries;
+
+	/*	Debug queries, one set per frame in flight, read back N-1 frames later to avoid stalling.	*/
+	static constexpr size_t nrDebugQueries = 7;
+	using DebugQuerySet = struct debug_query_set_t {
+		std::array<unsigned int, nrDebugQueries> queries;
+		size_t frame = 0;
+		bool issued = false;
+	};
+	std::vector<DebugQuerySet> debugQueries;
+	size_t debugQueryIndex = 0;
 	fragcore::IFileSystem *filesystem; /*	*/
 
 	int preWidth = -1;
@@ -167,6 +201,10 @@ class FVDECLSPEC GLSampleWindow : public nekomimi::MIMIWindow {
 	glsample::FrameBuffer *defaultFramebuffer = nullptr;
 	glsample::FrameBuffer *MMSAFrameBuffer = nullptr;
 
+	glsample::BenchmarkRecorder *benchmark = nullptr;
+	std::string benchmarkOutput;
+	std::string traceOutput;
+
   protected:
 	spdlog::logger *logger = nullptr;
 	void *rdoc_api = nullptr;
@@ -0,0 +1,200 @@
+#include "GPUCulling.h"
+#include "IOUtil.h"
+#include "Profiler.h"
+#include <GL/glew.h>
+#include <ShaderLoader.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace fragcore;
+
+namespace glsample {
+
+	GPUCulling::~GPUCulling() { this->release(); }
+
+	void GPUCulling::init(fragcore::IFileSystem *filesystem) {
+
+		/*	*/
+		const std::string computeCullingShaderPath = "Shaders/culling/culling_indirect_count.comp.spv";
+
+		/*	Load shader binaries.	*/
+		const std::vector<uint32_t> culling_binary =
+			IOUtil::readFileData<uint32_t>(computeCullingShaderPath, filesystem);
+
+		/*	*/
+		fragcore::ShaderCompiler::CompilerConvertOption compilerOptions;
+		compilerOptions.target = fragcore::ShaderLanguage::GLSL;
+		compilerOptions.glslVersion = 460;
+
+		this->cull_program = ShaderLoader::loadComputeProgram(compilerOptions, &culling_binary);
+
+		/*	Setup compute pipeline.	*/
+		glUseProgram(this->cull_program);
+		const int uniform_buffer_index = glGetUniformBlockIndex(this->cull_program, "UniformBufferBlock");
+		glUniformBlockBinding(this->cull_program, uniform_buffer_index, this->uniform_buffer_binding);
+		glUniform1i(glGetUniformLocation(this->cull_program, "DepthPyramid"), this->pyramid_texture_binding);
+
+		const std::pair<const char *, unsigned int> storageBlocks[] = {
+			{"CullDrawBuffer", this->draw_buffer_binding},	   {"CullBucketBuffer", this->bucket_buffer_binding},
+			{"NodeBuffer", this->node_buffer_binding},		   {"CommandBuffer", this->command_buffer_binding},
+			{"DrawCountBuffer", this->draw_count_buffer_binding}};
+		for (const auto &block : storageBlocks) {
+			const unsigned int block_index =
+				glGetProgramResourceIndex(this->cull_program, GL_SHADER_STORAGE_BLOCK, block.first);
+			glShaderStorageBlockBinding(this->cull_program, block_index, block.second);
+		}
+		glUseProgram(0);
+
+		/*	Nearest texel of the level, never filtered between depths.	*/
+		glCreateSamplers(1, &this->pyramid_sampler);
+		glSamplerParameteri(this->pyramid_sampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glSamplerParameteri(this->pyramid_sampler, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glSamplerParameteri(this->pyramid_sampler, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glSamplerParameteri(this->pyramid_sampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+
+		/*	*/
+		glGenBuffers(1, &this->uniform_buffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(UniformBlock), nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	void GPUCulling::release() {
+		if (this->cull_program > 0) {
+			glDeleteProgram(this->cull_program);
+			this->cull_program = 0;
+		}
+		if (this->pyramid_sampler) {
+			glDeleteSamplers(1, &this->pyramid_sampler);
+			this->pyramid_sampler = 0;
+		}
+
+		/*	*/
+		for (unsigned int *buffer : {&this->uniform_buffer, &this->draw_buffer, &this->bucket_buffer,
+									 &this->command_buffer, &this->draw_count_buffer}) {
+			if (*buffer) {
+				glDeleteBuffers(1, buffer);
+				*buffer = 0;
+			}
+		}
+		this->nrDraws = 0;
+		this->buckets.clear();
+	}
+
+	bool GPUCulling::isSupported() const noexcept {
+		return this->cull_program > 0 && glMultiDrawElementsIndirectCountARB;
+	}
+
+	void GPUCulling::setDraws(const std::vector<CullDraw> &draws, const std::vector<CullBucket> &buckets) {
+
+		/*	Command capacity of all buckets.	*/
+		size_t nrCommands = 0;
+		for (const CullBucket &bucket : buckets) {
+			nrCommands = std::max<size_t>(nrCommands, bucket.offset + bucket.capacity);
+		}
+
+		for (unsigned int *buffer :
+			 {&this->draw_buffer, &this->bucket_buffer, &this->command_buffer, &this->draw_count_buffer}) {
+			if (*buffer) {
+				glDeleteBuffers(1, buffer);
+				*buffer = 0;
+			}
+		}
+
+		this->nrDraws = draws.size();
+		this->buckets = buckets;
+		if (draws.empty() || buckets.empty()) {
+			this->nrDraws = 0;
+			return;
+		}
+
+		glGenBuffers(1, &this->draw_buffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->draw_buffer);
+		glBufferStorage(GL_SHADER_STORAGE_BUFFER, draws.size() * sizeof(CullDraw), draws.data(), 0);
+
+		glGenBuffers(1, &this->bucket_buffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->bucket_buffer);
+		glBufferStorage(GL_SHADER_STORAGE_BUFFER, buckets.size() * sizeof(CullBucket), buckets.data(), 0);
+
+		glGenBuffers(1, &this->command_buffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->command_buffer);
+		glBufferStorage(GL_SHADER_STORAGE_BUFFER, nrCommands * sizeof(DrawElementsIndirectCommand), nullptr, 0);
+
+		/*	One count per bucket, cleared before each dispatch.	*/
+		glGenBuffers(1, &this->draw_count_buffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->draw_count_buffer);
+		glBufferStorage(GL_SHADER_STORAGE_BUFFER, buckets.size() * sizeof(GLuint), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	void GPUCulling::setDepthPyramid(const unsigned int texture, const unsigned int width, const unsigned int height,
+									 const unsigned int levels, const glm::mat4 &viewProjection) noexcept {
+		this->pyramidTexture = texture;
+		this->uniformStage.occlusionViewProjection = viewProjection;
+		this->uniformStage.pyramidSize = glm::vec2(width, height);
+		this->uniformStage.pyramidLevels = texture ? levels : 0;
+	}
+
+	void GPUCulling::cull(const glm::vec4 *planes, const unsigned int nodeBuffer, const size_t nodeOffset,
+						  const size_t nodeSize) {
+		if (this->nrDraws == 0) {
+			return;
+		}
+
+		/*	*/
+		std::memcpy(this->uniformStage.planes, planes, sizeof(this->uniformStage.planes));
+		this->uniformStage.nrDraws = static_cast<unsigned int>(this->nrDraws);
+
+		glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(this->uniformStage), &this->uniformStage);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		/*	Reset the visible count of each bucket.	*/
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->draw_count_buffer);
+		glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+		Profiler::pushScope("GPU Culling");
+
+		glUseProgram(this->cull_program);
+
+		glBindBufferBase(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->draw_buffer_binding, this->draw_buffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->bucket_buffer_binding, this->bucket_buffer);
+		glBindBufferRange(GL_SHADER_STORAGE_BUFFER, this->node_buffer_binding, nodeBuffer, nodeOffset, nodeSize);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->command_buffer_binding, this->command_buffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->draw_count_buffer_binding, this->draw_count_buffer);
+
+		if (this->uniformStage.pyramidLevels > 0) {
+			glActiveTexture(GL_TEXTURE0 + this->pyramid_texture_binding);
+			glBindTexture(GL_TEXTURE_2D, this->pyramidTexture);
+			glBindSampler(this->pyramid_texture_binding, this->pyramid_sampler);
+		}
+
+		glDispatchCompute(std::ceil(this->nrDraws / (float)this->localWorkGroupSize), 1, 1);
+
+		/*	Commands and counts are consumed by the indirect draws.	*/
+		glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+		if (this->uniformStage.pyramidLevels > 0) {
+			glBindSampler(this->pyramid_texture_binding, 0);
+		}
+		glUseProgram(0);
+
+		Profiler::popScope();
+	}
+
+	void GPUCulling::draw(const size_t bucket, const unsigned int primitive, const unsigned int indexType) const {
+		const CullBucket &range = this->buckets[bucket];
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, this->command_buffer);
+		glBindBuffer(GL_PARAMETER_BUFFER_ARB, this->draw_count_buffer);
+
+		const void *commands = reinterpret_cast<const void *>(range.offset * sizeof(DrawElementsIndirectCommand));
+		const GLintptr drawCount = bucket * sizeof(GLuint);
+		glMultiDrawElementsIndirectCountARB(primitive, indexType, commands, drawCount, range.capacity, 0);
+	}
+
+} // namespace glsample
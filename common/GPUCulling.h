@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "FragDef.h"
+#include "GLSampleSession.h"
+#include <IO/FileSystem.h>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace glsample {
+
+	/**
+	 * @brief Frustum and hierarchical depth culling of indirect draws in a compute shader.
+	 *
+	 * The visible draws of each bucket are compacted into the command buffer, and the number of visible
+	 * draws is written to the draw count buffer, consumed by glMultiDrawElementsIndirectCount. The CPU
+	 * cost per frame is a single dispatch, independent of the number of draws.
+	 */
+	class FVDECLSPEC GPUCulling {
+	  public:
+		/*	Matches the CullDraw struct of the compute shader, std430.	*/
+		using CullDraw = struct cull_draw_t {
+			glm::vec3 boundMin; /*	Local space bound.	*/
+			uint32_t node;		/*	Index of the model matrix.	*/
+			glm::vec3 boundMax;
+			uint32_t bucket;
+			uint32_t count;
+			uint32_t firstIndex;
+			int32_t baseVertex;
+			uint32_t baseInstance;
+		};
+
+		/*	Range of the command buffer owned by the bucket.	*/
+		using CullBucket = struct cull_bucket_t {
+			uint32_t offset;
+			uint32_t capacity;
+		};
+
+		GPUCulling() = default;
+		GPUCulling(const GPUCulling &) = delete;
+		GPUCulling &operator=(const GPUCulling &) = delete;
+		virtual ~GPUCulling();
+
+		/**
+		 * @brief Load the culling compute program.
+		 */
+		void init(fragcore::IFileSystem *filesystem);
+
+		void release();
+
+		/**
+		 * @brief Check if the program is loaded and the driver supports indirect draw count.
+		 */
+		bool isSupported() const noexcept;
+
+		/**
+		 * @brief Upload the draws, only required when the draws or buckets are changed.
+		 */
+		void setDraws(const std::vector<CullDraw> &draws, const std::vector<CullBucket> &buckets);
+
+		/**
+		 * @brief Depth pyramid of the previous frame, with the farthest depth per texel in each level.
+		 *
+		 * @param texture 0 to disable the occlusion test.
+		 * @param viewProjection view projection the depth buffer was rendered with.
+		 */
+		void setDepthPyramid(const unsigned int texture, const unsigned int width, const unsigned int height,
+							 const unsigned int levels, const glm::mat4 &viewProjection) noexcept;
+
+		/**
+		 * @brief Dispatch the culling of all draws.
+		 *
+		 * @param planes the six normalized plane equations, see Frustum::getPlaneEquations.
+		 * @param nodeBuffer buffer with the model matrices, bound from nodeOffset.
+		 */
+		void cull(const glm::vec4 *planes, const unsigned int nodeBuffer, const size_t nodeOffset,
+				  const size_t nodeSize);
+
+		/**
+		 * @brief Draw the visible draws of the bucket, the vertex array must be bound.
+		 */
+		void draw(const size_t bucket, const unsigned int primitive, const unsigned int indexType) const;
+
+		size_t getNrDraws() const noexcept { return this->nrDraws; }
+		size_t getNrBuckets() const noexcept { return this->buckets.size(); }
+
+	  private:
+		using UniformBlock = struct alignas(16) uniform_block_t {
+			glm::mat4 occlusionViewProjection;
+			glm::vec4 planes[6];
+			glm::vec2 pyramidSize;
+			unsigned int pyramidLevels;
+			unsigned int nrDraws;
+		};
+
+		UniformBlock uniformStage{};
+		std::vector<CullBucket> buckets;
+		size_t nrDraws = 0;
+		unsigned int pyramidTexture = 0;
+
+		int cull_program = 0;
+		unsigned int pyramid_sampler = 0;
+		unsigned int uniform_buffer = 0;
+		unsigned int draw_buffer = 0;
+		unsigned int bucket_buffer = 0;
+		unsigned int command_buffer = 0;
+		unsigned int draw_count_buffer = 0;
+
+		const unsigned int localWorkGroupSize = 64;
+
+		/*	*/
+		unsigned int uniform_buffer_binding = 0;
+		unsigned int pyramid_texture_binding = 1;
+		unsigned int draw_buffer_binding = 2;
+		unsigned int bucket_buffer_binding = 3;
+		unsigned int node_buffer_binding = 4;
+		unsigned int command_buffer_binding = 5;
+		unsigned int draw_count_buffer_binding = 6;
+	};
+
+} // namespace glsample
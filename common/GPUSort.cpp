@@ -0,0 +1,355 @@
+#include "GPUSort.h"
+#include "IOUtil.h"
+#include "Util/TaskParallel.h"
+#include <GL/glew.h>
+#include <ShaderLoader.h>
+#include <algorithm>
+#include <utility>
+
+using namespace fragcore;
+
+namespace glsample {
+
+	/*	Matches the BITONIC_MODE of Shaders/sort/sort.glsl.	*/
+	enum BitonicMode : uint32_t {
+		BitonicLocalSort = 0,
+		BitonicGlobalStep = 1,
+		BitonicLocalMerge = 2,
+	};
+
+	GPUSort::~GPUSort() { this->release(); }
+
+	void GPUSort::init(fragcore::IFileSystem *filesystem) {
+
+		/*	*/
+		fragcore::ShaderCompiler::CompilerConvertOption compilerOptions;
+		compilerOptions.target = fragcore::ShaderLanguage::GLSL;
+		compilerOptions.glslVersion = 460;
+
+		const std::pair<const char *, unsigned int> storageBlocks[] = {
+			{"SortKeysIn", this->key_in_binding},		{"SortValuesIn", this->value_in_binding},
+			{"SortKeysOut", this->key_out_binding},		{"SortValuesOut", this->value_out_binding},
+			{"SortScanData", this->scan_data_binding}, {"SortScanSums", this->scan_sums_binding}};
+
+		auto loadProgram = [&](const std::string &path) {
+			const std::vector<uint32_t> binary = IOUtil::readFileData<uint32_t>(path, filesystem);
+			const int program = ShaderLoader::loadComputeProgram(compilerOptions, &binary);
+
+			/*	Setup compute pipeline.	*/
+			glUseProgram(program);
+			const int uniform_buffer_index = glGetUniformBlockIndex(program, "UniformSortBufferBlock");
+			glUniformBlockBinding(program, uniform_buffer_index, this->uniform_buffer_binding);
+
+			for (const auto &block : storageBlocks) {
+				const unsigned int block_index =
+					glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, block.first);
+				if (block_index != GL_INVALID_INDEX) {
+					glShaderStorageBlockBinding(program, block_index, block.second);
+				}
+			}
+			glUseProgram(0);
+			return program;
+		};
+
+		this->radix_count_program = loadProgram("Shaders/sort/radix_count.comp.spv");
+		this->radix_scan_program = loadProgram("Shaders/sort/radix_scan.comp.spv");
+		this->radix_scan_add_program = loadProgram("Shaders/sort/radix_scan_add.comp.spv");
+		this->radix_scatter_program = loadProgram("Shaders/sort/radix_scatter.comp.spv");
+		this->bitonic_program = loadProgram("Shaders/sort/bitonic.comp.spv");
+
+		/*	*/
+		GLint minMapBufferSize = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
+		this->uniformAlignSize = Math::align<size_t>(sizeof(UniformBlock), (size_t)minMapBufferSize);
+
+		glGenBuffers(1, &this->uniform_buffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
+		glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignSize * this->nrUniformPasses, nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	void GPUSort::release() {
+		for (int *program : {&this->radix_count_program, &this->radix_scan_program, &this->radix_scan_add_program,
+							 &this->radix_scatter_program, &this->bitonic_program}) {
+			if (*program > 0) {
+				glDeleteProgram(*program);
+				*program = 0;
+			}
+		}
+
+		/*	*/
+		for (unsigned int *buffer : {&this->uniform_buffer, &this->temp_key_buffer, &this->temp_value_buffer}) {
+			if (*buffer) {
+				glDeleteBuffers(1, buffer);
+				*buffer = 0;
+			}
+		}
+		if (!this->scanBuffers.empty()) {
+			glDeleteBuffers(this->scanBuffers.size(), this->scanBuffers.data());
+			this->scanBuffers.clear();
+			this->scanCapacity.clear();
+		}
+		this->tempKeyCapacity = 0;
+		this->tempValueCapacity = 0;
+	}
+
+	void GPUSort::reserveBuffer(unsigned int &buffer, size_t &capacity, const size_t size) {
+		if (buffer != 0 && size <= capacity) {
+			return;
+		}
+		if (buffer == 0) {
+			glGenBuffers(1, &buffer);
+		}
+
+		capacity = std::max<size_t>(size, 64);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, capacity, nullptr, GL_DYNAMIC_COPY);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	void GPUSort::setPass(const UniformBlock &params) {
+		/*	Buffer updates are ordered with the dispatches, the ring only avoids waiting on them.	*/
+		const size_t offset = (this->uniformPass++ % this->nrUniformPasses) * this->uniformAlignSize;
+
+		glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, offset, sizeof(params), &params);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer, offset,
+						  sizeof(params));
+	}
+
+	void GPUSort::scan(const size_t level, const size_t count) {
+
+		const size_t nrGroups = (count + scanBlockSize - 1) / scanBlockSize;
+
+		UniformBlock params{};
+		params.count = static_cast<uint32_t>(count);
+
+		/*	Scan each group, and write the group totals to the next level.	*/
+		this->setPass(params);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->scan_data_binding, this->scanBuffers[level]);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->scan_sums_binding, this->scanBuffers[level + 1]);
+		glUseProgram(this->radix_scan_program);
+		glDispatchCompute(nrGroups, 1, 1);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+		if (nrGroups > 1) {
+			this->scan(level + 1, nrGroups);
+
+			/*	Add the scanned group totals.	*/
+			this->setPass(params);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->scan_data_binding, this->scanBuffers[level]);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->scan_sums_binding, this->scanBuffers[level + 1]);
+			glUseProgram(this->radix_scan_add_program);
+			glDispatchCompute(nrGroups, 1, 1);
+			glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		}
+	}
+
+	void GPUSort::sortRadix(const unsigned int keyBuffer, const unsigned int valueBuffer, const size_t count,
+							const unsigned int keyBits) {
+		if (count <= 1) {
+			return;
+		}
+
+		const bool hasValues = valueBuffer != 0;
+		const size_t nrBlocks = (count + radixBlockSize - 1) / radixBlockSize;
+		const size_t histogramSize = nrBlocks * radixSize;
+
+		reserveBuffer(this->temp_key_buffer, this->tempKeyCapacity, count * sizeof(uint32_t));
+		if (hasValues) {
+			reserveBuffer(this->temp_value_buffer, this->tempValueCapacity, count * sizeof(uint32_t));
+		}
+
+		/*	Histogram, and the block sums of each scan level, until a single scan group remains.	*/
+		std::vector<size_t> levelSizes = {histogramSize};
+		while (true) {
+			const size_t size = levelSizes.back();
+			levelSizes.push_back((size + scanBlockSize - 1) / scanBlockSize);
+			if (size <= scanBlockSize) {
+				break;
+			}
+		}
+		if (this->scanBuffers.size() < levelSizes.size()) {
+			this->scanBuffers.resize(levelSizes.size(), 0);
+			this->scanCapacity.resize(levelSizes.size(), 0);
+		}
+		for (size_t i = 0; i < levelSizes.size(); i++) {
+			reserveBuffer(this->scanBuffers[i], this->scanCapacity[i], levelSizes[i] * sizeof(uint32_t));
+		}
+
+		unsigned int sourceKeys = keyBuffer;
+		unsigned int sourceValues = hasValues ? valueBuffer : keyBuffer;
+		unsigned int destinationKeys = this->temp_key_buffer;
+		unsigned int destinationValues = hasValues ? this->temp_value_buffer : this->temp_key_buffer;
+
+		const unsigned int nrPasses = (std::min(keyBits, 32u) + radixBits - 1) / radixBits;
+		for (unsigned int pass = 0; pass < nrPasses; pass++) {
+
+			UniformBlock params{};
+			params.count = static_cast<uint32_t>(count);
+			params.hasValues = hasValues ? 1 : 0;
+			params.shift = pass * radixBits;
+			params.nrBlocks = static_cast<uint32_t>(nrBlocks);
+
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->key_in_binding, sourceKeys);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->value_in_binding, sourceValues);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->key_out_binding, destinationKeys);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->value_out_binding, destinationValues);
+
+			/*	Digit count of each block.	*/
+			this->setPass(params);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->scan_data_binding, this->scanBuffers[0]);
+			glUseProgram(this->radix_count_program);
+			glDispatchCompute(nrBlocks, 1, 1);
+			glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+			/*	Output offset of each digit and block.	*/
+			this->scan(0, histogramSize);
+
+			/*	Stable scatter to the offsets.	*/
+			this->setPass(params);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->scan_data_binding, this->scanBuffers[0]);
+			glUseProgram(this->radix_scatter_program);
+			glDispatchCompute(nrBlocks, 1, 1);
+			glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+			std::swap(sourceKeys, destinationKeys);
+			std::swap(sourceValues, destinationValues);
+		}
+		glUseProgram(0);
+
+		/*	Odd number of passes, the result is in the temporary buffers.	*/
+		if (sourceKeys != keyBuffer) {
+			glBindBuffer(GL_COPY_READ_BUFFER, sourceKeys);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, keyBuffer);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, count * sizeof(uint32_t));
+			if (hasValues) {
+				glBindBuffer(GL_COPY_READ_BUFFER, sourceValues);
+				glBindBuffer(GL_COPY_WRITE_BUFFER, valueBuffer);
+				glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, count * sizeof(uint32_t));
+			}
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		}
+
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT |
+						GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+	}
+
+	void GPUSort::sortBitonic(const unsigned int keyBuffer, const unsigned int valueBuffer, const size_t count) {
+		if (count <= 1) {
+			return;
+		}
+
+		const bool hasValues = valueBuffer != 0;
+		const size_t nrBlocks = (count + bitonicBlockSize - 1) / bitonicBlockSize;
+
+		/*	Sorted as if padded to the power of two with the largest keys.	*/
+		size_t paddedCount = bitonicBlockSize;
+		while (paddedCount < count) {
+			paddedCount <<= 1;
+		}
+
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->key_in_binding, keyBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, this->value_in_binding, hasValues ? valueBuffer : keyBuffer);
+		glUseProgram(this->bitonic_program);
+
+		UniformBlock params{};
+		params.count = static_cast<uint32_t>(count);
+		params.hasValues = hasValues ? 1 : 0;
+
+		/*	Sort each block in shared memory.	*/
+		params.mode = BitonicLocalSort;
+		this->setPass(params);
+		glDispatchCompute(nrBlocks, 1, 1);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+		/*	Merge the sequences, the compare distances within a block are done in shared memory.	*/
+		for (size_t sequenceSize = bitonicBlockSize * 2; sequenceSize <= paddedCount; sequenceSize <<= 1) {
+			params.sequenceSize = static_cast<uint32_t>(sequenceSize);
+
+			for (size_t distance = sequenceSize / 2; distance >= bitonicBlockSize; distance >>= 1) {
+				params.mode = BitonicGlobalStep;
+				params.compareDistance = static_cast<uint32_t>(distance);
+				this->setPass(params);
+				glDispatchCompute(paddedCount / 2 / bitonicWorkGroupSize, 1, 1);
+				glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+			}
+
+			params.mode = BitonicLocalMerge;
+			this->setPass(params);
+			glDispatchCompute(nrBlocks, 1, 1);
+			glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		}
+		glUseProgram(0);
+
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT |
+						GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+	}
+
+	void GPUSort::sort(const unsigned int keyBuffer, const unsigned int valueBuffer, const size_t count) {
+		if (count <= this->bitonicThreshold) {
+			this->sortBitonic(keyBuffer, valueBuffer, count);
+		} else {
+			this->sortRadix(keyBuffer, valueBuffer, count);
+		}
+	}
+
+	void GPUSort::sortCPU(uint32_t *keys, uint32_t *values, const size_t count) {
+		if (count <= 1) {
+			return;
+		}
+
+		/*	8 bit digits, each chunk has its own offsets to keep the scatter stable.	*/
+		const size_t digitSize = 256;
+		const size_t grainSize = 1 << 16;
+		const size_t nrChunks = (count + grainSize - 1) / grainSize;
+
+		std::vector<uint32_t> tempKeys(count);
+		std::vector<uint32_t> tempValues(values ? count : 0);
+		std::vector<size_t> offsets(nrChunks * digitSize);
+
+		uint32_t *sourceKeys = keys;
+		uint32_t *sourceValues = values;
+		uint32_t *destinationKeys = tempKeys.data();
+		uint32_t *destinationValues = values ? tempValues.data() : nullptr;
+
+		for (unsigned int shift = 0; shift < 32; shift += 8) {
+			std::fill(offsets.begin(), offsets.end(), 0);
+
+			parallelFor(count, grainSize, [&](const size_t begin, const size_t end) {
+				size_t *chunkCounts = &offsets[(begin / grainSize) * digitSize];
+				for (size_t i = begin; i < end; i++) {
+					chunkCounts[(sourceKeys[i] >> shift) & 0xFF]++;
+				}
+			});
+
+			/*	Digit major exclusive scan.	*/
+			size_t offset = 0;
+			for (size_t digit = 0; digit < digitSize; digit++) {
+				for (size_t chunk = 0; chunk < nrChunks; chunk++) {
+					const size_t digitCount = offsets[chunk * digitSize + digit];
+					offsets[chunk * digitSize + digit] = offset;
+					offset += digitCount;
+				}
+			}
+
+			parallelFor(count, grainSize, [&](const size_t begin, const size_t end) {
+				size_t *chunkOffsets = &offsets[(begin / grainSize) * digitSize];
+				for (size_t i = begin; i < end; i++) {
+					const size_t destination = chunkOffsets[(sourceKeys[i] >> shift) & 0xFF]++;
+					destinationKeys[destination] = sourceKeys[i];
+					if (sourceValues) {
+						destinationValues[destination] = sourceValues[i];
+					}
+				}
+			});
+
+			std::swap(sourceKeys, destinationKeys);
+			std::swap(sourceValues, destinationValues);
+		}
+		/*	Even number of passes, the result is back in the input arrays.	*/
+	}
+
+} // namespace glsample
@@ -0,0 +1,150 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "FragDef.h"
+#include <IO/FileSystem.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace glsample {
+
+	/**
+	 * @brief Sort 32 bit keys, with optional 32 bit values, in shader storage buffers.
+	 *
+	 * The LSD radix sort handles any number of elements, with a count, scan and stable scatter pass for each
+	 * 4 bit digit. The bitonic sort needs fewer dispatches for small batches. Both sort ascending and in
+	 * place. sortCPU is the multithreaded fallback when the data is on the CPU.
+	 */
+	class FVDECLSPEC GPUSort {
+	  public:
+		enum class Algorithm : unsigned int {
+			Radix,	 /*	*/
+			Bitonic, /*	*/
+			CPU		 /*	*/
+		};
+
+		GPUSort() = default;
+		GPUSort(const GPUSort &) = delete;
+		GPUSort &operator=(const GPUSort &) = delete;
+		virtual ~GPUSort();
+
+		/**
+		 * @brief Load the sort compute programs.
+		 */
+		void init(fragcore::IFileSystem *filesystem);
+
+		void release();
+
+		/**
+		 * @brief Radix sort of the keys, and the values along them.
+		 *
+		 * @param valueBuffer 0 to only sort the keys.
+		 * @param keyBits only the lower bits of the keys are sorted, rounded up to the digit size.
+		 */
+		void sortRadix(const unsigned int keyBuffer, const unsigned int valueBuffer, const size_t count,
+					   const unsigned int keyBits = 32);
+
+		/**
+		 * @brief Bitonic sort of the keys, and the values along them.
+		 *
+		 * @param valueBuffer 0 to only sort the keys.
+		 */
+		void sortBitonic(const unsigned int keyBuffer, const unsigned int valueBuffer, const size_t count);
+
+		/**
+		 * @brief Bitonic sort up to the bitonic threshold, radix sort otherwise.
+		 */
+		void sort(const unsigned int keyBuffer, const unsigned int valueBuffer, const size_t count);
+
+		void setBitonicThreshold(const size_t threshold) noexcept { this->bitonicThreshold = threshold; }
+		size_t getBitonicThreshold() const noexcept { return this->bitonicThreshold; }
+
+		/**
+		 * @brief Multithreaded stable LSD radix sort on the CPU.
+		 *
+		 * @param values nullptr to only sort the keys.
+		 */
+		static void sortCPU(uint32_t *keys, uint32_t *values, const size_t count);
+
+		/**
+		 * @brief Key with the same order as the float, including negative values.
+		 */
+		static uint32_t floatToKey(const float value) noexcept {
+			uint32_t bits = 0;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+		}
+
+	  private:
+		/*	Matches UniformSortBufferBlock in Shaders/sort/sort.glsl.	*/
+		using UniformBlock = struct uniform_block_t {
+			uint32_t count;
+			uint32_t hasValues;
+			uint32_t shift;
+			uint32_t nrBlocks;
+			uint32_t sequenceSize;
+			uint32_t compareDistance;
+			uint32_t mode;
+			uint32_t _pad;
+		};
+
+		void setPass(const UniformBlock &params);
+		void scan(const size_t level, const size_t count);
+		static void reserveBuffer(unsigned int &buffer, size_t &capacity, const size_t size);
+
+		static const unsigned int workGroupSize = 256;
+		static const unsigned int radixBits = 4;
+		static const unsigned int radixSize = 1 << radixBits;
+		static const unsigned int radixBlockSize = workGroupSize * 16;
+		static const unsigned int scanBlockSize = workGroupSize * 4;
+		static const unsigned int bitonicWorkGroupSize = 512;
+		static const unsigned int bitonicBlockSize = bitonicWorkGroupSize * 2;
+
+		size_t bitonicThreshold = 1 << 14;
+
+		int radix_count_program = 0;
+		int radix_scan_program = 0;
+		int radix_scan_add_program = 0;
+		int radix_scatter_program = 0;
+		int bitonic_program = 0;
+
+		/*	Ring of pass parameters, bound as a range for each dispatch.	*/
+		unsigned int uniform_buffer = 0;
+		size_t uniformAlignSize = sizeof(UniformBlock);
+		const size_t nrUniformPasses = 256;
+		size_t uniformPass = 0;
+
+		unsigned int temp_key_buffer = 0;
+		unsigned int temp_value_buffer = 0;
+		size_t tempKeyCapacity = 0;
+		size_t tempValueCapacity = 0;
+
+		/*	Histogram, followed by the block sums of each scan level.	*/
+		std::vector<unsigned int> scanBuffers;
+		std::vector<size_t> scanCapacity;
+
+		/*	Not shared with the scene bindings.	*/
+		unsigned int uniform_buffer_binding = 8;
+		unsigned int key_in_binding = 10;
+		unsigned int value_in_binding = 11;
+		unsigned int key_out_binding = 12;
+		unsigned int value_out_binding = 13;
+		unsigned int scan_data_binding = 14;
+		unsigned int scan_sums_binding = 15;
+	};
+
+} // namespace glsample
@@ -19,6 +19,7 @@
 #include <IO/FileSystem.h>
 #include <IO/IOUtil.h>
 #include <fmt/format.h>
+#include <string>
 #include <vector>
 
 namespace glsample {
@@ -49,5 +50,22 @@ namespace glsample {
 			ref->close();
 			return buffer;
 		}
+
+		/**
+		 * @brief Escape the quotes and backslashes of a JSON string value, control characters are dropped.
+		 */
+		static std::string escapeJSON(const std::string &value) {
+			std::string escaped;
+			escaped.reserve(value.size());
+			for (const char c : value) {
+				if (c == '"' || c == '\\') {
+					escaped.push_back('\\');
+				}
+				if (static_cast<unsigned char>(c) >= 0x20) {
+					escaped.push_back(c);
+				}
+			}
+			return escaped;
+		}
 	};
 } // namespace glsample
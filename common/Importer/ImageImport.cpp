@@ -5,6 +5,7 @@
 #include <cmath>
 #include <limits>
 #include <magic_enum.hpp>
+#include <optional>
 
 using namespace fragcore;
 using namespace glsample;
@@ -18,12 +19,27 @@ TextureImporter::~TextureImporter() { glDeleteBuffers(3, this->pbos.data()); }
 int TextureImporter::loadImage2D(const std::string &path, const ColorSpace colorSpace,
 								 const TextureCompression compression) {
 
-	ImageLoader imageLoader;
-	Ref<IO> io = Ref<IO>(this->filesystem->openFile(path.c_str(), IO::IOMode::READ));
-	Image image = imageLoader.loadImage(io);
-	io->close();
+	int texture_index = -1;
+
+	/*	Block compressed on the CPU, and cached next to the image file.	*/
+	if (compression == TextureCompression::Default || compression == TextureCompression::BPTC) {
+		CompressedImage compressed;
+		std::optional<Image> image;
+		if (TextureCompressor::loadImage(this->filesystem->getAbsolutePath(path.c_str()), compression, colorSpace,
+										 false, compressed, image)) {
+			texture_index = this->loadCompressedImage2D(compressed);
+		} else {
+			texture_index = this->loadImage2DRaw(image.value(), colorSpace, compression);
+		}
+	} else {
+		ImageLoader imageLoader;
+		Ref<IO> io = Ref<IO>(this->filesystem->openFile(path.c_str(), IO::IOMode::READ));
+		Image image = imageLoader.loadImage(io);
+		io->close();
+
+		texture_index = this->loadImage2DRaw(image, colorSpace, compression);
+	}
 
-	int texture_index = this->loadImage2DRaw(image, colorSpace);
 	if (texture_index >= 0) {
 		glObjectLabel(GL_TEXTURE, texture_index, path.size(), path.data());
 	}
@@ -32,6 +48,85 @@ int TextureImporter::loadImage2D(const std::string &path, const ColorSpace color
 
 int TextureImporter::loadImage2DRaw(const Image &image, const ColorSpace colorSpace,
 									const TextureCompression compression) {
+	if (TextureCompressor::isSupported(image.getFormat(), compression)) {
+		return this->loadCompressedImage2D(TextureCompressor::compress(image, compression, colorSpace));
+	}
+	return this->createImage2D(image, image.getPixelData(), colorSpace, compression);
+}
+
+int TextureImporter::loadImage2DFromBuffer(const Image &image, const size_t bufferOffset, const ColorSpace colorSpace,
+										   const TextureCompression compression) {
+	return this->createImage2D(image, reinterpret_cast<const void *>(bufferOffset), colorSpace, compression);
+}
+
+int TextureImporter::loadCompressedImage2D(const CompressedImage &image) {
+	return this->createCompressedImage2D(image, image.data.data());
+}
+
+int TextureImporter::loadCompressedImage2DFromBuffer(const CompressedImage &image, const size_t bufferOffset) {
+	return this->createCompressedImage2D(image, reinterpret_cast<const uint8_t *>(bufferOffset));
+}
+
+static void setImage2DParameters(const GLenum target, const size_t max_mipmap) {
+
+	/*	wrap and filter.	*/
+	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_REPEAT));
+	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_REPEAT));
+	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_WRAP_R, GL_REPEAT));
+
+	/*	Filtering.	*/
+	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
+	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+
+	/*	*/
+	FVALIDATE_GL_CALL(glTexParameterf(target, GL_TEXTURE_MAX_ANISOTROPY_EXT, 16));
+
+	/*	*/
+	const float border[4] = {1, 1, 1, 1};
+	FVALIDATE_GL_CALL(glTexParameterfv(target, GL_TEXTURE_BORDER_COLOR, &border[0]));
+
+	/*	*/
+	FVALIDATE_GL_CALL(glTexParameterf(target, GL_TEXTURE_MIN_LOD, -1000));
+	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_MAX_LOD, 1000));
+
+	FVALIDATE_GL_CALL(glTexParameterf(target, GL_TEXTURE_LOD_BIAS, 0.0f));
+
+	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0));
+
+	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, max_mipmap));
+}
+
+int TextureImporter::createCompressedImage2D(const CompressedImage &image, const uint8_t *blocks) {
+
+	const GLenum target = GL_TEXTURE_2D;
+	GLuint texture = 0;
+
+	const GLenum internalformat = TextureCompressor::getInternalFormat(image.format, image.srgb);
+
+	FVALIDATE_GL_CALL(glGenTextures(1, &texture));
+
+	FVALIDATE_GL_CALL(glBindTexture(target, texture));
+
+	setImage2DParameters(target, image.levelSizes.size() - 1);
+
+	/*	Mip chain is compressed on the CPU, since it can not be generated from compressed data.	*/
+	unsigned int width = image.width;
+	unsigned int height = image.height;
+	for (size_t level = 0; level < image.levelSizes.size(); level++) {
+		FVALIDATE_GL_CALL(glCompressedTexImage2D(target, level, internalformat, width, height, 0,
+												 image.levelSizes[level], blocks + image.levelOffsets[level]));
+
+		width = Math::max<unsigned int>(width / 2, 1);
+		height = Math::max<unsigned int>(height / 2, 1);
+	}
+
+	FVALIDATE_GL_CALL(glBindTexture(target, 0));
+
+	return texture;
+}
+
+int TextureImporter::createImage2D(const Image &image, const void *pixels, const ColorSpace colorSpace,
+								   const TextureCompression compression) {
 
 	GLenum target = GL_TEXTURE_2D;
 	GLuint texture = 0;
@@ -192,40 +287,16 @@ int TextureImporter::loadImage2DRaw(const Image &image, const ColorSpace colorSp
 
 	FVALIDATE_GL_CALL(glBindTexture(target, texture));
 
-	/*	Offload with PBO buffer.	*/ // TODO: add support
+	/*	Pixels are read from the pixel unpack buffer if bound, see loadImage2DFromBuffer.	*/
 
 	/*	Alignment.	*/
 	FVALIDATE_GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
 	FVALIDATE_GL_CALL(glPixelStorei(GL_PACK_ALIGNMENT, 4));
 
-	/*	wrap and filter.	*/
-	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_REPEAT));
-	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_REPEAT));
-	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_WRAP_R, GL_REPEAT));
-
-	/*	Filtering.	*/
-	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
-	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-
-	/*	*/
-	FVALIDATE_GL_CALL(glTexParameterf(target, GL_TEXTURE_MAX_ANISOTROPY_EXT, 16));
-
-	/*	*/
-	const float border[4] = {1, 1, 1, 1};
-	FVALIDATE_GL_CALL(glTexParameterfv(target, GL_TEXTURE_BORDER_COLOR, &border[0]));
-
-	/*	*/
-	FVALIDATE_GL_CALL(glTexParameterf(target, GL_TEXTURE_MIN_LOD, -1000));
-	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_MAX_LOD, 1000));
-
-	FVALIDATE_GL_CALL(glTexParameterf(target, GL_TEXTURE_LOD_BIAS, 0.0f));
-
-	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0));
-
-	FVALIDATE_GL_CALL(glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, max_mipmap));
+	setImage2DParameters(target, max_mipmap);
 
 	FVALIDATE_GL_CALL(
-		glTexImage2D(target, 0, internalformat, image.width(), image.height(), 0, format, type, image.getPixelData()));
+		glTexImage2D(target, 0, internalformat, image.width(), image.height(), 0, format, type, pixels));
 
 	FVALIDATE_GL_CALL(glGenerateMipmap(target));
 
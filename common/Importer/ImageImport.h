@@ -15,6 +15,7 @@
  */
 #pragma once
 #include "../Common.h"
+#include "TextureCompressor.h"
 #include <IO/FileSystem.h>
 #include <IO/IFileSystem.h>
 #include <ImageLoader.h>
@@ -23,13 +24,6 @@
 
 namespace glsample {
 
-	enum class TextureCompression {
-		None,	 /*	*/
-		Default, /*	*/
-		BPTC,	 /*	*/
-		ASTC	 /*	*/
-	};
-
 	/**
 	 * @brief
 	 *
@@ -48,6 +42,25 @@ namespace glsample {
 		int loadImage2DRaw(const fragcore::Image &image, const ColorSpace colorSpace = ColorSpace::RawLinear,
 						   const TextureCompression compression = TextureCompression::None);
 
+		/**
+		 * @brief Create texture from the image format and size, with the pixels read from the bound
+		 * GL_PIXEL_UNPACK_BUFFER at the byte offset.
+		 */
+		int loadImage2DFromBuffer(const fragcore::Image &image, const size_t bufferOffset,
+								  const ColorSpace colorSpace = ColorSpace::RawLinear,
+								  const TextureCompression compression = TextureCompression::None);
+
+		/**
+		 * @brief Create texture from the block compressed image, with all of its mip levels.
+		 */
+		int loadCompressedImage2D(const CompressedImage &image);
+
+		/**
+		 * @brief Create texture from the block compressed image, with the blocks read from the bound
+		 * GL_PIXEL_UNPACK_BUFFER at the byte offset.
+		 */
+		int loadCompressedImage2DFromBuffer(const CompressedImage &image, const size_t bufferOffset);
+
 		int loadCubeMap(const std::string &px, const std::string &nx, const std::string &py, const std::string &ny,
 						const std::string &pz, const std::string &nz,
 						const ColorSpace colorSpace = ColorSpace::RawLinear,
@@ -55,6 +68,11 @@ namespace glsample {
 		int loadCubeMap(const std::vector<std::string> &paths, const ColorSpace colorSpace = ColorSpace::RawLinear,
 						const TextureCompression compression = TextureCompression::None);
 
+	  private:
+		int createImage2D(const fragcore::Image &image, const void *pixels, const ColorSpace colorSpace,
+						  const TextureCompression compression);
+		int createCompressedImage2D(const CompressedImage &image, const uint8_t *blocks);
+
 	  private:
 		fragcore::IFileSystem *filesystem = nullptr;
 		std::array<unsigned int, 3> pbos = {};
@@ -2,14 +2,16 @@
 #include "IO/FileIO.h"
 #include "ImageImport.h"
 #include "ModelImporter.h"
+#include "TextureStreamer.h"
 #include "Util/ProcessDataUtil.h"
 #include <GL/glew.h>
-#include <ImageUtil.h>
 #include <ProceduralGeometry.h>
+#include <chrono>
 #include <cstdint>
-#include <exception>
 #include <iostream>
+#include <limits>
 #include <ostream>
+#include <thread>
 
 using namespace glsample;
 using namespace fragcore;
@@ -24,18 +26,30 @@ void ImportHelper::loadModelBuffer(ModelImporter &modelLoader, std::vector<MeshO
 	modelSet.resize(modelLoader.getModels().size());
 	unsigned int tmp_ibo = 0;
 
-	std::map<int, std::vector<ModelTemp>> map;
-	std::map<int, int> strideVBOMap;
-	std::map<int, int> strideVBAMap;
+	/*	Meshes sharing vertex array, by vertex layout and stride.	*/
+	using VertexFormatKey = std::pair<VertexLayout, size_t>;
+	std::map<VertexFormatKey, std::vector<ModelTemp>> map;
+	std::map<VertexFormatKey, int> strideVBOMap;
+	std::map<VertexFormatKey, int> strideVBAMap;
 	/*	*/
-	size_t indices_offset = 0;
+	std::vector<size_t> indicesByteOffset(modelLoader.getModels().size());
 	size_t indicesDataSize = 0;
 
 	/*	Sort based on vertex stride.	*/
 	for (size_t i = 0; i < modelLoader.getModels().size(); i++) {
 		const ModelSystemObject &refModel = modelLoader.getModels()[i];
-		map[refModel.vertexStride].push_back({&refModel, i});
-		indicesDataSize += refModel.indicesStride * refModel.nrIndices;
+		map[{refModel.vertexLayout, refModel.vertexStride}].push_back({&refModel, i});
+	}
+
+	/*	32-bit indices first, to keep all offsets aligned to the index size.	*/
+	for (const size_t indicesStride : {sizeof(uint32_t), sizeof(uint16_t)}) {
+		for (size_t i = 0; i < modelLoader.getModels().size(); i++) {
+			const ModelSystemObject &refModel = modelLoader.getModels()[i];
+			if (refModel.indicesStride == indicesStride) {
+				indicesByteOffset[i] = indicesDataSize;
+				indicesDataSize += refModel.indicesStride * refModel.nrIndices;
+			}
+		}
 	}
 
 	{
@@ -48,19 +62,11 @@ void ImportHelper::loadModelBuffer(ModelImporter &modelLoader, std::vector<MeshO
 		uint8_t *elementPointer =
 			(uint8_t *)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, indicesDataSize, GL_MAP_WRITE_BIT);
 
-		size_t offset = 0;
-
-		for (auto it = map.begin(); it != map.end(); it++) {
-			const std::vector<ModelTemp> &ref = (*it).second;
-			const int vertexStride = (*it).first;
-
-			for (size_t i = 0; i < ref.size(); i++) {
-				const ModelSystemObject &refModel = *ref[i].model;
-				const size_t indicesByteSize = refModel.indicesStride * refModel.nrIndices;
+		for (size_t i = 0; i < modelLoader.getModels().size(); i++) {
+			const ModelSystemObject &refModel = modelLoader.getModels()[i];
+			const size_t indicesByteSize = refModel.indicesStride * refModel.nrIndices;
 
-				std::memcpy(&elementPointer[offset], refModel.indicesData, indicesByteSize);
-				offset += indicesByteSize;
-			}
+			std::memcpy(&elementPointer[indicesByteOffset[i]], refModel.indicesData, indicesByteSize);
 		}
 		glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -68,13 +74,12 @@ void ImportHelper::loadModelBuffer(ModelImporter &modelLoader, std::vector<MeshO
 
 	/*	Create array buffer, for rendering static geometry.	*/
 	size_t nrVertices = 0;
-	size_t nrIndices = 0;
-	size_t boneDataSize = 0;
 
 	for (auto it = map.begin(); it != map.end(); it++) {
 
 		const std::vector<ModelTemp> &ref = (*it).second;
-		const int vertexStride = (*it).first;
+		const VertexLayout vertexLayout = (*it).first.first;
+		const int vertexStride = (*it).first.second;
 
 		size_t vertexDataSize = 0;
 		for (size_t i = 0; i < ref.size(); i++) {
@@ -110,7 +115,7 @@ void ImportHelper::loadModelBuffer(ModelImporter &modelLoader, std::vector<MeshO
 		glUnmapBuffer(GL_ARRAY_BUFFER);
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-		strideVBOMap[vertexStride] = tmp_vbo;
+		strideVBOMap[(*it).first] = tmp_vbo;
 
 		const ModelSystemObject &refModel_base = *ref[0].model;
 
@@ -121,25 +126,37 @@ void ImportHelper::loadModelBuffer(ModelImporter &modelLoader, std::vector<MeshO
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tmp_ibo);
 		glBindBuffer(GL_ARRAY_BUFFER, tmp_vbo);
 
+		const bool compact = vertexLayout == VertexLayout::Compact;
+
 		/*	Vertex.	*/
 		glEnableVertexAttribArrayARB(0);
-		glVertexAttribPointerARB(0, 3, GL_FLOAT, GL_FALSE, vertexStride,
-								 reinterpret_cast<void *>(refModel_base.vertexOffset));
+		glVertexAttribPointerARB(0, 3, compact ? GL_UNSIGNED_SHORT : GL_FLOAT, compact ? GL_TRUE : GL_FALSE,
+								 vertexStride, reinterpret_cast<void *>(refModel_base.vertexOffset));
 
 		/*	UV.	*/
 		glEnableVertexAttribArrayARB(1);
-		glVertexAttribPointerARB(1, 2, GL_FLOAT, GL_FALSE, vertexStride,
+		glVertexAttribPointerARB(1, 2, compact ? GL_HALF_FLOAT : GL_FLOAT, GL_FALSE, vertexStride,
 								 reinterpret_cast<void *>(refModel_base.uvOffset));
 
 		/*	Normal.	*/
 		glEnableVertexAttribArrayARB(2);
-		glVertexAttribPointerARB(2, 3, GL_FLOAT, GL_FALSE, vertexStride,
-								 reinterpret_cast<void *>(refModel_base.normalOffset));
+		if (compact) {
+			glVertexAttribPointerARB(2, 2, GL_SHORT, GL_TRUE, vertexStride,
+									 reinterpret_cast<void *>(refModel_base.normalOffset));
+		} else {
+			glVertexAttribPointerARB(2, 3, GL_FLOAT, GL_FALSE, vertexStride,
+									 reinterpret_cast<void *>(refModel_base.normalOffset));
+		}
 
 		/*	Tangent.	*/
 		glEnableVertexAttribArrayARB(3);
-		glVertexAttribPointerARB(3, 3, GL_FLOAT, GL_FALSE, vertexStride,
-								 reinterpret_cast<void *>(refModel_base.tangentOffset));
+		if (compact) {
+			glVertexAttribPointerARB(3, 2, GL_SHORT, GL_TRUE, vertexStride,
+									 reinterpret_cast<void *>(refModel_base.tangentOffset));
+		} else {
+			glVertexAttribPointerARB(3, 3, GL_FLOAT, GL_FALSE, vertexStride,
+									 reinterpret_cast<void *>(refModel_base.tangentOffset));
+		}
 
 		/*	Bone.	*/
 		if (refModel_base.boneIndexOffset > 0) {
@@ -162,7 +179,7 @@ void ImportHelper::loadModelBuffer(ModelImporter &modelLoader, std::vector<MeshO
 
 		glBindVertexArray(0);
 
-		strideVBAMap[vertexStride] = tmp_vao;
+		strideVBAMap[(*it).first] = tmp_vao;
 
 		/*	*/
 		size_t vertices_offset = 0;
@@ -178,11 +195,13 @@ void ImportHelper::loadModelBuffer(ModelImporter &modelLoader, std::vector<MeshO
 
 			/*	*/
 			const size_t vertexSize = refModel.nrVertices;
-			const size_t indicesSize = refModel.nrIndices;
 
 			/*	*/
 			MeshObject &ref = modelSet[pindex];
-			ref.indices_offset = indices_offset;
+			ref.indices_offset = indicesByteOffset[pindex] / IndicesStride;
+			ref.indices_stride = IndicesStride;
+			ref.indices_type = IndicesStride == sizeof(uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+			ref.quantized_position = refModel.vertexLayout == VertexLayout::Compact;
 			ref.vertex_offset = vertices_offset;
 			ref.nrIndicesElements = refModel.nrIndices;
 			ref.nrVertices = refModel.nrVertices;
@@ -190,7 +209,6 @@ void ImportHelper::loadModelBuffer(ModelImporter &modelLoader, std::vector<MeshO
 
 			/*	*/
 			vertices_offset += vertexSize;
-			indices_offset += indicesSize;
 
 			/*	*/
 			ref.vao = tmp_vao;
@@ -213,96 +231,63 @@ void ImportHelper::loadModelBuffer(ModelImporter &modelLoader, std::vector<MeshO
 	}
 }
 
-void ImportHelper::loadTextures(ModelImporter &modelLoader, std::vector<TextureAssetObject> &textures) {
+static void queueTextures(ModelImporter &modelLoader, TextureStreamer &streamer) {
 
 	std::vector<TextureAssetObject> &Reftextures = modelLoader.getTextures();
 
-	textures.resize(Reftextures.size());
-
-	glsample::TextureImporter textureImporter(modelLoader.getFileSystem());
-	ProcessData process(modelLoader.getFileSystem());
-
 	for (size_t texture_index = 0; texture_index < Reftextures.size(); texture_index++) {
 
 		std::vector<MaterialObject *> materials = modelLoader.getMaterials(texture_index);
 
-		TextureAssetObject &tex = Reftextures[texture_index];
+		const TextureAssetObject &tex = Reftextures[texture_index];
 		ColorSpace colorSpace = ColorSpace::RawLinear;
-		TextureCompression compression = TextureCompression::Default;
+		const TextureCompression compression = TextureCompression::Default;
+		bool convertNormalMap = false;
 
 		/*	Determine color space, based on the texture usages.	*/
 		if (!materials.empty()) {
 			if (materials[0]->diffuseIndex == texture_index) {
 				colorSpace = ColorSpace::SRGB;
 			}
-		}
-
-		if (tex.data == nullptr) {
-
-			try {
-				std::cout << "Loading " << tex.filepath << std::endl;
-				fragcore::Ref<fragcore::IO> refIO =
-					fragcore::Ref<fragcore::IO>(new fragcore::FileIO(tex.filepath, FileIO::READ));
-
-				/*	*/
-				fragcore::ImageLoader imageLoader;
 
-				Image image = imageLoader.loadImage(refIO);
-
-				if (!materials.empty() && materials[0]->heightbumpIndex == texture_index) {
-					image = ImageUtil::convert2NormalMap(image);
-					materials[0]->heightbumpIndex = -1;
-					materials[0]->normalIndex = texture_index;
-				}
-
-				tex.texture = textureImporter.loadImage2DRaw(image, colorSpace, compression);
-				if (tex.texture >= 0) {
-					glObjectLabel(GL_TEXTURE, tex.texture, tex.filepath.size(), tex.filepath.data());
-				}
-				// TODO: use gpu to convert image.
-
-			} catch (const std::exception &ex) {
-				std::cerr << "Failed to load: " << tex.filepath << " " << ex.what() << std::endl;
+			/*	Height map is converted to normal map once decoded.	*/
+			if (tex.data == nullptr && materials[0]->heightbumpIndex == texture_index) {
+				convertNormalMap = true;
+				materials[0]->heightbumpIndex = -1;
+				materials[0]->normalIndex = texture_index;
 			}
-		} else {
+		}
 
-			/*	Compressed data.	*/
-			if (tex.height == 0 && tex.dataSize > 0 && tex.data && tex.width > 0) {
+		std::cout << "Loading " << tex.filepath << std::endl;
+		streamer.load(tex, texture_index, colorSpace, compression, convertNormalMap);
+	}
+}
 
-				/*	*/
-				fragcore::Ref<fragcore::IO> refIO = fragcore::Ref<fragcore::IO>(
-					new fragcore::BufferIO((const void *)tex.data, (unsigned long)tex.dataSize));
+void ImportHelper::loadTextures(ModelImporter &modelLoader, std::vector<TextureAssetObject> &textures) {
 
-				/*	*/
-				fragcore::ImageLoader imageLoader;
+	std::vector<TextureAssetObject> &Reftextures = modelLoader.getTextures();
 
-				try {
+	/*	Decode all textures in parallel, and wait until all are uploaded.	*/
+	TextureStreamer streamer(modelLoader.getFileSystem());
+	streamer.setUploadBudget(std::numeric_limits<size_t>::max());
 
-					Image image = imageLoader.loadImage(refIO);
+	queueTextures(modelLoader, streamer);
 
-					tex.texture = textureImporter.loadImage2DRaw(image, colorSpace, compression);
-					if (tex.texture >= 0) {
-						glObjectLabel(GL_TEXTURE, tex.texture, tex.filepath.size(), tex.filepath.data());
-					}
-				} catch (std::exception &ex) {
-					std::cerr << "Failed to load: " << ex.what() << std::endl;
-				}
+	while (!streamer.isDone()) {
+		if (streamer.update(Reftextures) == 0) {
+			glFlush();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
 
-				refIO->close();
-			} else {
+	textures = Reftextures;
+}
 
-				/*	None-compressed.	*/
-				fragcore::Image image(tex.width, tex.height, ImageFormat::ARGB32);
-				image.setPixelData(tex.data, image.getSize());
+void ImportHelper::loadTextures(ModelImporter &modelLoader, std::vector<TextureAssetObject> &textures,
+								TextureStreamer &streamer) {
 
-				tex.texture = textureImporter.loadImage2DRaw(image, colorSpace, compression);
-				if (tex.texture >= 0) {
-					glObjectLabel(GL_TEXTURE, tex.texture, tex.filepath.size(), tex.filepath.data());
-				}
-			}
-		}
+	/*	Default textures are used until the streamed textures are assigned.	*/
+	textures = modelLoader.getTextures();
 
-		/*	*/
-	}
-	textures = Reftextures;
-}
\ No newline at end of file
+	queueTextures(modelLoader, streamer);
+}
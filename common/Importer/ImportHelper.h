@@ -16,6 +16,7 @@
 #pragma once
 #include "GLSampleSession.h"
 #include "ModelImporter.h"
+#include "TextureStreamer.h"
 
 namespace glsample {
 
@@ -39,6 +40,16 @@ namespace glsample {
 		 * @param textures
 		 */
 		static void loadTextures(ModelImporter &modelLoader, std::vector<TextureAssetObject> &textures);
+
+		/**
+		 * @brief Queue all the textures on the streamer, the textures are assigned by TextureStreamer::update.
+		 *
+		 * @param modelLoader
+		 * @param textures
+		 * @param streamer
+		 */
+		static void loadTextures(ModelImporter &modelLoader, std::vector<TextureAssetObject> &textures,
+								 TextureStreamer &streamer);
 		// static void mergeGeometry(std::vector<ProceduralGeometry::Vertex> wireCubeVertices,
 		//						  std::vector<unsigned int> wireCubeIndices);
 	};
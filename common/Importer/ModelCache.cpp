@@ -0,0 +1,639 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#include "ModelCache.h"
+#include "Math/Math.h"
+#include "Util/Hash.h"
+#include <cstring>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+std::string ModelCache::cacheDirectory = ".cache/models";
+
+/*	Bump whenever the layout of the cache entries, or the import processing, changes.	*/
+static const uint32_t model_cache_version = 2;
+static const uint32_t model_cache_magic = 0x434D4C47; /*	GLMC	*/
+
+/*	Vertex and index blobs are aligned, so they can be used directly from the mapping.	*/
+static const size_t model_cache_blob_alignment = 16;
+
+using ModelCacheHeader = struct model_cache_header_t {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t vertexLayout;
+	uint32_t reserved;
+	uint64_t sourceHash;
+};
+
+class ModelCacheWriter {
+  public:
+	template <typename T> void write(const T &value) {
+		static_assert(std::is_trivially_copyable<T>::value, "Requires trivially copyable type");
+		this->writeBytes(&value, sizeof(T));
+	}
+
+	void write(const std::string &value) {
+		this->write(static_cast<uint64_t>(value.size()));
+		this->writeBytes(value.data(), value.size());
+	}
+
+	template <typename T> void write(const std::vector<T> &values) {
+		static_assert(std::is_trivially_copyable<T>::value, "Requires trivially copyable type");
+		this->write(static_cast<uint64_t>(values.size()));
+		this->writeBytes(values.data(), values.size() * sizeof(T));
+	}
+
+	void writeBlob(const void *data, const size_t size) {
+		this->write(static_cast<uint64_t>(size));
+		this->data.resize(fragcore::Math::align<size_t>(this->data.size(), model_cache_blob_alignment), 0);
+		this->writeBytes(data, size);
+	}
+
+	void writeBytes(const void *bytes, const size_t size) {
+		if (size > 0) {
+			const uint8_t *begin = static_cast<const uint8_t *>(bytes);
+			this->data.insert(this->data.end(), begin, begin + size);
+		}
+	}
+
+	const std::vector<uint8_t> &getData() const noexcept { return this->data; }
+
+  private:
+	std::vector<uint8_t> data;
+};
+
+/*	Reads from the mapped entry, any out of bound read invalidates the reader and returns zeroed values.	*/
+class ModelCacheReader {
+  public:
+	ModelCacheReader(const uint8_t *data, const size_t size) : data(data), size(size) {}
+
+	template <typename T> void read(T &value) {
+		static_assert(std::is_trivially_copyable<T>::value, "Requires trivially copyable type");
+		const uint8_t *bytes = this->readBytes(sizeof(T));
+		if (bytes) {
+			std::memcpy(&value, bytes, sizeof(T));
+		} else {
+			std::memset(&value, 0, sizeof(T));
+		}
+	}
+
+	void read(std::string &value) {
+		const size_t length = this->readCount(1);
+		const uint8_t *bytes = this->readBytes(length);
+		value.assign(reinterpret_cast<const char *>(bytes), bytes ? length : 0);
+	}
+
+	template <typename T> void read(std::vector<T> &values) {
+		static_assert(std::is_trivially_copyable<T>::value, "Requires trivially copyable type");
+		const size_t count = this->readCount(sizeof(T));
+		const uint8_t *bytes = this->readBytes(count * sizeof(T));
+		values.resize(bytes ? count : 0);
+		if (bytes && count > 0) {
+			std::memcpy(values.data(), bytes, count * sizeof(T));
+		}
+	}
+
+	const uint8_t *readBlob(size_t &blobSize) {
+		uint64_t length = 0;
+		this->read(length);
+		this->offset = fragcore::Math::align<size_t>(this->offset, model_cache_blob_alignment);
+		const uint8_t *bytes = this->readBytes(length);
+		blobSize = bytes ? length : 0;
+		return bytes;
+	}
+
+	/*	Number of elements, limited by the remaining bytes, to prevent large allocations of invalid entries.	*/
+	size_t readCount(const size_t elementSize) {
+		uint64_t count = 0;
+		this->read(count);
+		if (count > (this->size - this->offset) / fragcore::Math::max<size_t>(elementSize, 1)) {
+			this->valid = false;
+			return 0;
+		}
+		return count;
+	}
+
+	const uint8_t *readBytes(const size_t length) {
+		if (!this->valid || this->offset > this->size || length > this->size - this->offset) {
+			this->valid = false;
+			return nullptr;
+		}
+		const uint8_t *bytes = &this->data[this->offset];
+		this->offset += length;
+		return bytes;
+	}
+
+	bool isValid() const noexcept { return this->valid; }
+
+  private:
+	const uint8_t *data;
+	size_t size;
+	size_t offset = 0;
+	bool valid = true;
+};
+
+/*	Map the whole file read only, the memory is released when the last reference is released.	*/
+static std::shared_ptr<const void> mapFile(const std::string &path, size_t &size) {
+#if defined(__unix__) || defined(__APPLE__)
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return nullptr;
+	}
+
+	struct stat fileStat {};
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+		close(fd);
+		return nullptr;
+	}
+
+	const size_t mappedSize = static_cast<size_t>(fileStat.st_size);
+	void *mapped = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED) {
+		return nullptr;
+	}
+
+	size = mappedSize;
+	return std::shared_ptr<const void>(mapped, [mappedSize](const void *data) {
+		munmap(const_cast<void *>(data), mappedSize);
+	});
+#else
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		return nullptr;
+	}
+
+	const std::streamsize fileSize = file.tellg();
+	if (fileSize <= 0) {
+		return nullptr;
+	}
+
+	std::shared_ptr<uint8_t> data(new uint8_t[fileSize], std::default_delete<uint8_t[]>());
+	file.seekg(0, std::ios::beg);
+	if (!file.read(reinterpret_cast<char *>(data.get()), fileSize)) {
+		return nullptr;
+	}
+
+	size = static_cast<size_t>(fileSize);
+	return data;
+#endif
+}
+
+static void writeBound(ModelCacheWriter &writer, const fragcore::Bound &bound) {
+	for (unsigned int i = 0; i < 3; i++) {
+		writer.write(static_cast<float>(bound.aabb.min[i]));
+		writer.write(static_cast<float>(bound.aabb.max[i]));
+	}
+}
+
+static void readBound(ModelCacheReader &reader, fragcore::Bound &bound) {
+	for (unsigned int i = 0; i < 3; i++) {
+		float min = 0;
+		float max = 0;
+		reader.read(min);
+		reader.read(max);
+		bound.aabb.min[i] = min;
+		bound.aabb.max[i] = max;
+	}
+}
+
+static void writeMaterial(ModelCacheWriter &writer, const MaterialObject &material) {
+	writer.write(material.name);
+	writer.write(material.ambient);
+	writer.write(material.diffuse);
+	writer.write(material.emission);
+	writer.write(material.specular);
+	writer.write(material.transparent);
+	writer.write(material.reflectivity);
+	writer.write(material.shinininess);
+	writer.write(material.bumpiness);
+	writer.write(material.opacity);
+	writer.write(material.blend_func_mode);
+	writer.write(material.wireframe_mode);
+	writer.write(material.culling_both_side_mode);
+	writer.write(material.clipping);
+	writer.write(material.shade_model);
+	writer.write(material.texture_sampling);
+	writer.write(material.texture_index);
+}
+
+static void readMaterial(ModelCacheReader &reader, MaterialObject &material) {
+	reader.read(material.name);
+	reader.read(material.ambient);
+	reader.read(material.diffuse);
+	reader.read(material.emission);
+	reader.read(material.specular);
+	reader.read(material.transparent);
+	reader.read(material.reflectivity);
+	reader.read(material.shinininess);
+	reader.read(material.bumpiness);
+	reader.read(material.opacity);
+	reader.read(material.blend_func_mode);
+	reader.read(material.wireframe_mode);
+	reader.read(material.culling_both_side_mode);
+	reader.read(material.clipping);
+	reader.read(material.shade_model);
+	reader.read(material.texture_sampling);
+	reader.read(material.texture_index);
+}
+
+static void writeLight(ModelCacheWriter &writer, const LightObject &light) {
+	writer.write(light.name);
+	writer.write(light.position);
+	writer.write(light.direction);
+	writer.write(light.mUp);
+	writer.write(light.mAttenuationConstant);
+	writer.write(light.mAttenuationLinear);
+	writer.write(light.mAttenuationQuadratic);
+	writer.write(light.mColorDiffuse);
+	writer.write(light.mColorSpecular);
+	writer.write(light.mColorAmbient);
+	writer.write(light.mAngleInnerCone);
+	writer.write(light.mAngleOuterCone);
+}
+
+static void readLight(ModelCacheReader &reader, LightObject &light) {
+	reader.read(light.name);
+	reader.read(light.position);
+	reader.read(light.direction);
+	reader.read(light.mUp);
+	reader.read(light.mAttenuationConstant);
+	reader.read(light.mAttenuationLinear);
+	reader.read(light.mAttenuationQuadratic);
+	reader.read(light.mColorDiffuse);
+	reader.read(light.mColorSpecular);
+	reader.read(light.mColorAmbient);
+	reader.read(light.mAngleInnerCone);
+	reader.read(light.mAngleOuterCone);
+}
+
+void ModelCache::setCacheDirectory(const std::string &directory) { ModelCache::cacheDirectory = directory; }
+
+uint64_t ModelCache::computeSourceHash(const std::string &path) {
+
+	/*	Size and modification time, rather than reading the whole source on every load.	*/
+	std::error_code error;
+	const uint64_t size = fs::file_size(path, error);
+	if (error) {
+		return 0;
+	}
+	const int64_t modified = fs::last_write_time(path, error).time_since_epoch().count();
+	if (error) {
+		return 0;
+	}
+
+	uint64_t hash = glsample::hashBytes(&model_cache_version, sizeof(model_cache_version));
+	hash = glsample::hashBytes(&size, sizeof(size), hash);
+	return glsample::hashBytes(&modified, sizeof(modified), hash);
+}
+
+std::string ModelCache::getEntryPath(const std::string &path, const VertexLayout layout) {
+
+	/*	Same entry for the file, regardless of how the path is written.	*/
+	std::error_code error;
+	const std::string absolutePath = fs::weakly_canonical(fs::absolute(path, error), error).string();
+	const uint32_t vertexLayout = static_cast<uint32_t>(layout);
+
+	uint64_t key = glsample::hashBytes(absolutePath.data(), absolutePath.size());
+	key = glsample::hashBytes(&vertexLayout, sizeof(vertexLayout), key);
+
+	return fmt::format("{}/{:016x}.model", ModelCache::cacheDirectory, key);
+}
+
+bool ModelCache::load(ModelImporter &importer, const std::string &path, const uint64_t sourceHash) {
+
+	if (!ModelCache::isEnabled() || sourceHash == 0) {
+		return false;
+	}
+
+	size_t size = 0;
+	std::shared_ptr<const void> mapping = mapFile(ModelCache::getEntryPath(path, importer.getVertexLayout()), size);
+	if (!mapping) {
+		return false;
+	}
+
+	ModelCacheReader reader(static_cast<const uint8_t *>(mapping.get()), size);
+
+	ModelCacheHeader header{};
+	reader.read(header);
+	if (!reader.isValid() || header.magic != model_cache_magic || header.version != model_cache_version ||
+		header.vertexLayout != static_cast<uint32_t>(importer.getVertexLayout()) || header.sourceHash != sourceHash) {
+		return false;
+	}
+
+	glm::mat4 globalNodeTransform;
+	reader.read(globalNodeTransform);
+
+	std::vector<TextureAssetObject> textures(reader.readCount(sizeof(uint64_t)));
+	std::vector<const uint8_t *> textureData(textures.size(), nullptr);
+	for (size_t i = 0; i < textures.size(); i++) {
+		reader.read(textures[i].filepath);
+		reader.read(textures[i].width);
+		reader.read(textures[i].height);
+		textureData[i] = reader.readBlob(textures[i].dataSize);
+	}
+
+	std::vector<MaterialObject> materials(reader.readCount(sizeof(uint64_t)));
+	for (MaterialObject &material : materials) {
+		readMaterial(reader, material);
+	}
+
+	/*	Models, vertex and index data are used directly from the mapping.	*/
+	std::vector<ModelSystemObject> models(reader.readCount(sizeof(uint64_t)));
+	for (ModelSystemObject &model : models) {
+		uint32_t vertexLayout = 0;
+
+		reader.read(model.name);
+		reader.read(model.nrVertices);
+		reader.read(model.nrIndices);
+		reader.read(model.vertexStride);
+		reader.read(model.indicesStride);
+		reader.read(model.material_index);
+		readBound(reader, model.bound);
+		reader.read(model.vertexOffset);
+		reader.read(model.normalOffset);
+		reader.read(model.tangentOffset);
+		reader.read(model.uvOffset);
+		reader.read(model.boneOffset);
+		reader.read(model.boneWeightOffset);
+		reader.read(model.boneIndexOffset);
+		reader.read(model.primitiveType);
+		reader.read(vertexLayout);
+		model.vertexLayout = static_cast<VertexLayout>(vertexLayout);
+
+		size_t vertexDataSize = 0;
+		size_t indicesDataSize = 0;
+		model.vertexData = const_cast<uint8_t *>(reader.readBlob(vertexDataSize));
+		model.indicesData = const_cast<uint8_t *>(reader.readBlob(indicesDataSize));
+
+		if (vertexDataSize != model.nrVertices * model.vertexStride ||
+			indicesDataSize != model.nrIndices * model.indicesStride) {
+			return false;
+		}
+	}
+
+	/*	Nodes are stored with parents before their children.	*/
+	std::vector<std::unique_ptr<NodeObject>> nodes(reader.readCount(sizeof(uint64_t)));
+	for (size_t i = 0; i < nodes.size(); i++) {
+		nodes[i] = std::make_unique<NodeObject>();
+		NodeObject &node = *nodes[i];
+
+		int64_t parent = -1;
+		reader.read(node.name);
+		reader.read(node.localPosition);
+		reader.read(node.localRotation);
+		reader.read(node.localScale);
+		reader.read(node.modelGlobalTransform);
+		reader.read(node.modelLocalTransform);
+		readBound(reader, node.bound);
+		reader.read(node.geometryObjectIndex);
+		reader.read(node.materialIndex);
+		reader.read(parent);
+
+		if (parent >= static_cast<int64_t>(i) || node.geometryObjectIndex.size() != node.materialIndex.size()) {
+			return false;
+		}
+		node.parent = parent >= 0 ? nodes[parent].get() : nullptr;
+
+		for (size_t geo_index = 0; geo_index < node.geometryObjectIndex.size(); geo_index++) {
+			if (node.geometryObjectIndex[geo_index] >= models.size() ||
+				node.materialIndex[geo_index] >= materials.size()) {
+				return false;
+			}
+		}
+	}
+
+	std::vector<SkeletonSystem> skeletons(reader.readCount(sizeof(uint64_t)));
+	for (SkeletonSystem &skeleton : skeletons) {
+		reader.read(skeleton.name);
+
+		const size_t nrBones = reader.readCount(sizeof(uint64_t));
+		for (size_t i = 0; i < nrBones && reader.isValid(); i++) {
+			Bone bone;
+			int64_t armature = -1;
+
+			reader.read(bone.name);
+			reader.read(bone.finalTransform);
+			reader.read(bone.offsetBoneMatrix);
+			reader.read(bone.boneIndex);
+			reader.read(armature);
+
+			if (armature >= static_cast<int64_t>(nodes.size())) {
+				return false;
+			}
+			bone.armature_bone = armature >= 0 ? nodes[armature].get() : nullptr;
+			skeleton.bones[bone.name] = bone;
+		}
+	}
+
+	std::vector<AnimationObject> animations(reader.readCount(sizeof(uint64_t)));
+	for (AnimationObject &animation : animations) {
+		reader.read(animation.name);
+		reader.read(animation.duration);
+
+		animation.curves.resize(reader.readCount(sizeof(uint64_t)));
+		for (Curve &curve : animation.curves) {
+			reader.read(curve.name);
+			reader.read(curve.keyframes);
+		}
+	}
+
+	std::vector<LightObject> lights(reader.readCount(sizeof(uint64_t)));
+	for (LightObject &light : lights) {
+		readLight(reader, light);
+	}
+
+	if (!reader.isValid()) {
+		return false;
+	}
+
+	/*	Embedded texture data is copied, since it is owned and released by the importer.	*/
+	for (size_t i = 0; i < textures.size(); i++) {
+		if (textures[i].dataSize > 0) {
+			textures[i].data = static_cast<char *>(malloc(textures[i].dataSize));
+			std::memcpy(textures[i].data, textureData[i], textures[i].dataSize);
+		}
+	}
+
+	/*	Entry is valid, replace the content of the importer.	*/
+	importer.clear();
+
+	importer.globalNodeTransform = globalNodeTransform;
+	importer.textures = std::move(textures);
+	importer.materials = std::move(materials);
+	importer.models = std::move(models);
+	importer.skeletons = std::move(skeletons);
+	importer.animations = std::move(animations);
+	importer.lights = std::move(lights);
+
+	importer.nodeByName.clear();
+	for (std::unique_ptr<NodeObject> &node : nodes) {
+		importer.nodeByName[node->name] = node.get();
+		importer.nodes.push_back(node.release());
+	}
+
+	importer.cacheMapping = std::move(mapping);
+
+	return true;
+}
+
+void ModelCache::store(const ModelImporter &importer, const std::string &path, const uint64_t sourceHash) {
+
+	if (!ModelCache::isEnabled() || sourceHash == 0) {
+		return;
+	}
+
+	ModelCacheWriter writer;
+
+	const ModelCacheHeader header = {model_cache_magic, model_cache_version,
+									 static_cast<uint32_t>(importer.getVertexLayout()), 0, sourceHash};
+	writer.write(header);
+	writer.write(importer.globalNodeTransform);
+
+	writer.write(static_cast<uint64_t>(importer.textures.size()));
+	for (const TextureAssetObject &texture : importer.textures) {
+		writer.write(texture.filepath);
+		writer.write(texture.width);
+		writer.write(texture.height);
+		writer.writeBlob(texture.data, texture.data ? texture.dataSize : 0);
+	}
+
+	writer.write(static_cast<uint64_t>(importer.materials.size()));
+	for (const MaterialObject &material : importer.materials) {
+		writeMaterial(writer, material);
+	}
+
+	writer.write(static_cast<uint64_t>(importer.models.size()));
+	for (const ModelSystemObject &model : importer.models) {
+		writer.write(model.name);
+		writer.write(model.nrVertices);
+		writer.write(model.nrIndices);
+		writer.write(model.vertexStride);
+		writer.write(model.indicesStride);
+		writer.write(model.material_index);
+		writeBound(writer, model.bound);
+		writer.write(model.vertexOffset);
+		writer.write(model.normalOffset);
+		writer.write(model.tangentOffset);
+		writer.write(model.uvOffset);
+		writer.write(model.boneOffset);
+		writer.write(model.boneWeightOffset);
+		writer.write(model.boneIndexOffset);
+		writer.write(model.primitiveType);
+		writer.write(static_cast<uint32_t>(model.vertexLayout));
+		writer.writeBlob(model.vertexData, model.nrVertices * model.vertexStride);
+		writer.writeBlob(model.indicesData, model.nrIndices * model.indicesStride);
+	}
+
+	std::unordered_map<const NodeObject *, int64_t> nodeIndices;
+	for (size_t i = 0; i < importer.nodes.size(); i++) {
+		nodeIndices[importer.nodes[i]] = static_cast<int64_t>(i);
+	}
+
+	writer.write(static_cast<uint64_t>(importer.nodes.size()));
+	for (const NodeObject *node : importer.nodes) {
+		const auto parent = nodeIndices.find(node->parent);
+
+		writer.write(node->name);
+		writer.write(node->localPosition);
+		writer.write(node->localRotation);
+		writer.write(node->localScale);
+		writer.write(node->modelGlobalTransform);
+		writer.write(node->modelLocalTransform);
+		writeBound(writer, node->bound);
+		writer.write(node->geometryObjectIndex);
+		writer.write(node->materialIndex);
+		writer.write(parent != nodeIndices.end() ? parent->second : int64_t(-1));
+	}
+
+	writer.write(static_cast<uint64_t>(importer.skeletons.size()));
+	for (const SkeletonSystem &skeleton : importer.skeletons) {
+		writer.write(skeleton.name);
+
+		writer.write(static_cast<uint64_t>(skeleton.bones.size()));
+		for (const auto &it : skeleton.bones) {
+			const Bone &bone = it.second;
+			const auto armature = nodeIndices.find(bone.armature_bone);
+
+			writer.write(it.first);
+			writer.write(bone.finalTransform);
+			writer.write(bone.offsetBoneMatrix);
+			writer.write(bone.boneIndex);
+			writer.write(armature != nodeIndices.end() ? armature->second : int64_t(-1));
+		}
+	}
+
+	writer.write(static_cast<uint64_t>(importer.animations.size()));
+	for (const AnimationObject &animation : importer.animations) {
+		writer.write(animation.name);
+		writer.write(animation.duration);
+
+		writer.write(static_cast<uint64_t>(animation.curves.size()));
+		for (const Curve &curve : animation.curves) {
+			writer.write(curve.name);
+			writer.write(curve.keyframes);
+		}
+	}
+
+	writer.write(static_cast<uint64_t>(importer.lights.size()));
+	for (const LightObject &light : importer.lights) {
+		writeLight(writer, light);
+	}
+
+	std::error_code error;
+	fs::create_directories(ModelCache::cacheDirectory, error);
+	if (error) {
+		return;
+	}
+
+	/*	Write to temporary file first, to prevent other processes from reading partial entries.	*/
+	const std::string entryPath = ModelCache::getEntryPath(path, importer.getVertexLayout());
+	const std::string tmpPath =
+		fmt::format("{}.{}.tmp", entryPath, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+	{
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			return;
+		}
+		file.write(reinterpret_cast<const char *>(writer.getData().data()),
+				   static_cast<std::streamsize>(writer.getData().size()));
+		if (!file) {
+			file.close();
+			fs::remove(tmpPath, error);
+			return;
+		}
+	}
+
+	fs::rename(tmpPath, entryPath, error);
+	if (error) {
+		fs::remove(tmpPath, error);
+	}
+}
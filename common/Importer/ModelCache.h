@@ -0,0 +1,60 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "ModelImporter.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief On-disk cache of fully imported models, to skip assimp and its post processing on warm loads.
+ *
+ * Each entry stores the packed vertex and index buffers, the node hierarchy, materials, texture
+ * references, skeletons, animations and lights of a model. Entries are keyed on the model path and
+ * vertex layout, and are discarded when the hash of the source file no longer match.
+ * The entry is memory mapped, the vertex and index data of the models point directly into the mapping.
+ */
+class FVDECLSPEC ModelCache {
+  public:
+	/**
+	 * @brief Set the directory to store the cache entries, an empty path disable the cache.
+	 */
+	static void setCacheDirectory(const std::string &directory);
+	static const std::string &getCacheDirectory() noexcept { return ModelCache::cacheDirectory; }
+
+	static bool isEnabled() noexcept { return !ModelCache::cacheDirectory.empty(); }
+
+	/**
+	 * @brief Hash of the size and modification time of the source file, 0 if it does not exist.
+	 */
+	static uint64_t computeSourceHash(const std::string &path);
+
+	/**
+	 * @brief Load the cached model into the importer.
+	 *
+	 * @return false if not cached, out of date or invalid, the importer is left unchanged.
+	 */
+	static bool load(ModelImporter &importer, const std::string &path, const uint64_t sourceHash);
+
+	/**
+	 * @brief Store the loaded model of the importer.
+	 */
+	static void store(const ModelImporter &importer, const std::string &path, const uint64_t sourceHash);
+
+  private:
+	static std::string getEntryPath(const std::string &path, const VertexLayout layout);
+
+	static std::string cacheDirectory;
+};
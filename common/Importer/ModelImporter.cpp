@@ -1,8 +1,10 @@
 #include "ModelImporter.h"
 #include "Core/SystemInfo.h"
 #include "Math/Math.h"
+#include "ModelCache.h"
 #include "RenderDesc.h"
 #include "TaskScheduler/IScheduler.h"
+#include "Util/TaskParallel.h"
 #include "assimp/Importer.hpp"
 #include "assimp/ProgressHandler.hpp"
 #include "assimp/config.h"
@@ -14,8 +16,11 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <glm/fwd.hpp>
+#include <glm/gtc/packing.hpp>
+#include <limits>
 #include <sys/types.h>
 #include <thread>
 #include <utility>
@@ -51,7 +56,8 @@ ModelImporter::ModelImporter(ModelImporter &&other)
 	: filepath(other.filepath), nodes(other.nodes), models(other.models), materials(other.materials),
 	  textures(other.textures), textureMapping(other.textureMapping), textureIndexMapping(other.textureIndexMapping),
 	  skeletons(other.skeletons), animations(other.animations), vertexBoneData(other.vertexBoneData),
-	  rootNode(other.rootNode), globalNodeTransform(other.globalNodeTransform) {
+	  rootNode(other.rootNode), globalNodeTransform(other.globalNodeTransform), vertexLayout(other.vertexLayout),
+	  cacheMapping(other.cacheMapping) {
 	this->fileSystem = std::exchange(other.fileSystem, nullptr);
 }
 
@@ -71,6 +77,8 @@ ModelImporter &ModelImporter::operator=(ModelImporter &&other) {
 	this->skeletons = other.skeletons;
 	this->animations = other.animations;
 	this->vertexBoneData = other.vertexBoneData;
+	this->vertexLayout = other.vertexLayout;
+	this->cacheMapping = other.cacheMapping;
 
 	return *this;
 }
@@ -86,7 +94,17 @@ class CustomProgress : public Assimp::ProgressHandler {
 void ModelImporter::loadContent(const std::string &path, unsigned long int supportFlag) {
 	Assimp::Importer importer;
 
-	this->filepath = fs::path(fileSystem->getAbsolutePath(path.c_str())).parent_path();
+	const std::string absolutePath = fileSystem->getAbsolutePath(path.c_str());
+	this->filepath = fs::path(absolutePath).parent_path();
+
+	/*	Skip assimp entirely, if the processed model is cached and the source file is unchanged.	*/
+	uint64_t sourceHash = 0;
+	if (ModelCache::isEnabled()) {
+		sourceHash = ModelCache::computeSourceHash(absolutePath);
+		if (ModelCache::load(*this, absolutePath, sourceHash)) {
+			return;
+		}
+	}
 
 	importer.SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME, false);
 	importer.SetProgressHandler(new CustomProgress());
@@ -102,6 +120,8 @@ void ModelImporter::loadContent(const std::string &path, unsigned long int suppo
 	this->globalNodeTransform = aiMatrix4x4ToGlm(&this->sceneRef->mRootNode->mTransformation);
 
 	this->initScene(this->sceneRef);
+
+	ModelCache::store(*this, absolutePath, sourceHash);
 }
 
 void ModelImporter::clear() noexcept {
@@ -119,6 +139,7 @@ void ModelImporter::clear() noexcept {
 	this->animations.clear();
 	this->lights.clear();
 	this->skeletons.clear();
+	this->cacheMapping.reset();
 }
 
 void ModelImporter::initScene(const aiScene *scene) {
@@ -164,29 +185,6 @@ void ModelImporter::initScene(const aiScene *scene) {
 		}
 	});
 
-	/*	*/
-	const size_t nr_threads = fragcore::Math::clamp<size_t>(scene->mNumMeshes / 4, 1, SystemInfo::getCPUCoreCount());
-	std::vector<std::thread> model_threads(nr_threads);
-
-	/*	Multithread the loading of all the geometry data.	*/
-	for (size_t index_thread = 0; index_thread < model_threads.size(); index_thread++) {
-
-		const size_t start_mesh = (scene->mNumMeshes / nr_threads) * index_thread;
-		size_t num_mesh = (scene->mNumMeshes / nr_threads);
-		if (index_thread == model_threads.size() - 1) {
-			num_mesh *= 2;
-		}
-
-		model_threads[index_thread] = std::thread([&, start_mesh, num_mesh]() {
-			if (scene->HasMeshes()) {
-
-				for (size_t x = start_mesh; x < fragcore::Math::min<size_t>(start_mesh + num_mesh, scene->mNumMeshes);
-					 x++) {
-					this->initMesh(scene->mMeshes[x], x);
-				}
-			}
-		});
-	}
 	/*	*/
 	std::thread process_animation_light_camera_thread([&]() {
 		if (scene->HasAnimations()) {
@@ -210,13 +208,14 @@ void ModelImporter::initScene(const aiScene *scene) {
 	});
 	// process_animation_light_camera_thread.detach();
 
+	/*	Load all the geometry data on the current thread, alongside the textures and animations.	*/
+	if (scene->HasMeshes()) {
+		this->initMeshes(scene);
+	}
+
 	process_textures_thread.join();
 	process_animation_light_camera_thread.join();
 
-	for (size_t i = 0; i < model_threads.size(); i++) {
-		model_threads[i].join();
-	}
-
 	/*	*/
 	if (scene->HasMaterials()) {
 
@@ -337,131 +336,314 @@ SkeletonSystem *ModelImporter::initBoneSkeleton(const aiMesh *mesh, unsigned int
 	return nullptr;
 }
 
+void ModelImporter::initMeshes(const aiScene *scene) {
+
+	/*	Split large meshes into multiple ranges, so a single large mesh is not processed by a single thread.	*/
+	const size_t vertex_range_size = 64 * 1024;
+
+	using VertexRange = struct vertex_range_t {
+		unsigned int mesh;
+		size_t begin;
+		size_t end;
+	};
+
+	glsample::parallelFor(scene->mNumMeshes, 1, [&](const size_t begin, const size_t end) {
+		for (size_t x = begin; x < end; x++) {
+			this->initMeshLayout(scene->mMeshes[x], x);
+		}
+	});
+
+	std::vector<VertexRange> ranges;
+	for (unsigned int x = 0; x < scene->mNumMeshes; x++) {
+		const size_t nrVertices = scene->mMeshes[x]->mNumVertices;
+		for (size_t begin = 0; begin < nrVertices; begin += vertex_range_size) {
+			ranges.push_back({x, begin, fragcore::Math::min<size_t>(begin + vertex_range_size, nrVertices)});
+		}
+	}
+
+	/*	Each thread claims the next range when done, which balances meshes of different sizes.	*/
+	glsample::parallelFor(ranges.size(), 1, [&](const size_t begin, const size_t end) {
+		for (size_t x = begin; x < end; x++) {
+			const VertexRange &range = ranges[x];
+			const ModelSystemObject &mesh = this->models[range.mesh];
+			if (mesh.vertexLayout == VertexLayout::Compact) {
+				ModelImporter::packMeshVerticesCompact(scene->mMeshes[range.mesh], mesh, range.begin, range.end);
+			} else {
+				ModelImporter::packMeshVertices(scene->mMeshes[range.mesh], mesh, range.begin, range.end);
+			}
+		}
+	});
+
+	/*	Bone weights are written into the packed vertices, requires all the ranges to be done.	*/
+	glsample::parallelFor(scene->mNumMeshes, 1, [&](const size_t begin, const size_t end) {
+		for (size_t x = begin; x < end; x++) {
+			this->initMeshBonesAndIndices(scene->mMeshes[x], x);
+		}
+	});
+}
+
 ModelSystemObject *ModelImporter::initMesh(const aiMesh *aimesh, unsigned int index) {
+	ModelSystemObject *pmesh = this->initMeshLayout(aimesh, index);
+	if (pmesh->vertexLayout == VertexLayout::Compact) {
+		ModelImporter::packMeshVerticesCompact(aimesh, *pmesh, 0, aimesh->mNumVertices);
+	} else {
+		ModelImporter::packMeshVertices(aimesh, *pmesh, 0, aimesh->mNumVertices);
+	}
+	return this->initMeshBonesAndIndices(aimesh, index);
+}
+
+ModelSystemObject *ModelImporter::initMeshLayout(const aiMesh *aimesh, unsigned int index) {
 	ModelSystemObject *pmesh = &this->models[index];
+	pmesh->vertexLayout = this->vertexLayout;
 
 	const unsigned int nrUVs = fragcore::Math::max<unsigned int>(aimesh->GetNumUVChannels(), 1);
-	const unsigned int nrVertexColors = aimesh->GetNumColorChannels();
+	const bool compact = pmesh->vertexLayout == VertexLayout::Compact;
 
-	/*	*/
-	const size_t vertexSize = sizeof(float) * 3;
-	const size_t uvSize = nrUVs * (sizeof(float) * 2);
-	const size_t normalSize = sizeof(float) * 3;
-	const size_t tangentSize = sizeof(float) * 3;
+	/*	Compact, 4x unorm16 position, 2x half UV, normal and tangent octahedral encoded as 2x snorm16.	*/
+	const size_t vertexSize = compact ? sizeof(uint16_t) * 4 : sizeof(float) * 3;
+	const size_t uvSize = nrUVs * (compact ? sizeof(uint16_t) * 2 : sizeof(float) * 2);
+	const size_t normalSize = compact ? sizeof(uint32_t) : sizeof(float) * 3;
+	const size_t tangentSize = compact ? sizeof(uint32_t) : sizeof(float) * 3;
 	const size_t boneIDSize = sizeof(unsigned int);
 	const size_t boneWeightSize = sizeof(float);
 
 	/*	*/
 	const size_t boneWeightCount = 4;
 	size_t boneByteSize = 0;
-	size_t bonecount = 0;
 	if (aimesh->HasBones()) {
 		boneByteSize = boneIDSize * boneWeightCount + boneWeightSize * boneWeightCount;
-		bonecount = boneWeightCount;
 	}
 
 	/*	*/
 	const size_t StrideSize = vertexSize + uvSize + normalSize + tangentSize + boneByteSize;
-	const uint floatStride = StrideSize / sizeof(float);
 
-	const size_t indicesSize = 4;
+	/*	Assign data offset.	*/
+	pmesh->vertexOffset = 0;
+	pmesh->uvOffset = vertexSize;
+	pmesh->normalOffset = vertexSize + uvSize;
+	pmesh->tangentOffset = vertexSize + uvSize + normalSize;
+	if (aimesh->HasBones()) {
+		pmesh->boneIndexOffset = (vertexSize + uvSize + normalSize + tangentSize);
+		pmesh->boneWeightOffset = (vertexSize + uvSize + normalSize + tangentSize + boneWeightCount * boneIDSize);
+	}
 
-	/*	*/
-	float *vertices = (float *)malloc(aimesh->mNumVertices * StrideSize);
-	unsigned char *Indice =
-		(unsigned char *)malloc(indicesSize * aimesh->mNumFaces * 3); // TODO: compute number of faces.
+	pmesh->nrVertices = aimesh->mNumVertices;
+	pmesh->vertexStride = StrideSize;
+	pmesh->vertexData = malloc(aimesh->mNumVertices * StrideSize);
+	pmesh->primitiveType = aimesh->mPrimitiveTypes;
+	pmesh->name = std::string(aimesh->mName.C_Str());
 
-	/*	*/
-	unsigned char *Itemp = Indice;
+	return pmesh;
+}
 
-	/*	*/
-	const aiVector3D Zero = aiVector3D(0, 0, 0);
+/*	Number of vertices processed together, small enough to stay in registers once unrolled.	*/
+static const size_t vertex_block_size = 8;
+
+/*	Interleave a three component attribute, optionally normalized, for a block of vertices.	*/
+template <bool normalize>
+static inline void packVector3Block(const aiVector3D *source, float *destination, const size_t floatStride,
+									const size_t count) noexcept {
+	float x[vertex_block_size];
+	float y[vertex_block_size];
+	float z[vertex_block_size];
+
+	/*	Load.	*/
+	for (size_t i = 0; i < count; i++) {
+		x[i] = source[i].x;
+		y[i] = source[i].y;
+		z[i] = source[i].z;
+	}
+
+	if constexpr (normalize) {
+		for (size_t i = 0; i < count; i++) {
+			const float length = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+			const float invLength = length > 0.0f ? 1.0f / length : 0.0f;
+			x[i] *= invLength;
+			y[i] *= invLength;
+			z[i] *= invLength;
+		}
+	}
+
+	/*	Store.	*/
+	for (size_t i = 0; i < count; i++) {
+		float *vertex = &destination[i * floatStride];
+		vertex[0] = x[i];
+		vertex[1] = y[i];
+		vertex[2] = z[i];
+	}
+}
+
+template <bool normalize>
+static void packVector3(const aiVector3D *source, float *destination, const size_t floatStride, const size_t begin,
+						const size_t end) noexcept {
+	size_t x = begin;
+	for (; x + vertex_block_size <= end; x += vertex_block_size) {
+		packVector3Block<normalize>(&source[x], &destination[x * floatStride], floatStride, vertex_block_size);
+	}
+	packVector3Block<normalize>(&source[x], &destination[x * floatStride], floatStride, end - x);
+}
+
+static void packVector2(const aiVector3D *source, float *destination, const size_t floatStride, const size_t begin,
+						const size_t end) noexcept {
+	for (size_t x = begin; x < end; x++) {
+		float *vertex = &destination[x * floatStride];
+		vertex[0] = source[x].x;
+		vertex[1] = source[x].y;
+	}
+}
+
+static void packZero(float *destination, const size_t floatStride, const size_t nrFloats, const size_t begin,
+					 const size_t end) noexcept {
+	for (size_t x = begin; x < end; x++) {
+		std::memset(&destination[x * floatStride], 0, nrFloats * sizeof(float));
+	}
+}
+
+void ModelImporter::packMeshVertices(const aiMesh *aimesh, const ModelSystemObject &mesh, const size_t begin,
+									 const size_t end) noexcept {
+
+	float *vertices = static_cast<float *>(mesh.vertexData);
+	const size_t floatStride = mesh.vertexStride / sizeof(float);
+
+	/*	Each attribute is packed on its own, so the layout is only resolved once per range of vertices,
+	 * instead of per vertex.	*/
+	float *positions = &vertices[mesh.vertexOffset / sizeof(float)];
 	if (aimesh->HasPositions()) {
+		packVector3<false>(aimesh->mVertices, positions, floatStride, begin, end);
+	} else {
+		packZero(positions, floatStride, 3, begin, end);
+	}
 
-		for (unsigned int x = 0; x < aimesh->mNumVertices; x++) {
+	/*	UV coordinates.	*/
+	const unsigned int nrUVs = aimesh->GetNumUVChannels();
+	if (nrUVs > 0) {
+		for (unsigned int uv_index = 0; uv_index < nrUVs; uv_index++) {
+			float *uvs = &vertices[mesh.uvOffset / sizeof(float) + uv_index * 2];
+			packVector2(aimesh->mTextureCoords[uv_index], uvs, floatStride, begin, end);
+		}
+	} else {
+		packZero(&vertices[mesh.uvOffset / sizeof(float)], floatStride, 2, begin, end);
+	}
 
-			float *pVertex = &vertices[static_cast<size_t>(floatStride * x)];
+	/*	Normals.	*/
+	float *normals = &vertices[mesh.normalOffset / sizeof(float)];
+	if (aimesh->HasNormals()) {
+		packVector3<true>(aimesh->mNormals, normals, floatStride, begin, end);
+	} else {
+		packZero(normals, floatStride, 3, begin, end);
+	}
 
-			/*	*/
-			const aiVector3D *Pos = &(aimesh->mVertices[x]);
-			aiVector3D *pNormal = &(aimesh->mNormals[x]);
-			const aiVector3D *Tangent = aimesh->mTangents ? &(aimesh->mTangents[x]) : nullptr;
-
-			/*	Vertex position.	*/
-			*pVertex++ = Pos->x;
-			*pVertex++ = Pos->y;
-			*pVertex++ = Pos->z;
-
-			/*	UV coordinates.	*/
-			if (aimesh->GetNumUVChannels() > 0) {
-				for (unsigned int uv_index = 0; uv_index < aimesh->GetNumUVChannels(); uv_index++) {
-					if (aimesh->HasTextureCoords(uv_index)) {
-						*pVertex++ = aimesh->mTextureCoords[uv_index][x].x;
-						*pVertex++ = aimesh->mTextureCoords[uv_index][x].y;
-					}
-				}
-			} else {
-				*pVertex++ = 0;
-				*pVertex++ = 0;
-			}
+	/*	*/
+	float *tangents = &vertices[mesh.tangentOffset / sizeof(float)];
+	if (aimesh->mTangents) {
+		packVector3<false>(aimesh->mTangents, tangents, floatStride, begin, end);
+	} else {
+		packZero(tangents, floatStride, 3, begin, end);
+	}
 
-			/*	Normals.	*/
-			if (aimesh->HasNormals()) {
-				pNormal->Normalize();
-				*pVertex++ = pNormal->x;
-				*pVertex++ = pNormal->y;
-				*pVertex++ = pNormal->z;
-			} else {
-				*pVertex++ = 0;
-				*pVertex++ = 0;
-				*pVertex++ = 0;
-			}
+	/*	Offset only. assign later.	*/
+	if (aimesh->HasBones()) {
+		const size_t boneFloats = floatStride - mesh.boneIndexOffset / sizeof(float);
+		packZero(&vertices[mesh.boneIndexOffset / sizeof(float)], floatStride, boneFloats, begin, end);
+	}
+}
 
-			/*	*/
-			if (Tangent) {
-				*pVertex++ = Tangent->x;
-				*pVertex++ = Tangent->y;
-				*pVertex++ = Tangent->z;
-			} else {
+/*	Uniform scale of the position quantization, the largest extent of the AABB. Being uniform, directions are
+ * left unaffected by the dequantization, besides their length.	*/
+static inline float computeQuantizationScale(const aiAABB &aabb) noexcept {
+	const float extent = fragcore::Math::max<float>(
+		aabb.mMax.x - aabb.mMin.x, fragcore::Math::max<float>(aabb.mMax.y - aabb.mMin.y, aabb.mMax.z - aabb.mMin.z));
+	return extent > 0 ? extent : 1.0f;
+}
 
-				*pVertex++ = 0;
-				*pVertex++ = 0;
-				*pVertex++ = 0;
-			}
+/*	Direction octahedral encoded as 2x snorm16, independent of the mesh bounds.	*/
+static inline uint32_t packDirection(const aiVector3D &direction) noexcept {
+	const glm::vec3 dir = glm::vec3(direction.x, direction.y, direction.z);
+	const float sum = std::abs(dir.x) + std::abs(dir.y) + std::abs(dir.z);
+	if (sum <= 0.0f) {
+		return 0;
+	}
 
-			if (aimesh->GetNumColorChannels() > 0) {
-				for (unsigned int color_index = 0; color_index < aimesh->GetNumColorChannels(); color_index++) {
-					aimesh->mColors[color_index][x];
-				}
-			}
+	glm::vec2 oct = glm::vec2(dir.x, dir.y) / sum;
+	/*	Fold the lower hemisphere over the diagonals.	*/
+	if (dir.z < 0.0f) {
+		oct = (1.0f - glm::abs(glm::vec2(oct.y, oct.x))) *
+			  glm::vec2(oct.x >= 0.0f ? 1.0f : -1.0f, oct.y >= 0.0f ? 1.0f : -1.0f);
+	}
+	return glm::packSnorm2x16(oct);
+}
 
-			/*	Offset only. assign later.	*/
-			if (boneByteSize > 0 && bonecount > 0) {
-				/*	BoneID	*/
-				for (unsigned int i = 0; i < bonecount; i++) {
-					*pVertex++ = 0;
-				}
-				/*	BoneWeight	*/
-				for (unsigned int i = 0; i < bonecount; i++) {
-					*pVertex++ = 0;
-				}
-			}
+void ModelImporter::packMeshVerticesCompact(const aiMesh *aimesh, const ModelSystemObject &mesh, const size_t begin,
+											const size_t end) noexcept {
 
-		} /*	*/
+	uint8_t *vertices = static_cast<uint8_t *>(mesh.vertexData);
+	const size_t stride = mesh.vertexStride;
+
+	const glm::vec3 min = glm::vec3(aimesh->mAABB.mMin.x, aimesh->mAABB.mMin.y, aimesh->mAABB.mMin.z);
+	const float invScale = 1.0f / computeQuantizationScale(aimesh->mAABB);
+
+	/*	Position.	*/
+	for (size_t x = begin; x < end; x++) {
+		const aiVector3D &position = aimesh->HasPositions() ? aimesh->mVertices[x] : aiVector3D(0, 0, 0);
+		const glm::vec3 normalized =
+			glm::clamp((glm::vec3(position.x, position.y, position.z) - min) * invScale, glm::vec3(0), glm::vec3(1));
+
+		const uint64_t packed = glm::packUnorm4x16(glm::vec4(normalized, 0.0f));
+		std::memcpy(&vertices[x * stride + mesh.vertexOffset], &packed, sizeof(packed));
 	}
 
-	/*	Assign data offset.	*/
-	pmesh->vertexOffset = 0;
-	pmesh->uvOffset = vertexSize;
-	pmesh->normalOffset = vertexSize + uvSize;
-	pmesh->tangentOffset = vertexSize + uvSize + normalSize;
+	/*	UV coordinates.	*/
+	const unsigned int nrUVs = fragcore::Math::max<unsigned int>(aimesh->GetNumUVChannels(), 1);
+	for (unsigned int uv_index = 0; uv_index < nrUVs; uv_index++) {
+		const aiVector3D *uvs = aimesh->HasTextureCoords(uv_index) ? aimesh->mTextureCoords[uv_index] : nullptr;
+		for (size_t x = begin; x < end; x++) {
+			const uint32_t packed = uvs ? glm::packHalf2x16(glm::vec2(uvs[x].x, uvs[x].y)) : 0;
+			std::memcpy(&vertices[x * stride + mesh.uvOffset + uv_index * sizeof(packed)], &packed, sizeof(packed));
+		}
+	}
 
-	/*	Load bones.	*/
+	/*	Normals.	*/
+	for (size_t x = begin; x < end; x++) {
+		const uint32_t packed = aimesh->HasNormals() ? packDirection(aimesh->mNormals[x]) : 0;
+		std::memcpy(&vertices[x * stride + mesh.normalOffset], &packed, sizeof(packed));
+	}
+
+	/*	*/
+	for (size_t x = begin; x < end; x++) {
+		const uint32_t packed = aimesh->mTangents ? packDirection(aimesh->mTangents[x]) : 0;
+		std::memcpy(&vertices[x * stride + mesh.tangentOffset], &packed, sizeof(packed));
+	}
+
+	/*	Offset only. assign later.	*/
 	if (aimesh->HasBones()) {
+		const size_t boneSize = stride - mesh.boneIndexOffset;
+		for (size_t x = begin; x < end; x++) {
+			std::memset(&vertices[x * stride + mesh.boneIndexOffset], 0, boneSize);
+		}
+	}
+}
 
-		/*	*/
-		pmesh->boneIndexOffset = (vertexSize + uvSize + normalSize + tangentSize);
-		pmesh->boneWeightOffset = (vertexSize + uvSize + normalSize + tangentSize + bonecount * boneIDSize);
+ModelSystemObject *ModelImporter::initMeshBonesAndIndices(const aiMesh *aimesh, unsigned int index) {
+	ModelSystemObject *pmesh = &this->models[index];
+
+	float *vertices = static_cast<float *>(pmesh->vertexData);
+	const uint floatStride = pmesh->vertexStride / sizeof(float);
+	const size_t bonecount = 4;
+
+	/*	16-bit indices, if all vertices can be addressed.	*/
+	const bool shortIndices = pmesh->vertexLayout == VertexLayout::Compact &&
+							  aimesh->mNumVertices <= std::numeric_limits<uint16_t>::max();
+	const size_t indicesSize = shortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
+
+	/*	*/
+	unsigned char *Indice =
+		(unsigned char *)malloc(indicesSize * aimesh->mNumFaces * 3); // TODO: compute number of faces.
+
+	/*	*/
+	unsigned char *Itemp = Indice;
+
+	/*	Load bones.	*/
+	if (aimesh->HasBones()) {
 
 		const uint BoneStrideOffset = (pmesh->boneIndexOffset / sizeof(float));
 
@@ -510,24 +692,13 @@ ModelSystemObject *ModelImporter::initMesh(const aiMesh *aimesh, unsigned int in
 				nrFaces += face.mNumIndices;
 			}
 
-		} else { // TODO determine if can be removed.
+		} else {
+			uint16_t *shortIndice = reinterpret_cast<uint16_t *>(Indice);
 			for (size_t x = 0; x < aimesh->mNumFaces; x++) {
 				const aiFace &face = aimesh->mFaces[x];
 
-				if (face.mNumIndices == 3) {
-
-					std::memcpy(Indice, &face.mIndices[0], indicesSize);
-					Indice += indicesSize;
-					std::memcpy(Indice, &face.mIndices[1], indicesSize);
-					Indice += indicesSize;
-					std::memcpy(Indice, &face.mIndices[2], indicesSize);
-					Indice += indicesSize;
-
-				} else if (face.mNumIndices == 2) {
-					std::memcpy(Indice, &face.mIndices[0], indicesSize);
-					Indice += indicesSize;
-					std::memcpy(Indice, &face.mIndices[1], indicesSize);
-					Indice += indicesSize;
+				for (unsigned int i = 0; i < face.mNumIndices; i++) {
+					*shortIndice++ = static_cast<uint16_t>(face.mIndices[i]);
 				}
 
 				nrFaces += face.mNumIndices;
@@ -562,11 +733,6 @@ ModelSystemObject *ModelImporter::initMesh(const aiMesh *aimesh, unsigned int in
 	pmesh->indicesData = Indice;
 	pmesh->indicesStride = indicesSize;
 	pmesh->nrIndices = nrFaces;
-	pmesh->nrVertices = aimesh->mNumVertices;
-	pmesh->vertexData = vertices;
-	pmesh->vertexStride = StrideSize;
-	pmesh->primitiveType = aimesh->mPrimitiveTypes;
-	pmesh->name = std::string(aimesh->mName.C_Str());
 
 	return pmesh;
 }
@@ -36,6 +36,7 @@
 #include <glm/fwd.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
+#include <memory>
 
 namespace glsample {}
 
@@ -142,6 +143,16 @@ using MeshData = struct mesh_data_t : public AssetObject {
 
 using MorpthTarget = struct morph_target {};
 
+/**
+ * @brief Vertex layout of the imported meshes.
+ */
+enum class VertexLayout : unsigned int {
+	Float = 0, /*	32-bit float attributes and 32-bit indices.	*/
+	/*	Position quantized against the largest extent of the mesh AABB as 16-bit unorm, half float UV, normal
+	 * and tangent octahedral encoded as 2x 16-bit snorm. 16-bit indices when possible.	*/
+	Compact = 1,
+};
+
 using ModelSystemObject = struct model_system_object : public AssetObject {
 
 	// MeshData mesh;
@@ -168,6 +179,7 @@ using ModelSystemObject = struct model_system_object : public AssetObject {
 	unsigned int boneIndexOffset{};
 
 	unsigned int primitiveType{};
+	VertexLayout vertexLayout = VertexLayout::Float;
 };
 
 using Bone = struct bone_t : public AssetObject {
@@ -234,6 +246,8 @@ using LightObject = struct light_object_t : public AssetObject {
 };
 
 class FVDECLSPEC ModelImporter {
+	friend class ModelCache;
+
   public:
 	ModelImporter(fragcore::IFileSystem *fileSystem) : fileSystem(fileSystem) {}
 	ModelImporter(const ModelImporter &other) = default;
@@ -250,6 +264,12 @@ class FVDECLSPEC ModelImporter {
 
 	fragcore::IFileSystem *getFileSystem() const noexcept { return this->fileSystem; }
 
+	/**
+	 * @brief Vertex layout used for all the meshes loaded after.
+	 */
+	void setVertexLayout(const VertexLayout layout) noexcept { this->vertexLayout = layout; }
+	VertexLayout getVertexLayout() const noexcept { return this->vertexLayout; }
+
   protected:
 	void initScene(const aiScene *scene);
 
@@ -260,8 +280,29 @@ class FVDECLSPEC ModelImporter {
 
 	MaterialObject *initMaterial(aiMaterial *material, size_t index);
 
+	/**
+	 * @brief Load all the meshes of the scene, distributing the vertex packing of all meshes on all cores.
+	 */
+	void initMeshes(const aiScene *scene);
+
 	ModelSystemObject *initMesh(const aiMesh *mesh, unsigned int index);
 
+	/**
+	 * @brief Compute the vertex layout and allocate the vertex buffer.
+	 */
+	ModelSystemObject *initMeshLayout(const aiMesh *mesh, unsigned int index);
+
+	/**
+	 * @brief Interleave the vertices [begin, end) into the vertex buffer, ranges can be packed concurrently.
+	 */
+	static void packMeshVertices(const aiMesh *mesh, const ModelSystemObject &object, const size_t begin,
+								 const size_t end) noexcept;
+
+	static void packMeshVerticesCompact(const aiMesh *mesh, const ModelSystemObject &object, const size_t begin,
+										const size_t end) noexcept;
+
+	ModelSystemObject *initMeshBonesAndIndices(const aiMesh *mesh, unsigned int index);
+
 	SkeletonSystem *initBoneSkeleton(const aiMesh *mesh, unsigned int index);
 
 	TextureAssetObject *initTexture(aiTexture *texture, unsigned int index);
@@ -320,4 +361,9 @@ class FVDECLSPEC ModelImporter {
 
 	NodeObject *rootNode = nullptr;
 	glm::mat4 globalNodeTransform;
+
+	VertexLayout vertexLayout = VertexLayout::Float;
+
+	/*	Mapped cache entry, holds the vertex and index data of the models loaded from the cache.	*/
+	std::shared_ptr<const void> cacheMapping;
 };
@@ -1,5 +1,6 @@
 #include "Scene.h"
 #include "../Common.h"
+#include "../Profiler.h"
 #include "Math3D/Color.h"
 #include "ModelImporter.h"
 #include "UIComponent.h"
@@ -8,9 +9,12 @@
 #include "imgui.h"
 #include "magic_enum.hpp"
 #include <GL/glew.h>
+#include <algorithm>
+#include <cstring>
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/geometric.hpp>
 #include <iostream>
+#include <limits>
 #include <ostream>
 #include <sys/types.h>
 
@@ -47,6 +51,29 @@ namespace glsample {
 			}
 		}
 
+		this->textureStreamer.reset();
+
+		/*	*/
+		for (GLsync &fence : this->indirectStructure.fences) {
+			if (fence) {
+				glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+		if (glIsBuffer(this->indirectStructure.indirect_buffer)) {
+			glDeleteBuffers(1, &this->indirectStructure.indirect_buffer);
+		}
+		if (glIsBuffer(this->indirectStructure.draw_buffer)) {
+			glDeleteBuffers(1, &this->indirectStructure.draw_buffer);
+		}
+		if (glIsBuffer(this->gpu_culling_assign_buffer)) {
+			glDeleteBuffers(1, &this->gpu_culling_assign_buffer);
+		}
+		this->gpuCulling.reset();
+		this->depthPyramid.reset();
+		this->occlusionQuery.reset();
+		this->clusteredLights.reset();
+
 		/*	*/
 		for (size_t tex_index = 0; tex_index < this->refTexture.size(); tex_index++) {
 			if (glIsTexture(this->refTexture[tex_index].texture)) {
@@ -159,6 +186,29 @@ namespace glsample {
 
 			glBindBuffer(GL_UNIFORM_BUFFER, 0);
 		}
+
+		/*	No point lights until set, the cluster buffers are still bound for the shaders.	*/
+		this->clusteredLights = std::make_shared<ClusteredLights>();
+		this->clusteredLights->init(nullptr);
+	}
+
+	/*	Uniform scale of the quantized position, the largest extent of the mesh AABB.	*/
+	static inline float computeDequantizationScale(const MeshObject &mesh) noexcept {
+		const glm::vec3 extent = glm::vec3(mesh.bound.aabb.max[0] - mesh.bound.aabb.min[0],
+										   mesh.bound.aabb.max[1] - mesh.bound.aabb.min[1],
+										   mesh.bound.aabb.max[2] - mesh.bound.aabb.min[2]);
+		const float scale = fragcore::Math::max<float>(extent.x, fragcore::Math::max<float>(extent.y, extent.z));
+		return scale > 0 ? scale : 1.0f;
+	}
+
+	/*	Transform from the quantized position to the mesh space, identity for float positions.	*/
+	static inline glm::mat4 computeDequantizationMatrix(const MeshObject &mesh) noexcept {
+		if (!mesh.quantized_position) {
+			return glm::mat4(1.0f);
+		}
+
+		const glm::vec3 min = glm::vec3(mesh.bound.aabb.min[0], mesh.bound.aabb.min[1], mesh.bound.aabb.min[2]);
+		return glm::scale(glm::translate(glm::mat4(1.0f), min), glm::vec3(computeDequantizationScale(mesh)));
 	}
 
 	void Scene::update(const float deltaTime) {
@@ -170,17 +220,59 @@ namespace glsample {
 			// this->animations[x].curves;
 		}
 
+		this->detectChanges();
 		this->updateBuffers();
 	}
 
+	void Scene::writeNodeData(const NodeObject *node, const size_t node_index) noexcept {
+		for (size_t geo_index = 0; geo_index < node->geometryObjectIndex.size(); geo_index++) {
+			const MeshObject &refMesh = this->refGeometry[node->geometryObjectIndex[geo_index]];
+			this->stageNodeData[node_index + geo_index].model =
+				node->modelGlobalTransform * computeDequantizationMatrix(refMesh);
+		}
+	}
+
 	void Scene::updateBuffers() {
 
-		/*	*/
-		size_t node_index = 0;
-		auto copyQueue = renderQueue;
-		for (const NodeObject *node : copyQueue) {
-			this->stageNodeData[node_index++].model = node->modelGlobalTransform;
+		/*	One node data per geometry, in node order, independent of the render order.	*/
+		size_t flush_begin = 0;
+		size_t flush_end = 0;
+		if (this->nodeDataDirty) {
+			size_t node_index = 0;
+			const size_t maxNodeData = this->UBOStructure.node_size_align / sizeof(NodeData);
+
+			this->nodeDataIndex.clear();
+			for (const NodeObject *node : this->nodes) {
+				if (node_index + node->geometryObjectIndex.size() > maxNodeData) {
+					break;
+				}
+
+				this->nodeDataIndex[node] = node_index;
+				this->writeNodeData(node, node_index);
+				node_index += node->geometryObjectIndex.size();
+			}
+
+			flush_end = node_index;
+			this->nodeDataDirty = false;
+
+			/*	The draws of the GPU culling reference the node data by index.	*/
+			this->gpuCullingDirty = true;
+		} else {
+			/*	Only the nodes moved since the last update.	*/
+			flush_begin = std::numeric_limits<size_t>::max();
+			for (const NodeObject *node : this->movedNodes) {
+				const auto nodeData = this->nodeDataIndex.find(node);
+				if (nodeData == this->nodeDataIndex.end()) {
+					continue;
+				}
+
+				this->writeNodeData(node, nodeData->second);
+				flush_begin = std::min(flush_begin, nodeData->second);
+				flush_end = std::max(flush_end, nodeData->second + node->geometryObjectIndex.size());
+			}
+			flush_begin = std::min(flush_begin, flush_end);
 		}
+		this->movedNodes.clear();
 
 		/*	Update Materials.	*/
 		size_t material_index = 0;
@@ -203,7 +295,11 @@ namespace glsample {
 									 this->UBOStructure.common_size_align);
 
 			/*	Update Node Data.	*/
-			glFlushMappedBufferRange(GL_UNIFORM_BUFFER, this->UBOStructure.node_offset, node_index * sizeof(NodeData));
+			if (flush_end > flush_begin) {
+				glFlushMappedBufferRange(GL_UNIFORM_BUFFER,
+										 this->UBOStructure.node_offset + flush_begin * sizeof(NodeData),
+										 (flush_end - flush_begin) * sizeof(NodeData));
+			}
 
 			/*	Update Material.	*/
 			glFlushMappedBufferRange(GL_UNIFORM_BUFFER, this->UBOStructure.material_offset,
@@ -217,46 +313,146 @@ namespace glsample {
 		}
 	}
 
-	void Scene::culling(Frustum *frustum) {
+	/*	World space AABB of the node bounds, from the transformed center and extent.	*/
+	void Scene::computeWorldBounds(const NodeObject &node, glm::vec3 &min, glm::vec3 &max) noexcept {
+		const glm::vec3 localMin = glm::vec3(node.bound.aabb.min[0], node.bound.aabb.min[1], node.bound.aabb.min[2]);
+		const glm::vec3 localMax = glm::vec3(node.bound.aabb.max[0], node.bound.aabb.max[1], node.bound.aabb.max[2]);
 
-		this->visableNodes.clear();
+		const glm::vec3 center = (localMin + localMax) * 0.5f;
+		const glm::vec3 extent = (localMax - localMin) * 0.5f;
 
-		/*	Frustum Culling.	*/
-		if (this->frustumCulling && frustum) {
-			for (size_t x = 0; x < this->getNodes().size(); x++) {
+		const glm::mat4 &transform = node.modelGlobalTransform;
+		const glm::vec3 worldCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+		const glm::vec3 worldExtent = glm::abs(glm::vec3(transform[0])) * extent.x +
+									  glm::abs(glm::vec3(transform[1])) * extent.y +
+									  glm::abs(glm::vec3(transform[2])) * extent.z;
 
-				NodeObject *node = this->getNodes()[x];
+		min = worldCenter - worldExtent;
+		max = worldCenter + worldExtent;
+	}
 
-				for (size_t i = 0; i < node->geometryObjectIndex.size(); i++) {
+	void Scene::invalidate() noexcept {
+		this->nodeDataDirty = true;
+		this->gpuCullingDirty = true;
+		this->cullingHierarchyDirty = true;
+		this->movedNodes.clear();
+	}
 
-					/*	Compute world space AABB.	*/
-					const AABB aabb = GeometryUtility::computeBoundingBox(
-						fragcore::AABB::createMinMax(
-							Vector3(node->bound.aabb.min[0], node->bound.aabb.min[1], node->bound.aabb.min[2]),
-							Vector3(node->bound.aabb.max[0], node->bound.aabb.max[1], node->bound.aabb.max[2])),
-						GLM2E<float, 4, 4>(node->modelGlobalTransform));
+	void Scene::detectChanges() {
 
-					if (false) {
-						BoundingSphere sphere = BoundingSphere(aabb.getCenter(), aabb.getSize().norm());
+		/*	The queue domain decides which nodes are drawn by the GPU culling, and the bucket of each draw.	*/
+		this->materialDomains.resize(this->materials.size());
+		for (size_t material_index = 0; material_index < this->materials.size(); material_index++) {
+			this->materialDomains[material_index] =
+				Scene::getQueueDomainIndex(this->getQueueDomain(this->materials[material_index]));
+		}
 
-						if (frustum->intersectionSphere(sphere) == Frustum::In) {
-							/*	*/
-							visableNodes.push_back(node);
-							break;
-						}
+		if (this->builtNodeCount != this->nodes.size() || this->builtMaterialDomains != this->materialDomains) {
+			this->invalidate();
+			this->builtNodeCount = this->nodes.size();
+			this->builtMaterialDomains = this->materialDomains;
+		}
+	}
 
-					} else {
+	bool Scene::isGPUCulled(const NodeObject &node) const noexcept {
+		/*	Same domain as the render queue, see sortRenderQueue.	*/
+		if (node.materialIndex.empty() || node.materialIndex[0] >= this->materials.size()) {
+			return false;
+		}
+		return Scene::getQueueDomainIndex(this->getQueueDomain(this->materials[node.materialIndex[0]])) <
+			   Scene::getQueueDomainIndex(RenderQueue::Transparent);
+	}
 
-						if (frustum->intersectionAABB(aabb) == Frustum::In) {
-							/*	*/
-							visableNodes.push_back(node);
-							break;
-						}
-					}
-				}
+	void Scene::buildCullingHierarchy() {
+
+		this->cullingNodes.clear();
+		this->cullingItemIndex.clear();
+		this->cullingHierarchyGPU = this->isGPUCullingActive();
+		this->cullingHierarchyDirty = false;
+
+		std::vector<glm::vec3> mins;
+		std::vector<glm::vec3> maxs;
+		for (NodeObject *node : this->nodes) {
+			if (node->geometryObjectIndex.empty()) {
+				continue;
+			}
+
+			/*	Opaque nodes are culled on the GPU, and are never part of the render queue.	*/
+			if (this->cullingHierarchyGPU && this->isGPUCulled(*node)) {
+				continue;
 			}
+
+			glm::vec3 min, max;
+			computeWorldBounds(*node, min, max);
+
+			this->cullingItemIndex[node] = static_cast<uint32_t>(this->cullingNodes.size());
+			this->cullingNodes.push_back(node);
+			mins.push_back(min);
+			maxs.push_back(max);
+		}
+
+		this->cullingHierarchy.build(mins.data(), maxs.data(), mins.size());
+	}
+
+	void Scene::updateNodeBounds(const NodeObject *node) {
+		this->movedNodes.push_back(node);
+
+		const auto item = this->cullingItemIndex.find(node);
+		if (item == this->cullingItemIndex.end()) {
+			return;
+		}
+
+		glm::vec3 min, max;
+		computeWorldBounds(*node, min, max);
+		this->cullingHierarchy.setBounds(item->second, min, max);
+	}
+
+	bool Scene::computeBounds(glm::vec3 &min, glm::vec3 &max) const {
+		bool found = false;
+		for (const NodeObject *node : this->nodes) {
+			if (node->geometryObjectIndex.empty()) {
+				continue;
+			}
+
+			glm::vec3 nodeMin, nodeMax;
+			computeWorldBounds(*node, nodeMin, nodeMax);
+			min = found ? glm::min(min, nodeMin) : nodeMin;
+			max = found ? glm::max(max, nodeMax) : nodeMax;
+			found = true;
+		}
+		return found;
+	}
+
+	void Scene::culling(Frustum *frustum) {
+
+		this->visableNodes.clear();
+
+		/*	Planes of the GPU culling.	*/
+		if (frustum) {
+			std::memcpy(this->cullingPlanes, frustum->getPlaneEquations(), sizeof(this->cullingPlanes));
+		}
+
+		this->detectChanges();
+		if (this->cullingHierarchyDirty || this->cullingHierarchyGPU != this->isGPUCullingActive()) {
+			this->buildCullingHierarchy();
+		}
+
+		/*	Frustum Culling.	*/
+		if (this->frustumCulling && frustum) {
+
+			/*	Apply the moved nodes.	*/
+			this->cullingHierarchy.refit();
+
+			this->visibleItems.clear();
+			this->cullingHierarchy.cull(*frustum, this->visibleItems);
+
+			for (const uint32_t item : this->visibleItems) {
+				this->visableNodes.push_back(this->cullingNodes[item]);
+			}
+		} else if (this->cullingHierarchyGPU) {
+			this->visableNodes = this->cullingNodes;
 		} else {
-			visableNodes = this->getNodes();
+			this->visableNodes = this->getNodes();
 		}
 	}
 
@@ -269,6 +465,20 @@ namespace glsample {
 			this->stageCommonBuffer->camera = *cameraController;
 			/*	*/
 			this->stageCommonBuffer->proj[0] = camera->getProjectionMatrix();
+
+			/*	View depth of the render queue sorting.	*/
+			if (cameraController) {
+				this->sortViewMatrix = cameraController->getViewMatrix();
+				this->renderViewProjection = camera->getProjectionMatrix() * this->sortViewMatrix;
+
+				/*	Clusters tiled over the current viewport, only when the sample uses the clustered lights.	*/
+				if (this->clusteredLighting && this->clusteredLights->getNrLights() > 0) {
+					GLint viewport[4];
+					glGetIntegerv(GL_VIEWPORT, viewport);
+					this->clusteredLights->update(this->sortViewMatrix, camera->getProjectionMatrix(),
+												  camera->getNear(), camera->getFar(), viewport[2], viewport[3]);
+				}
+			}
 		}
 
 		/*	*/
@@ -278,13 +488,22 @@ namespace glsample {
 		this->render();
 	}
 
+	const RenderQueue Scene::renderQueueOrder[Scene::nrRenderQueueDomains] = {
+		RenderQueue::Background,   RenderQueue::Geometry,	 RenderQueue::AlphaTest,
+		RenderQueue::GeometryLast, RenderQueue::Transparent, RenderQueue::Overlay};
+
 	void Scene::render() {
 
+		/*	Swap in the textures loaded since the last render, samples are not required to call update.	*/
+		if (this->textureStreamer) {
+			this->textureStreamer->update(this->refTexture);
+		}
+
 		/*	Reset States.	*/
 		this->currentNodeIndex = 0;
+		this->currentNodeBlock = std::numeric_limits<size_t>::max();
 		this->currentBindedMaterial = nullptr;
 
-		// TODO: sort materials and geometry.
 		this->sortRenderQueue();
 
 		// TODO: merge by shared geometries.
@@ -296,35 +515,52 @@ namespace glsample {
 						  this->UBOStructure.node_and_common_uniform_buffer, this->UBOStructure.common_offset,
 						  this->UBOStructure.common_size_align);
 
-		const std::vector<RenderQueue> order = {RenderQueue::Background,  RenderQueue::Geometry,
-												RenderQueue::AlphaTest,	  RenderQueue::GeometryLast,
-												RenderQueue::Transparent, RenderQueue::Overlay};
+		/*	Materials may include the cluster lights, valid without any lights.	*/
+		this->clusteredLights->bind();
 
-		for (auto it = order.begin(); it != order.end(); it++) {
-			// RenderQueue renderQueue = (*it).first;
-			std::deque<const NodeObject *> nodeQueue = this->renderBucketQueue[(*it)];
+		/*	Opaque geometries culled and drawn on the GPU, the remaining domains from the render queue.	*/
+		const bool useGPUCulling = this->isGPUCullingActive();
+		const unsigned int first_domain = useGPUCulling ? Scene::getQueueDomainIndex(RenderQueue::Transparent) : 0;
+		if (useGPUCulling) {
+			this->renderGPUCulled();
+		}
 
-			/*	*/
-			const std::string domain = fmt::format("{}", (int)(*it)); // magic_enum::enum_name((*it));
+		const bool useIndirect = this->indirectDraw && glMultiDrawElementsIndirect && glBufferStorage;
+		if (useIndirect) {
+			this->renderIndirect(first_domain);
+		}
 
-			glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 1, domain.size(), domain.data());
-			for (auto itQ = nodeQueue.begin(); itQ != nodeQueue.end(); itQ++) {
-				const NodeObject *node = (*itQ);
-				this->renderNode(node);
+		for (unsigned int domain_index = first_domain; !useIndirect && domain_index < Scene::nrRenderQueueDomains;
+			 domain_index++) {
+			const size_t begin = this->renderQueueOffsets[domain_index];
+			const size_t end = this->renderQueueOffsets[domain_index + 1];
+			if (begin == end) {
+				continue;
 			}
-			glPopDebugGroup();
-		}
 
-		for (auto it = this->renderQueue.begin(); it != this->renderQueue.end(); it++) {
-			const NodeObject *node = (*it);
-			// this->renderNode(node);
+			/*	*/
+			const std::string_view domain = magic_enum::enum_name(Scene::renderQueueOrder[domain_index]);
+
+			/*	Transparent nodes are never occluders, and not worth a query.	*/
+			const bool useOcclusionQuery = this->occlusionMode == OcclusionMode::ConditionalRender &&
+										   this->occlusionQuery &&
+										   domain_index < Scene::getQueueDomainIndex(RenderQueue::Transparent);
+
+			Profiler::pushScope(domain);
+			if (useOcclusionQuery) {
+				this->renderOcclusionQueried(begin, end);
+			} else {
+				for (size_t queue_index = begin; queue_index < end; queue_index++) {
+					this->renderNode(this->renderQueue[queue_index]);
+				}
+			}
+			Profiler::popScope();
 		}
 
 		if (this->debugMode & DebugMode::Wireframe) {
 			/*	*/
 			for (const NodeObject *node : this->renderQueue) {
 				/*	*/
-				// const NodeObject *node = this->renderQueue[x];
 				// this->renderNode(node);
 			}
 		}
@@ -437,25 +673,39 @@ namespace glsample {
 		}
 	}
 
-	void Scene::renderNode(const NodeObject *node) {
+	void Scene::bindNodeBlock(const size_t node_block) {
+		if (node_block == this->currentNodeBlock) {
+			return;
+		}
+
+		const size_t model_total_offset =
+			this->UBOStructure.node_offset + (node_block * 65536); // TODO:fix constants.
+		glBindBufferRange(GL_UNIFORM_BUFFER, this->UBOStructure.node_buffer_binding,
+						  this->UBOStructure.node_and_common_uniform_buffer, model_total_offset,
+						  this->UBOStructure.node_size_align);
+
+		// TODO: fix binding offset.
+		glBindBufferRange(GL_UNIFORM_BUFFER, this->UBOStructure.material_buffer_binding,
+						  this->UBOStructure.node_and_common_uniform_buffer, this->UBOStructure.material_offset,
+						  this->UBOStructure.material_align_size);
 
-		/*	Update binding offset.	*/
-		if (currentNodeIndex % this->UBOStructure.max_node_per_binding == 0) {
-			const unsigned int model_block_offset = currentNodeIndex / this->UBOStructure.max_node_per_binding;
-			const size_t model_total_offset =
-				this->UBOStructure.node_offset + (model_block_offset * 65536); // TODO:fix constants.
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->UBOStructure.node_buffer_binding,
-							  this->UBOStructure.node_and_common_uniform_buffer, model_total_offset,
-							  this->UBOStructure.node_size_align);
+		this->currentNodeBlock = node_block;
+	}
+
+	void Scene::renderNode(const NodeObject *node) {
 
-			// TODO: fix binding offset.
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->UBOStructure.material_buffer_binding,
-							  this->UBOStructure.node_and_common_uniform_buffer, this->UBOStructure.material_offset,
-							  this->UBOStructure.material_align_size);
+		const auto nodeData = this->nodeDataIndex.find(node);
+		if (nodeData == this->nodeDataIndex.end()) {
+			return;
 		}
 
 		for (size_t geo_index = 0; geo_index < node->geometryObjectIndex.size(); geo_index++) {
 
+			const size_t node_data_index = nodeData->second + geo_index;
+
+			/*	Update binding offset.	*/
+			this->bindNodeBlock(node_data_index / this->UBOStructure.max_node_per_binding);
+
 			/*	Setup material.	*/
 			const int material_index = node->materialIndex[geo_index];
 			{
@@ -467,10 +717,10 @@ namespace glsample {
 			const MeshObject &refMesh = this->refGeometry[node->geometryObjectIndex[geo_index]];
 			glBindVertexArray(refMesh.vao);
 			/*	Material, model matrix.	*/
-			glVertexAttribI2i(8, material_index, currentNodeIndex % this->UBOStructure.max_node_per_binding);
+			glVertexAttribI2i(8, material_index, node_data_index % this->UBOStructure.max_node_per_binding);
 			/*	*/
-			glDrawElementsBaseVertex(refMesh.primitiveType, refMesh.nrIndicesElements, GL_UNSIGNED_INT,
-									 (void *)(sizeof(unsigned int) * refMesh.indices_offset), refMesh.vertex_offset);
+			glDrawElementsBaseVertex(refMesh.primitiveType, refMesh.nrIndicesElements, refMesh.indices_type,
+									 (void *)(refMesh.indices_stride * refMesh.indices_offset), refMesh.vertex_offset);
 
 			// glBindVertexArray(0);
 		}
@@ -479,10 +729,104 @@ namespace glsample {
 		this->currentNodeIndex++;
 	}
 
+	/*	Sort the keys with the node index, least significant byte first. Bytes equal in all keys are skipped.	*/
+	static void radixSortKeys(std::vector<uint64_t> &keys, std::vector<uint32_t> &values,
+							  std::vector<uint64_t> &scratchKeys, std::vector<uint32_t> &scratchValues) noexcept {
+		const size_t count = keys.size();
+
+		size_t histogram[8][256] = {};
+		for (size_t i = 0; i < count; i++) {
+			const uint64_t key = keys[i];
+			for (unsigned int pass = 0; pass < 8; pass++) {
+				histogram[pass][(key >> (pass * 8)) & 0xff]++;
+			}
+		}
+
+		for (unsigned int pass = 0; pass < 8; pass++) {
+			size_t(&bucket)[256] = histogram[pass];
+			if (bucket[(keys[0] >> (pass * 8)) & 0xff] == count) {
+				continue;
+			}
+
+			/*	Exclusive prefix sum.	*/
+			size_t offset = 0;
+			for (unsigned int digit = 0; digit < 256; digit++) {
+				const size_t digit_count = bucket[digit];
+				bucket[digit] = offset;
+				offset += digit_count;
+			}
+
+			for (size_t i = 0; i < count; i++) {
+				const size_t dst = bucket[(keys[i] >> (pass * 8)) & 0xff]++;
+				scratchKeys[dst] = keys[i];
+				scratchValues[dst] = values[i];
+			}
+
+			keys.swap(scratchKeys);
+			values.swap(scratchValues);
+		}
+	}
+
+	/*	Monotonic 24 bit depth, from the bit pattern of the non negative float.	*/
+	static inline uint64_t quantizeDepth(const float depth) noexcept {
+		const float clamped = depth > 0.0f ? depth : 0.0f;
+		uint32_t bits;
+		std::memcpy(&bits, &clamped, sizeof(bits));
+		return bits >> 8;
+	}
+
+	unsigned int Scene::getQueueDomainIndex(const RenderQueue domain) noexcept {
+		unsigned int domain_index = 0;
+		while (domain_index < Scene::nrRenderQueueDomains - 1 && Scene::renderQueueOrder[domain_index] != domain) {
+			domain_index++;
+		}
+		return domain_index;
+	}
+
+	float Scene::computeViewDepth(const NodeObject &node) const noexcept {
+		/*	View depth of the bounds center.	*/
+		const glm::vec3 center = glm::vec3(node.bound.aabb.min[0] + node.bound.aabb.max[0],
+										   node.bound.aabb.min[1] + node.bound.aabb.max[1],
+										   node.bound.aabb.min[2] + node.bound.aabb.max[2]) *
+								 0.5f;
+		const glm::vec4 viewPosition = this->sortViewMatrix * (node.modelGlobalTransform * glm::vec4(center, 1.0f));
+		return -viewPosition.z;
+	}
+
+	uint64_t Scene::computeSortKey(const NodeObject &node, const RenderQueue domain) const noexcept {
+
+		const unsigned int domain_index = Scene::getQueueDomainIndex(domain);
+
+		const unsigned int material_index = node.materialIndex[0];
+		const MaterialObject &material = this->materials[material_index];
+		const unsigned int vao =
+			node.geometryObjectIndex.empty() ? 0 : this->refGeometry[node.geometryObjectIndex[0]].vao;
+
+		const uint64_t depth = quantizeDepth(this->computeViewDepth(node));
+
+		/*	Program 12 bits, material 12 bits and mesh 13 bits.	*/
+		const uint64_t state = (static_cast<uint64_t>(material.program & 0xfff) << 25) |
+							   (static_cast<uint64_t>(material_index & 0xfff) << 13) |
+							   static_cast<uint64_t>(vao & 0x1fff);
+
+		uint64_t key = static_cast<uint64_t>(domain_index) << 61;
+		if (domain == RenderQueue::Transparent) {
+			/*	Back to front, the state only orders nodes at equal depth.	*/
+			key |= ((0xffffff - depth) << 37) | state;
+		} else {
+			/*	Front to back in depth bands of a quarter octave, fewest state changes within each band, then
+			 * front to back within equal state. Early depth rejection is kept, while state changes are only
+			 * paid once per band.	*/
+			const uint64_t depthBand = (depth >> 13) & 0x3ff;
+			key |= (depthBand << 50) | (state << 13) | (depth & 0x1fff);
+		}
+		return key;
+	}
+
 	void Scene::sortRenderQueue() {
 
-		this->renderQueue.clear();
-		this->renderBucketQueue.clear();
+		this->sortKeys.clear();
+		this->sortNodes.clear();
 
 		/*	*/
 		for (size_t x = 0; x < this->visableNodes.size(); x++) {
@@ -503,31 +847,445 @@ namespace glsample {
 
 				const RenderQueue domain = getQueueDomain(*material);
 
-				renderBucketQueue[domain].push_back(node);
-
-				if (domain >= RenderQueue::Transparent) {
-					this->renderQueue.push_back(node);
-				} else {
-					this->renderQueue.push_front(node);
-				}
+				this->sortKeys.push_back(this->computeSortKey(*node, domain));
+				this->sortNodes.push_back(static_cast<uint32_t>(x));
 
 			} else {
 				std::cerr << "Invalid Material " << node->name << std::endl;
 			}
 		}
 
-		/*	Sort Transparent Objects. Based on priority.	*/
-		// std::sort(vec.begin(), vec.end(), [this, &index, &edges](const int_iter it1, const int_iter it2) -> bool {
-		// 	index[it1 - int_vec.begin()] < index[it2 - int_vec.begin()];
-		// });
+		const size_t count = this->sortKeys.size();
+		this->renderQueue.resize(count);
+		this->renderQueueOffsets.fill(count);
+		if (count == 0) {
+			return;
+		}
+
+		this->sortKeysScratch.resize(count);
+		this->sortNodesScratch.resize(count);
+		radixSortKeys(this->sortKeys, this->sortNodes, this->sortKeysScratch, this->sortNodesScratch);
+
+		/*	Resolve the nodes, and the first node of each domain.	*/
+		for (size_t queue_index = count; queue_index-- > 0;) {
+			this->renderQueue[queue_index] = this->visableNodes[this->sortNodes[queue_index]];
+			this->renderQueueOffsets[this->sortKeys[queue_index] >> 61] = queue_index;
+		}
+		for (unsigned int domain_index = Scene::nrRenderQueueDomains; domain_index-- > 0;) {
+			this->renderQueueOffsets[domain_index] =
+				std::min(this->renderQueueOffsets[domain_index], this->renderQueueOffsets[domain_index + 1]);
+		}
+	}
+
+	/*	State that must match within a single multi draw call.	*/
+	static inline uint64_t computeDrawState(const MeshObject &mesh, const unsigned int material_index,
+											const size_t node_block) noexcept {
+		return (static_cast<uint64_t>(node_block & 0xff) << 37) |
+			   (static_cast<uint64_t>(mesh.primitiveType & 0xf) << 33) |
+			   (static_cast<uint64_t>(mesh.indices_type == GL_UNSIGNED_SHORT) << 32) |
+			   (static_cast<uint64_t>(material_index & 0xffff) << 16) | static_cast<uint64_t>(mesh.vao & 0xffff);
+	}
+
+	void Scene::bindDrawAssigns(const unsigned int vao, const unsigned int assign_buffer, unsigned int &current_vao) {
+		if (vao == current_vao) {
+			return;
+		}
+
+		/*	Restore the vertex array for the per node draw calls.	*/
+		if (current_vao) {
+			glVertexAttribDivisor(8, 0);
+			glDisableVertexAttribArray(8);
+		}
+
+		/*	Source vAssigns per instance from the draw assigns, offset by the base instance.	*/
+		if (vao) {
+			glBindVertexArray(vao);
+			glBindBuffer(GL_ARRAY_BUFFER, assign_buffer);
+			glEnableVertexAttribArray(8);
+			glVertexAttribIPointer(8, 2, GL_INT, sizeof(DrawAssign), nullptr);
+			glVertexAttribDivisor(8, 1);
+		}
+		current_vao = vao;
+	}
+
+	void Scene::renderIndirect(const unsigned int first_domain) {
+
+		/*	One draw per geometry in render queue order, each with the queue domain of its own material.	*/
+		this->indirectDraws.clear();
+		this->drawSortKeys.clear();
+		this->drawOrder.clear();
+		for (size_t queue_index = this->renderQueueOffsets[first_domain]; queue_index < this->renderQueue.size();
+			 queue_index++) {
+			const NodeObject *node = this->renderQueue[queue_index];
+			const auto nodeData = this->nodeDataIndex.find(node);
+			if (nodeData == this->nodeDataIndex.end()) {
+				continue;
+			}
+
+			for (size_t geo_index = 0; geo_index < node->geometryObjectIndex.size(); geo_index++) {
+				const unsigned int material_index = node->materialIndex[geo_index];
+				if (material_index >= this->materials.size()) {
+					continue;
+				}
+
+				const RenderQueue domain = this->getQueueDomain(this->materials[material_index]);
+				const unsigned int domain_index = Scene::getQueueDomainIndex(domain);
+				if (domain_index < first_domain) {
+					continue;
+				}
+
+				const MeshObject &mesh = this->refGeometry[node->geometryObjectIndex[geo_index]];
+				const size_t node_data_index = nodeData->second + geo_index;
+				const uint64_t state =
+					computeDrawState(mesh, material_index, node_data_index / this->UBOStructure.max_node_per_binding);
+
+				/*	Opaque draws are grouped by state, transparent draws keep their back to front order.	*/
+				const uint64_t sequence = this->indirectDraws.size();
+				const uint64_t order = domain == RenderQueue::Transparent ? sequence : state;
+				const uint64_t key = (static_cast<uint64_t>(domain_index) << 61) | order;
+
+				this->drawSortKeys.push_back(key);
+				this->drawOrder.push_back(static_cast<uint32_t>(this->indirectDraws.size()));
+				this->indirectDraws.push_back(
+					{static_cast<uint32_t>(node_data_index), material_index, &mesh, state});
+			}
+		}
+
+		const size_t count = this->indirectDraws.size();
+		if (count == 0) {
+			return;
+		}
+
+		this->drawSortKeysScratch.resize(count);
+		this->drawOrderScratch.resize(count);
+		radixSortKeys(this->drawSortKeys, this->drawOrder, this->drawSortKeysScratch, this->drawOrderScratch);
+
+		IndirectDataStructure &indirect = this->indirectStructure;
+
+		/*	Grow the buffers, only when the number of draws exceeds all previous frames.	*/
+		if (count > indirect.capacity) {
+			for (GLsync &fence : indirect.fences) {
+				if (fence) {
+					glDeleteSync(fence);
+					fence = nullptr;
+				}
+			}
+			if (indirect.indirect_buffer) {
+				glDeleteBuffers(1, &indirect.indirect_buffer);
+				glDeleteBuffers(1, &indirect.draw_buffer);
+			}
+
+			indirect.capacity = Math::max<size_t>(count * 2, 1024);
+			const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+			const size_t commandSize = indirect.capacity * Scene::frameChainCount * sizeof(DrawElementsIndirectCommand);
+			glGenBuffers(1, &indirect.indirect_buffer);
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect.indirect_buffer);
+			glBufferStorage(GL_DRAW_INDIRECT_BUFFER, commandSize, nullptr, flags);
+			indirect.commands = static_cast<DrawElementsIndirectCommand *>(
+				glMapBufferRange(GL_DRAW_INDIRECT_BUFFER, 0, commandSize, flags));
+
+			const size_t assignSize = indirect.capacity * Scene::frameChainCount * sizeof(DrawAssign);
+			glGenBuffers(1, &indirect.draw_buffer);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, indirect.draw_buffer);
+			glBufferStorage(GL_SHADER_STORAGE_BUFFER, assignSize, nullptr, flags);
+			indirect.assigns =
+				static_cast<DrawAssign *>(glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, assignSize, flags));
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		}
+
+		/*	Wait until the GPU has consumed the region from frameChainCount renders ago.	*/
+		const unsigned int region = this->frameIndex % Scene::frameChainCount;
+		if (indirect.fences[region]) {
+			glClientWaitSync(indirect.fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+			glDeleteSync(indirect.fences[region]);
+			indirect.fences[region] = nullptr;
+		}
+
+		/*	Commands in sorted order, the base instance selects the draw assign.	*/
+		const size_t base = region * indirect.capacity;
+		this->indirectBuckets.clear();
+		for (size_t i = 0; i < count; i++) {
+			const IndirectDraw &draw = this->indirectDraws[this->drawOrder[i]];
+			const unsigned int domain_index = static_cast<unsigned int>(this->drawSortKeys[i] >> 61);
+
+			indirect.commands[base + i] = {static_cast<GLuint>(draw.mesh->nrIndicesElements), 1,
+										   static_cast<GLuint>(draw.mesh->indices_offset),
+										   static_cast<GLuint>(draw.mesh->vertex_offset),
+										   static_cast<GLuint>(base + i)};
+			indirect.assigns[base + i] = {static_cast<int>(draw.material),
+										  static_cast<int>(draw.nodeData % this->UBOStructure.max_node_per_binding)};
+
+			if (this->indirectBuckets.empty() || this->indirectBuckets.back().domain != domain_index ||
+				this->indirectBuckets.back().draw->state != draw.state) {
+				this->indirectBuckets.push_back({i, 0, domain_index, &draw});
+			}
+			this->indirectBuckets.back().count++;
+		}
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect.indirect_buffer);
+
+		unsigned int currentDomain = Scene::nrRenderQueueDomains;
+		unsigned int currentVAO = 0;
+		for (const IndirectBucket &bucket : this->indirectBuckets) {
+			const IndirectDraw &draw = *bucket.draw;
+
+			if (bucket.domain != currentDomain) {
+				if (currentDomain != Scene::nrRenderQueueDomains) {
+					Profiler::popScope();
+				}
+				const std::string_view domain = magic_enum::enum_name(Scene::renderQueueOrder[bucket.domain]);
+				Profiler::pushScope(domain);
+				currentDomain = bucket.domain;
+			}
+
+			this->bindNodeBlock(draw.nodeData / this->UBOStructure.max_node_per_binding);
+			this->bindMaterial(&this->materials[draw.material]);
 
-		//				int priority = computeMaterialPriority(*material);
+			this->bindDrawAssigns(draw.mesh->vao, indirect.draw_buffer, currentVAO);
 
-		renderBucketQueue[RenderQueue::Transparent];
+			glMultiDrawElementsIndirect(
+				draw.mesh->primitiveType, draw.mesh->indices_type,
+				reinterpret_cast<const void *>((base + bucket.offset) * sizeof(DrawElementsIndirectCommand)),
+				bucket.count, 0);
+		}
 
-		/*	Sort based on Shared mesh objects.	*/
+		this->bindDrawAssigns(0, 0, currentVAO);
+		if (currentDomain != Scene::nrRenderQueueDomains) {
+			Profiler::popScope();
+		}
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
 
-		/*	Sort Transparent Objects. Based on distance.	*/
+		indirect.fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		this->frameIndex++;
+	}
+
+	void Scene::initGPUCulling(fragcore::IFileSystem *filesystem) {
+		this->gpuCulling = std::make_shared<GPUCulling>();
+		this->gpuCulling->init(filesystem);
+		this->gpuCullingBuckets.clear();
+		this->gpuCullingDirty = true;
+		this->gpuCullingEnabled = true;
+	}
+
+	void Scene::buildGPUCullingDraws() {
+
+		using CullingDraw = struct culling_draw_t {
+			uint64_t key;
+			GPUCulling::CullDraw draw;
+			DrawAssign assign;
+			GPUCullingBucket state;
+		};
+
+		/*	All opaque geometries, the visibility is determined on the GPU.	*/
+		std::vector<CullingDraw> draws;
+		for (const NodeObject *node : this->nodes) {
+			const auto nodeData = this->nodeDataIndex.find(node);
+			if (nodeData == this->nodeDataIndex.end()) {
+				continue;
+			}
+
+			for (size_t geo_index = 0; geo_index < node->geometryObjectIndex.size(); geo_index++) {
+				const unsigned int material_index = node->materialIndex[geo_index];
+				if (material_index >= this->materials.size()) {
+					continue;
+				}
+
+				const unsigned int domain_index =
+					Scene::getQueueDomainIndex(this->getQueueDomain(this->materials[material_index]));
+				if (domain_index >= Scene::getQueueDomainIndex(RenderQueue::Transparent)) {
+					continue;
+				}
+
+				const MeshObject &mesh = this->refGeometry[node->geometryObjectIndex[geo_index]];
+				const size_t node_data_index = nodeData->second + geo_index;
+				const size_t node_block = node_data_index / this->UBOStructure.max_node_per_binding;
+
+				/*	Bound in the space of the vertices, the node data includes the dequantization.	*/
+				const glm::vec3 boundMin =
+					mesh.quantized_position
+						? glm::vec3(0.0f)
+						: glm::vec3(mesh.bound.aabb.min[0], mesh.bound.aabb.min[1], mesh.bound.aabb.min[2]);
+				const glm::vec3 boundMax =
+					mesh.quantized_position
+						? (glm::vec3(mesh.bound.aabb.max[0], mesh.bound.aabb.max[1], mesh.bound.aabb.max[2]) -
+						   glm::vec3(mesh.bound.aabb.min[0], mesh.bound.aabb.min[1], mesh.bound.aabb.min[2])) /
+							  computeDequantizationScale(mesh)
+						: glm::vec3(mesh.bound.aabb.max[0], mesh.bound.aabb.max[1], mesh.bound.aabb.max[2]);
+
+				CullingDraw draw{};
+				draw.key = (static_cast<uint64_t>(domain_index) << 61) |
+						   computeDrawState(mesh, material_index, node_block);
+				draw.draw = {boundMin,
+							 static_cast<uint32_t>(node_data_index),
+							 boundMax,
+							 0,
+							 static_cast<uint32_t>(mesh.nrIndicesElements),
+							 static_cast<uint32_t>(mesh.indices_offset),
+							 static_cast<int32_t>(mesh.vertex_offset),
+							 0};
+				draw.assign = {static_cast<int>(material_index),
+							   static_cast<int>(node_data_index % this->UBOStructure.max_node_per_binding)};
+				draw.state = {mesh.vao, material_index, mesh.primitiveType, mesh.indices_type,
+							  node_block, domain_index};
+				draws.push_back(draw);
+			}
+		}
+
+		std::sort(draws.begin(), draws.end(),
+				  [](const CullingDraw &a, const CullingDraw &b) { return a.key < b.key; });
+
+		/*	Each bucket owns the command range of its draws, base instance is the draw index.	*/
+		std::vector<GPUCulling::CullDraw> cullDraws(draws.size());
+		std::vector<GPUCulling::CullBucket> cullBuckets;
+		std::vector<DrawAssign> assigns(draws.size());
+		this->gpuCullingBuckets.clear();
+		for (size_t i = 0; i < draws.size(); i++) {
+			if (i == 0 || draws[i].key != draws[i - 1].key) {
+				cullBuckets.push_back({static_cast<uint32_t>(i), 0});
+				this->gpuCullingBuckets.push_back(draws[i].state);
+			}
+			cullBuckets.back().capacity++;
+
+			cullDraws[i] = draws[i].draw;
+			cullDraws[i].bucket = static_cast<uint32_t>(cullBuckets.size() - 1);
+			cullDraws[i].baseInstance = static_cast<uint32_t>(i);
+			assigns[i] = draws[i].assign;
+		}
+
+		if (glIsBuffer(this->gpu_culling_assign_buffer)) {
+			glDeleteBuffers(1, &this->gpu_culling_assign_buffer);
+			this->gpu_culling_assign_buffer = 0;
+		}
+		if (!assigns.empty()) {
+			glGenBuffers(1, &this->gpu_culling_assign_buffer);
+			glBindBuffer(GL_ARRAY_BUFFER, this->gpu_culling_assign_buffer);
+			glBufferStorage(GL_ARRAY_BUFFER, assigns.size() * sizeof(DrawAssign), assigns.data(), 0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+
+		this->gpuCulling->setDraws(cullDraws, cullBuckets);
+	}
+
+	void Scene::renderGPUCulled() {
+
+		if (this->gpuCullingDirty) {
+			this->buildGPUCullingDraws();
+			this->gpuCullingDirty = false;
+		}
+		if (this->gpuCullingBuckets.empty()) {
+			return;
+		}
+
+		/*	Model matrices read directly from the node data.	*/
+		this->gpuCulling->cull(this->cullingPlanes, this->UBOStructure.node_and_common_uniform_buffer,
+							   this->UBOStructure.node_offset, this->UBOStructure.node_size_align);
+
+		unsigned int currentDomain = Scene::nrRenderQueueDomains;
+		unsigned int currentVAO = 0;
+		for (size_t bucket_index = 0; bucket_index < this->gpuCullingBuckets.size(); bucket_index++) {
+			const GPUCullingBucket &bucket = this->gpuCullingBuckets[bucket_index];
+
+			if (bucket.domain != currentDomain) {
+				if (currentDomain != Scene::nrRenderQueueDomains) {
+					Profiler::popScope();
+				}
+				const std::string_view domain = magic_enum::enum_name(Scene::renderQueueOrder[bucket.domain]);
+				Profiler::pushScope(domain);
+				currentDomain = bucket.domain;
+			}
+
+			this->bindNodeBlock(bucket.nodeBlock);
+			this->bindMaterial(&this->materials[bucket.material]);
+			this->bindDrawAssigns(bucket.vao, this->gpu_culling_assign_buffer, currentVAO);
+
+			this->gpuCulling->draw(bucket_index, bucket.primitiveType, bucket.indices_type);
+		}
+
+		this->bindDrawAssigns(0, 0, currentVAO);
+		if (currentDomain != Scene::nrRenderQueueDomains) {
+			Profiler::popScope();
+		}
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		glBindBuffer(GL_PARAMETER_BUFFER_ARB, 0);
+	}
+
+	void Scene::initOcclusionCulling(fragcore::IFileSystem *filesystem) {
+		this->depthPyramid = std::make_shared<DepthPyramid>();
+		this->depthPyramid->init(filesystem);
+		this->occlusionQuery = std::make_shared<OcclusionQuery>();
+		this->occlusionQuery->init(filesystem);
+	}
+
+	void Scene::initClusteredLighting(fragcore::IFileSystem *filesystem) {
+		this->clusteredLights->release();
+		this->clusteredLights->init(filesystem);
+		this->clusteredLights->setUseCompute(true);
+		this->clusteredLighting = true;
+	}
+
+	void Scene::setPointLights(const std::vector<PointLightInstance> &lights) {
+		this->clusteredLights->setPointLights(lights.data(), lights.size());
+		this->clusteredLighting = true;
+	}
+
+	void Scene::setOcclusionMode(const OcclusionMode mode) noexcept {
+		this->occlusionMode = mode;
+
+		/*	Pyramid of a previous frame is no longer updated.	*/
+		if (mode != OcclusionMode::HierarchicalZ && this->gpuCulling) {
+			this->gpuCulling->setDepthPyramid(0, 0, 0, 0, glm::mat4(1.0f));
+		}
+	}
+
+	void Scene::updateDepthPyramid(const unsigned int depthTexture, const unsigned int width,
+								   const unsigned int height) {
+		if (this->occlusionMode != OcclusionMode::HierarchicalZ || !this->depthPyramid) {
+			return;
+		}
+
+		this->depthPyramid->build(depthTexture, width, height, this->renderViewProjection);
+
+		if (this->gpuCulling) {
+			this->gpuCulling->setDepthPyramid(this->depthPyramid->getTexture(), this->depthPyramid->getWidth(),
+											  this->depthPyramid->getHeight(), this->depthPyramid->getNrLevels(),
+											  this->depthPyramid->getViewProjection());
+		}
+	}
+
+	void Scene::renderOcclusionQueried(const size_t begin, const size_t end) {
+
+		/*	Strictly front to back, the render queue only orders by depth band, and sortRenderQueue may be
+		 *	overridden.	*/
+		this->occlusionNodes.clear();
+		for (size_t queue_index = begin; queue_index < end; queue_index++) {
+			const NodeObject *node = this->renderQueue[queue_index];
+			this->occlusionNodes.emplace_back(this->computeViewDepth(*node), node);
+		}
+		std::stable_sort(this->occlusionNodes.begin(), this->occlusionNodes.end(),
+						 [](const auto &a, const auto &b) { return a.first < b.first; });
+
+		/*	Each batch is tested against the depth of the nodes drawn before it, the nearest occluders first.	*/
+		const size_t batchSize = this->occlusionQuery->getNrQueries();
+		for (size_t batch = 0; batch < this->occlusionNodes.size(); batch += batchSize) {
+			const size_t count = std::min(batchSize, this->occlusionNodes.size() - batch);
+
+			this->occlusionBoundMin.resize(count);
+			this->occlusionBoundMax.resize(count);
+			for (size_t i = 0; i < count; i++) {
+				computeWorldBounds(*this->occlusionNodes[batch + i].second, this->occlusionBoundMin[i],
+								   this->occlusionBoundMax[i]);
+			}
+
+			this->occlusionQuery->query(this->renderViewProjection, this->occlusionBoundMin.data(),
+										this->occlusionBoundMax.data(), count);
+
+			for (size_t i = 0; i < count; i++) {
+				this->occlusionQuery->beginConditionalRender(i);
+				this->renderNode(this->occlusionNodes[batch + i].second);
+				this->occlusionQuery->endConditionalRender();
+			}
+		}
 	}
 
 	int Scene::computeMaterialPriority(const MaterialObject &material) const noexcept {
@@ -590,6 +1348,7 @@ namespace glsample {
 												 : nodes[node_index]->parent->modelGlobalTransform;
 						nodes[node_index]->modelGlobalTransform =
 							glm::translate(globaMat, nodes[node_index]->localPosition);
+						this->updateNodeBounds(nodes[node_index]);
 					}
 
 					if (ImGui::DragFloat4("Rotation (Quat)", &nodes[node_index]->localRotation[0])) {
@@ -600,6 +1359,7 @@ namespace glsample {
 						nodes[node_index]->modelGlobalTransform =
 							glm::translate(globaMat, nodes[node_index]->localPosition) *
 							glm::mat4_cast(nodes[node_index]->localRotation);
+						this->updateNodeBounds(nodes[node_index]);
 					}
 
 					if (ImGui::DragFloat4("Scale (Quat)", &nodes[node_index]->localScale[0])) {
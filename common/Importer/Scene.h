@@ -14,12 +14,21 @@
  * all copies or substantial portions of the Software.
  */
 #pragma once
+#include "ClusteredLights.h"
 #include "Core/UIDObject.h"
+#include "DepthPyramid.h"
+#include "GPUCulling.h"
 #include "GLSampleSession.h"
 #include "ImportHelper.h"
 #include "ModelImporter.h"
+#include "OcclusionQuery.h"
 #include "SampleHelper.h"
-#include <deque>
+#include "Util/BoundingVolumeHierarchy.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
 
 namespace glsample {
 
@@ -49,6 +58,12 @@ namespace glsample {
 		Overlay = 3000,		 /*  */
 	};
 
+	enum class OcclusionMode : unsigned int {
+		None = 0,			   /*	Frustum culling only.	*/
+		HierarchicalZ = 1,	   /*	GPU culled draws tested against the depth pyramid of the previous frame.	*/
+		ConditionalRender = 2, /*	Bounding box occlusion queries with conditional rendering.	*/
+	};
+
 	enum DebugMode : unsigned int {
 		None = 0,
 		Wireframe = 0x1,
@@ -77,9 +92,24 @@ namespace glsample {
 
 		virtual void update(const float deltaTime);
 
+		/**
+		 * @brief Upload the node data of the nodes moved since the last update, see updateNodeBounds, all nodes
+		 * after the scene has been invalidated.
+		 */
 		virtual void updateBuffers();
 
-		virtual void culling(Frustum *frustum); // TODO: add
+		/**
+		 * @brief Compute the visible nodes, culled against the bounding volume hierarchy of the nodes.
+		 *
+		 * While the GPU culling is active, only the nodes not drawn by the GPU culling are culled and queued.
+		 */
+		virtual void culling(Frustum *frustum);
+
+		/**
+		 * @brief Rebuild the node data, culling hierarchy and GPU culling draws on the next update, after nodes
+		 * or geometries have been changed. Changes of the node count and material queue domains are detected.
+		 */
+		void invalidate() noexcept;
 
 		virtual void render(Camera *camera);
 		virtual void render();
@@ -87,6 +117,12 @@ namespace glsample {
 		virtual void bindMaterial(const MaterialObject* material);
 		virtual void renderNode(const NodeObject *node);
 
+		/**
+		 * @brief Sort the visible nodes by a 64 bit key of queue domain, program, material, mesh and view depth.
+		 *
+		 * Opaque domains are sorted front to back, the Transparent domain back to front. The keys are radix
+		 * sorted into buffers reused between frames, no allocation once the buffers have grown.
+		 */
 		virtual void sortRenderQueue();
 
 		virtual void renderUI();
@@ -95,6 +131,68 @@ namespace glsample {
 			  //	void enableDebug();
 	  public:
 		const std::vector<NodeObject *> &getNodes() const noexcept { return this->nodes; }
+		const std::vector<NodeObject *> &getVisibleNodes() const noexcept { return this->visableNodes; }
+
+		void setFrustumCulling(const bool enable) noexcept { this->frustumCulling = enable; }
+		bool isFrustumCulling() const noexcept { return this->frustumCulling; }
+
+		/**
+		 * @brief Submit the render queue with glMultiDrawElementsIndirect, one call per shared vertex array and
+		 * material, instead of one draw call per geometry. renderNode is not invoked while enabled.
+		 */
+		void setIndirectDraw(const bool enable) noexcept { this->indirectDraw = enable; }
+		bool isIndirectDraw() const noexcept { return this->indirectDraw; }
+
+		/**
+		 * @brief Load the compute program that culls and compacts the opaque draws on the GPU, drawn with
+		 * glMultiDrawElementsIndirectCount. Transparent and overlay nodes still use the sorted render queue.
+		 */
+		void initGPUCulling(fragcore::IFileSystem *filesystem);
+		void setGPUCulling(const bool enable) noexcept { this->gpuCullingEnabled = enable; }
+		bool isGPUCulling() const noexcept { return this->gpuCullingEnabled; }
+		std::shared_ptr<GPUCulling> &getGPUCulling() noexcept { return this->gpuCulling; }
+
+		/**
+		 * @brief Load the depth pyramid and occlusion query programs.
+		 *
+		 * HierarchicalZ culls the draws of the GPU culling, see initGPUCulling. ConditionalRender wraps the
+		 * opaque nodes of the per node path in occlusion queries, tested against the depth drawn so far.
+		 */
+		void initOcclusionCulling(fragcore::IFileSystem *filesystem);
+		void setOcclusionMode(const OcclusionMode mode) noexcept;
+		OcclusionMode getOcclusionMode() const noexcept { return this->occlusionMode; }
+
+		/**
+		 * @brief Build the depth pyramid from the depth attachment of the rendered frame, used by the culling of
+		 * the next frame.
+		 */
+		void updateDepthPyramid(const unsigned int depthTexture, const unsigned int width, const unsigned int height);
+		std::shared_ptr<DepthPyramid> &getDepthPyramid() noexcept { return this->depthPyramid; }
+
+		/**
+		 * @brief Load the compute program of the cluster light assignment, the lights are otherwise assigned on
+		 * the CPU. The clusters are bound by render(), and updated by render(Camera *) once either function has
+		 * been called and the scene has point lights, see Shaders/common/cluster.glsl.
+		 */
+		void initClusteredLighting(fragcore::IFileSystem *filesystem);
+		void setPointLights(const std::vector<PointLightInstance> &lights);
+		std::shared_ptr<ClusteredLights> &getClusteredLights() noexcept { return this->clusteredLights; }
+
+		/**
+		 * @brief Update the culling bounds of the node, after its global transform has been changed.
+		 */
+		void updateNodeBounds(const NodeObject *node);
+
+		/**
+		 * @brief World space bounds of all the nodes with geometry.
+		 * @return false if the scene has no geometry.
+		 */
+		bool computeBounds(glm::vec3 &min, glm::vec3 &max) const;
+
+		/**
+		 * @brief World space bounds of the node, from its local bounds and global transform.
+		 */
+		static void computeWorldBounds(const NodeObject &node, glm::vec3 &min, glm::vec3 &max) noexcept;
 
 		const std::vector<MeshObject> &getMeshes() const noexcept { return this->refGeometry; }
 		std::vector<MeshObject> &getMeshes() noexcept { return this->refGeometry; }
@@ -103,6 +201,35 @@ namespace glsample {
 		void bindTexture(const MaterialObject &material, const TextureType texture_type);
 		int computeMaterialPriority(const MaterialObject &material) const noexcept;
 		RenderQueue getQueueDomain(const MaterialObject &material) const noexcept;
+		float computeViewDepth(const NodeObject &node) const noexcept;
+		uint64_t computeSortKey(const NodeObject &node, const RenderQueue domain) const noexcept;
+		static unsigned int getQueueDomainIndex(const RenderQueue domain) noexcept;
+		void buildCullingHierarchy();
+		void detectChanges();
+		void writeNodeData(const NodeObject *node, const size_t node_index) noexcept;
+		bool isGPUCullingActive() const noexcept {
+			return this->gpuCullingEnabled && this->gpuCulling && this->gpuCulling->isSupported();
+		}
+		bool isGPUCulled(const NodeObject &node) const noexcept;
+		void bindNodeBlock(const size_t node_block);
+		void bindDrawAssigns(const unsigned int vao, const unsigned int assign_buffer, unsigned int &current_vao);
+
+		/**
+		 * @brief Build the indirect commands of the sorted render queue and draw them, per bucket of shared state.
+		 */
+		void renderIndirect(const unsigned int first_domain);
+
+		/**
+		 * @brief Build the static draws and buckets of the GPU culling, from all opaque geometries.
+		 */
+		void buildGPUCullingDraws();
+		void renderGPUCulled();
+
+		/**
+		 * @brief Draw the render queue range front to back, each node conditional on the occlusion query of its
+		 * bounds.
+		 */
+		void renderOcclusionQueried(const size_t begin, const size_t end);
 
 	  protected:
 		using GlobalRenderSettings = struct alignas(16) _global_rendering_settings_t {
@@ -150,14 +277,71 @@ namespace glsample {
 
 		MaterialObject* currentBindedMaterial = nullptr;
 
-		/*	TODO add queue structure.	*/
-		std::map<RenderQueue, std::deque<const NodeObject *>> renderBucketQueue;
-		std::deque<const NodeObject *> renderQueue;
+		static const unsigned int nrRenderQueueDomains = 6;
+		static const RenderQueue renderQueueOrder[nrRenderQueueDomains];
+
+		/*	Visible nodes in draw order, with the offset of each queue domain in draw order.	*/
+		std::vector<const NodeObject *> renderQueue;
+		std::array<size_t, nrRenderQueueDomains + 1> renderQueueOffsets{};
 		std::vector<NodeObject *> visableNodes;
 
+		/*	Sort keys and the node index, ping pong buffers of the radix sort.	*/
+		std::vector<uint64_t> sortKeys, sortKeysScratch;
+		std::vector<uint32_t> sortNodes, sortNodesScratch;
+		glm::mat4 sortViewMatrix = glm::mat4(1.0f);
+
+		/*	Per draw material and node index, fetched by the instanced vAssigns attribute or gl_BaseInstance.	*/
+		using DrawAssign = struct draw_assign_t {
+			int material;
+			int node;
+		};
+		using IndirectDraw = struct indirect_draw_t {
+			uint32_t nodeData;
+			uint32_t material;
+			const MeshObject *mesh;
+			uint64_t state;
+		};
+		using IndirectBucket = struct indirect_bucket_t {
+			size_t offset;
+			size_t count;
+			unsigned int domain;
+			const IndirectDraw *draw;
+		};
+		std::vector<IndirectDraw> indirectDraws;
+		std::vector<uint64_t> drawSortKeys, drawSortKeysScratch;
+		std::vector<uint32_t> drawOrder, drawOrderScratch;
+		std::vector<IndirectBucket> indirectBuckets;
+
+		/*	State of each bucket of the GPU culling, the draw assigns are static.	*/
+		using GPUCullingBucket = struct gpu_culling_bucket_t {
+			unsigned int vao;
+			unsigned int material;
+			int primitiveType;
+			unsigned int indices_type;
+			size_t nodeBlock;
+			unsigned int domain;
+		};
+		std::shared_ptr<GPUCulling> gpuCulling;
+		std::vector<GPUCullingBucket> gpuCullingBuckets;
+		bool gpuCullingDirty = true;
+		unsigned int gpu_culling_assign_buffer = 0;
+		glm::vec4 cullingPlanes[6]{};
+
+		/*	*/
+		std::shared_ptr<DepthPyramid> depthPyramid;
+		std::shared_ptr<OcclusionQuery> occlusionQuery;
+		std::vector<glm::vec3> occlusionBoundMin, occlusionBoundMax;
+		std::vector<std::pair<float, const NodeObject *>> occlusionNodes;
+		glm::mat4 renderViewProjection = glm::mat4(1.0f);
+
+		/*	Point lights of the scene, assigned to the clusters of the camera.	*/
+		std::shared_ptr<ClusteredLights> clusteredLights;
+		bool clusteredLighting = false;
+
 		std::vector<NodeObject *> nodes;
 		std::vector<MeshObject> refGeometry;
 		std::vector<TextureAssetObject> refTexture;
+		std::shared_ptr<TextureStreamer> textureStreamer;
 		std::vector<MaterialObject> materials;
 		std::vector<AnimationObject> animations;
 
@@ -167,7 +351,29 @@ namespace glsample {
 
 		DebugMode debugMode = DebugMode::None;
 		bool frustumCulling = false;
+		bool indirectDraw = false;
+		bool gpuCullingEnabled = false;
+		OcclusionMode occlusionMode = OcclusionMode::None;
 		size_t currentNodeIndex = 0;
+		size_t currentNodeBlock = 0;
+
+		/*	Index of the first node data of each node, one node data per geometry.	*/
+		std::unordered_map<const NodeObject *, size_t> nodeDataIndex;
+		std::vector<const NodeObject *> movedNodes;
+		bool nodeDataDirty = true;
+
+		/*	State the node data and the culling were built from.	*/
+		size_t builtNodeCount = 0;
+		std::vector<unsigned int> builtMaterialDomains, materialDomains;
+
+		/*	World space bounds of the nodes with geometry, built on the first culling. Only the nodes not drawn
+		 *	by the GPU culling while it is active.	*/
+		BoundingVolumeHierarchy cullingHierarchy;
+		bool cullingHierarchyGPU = false;
+		bool cullingHierarchyDirty = true;
+		std::vector<NodeObject *> cullingNodes;
+		std::unordered_map<const NodeObject *, uint32_t> cullingItemIndex;
+		std::vector<uint32_t> visibleItems;
 
 		using UniformDataStructure = struct uniform_data_structure {
 			/*	*/
@@ -205,6 +411,18 @@ namespace glsample {
 		int frameIndex = 0;
 		static const unsigned int frameChainCount = 3;
 
+		/*	Persistent mapped commands and draw assigns, one region per frame in flight.	*/
+		using IndirectDataStructure = struct indirect_data_structure {
+			unsigned int indirect_buffer = 0;
+			unsigned int draw_buffer = 0;
+			size_t capacity = 0;
+			DrawElementsIndirectCommand *commands = nullptr;
+			DrawAssign *assigns = nullptr;
+			GLsync fences[frameChainCount]{};
+		};
+
+		IndirectDataStructure indirectStructure;
+
 	  public:
 		template <typename T = Scene> static T loadFrom(ModelImporter &importer) {
 			T scene;
@@ -212,7 +430,9 @@ namespace glsample {
 			/*	*/
 			scene.nodes = importer.getNodes();
 			ImportHelper::loadModelBuffer(importer, scene.refGeometry);
-			ImportHelper::loadTextures(importer, scene.refTexture);
+			/*	Textures are streamed in, rendered with the default textures until loaded.	*/
+			scene.textureStreamer = std::make_shared<TextureStreamer>(importer.getFileSystem());
+			ImportHelper::loadTextures(importer, scene.refTexture, *scene.textureStreamer);
 			scene.materials = importer.getMaterials();
 
 			return scene;
@@ -0,0 +1,728 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#include "TextureCompressor.h"
+#include "IO/FileIO.h"
+#include "Util/Hash.h"
+#include "Util/TaskParallel.h"
+#include <GL/glew.h>
+#include <ImageUtil.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace fs = std::filesystem;
+using namespace fragcore;
+using namespace glsample;
+
+bool TextureCompressor::cacheEnabled = true;
+
+/*	Bump whenever the encoder output changes, to recompress all the cached images.	*/
+static const uint32_t texture_cache_version = 1;
+static const uint32_t texture_cache_magic = 0x43424C47; /*	GLBC	*/
+
+static const uint32_t dds_magic = 0x20534444;	  /*	DDS	*/
+static const uint32_t dds_fourcc_dx10 = 0x30315844; /*	DX10	*/
+
+using DDSPixelFormat = struct dds_pixel_format_t {
+	uint32_t size;
+	uint32_t flags;
+	uint32_t fourCC;
+	uint32_t rgbBitCount;
+	uint32_t bitMask[4];
+};
+
+using DDSHeader = struct dds_header_t {
+	uint32_t magic;
+	uint32_t size;
+	uint32_t flags;
+	uint32_t height;
+	uint32_t width;
+	uint32_t pitchOrLinearSize;
+	uint32_t depth;
+	uint32_t mipMapCount;
+	uint32_t reserved1[11]; /*	GLBC magic, version and source hash.	*/
+	DDSPixelFormat pixelFormat;
+	uint32_t caps[4];
+	uint32_t reserved2;
+	/*	DX10 extension.	*/
+	uint32_t dxgiFormat;
+	uint32_t resourceDimension;
+	uint32_t miscFlag;
+	uint32_t arraySize;
+	uint32_t miscFlags2;
+};
+
+static uint32_t getDXGIFormat(const BlockCompression format, const bool srgb) noexcept {
+	switch (format) {
+	case BlockCompression::BC1:
+		return srgb ? 72 : 71;
+	case BlockCompression::BC3:
+		return srgb ? 78 : 77;
+	case BlockCompression::BC4:
+		return 80;
+	case BlockCompression::BC5:
+		return 83;
+	case BlockCompression::BC7:
+	default:
+		return srgb ? 99 : 98;
+	}
+}
+
+/*	Texels of a 4x4 block, edge texels are repeated for images not multiple of 4.	*/
+static inline void loadBlock(const uint8_t *rgba, const unsigned int width, const unsigned int height,
+							 const unsigned int blockX, const unsigned int blockY, uint8_t block[16][4]) noexcept {
+	for (unsigned int y = 0; y < 4; y++) {
+		const unsigned int py = std::min(blockY * 4 + y, height - 1);
+		for (unsigned int x = 0; x < 4; x++) {
+			const unsigned int px = std::min(blockX * 4 + x, width - 1);
+			std::memcpy(block[y * 4 + x], &rgba[(static_cast<size_t>(py) * width + px) * 4], 4);
+		}
+	}
+}
+
+static inline uint16_t packRGB565(const int r, const int g, const int b) noexcept {
+	return static_cast<uint16_t>((((r * 31 + 127) / 255) << 11) | (((g * 63 + 127) / 255) << 5) |
+								 ((b * 31 + 127) / 255));
+}
+
+static inline void unpackRGB565(const uint16_t color, int rgb[3]) noexcept {
+	const int r = (color >> 11) & 0x1f;
+	const int g = (color >> 5) & 0x3f;
+	const int b = color & 0x1f;
+	rgb[0] = (r << 3) | (r >> 2);
+	rgb[1] = (g << 2) | (g >> 4);
+	rgb[2] = (b << 3) | (b >> 2);
+}
+
+/*	Bounding box endpoints, flipped along the axes negatively correlated with red, and inset to reduce the error.	*/
+static void computeEndpoints(const uint8_t block[16][4], const unsigned int nrChannels, int minColor[4],
+							 int maxColor[4]) noexcept {
+	int mean[4] = {0, 0, 0, 0};
+	for (unsigned int c = 0; c < nrChannels; c++) {
+		minColor[c] = 255;
+		maxColor[c] = 0;
+	}
+
+	for (unsigned int i = 0; i < 16; i++) {
+		for (unsigned int c = 0; c < nrChannels; c++) {
+			minColor[c] = std::min<int>(minColor[c], block[i][c]);
+			maxColor[c] = std::max<int>(maxColor[c], block[i][c]);
+			mean[c] += block[i][c];
+		}
+	}
+
+	/*	Covariance against the channel with the largest range.	*/
+	unsigned int reference = 0;
+	for (unsigned int c = 1; c < nrChannels; c++) {
+		if (maxColor[c] - minColor[c] > maxColor[reference] - minColor[reference]) {
+			reference = c;
+		}
+	}
+
+	for (unsigned int c = 0; c < nrChannels; c++) {
+		if (c == reference) {
+			continue;
+		}
+		int covariance = 0;
+		for (unsigned int i = 0; i < 16; i++) {
+			covariance += (block[i][reference] * 16 - mean[reference]) * (block[i][c] * 16 - mean[c]);
+		}
+		if (covariance < 0) {
+			std::swap(minColor[c], maxColor[c]);
+		}
+	}
+
+	for (unsigned int c = 0; c < nrChannels; c++) {
+		const int inset = (maxColor[c] - minColor[c]) / 16;
+		minColor[c] += inset;
+		maxColor[c] -= inset;
+	}
+}
+
+static void encodeBC1(const uint8_t block[16][4], uint8_t *output) noexcept {
+	int minColor[4];
+	int maxColor[4];
+	computeEndpoints(block, 3, minColor, maxColor);
+
+	uint16_t color0 = packRGB565(maxColor[0], maxColor[1], maxColor[2]);
+	uint16_t color1 = packRGB565(minColor[0], minColor[1], minColor[2]);
+
+	/*	Four color mode requires color0 > color1.	*/
+	if (color0 < color1) {
+		std::swap(color0, color1);
+	}
+
+	uint32_t indices = 0;
+	if (color0 != color1) {
+		int palette[4][3];
+		unpackRGB565(color0, palette[0]);
+		unpackRGB565(color1, palette[1]);
+		for (unsigned int c = 0; c < 3; c++) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+		}
+
+		for (unsigned int i = 0; i < 16; i++) {
+			int bestError = std::numeric_limits<int>::max();
+			uint32_t bestIndex = 0;
+			for (uint32_t p = 0; p < 4; p++) {
+				const int dr = block[i][0] - palette[p][0];
+				const int dg = block[i][1] - palette[p][1];
+				const int db = block[i][2] - palette[p][2];
+				const int error = dr * dr + dg * dg + db * db;
+				if (error < bestError) {
+					bestError = error;
+					bestIndex = p;
+				}
+			}
+			indices |= bestIndex << (i * 2);
+		}
+	}
+
+	output[0] = color0 & 0xff;
+	output[1] = color0 >> 8;
+	output[2] = color1 & 0xff;
+	output[3] = color1 >> 8;
+	for (unsigned int i = 0; i < 4; i++) {
+		output[4 + i] = (indices >> (i * 8)) & 0xff;
+	}
+}
+
+static void encodeBC4(const uint8_t block[16][4], const unsigned int channel, uint8_t *output) noexcept {
+	int minValue = 255;
+	int maxValue = 0;
+	for (unsigned int i = 0; i < 16; i++) {
+		minValue = std::min<int>(minValue, block[i][channel]);
+		maxValue = std::max<int>(maxValue, block[i][channel]);
+	}
+
+	/*	Eight values mode, requires value0 > value1.	*/
+	uint64_t indices = 0;
+	if (maxValue > minValue) {
+		int palette[8];
+		palette[0] = maxValue;
+		palette[1] = minValue;
+		for (int p = 2; p < 8; p++) {
+			palette[p] = ((8 - p) * maxValue + (p - 1) * minValue + 3) / 7;
+		}
+
+		for (unsigned int i = 0; i < 16; i++) {
+			int bestError = std::numeric_limits<int>::max();
+			uint64_t bestIndex = 0;
+			for (uint64_t p = 0; p < 8; p++) {
+				const int error = std::abs(block[i][channel] - palette[p]);
+				if (error < bestError) {
+					bestError = error;
+					bestIndex = p;
+				}
+			}
+			indices |= bestIndex << (i * 3);
+		}
+	}
+
+	output[0] = static_cast<uint8_t>(maxValue);
+	output[1] = static_cast<uint8_t>(minValue);
+	for (unsigned int i = 0; i < 6; i++) {
+		output[2 + i] = (indices >> (i * 8)) & 0xff;
+	}
+}
+
+/*	BC7 mode 6, single subset RGBA with 7 bit endpoints, shared p-bit per endpoint and 4 bit indices.	*/
+static void encodeBC7(const uint8_t block[16][4], uint8_t *output) noexcept {
+	static const int weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+	int endpoints[2][4];
+	computeEndpoints(block, 4, endpoints[1], endpoints[0]);
+
+	/*	Quantize each endpoint to 7 bits, with the p-bit of least error.	*/
+	int quantized[2][4];
+	int pbits[2];
+	for (unsigned int e = 0; e < 2; e++) {
+		int bestError = std::numeric_limits<int>::max();
+		for (int p = 0; p < 2; p++) {
+			int error = 0;
+			int values[4];
+			for (unsigned int c = 0; c < 4; c++) {
+				values[c] = std::clamp((endpoints[e][c] - p + 1) / 2, 0, 127);
+				const int diff = ((values[c] << 1) | p) - endpoints[e][c];
+				error += diff * diff;
+			}
+			if (error < bestError) {
+				bestError = error;
+				pbits[e] = p;
+				std::memcpy(quantized[e], values, sizeof(values));
+			}
+		}
+	}
+
+	int palette[16][4];
+	for (unsigned int w = 0; w < 16; w++) {
+		for (unsigned int c = 0; c < 4; c++) {
+			const int e0 = (quantized[0][c] << 1) | pbits[0];
+			const int e1 = (quantized[1][c] << 1) | pbits[1];
+			palette[w][c] = ((64 - weights[w]) * e0 + weights[w] * e1 + 32) >> 6;
+		}
+	}
+
+	unsigned int indices[16];
+	for (unsigned int i = 0; i < 16; i++) {
+		int bestError = std::numeric_limits<int>::max();
+		for (unsigned int w = 0; w < 16; w++) {
+			int error = 0;
+			for (unsigned int c = 0; c < 4; c++) {
+				const int diff = block[i][c] - palette[w][c];
+				error += diff * diff;
+			}
+			if (error < bestError) {
+				bestError = error;
+				indices[i] = w;
+			}
+		}
+	}
+
+	/*	Most significant bit of the anchor index is implicit zero, swap the endpoints otherwise.	*/
+	if (indices[0] >= 8) {
+		std::swap(quantized[0], quantized[1]);
+		std::swap(pbits[0], pbits[1]);
+		for (unsigned int i = 0; i < 16; i++) {
+			indices[i] = 15 - indices[i];
+		}
+	}
+
+	std::memset(output, 0, 16);
+	size_t bit = 0;
+	const auto writeBits = [&](const uint32_t value, const unsigned int nrBits) {
+		for (unsigned int i = 0; i < nrBits; i++, bit++) {
+			output[bit >> 3] |= ((value >> i) & 1) << (bit & 7);
+		}
+	};
+
+	writeBits(1 << 6, 7); /*	Mode 6.	*/
+	for (unsigned int c = 0; c < 4; c++) {
+		writeBits(quantized[0][c], 7);
+		writeBits(quantized[1][c], 7);
+	}
+	writeBits(pbits[0], 1);
+	writeBits(pbits[1], 1);
+	writeBits(indices[0], 3);
+	for (unsigned int i = 1; i < 16; i++) {
+		writeBits(indices[i], 4);
+	}
+}
+
+static void encodeBlock(const BlockCompression format, const uint8_t block[16][4], uint8_t *output) noexcept {
+	switch (format) {
+	case BlockCompression::BC1:
+		encodeBC1(block, output);
+		break;
+	case BlockCompression::BC3:
+		encodeBC4(block, 3, output);
+		encodeBC1(block, output + 8);
+		break;
+	case BlockCompression::BC4:
+		encodeBC4(block, 0, output);
+		break;
+	case BlockCompression::BC5:
+		encodeBC4(block, 0, output);
+		encodeBC4(block, 1, output + 8);
+		break;
+	case BlockCompression::BC7:
+		encodeBC7(block, output);
+		break;
+	}
+}
+
+/*	Box filter, sRGB texels are averaged in linear space.	*/
+static std::vector<uint8_t> downsample(const std::vector<uint8_t> &rgba, const unsigned int width,
+									   const unsigned int height, const bool srgb) {
+	static const std::vector<float> srgbToLinear = []() {
+		std::vector<float> table(256);
+		for (size_t i = 0; i < table.size(); i++) {
+			const float value = i / 255.0f;
+			table[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+		}
+		return table;
+	}();
+	static const std::vector<uint8_t> linearToSrgb = []() {
+		std::vector<uint8_t> table(4096);
+		for (size_t i = 0; i < table.size(); i++) {
+			const float value = i / 4095.0f;
+			const float srgbValue =
+				value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+			table[i] = static_cast<uint8_t>(std::clamp(srgbValue * 255.0f + 0.5f, 0.0f, 255.0f));
+		}
+		return table;
+	}();
+
+	const unsigned int levelWidth = std::max(width / 2, 1u);
+	const unsigned int levelHeight = std::max(height / 2, 1u);
+	std::vector<uint8_t> level(static_cast<size_t>(levelWidth) * levelHeight * 4);
+
+	for (unsigned int y = 0; y < levelHeight; y++) {
+		const unsigned int y0 = std::min(y * 2, height - 1);
+		const unsigned int y1 = std::min(y * 2 + 1, height - 1);
+		for (unsigned int x = 0; x < levelWidth; x++) {
+			const unsigned int x0 = std::min(x * 2, width - 1);
+			const unsigned int x1 = std::min(x * 2 + 1, width - 1);
+
+			const uint8_t *texels[4] = {&rgba[(static_cast<size_t>(y0) * width + x0) * 4],
+										&rgba[(static_cast<size_t>(y0) * width + x1) * 4],
+										&rgba[(static_cast<size_t>(y1) * width + x0) * 4],
+										&rgba[(static_cast<size_t>(y1) * width + x1) * 4]};
+			uint8_t *destination = &level[(static_cast<size_t>(y) * levelWidth + x) * 4];
+
+			for (unsigned int c = 0; c < 4; c++) {
+				if (srgb && c < 3) {
+					const float sum = srgbToLinear[texels[0][c]] + srgbToLinear[texels[1][c]] +
+									  srgbToLinear[texels[2][c]] + srgbToLinear[texels[3][c]];
+					destination[c] = linearToSrgb[static_cast<size_t>(sum * 0.25f * 4095.0f + 0.5f)];
+				} else {
+					destination[c] = (texels[0][c] + texels[1][c] + texels[2][c] + texels[3][c] + 2) / 4;
+				}
+			}
+		}
+	}
+
+	return level;
+}
+
+bool TextureCompressor::isSupported(const ImageFormat format, const TextureCompression compression) noexcept {
+	if (compression != TextureCompression::Default && compression != TextureCompression::BPTC) {
+		return false;
+	}
+
+	switch (format) {
+	case ImageFormat::RGB24:
+	case ImageFormat::BGR24:
+	case ImageFormat::RGBA32:
+	case ImageFormat::BGRA32:
+	case ImageFormat::Alpha8:
+		return true;
+	default:
+		return false;
+	}
+}
+
+BlockCompression TextureCompressor::selectFormat(const ImageFormat format, const TextureCompression compression,
+												 const bool opaque) noexcept {
+	if (format == ImageFormat::Alpha8) {
+		return BlockCompression::BC4;
+	}
+	if (compression == TextureCompression::BPTC) {
+		return BlockCompression::BC7;
+	}
+	return opaque ? BlockCompression::BC1 : BlockCompression::BC3;
+}
+
+unsigned int TextureCompressor::getInternalFormat(const BlockCompression format, const bool srgb) noexcept {
+	switch (format) {
+	case BlockCompression::BC1:
+		return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	case BlockCompression::BC3:
+		return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	case BlockCompression::BC4:
+		return GL_COMPRESSED_RED_RGTC1;
+	case BlockCompression::BC5:
+		return GL_COMPRESSED_RG_RGTC2;
+	case BlockCompression::BC7:
+	default:
+		return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+	}
+}
+
+size_t TextureCompressor::getBlockSize(const BlockCompression format) noexcept {
+	return (format == BlockCompression::BC1 || format == BlockCompression::BC4) ? 8 : 16;
+}
+
+CompressedImage TextureCompressor::compress(const Image &image, const TextureCompression compression,
+											const ColorSpace colorSpace, const size_t maxThreads) {
+
+	const size_t nrTexels = static_cast<size_t>(image.width()) * image.height();
+	const uint8_t *pixels = static_cast<const uint8_t *>(image.getPixelData());
+
+	/*	Convert to RGBA8.	*/
+	std::vector<uint8_t> rgba(nrTexels * 4);
+	for (size_t i = 0; i < nrTexels; i++) {
+		uint8_t *texel = &rgba[i * 4];
+		switch (image.getFormat()) {
+		case ImageFormat::RGB24:
+			texel[0] = pixels[i * 3 + 0];
+			texel[1] = pixels[i * 3 + 1];
+			texel[2] = pixels[i * 3 + 2];
+			texel[3] = 255;
+			break;
+		case ImageFormat::BGR24:
+			texel[0] = pixels[i * 3 + 2];
+			texel[1] = pixels[i * 3 + 1];
+			texel[2] = pixels[i * 3 + 0];
+			texel[3] = 255;
+			break;
+		case ImageFormat::RGBA32:
+			std::memcpy(texel, &pixels[i * 4], 4);
+			break;
+		case ImageFormat::BGRA32:
+			texel[0] = pixels[i * 4 + 2];
+			texel[1] = pixels[i * 4 + 1];
+			texel[2] = pixels[i * 4 + 0];
+			texel[3] = pixels[i * 4 + 3];
+			break;
+		case ImageFormat::Alpha8:
+			texel[0] = texel[1] = texel[2] = pixels[i];
+			texel[3] = 255;
+			break;
+		default:
+			throw RuntimeException("None Supported Format: {}", static_cast<int>(image.getFormat()));
+		}
+	}
+
+	bool opaque = true;
+	for (size_t i = 0; i < nrTexels && opaque; i++) {
+		opaque = rgba[i * 4 + 3] == 255;
+	}
+
+	const BlockCompression format = TextureCompressor::selectFormat(image.getFormat(), compression, opaque);
+	const bool srgb = colorSpace == ColorSpace::SRGB;
+
+	return TextureCompressor::compress(rgba.data(), image.width(), image.height(), format, srgb, maxThreads);
+}
+
+CompressedImage TextureCompressor::compress(const uint8_t *rgba, const unsigned int width, const unsigned int height,
+											const BlockCompression format, const bool srgb, const size_t maxThreads) {
+
+	CompressedImage compressed;
+	compressed.format = format;
+	compressed.srgb = srgb;
+	compressed.width = width;
+	compressed.height = height;
+
+	const size_t blockSize = TextureCompressor::getBlockSize(format);
+
+	/*	Layout of the complete mip chain.	*/
+	unsigned int levelWidth = width;
+	unsigned int levelHeight = height;
+	size_t totalSize = 0;
+	while (true) {
+		const size_t levelSize = static_cast<size_t>((levelWidth + 3) / 4) * ((levelHeight + 3) / 4) * blockSize;
+		compressed.levelOffsets.push_back(totalSize);
+		compressed.levelSizes.push_back(levelSize);
+		totalSize += levelSize;
+
+		if (levelWidth == 1 && levelHeight == 1) {
+			break;
+		}
+		levelWidth = std::max(levelWidth / 2, 1u);
+		levelHeight = std::max(levelHeight / 2, 1u);
+	}
+	compressed.data.resize(totalSize);
+
+	std::vector<uint8_t> level(rgba, rgba + static_cast<size_t>(width) * height * 4);
+	levelWidth = width;
+	levelHeight = height;
+
+	for (size_t level_index = 0; level_index < compressed.levelSizes.size(); level_index++) {
+		const unsigned int blocksX = (levelWidth + 3) / 4;
+		const unsigned int blocksY = (levelHeight + 3) / 4;
+		uint8_t *levelData = &compressed.data[compressed.levelOffsets[level_index]];
+
+		/*	Each thread encodes rows of blocks.	*/
+		parallelFor(
+			blocksY, 4,
+			[&](const size_t begin, const size_t end) {
+				uint8_t block[16][4];
+				for (size_t blockY = begin; blockY < end; blockY++) {
+					for (unsigned int blockX = 0; blockX < blocksX; blockX++) {
+						loadBlock(level.data(), levelWidth, levelHeight, blockX, blockY, block);
+						encodeBlock(format, block, &levelData[(blockY * blocksX + blockX) * blockSize]);
+					}
+				}
+			},
+			maxThreads);
+
+		if (level_index + 1 < compressed.levelSizes.size()) {
+			level = downsample(level, levelWidth, levelHeight, srgb);
+			levelWidth = std::max(levelWidth / 2, 1u);
+			levelHeight = std::max(levelHeight / 2, 1u);
+		}
+	}
+
+	return compressed;
+}
+
+bool TextureCompressor::loadImage(const std::string &path, const TextureCompression compression,
+								  const ColorSpace colorSpace, const bool convertNormalMap, CompressedImage &compressed,
+								  std::optional<Image> &image, const size_t maxThreads) {
+
+	std::vector<char> source;
+	{
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file.is_open()) {
+			throw RuntimeException("Failed to open file: {}", path);
+		}
+		source.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0, std::ios::beg);
+		file.read(source.data(), static_cast<std::streamsize>(source.size()));
+	}
+
+	uint64_t sourceHash = hashBytes(&texture_cache_version, sizeof(texture_cache_version));
+	sourceHash = hashBytes(source.data(), source.size(), sourceHash);
+
+	const std::string cachePath = TextureCompressor::getCachePath(path, compression, colorSpace, convertNormalMap);
+	if (TextureCompressor::cacheEnabled && TextureCompressor::readCache(cachePath, sourceHash, compressed)) {
+		return true;
+	}
+
+	/*	Decode.	*/
+	ImageLoader imageLoader;
+	Ref<IO> refIO = Ref<IO>(new BufferIO((const void *)source.data(), (unsigned long)source.size()));
+	Image decoded = imageLoader.loadImage(refIO);
+	refIO->close();
+
+	if (convertNormalMap) {
+		decoded = ImageUtil::convert2NormalMap(decoded);
+	}
+
+	if (!TextureCompressor::isSupported(decoded.getFormat(), compression)) {
+		image.emplace(std::move(decoded));
+		return false;
+	}
+
+	compressed = TextureCompressor::compress(decoded, compression, colorSpace, maxThreads);
+	if (TextureCompressor::cacheEnabled) {
+		TextureCompressor::writeCache(cachePath, sourceHash, compressed);
+	}
+
+	return true;
+}
+
+std::string TextureCompressor::getCachePath(const std::string &path, const TextureCompression compression,
+											const ColorSpace colorSpace, const bool convertNormalMap) {
+	return fmt::format("{}.{}{}{}.dds", path, compression == TextureCompression::BPTC ? "bc7" : "bc",
+					   colorSpace == ColorSpace::SRGB ? "-srgb" : "", convertNormalMap ? "-normal" : "");
+}
+
+bool TextureCompressor::readCache(const std::string &path, const uint64_t sourceHash, CompressedImage &compressed) {
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	DDSHeader header{};
+	if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+		return false;
+	}
+
+	const uint64_t cachedHash = static_cast<uint64_t>(header.reserved1[2]) | static_cast<uint64_t>(header.reserved1[3])
+																				 << 32;
+	if (header.magic != dds_magic || header.pixelFormat.fourCC != dds_fourcc_dx10 ||
+		header.reserved1[0] != texture_cache_magic || header.reserved1[1] != texture_cache_version ||
+		cachedHash != sourceHash || header.width == 0 || header.height == 0) {
+		return false;
+	}
+
+	/*	Find the block format from the DXGI format.	*/
+	static const BlockCompression formats[] = {BlockCompression::BC1, BlockCompression::BC3, BlockCompression::BC4,
+											   BlockCompression::BC5, BlockCompression::BC7};
+	bool found = false;
+	for (const BlockCompression format : formats) {
+		for (const bool srgb : {false, true}) {
+			if (getDXGIFormat(format, srgb) == header.dxgiFormat) {
+				compressed.format = format;
+				compressed.srgb = srgb;
+				found = true;
+			}
+		}
+	}
+	if (!found) {
+		return false;
+	}
+
+	compressed.width = header.width;
+	compressed.height = header.height;
+	compressed.levelOffsets.clear();
+	compressed.levelSizes.clear();
+
+	const size_t blockSize = TextureCompressor::getBlockSize(compressed.format);
+	unsigned int levelWidth = header.width;
+	unsigned int levelHeight = header.height;
+	size_t totalSize = 0;
+	for (unsigned int level_index = 0; level_index < std::max(header.mipMapCount, 1u); level_index++) {
+		const size_t levelSize = static_cast<size_t>((levelWidth + 3) / 4) * ((levelHeight + 3) / 4) * blockSize;
+		compressed.levelOffsets.push_back(totalSize);
+		compressed.levelSizes.push_back(levelSize);
+		totalSize += levelSize;
+
+		levelWidth = std::max(levelWidth / 2, 1u);
+		levelHeight = std::max(levelHeight / 2, 1u);
+	}
+
+	compressed.data.resize(totalSize);
+	return static_cast<bool>(file.read(reinterpret_cast<char *>(compressed.data.data()), totalSize));
+}
+
+void TextureCompressor::writeCache(const std::string &path, const uint64_t sourceHash,
+								   const CompressedImage &compressed) {
+
+	DDSHeader header{};
+	header.magic = dds_magic;
+	header.size = 124;
+	header.flags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000; /*	Caps, size, pixel format, mips, linear size.	*/
+	header.height = compressed.height;
+	header.width = compressed.width;
+	header.pitchOrLinearSize = static_cast<uint32_t>(compressed.levelSizes[0]);
+	header.mipMapCount = static_cast<uint32_t>(compressed.levelSizes.size());
+	header.reserved1[0] = texture_cache_magic;
+	header.reserved1[1] = texture_cache_version;
+	header.reserved1[2] = static_cast<uint32_t>(sourceHash);
+	header.reserved1[3] = static_cast<uint32_t>(sourceHash >> 32);
+	header.pixelFormat.size = 32;
+	header.pixelFormat.flags = 0x4; /*	FourCC.	*/
+	header.pixelFormat.fourCC = dds_fourcc_dx10;
+	header.caps[0] = 0x1000 | 0x400000 | 0x8; /*	Texture, mip map, complex.	*/
+	header.dxgiFormat = getDXGIFormat(compressed.format, compressed.srgb);
+	header.resourceDimension = 3; /*	Texture 2D.	*/
+	header.arraySize = 1;
+
+	/*	Write to temporary file first, to prevent other processes from reading partial entries.	*/
+	std::error_code error;
+	const std::string tmpPath =
+		fmt::format("{}.{}.tmp", path, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+	{
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			return;
+		}
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char *>(compressed.data.data()),
+				   static_cast<std::streamsize>(compressed.data.size()));
+		if (!file) {
+			file.close();
+			fs::remove(tmpPath, error);
+			return;
+		}
+	}
+
+	fs::rename(tmpPath, path, error);
+	if (error) {
+		fs::remove(tmpPath, error);
+	}
+}
@@ -0,0 +1,117 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "../Common.h"
+#include <ImageLoader.h>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace glsample {
+
+	enum class TextureCompression {
+		None,	 /*	*/
+		Default, /*	*/
+		BPTC,	 /*	*/
+		ASTC	 /*	*/
+	};
+
+	enum class BlockCompression : unsigned int {
+		BC1, /*	RGB, 4 bits per texel.	*/
+		BC3, /*	RGBA, 8 bits per texel.	*/
+		BC4, /*	R, 4 bits per texel.	*/
+		BC5, /*	RG, 8 bits per texel.	*/
+		BC7, /*	RGBA, 8 bits per texel, higher quality than BC3.	*/
+	};
+
+	/**
+	 * @brief Block compressed image with its complete mip chain, stored contiguously.
+	 */
+	using CompressedImage = struct compressed_image_t {
+		BlockCompression format = BlockCompression::BC1;
+		bool srgb = false;
+		unsigned int width = 0;
+		unsigned int height = 0;
+		std::vector<size_t> levelOffsets;
+		std::vector<size_t> levelSizes;
+		std::vector<uint8_t> data;
+	};
+
+	/**
+	 * @brief CPU block compression encoder, and cache of the compressed images next to the source file.
+	 *
+	 * Cache entries are DDS files with the DX10 header, the hash of the source file is stored in the
+	 * reserved header fields and the entry is recompressed when the source file changes.
+	 */
+	class FVDECLSPEC TextureCompressor {
+	  public:
+		/**
+		 * @brief Check if the image format can be block compressed with the compression.
+		 */
+		static bool isSupported(const fragcore::ImageFormat format, const TextureCompression compression) noexcept;
+
+		/**
+		 * @brief Select the block format from the image format and requested compression.
+		 *
+		 * @param opaque all texels have full alpha, allows the RGB only formats.
+		 */
+		static BlockCompression selectFormat(const fragcore::ImageFormat format, const TextureCompression compression,
+											 const bool opaque) noexcept;
+
+		/**
+		 * @brief Compress the image with mip maps, blocks are encoded on the task scheduler workers.
+		 *
+		 * @param maxThreads upper limit of threads, including the calling thread, 0 use all workers.
+		 */
+		static CompressedImage compress(const fragcore::Image &image, const TextureCompression compression,
+										const ColorSpace colorSpace, const size_t maxThreads = 0);
+
+		/**
+		 * @brief Compress RGBA8 texels, with the mip chain generated on the CPU.
+		 */
+		static CompressedImage compress(const uint8_t *rgba, const unsigned int width, const unsigned int height,
+										const BlockCompression format, const bool srgb, const size_t maxThreads = 0);
+
+		/**
+		 * @brief Load the image file as block compressed, from the cache if up to date.
+		 *
+		 * Otherwise the image is decoded, compressed and stored in the cache. If the image format can not
+		 * be block compressed, the decoded image is returned instead.
+		 *
+		 * @return true if compressed was assigned, false if image was assigned.
+		 */
+		static bool loadImage(const std::string &path, const TextureCompression compression,
+							  const ColorSpace colorSpace, const bool convertNormalMap, CompressedImage &compressed,
+							  std::optional<fragcore::Image> &image, const size_t maxThreads = 0);
+
+		static unsigned int getInternalFormat(const BlockCompression format, const bool srgb) noexcept;
+		static size_t getBlockSize(const BlockCompression format) noexcept;
+
+		static void setCacheEnabled(const bool enabled) noexcept { TextureCompressor::cacheEnabled = enabled; }
+		static bool isCacheEnabled() noexcept { return TextureCompressor::cacheEnabled; }
+
+	  private:
+		static std::string getCachePath(const std::string &path, const TextureCompression compression,
+										const ColorSpace colorSpace, const bool convertNormalMap);
+		static bool readCache(const std::string &path, const uint64_t sourceHash, CompressedImage &compressed);
+		static void writeCache(const std::string &path, const uint64_t sourceHash, const CompressedImage &compressed);
+
+		static bool cacheEnabled;
+	};
+
+} // namespace glsample
@@ -0,0 +1,348 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#include "TextureStreamer.h"
+#include "IO/FileIO.h"
+#include "Math/Math.h"
+#include "TaskScheduler/Task.h"
+#include "Util/TaskParallel.h"
+#include <ImageLoader.h>
+#include <ImageUtil.h>
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+using namespace fragcore;
+using namespace glsample;
+
+/*	Offset alignment of each upload in the staging ring.	*/
+static const size_t staging_alignment = 256;
+
+class TextureStreamer::DecodeTask : public Task {
+  public:
+	DecodeTask(TextureStreamer *streamer, TextureRequest &&request) : streamer(streamer), request(std::move(request)) {}
+
+	void Execute() noexcept override {
+		/*	Skip the remaining decodes once the streamer is released.	*/
+		if (!this->streamer->stop) {
+			this->streamer->decodeRequest(this->request);
+		}
+		this->request = TextureRequest();
+	}
+
+	/*	Called by the worker once it no longer references the task.	*/
+	void Complete() noexcept override {
+		std::lock_guard<std::mutex> guard(this->streamer->lock);
+		this->completed = true;
+		this->streamer->nrTasksInFlight--;
+		this->streamer->taskCondition.notify_all();
+	}
+
+	bool isCompleted() const noexcept { return this->completed; }
+
+  private:
+	TextureStreamer *streamer;
+	TextureRequest request;
+	bool completed = false;
+};
+
+TextureStreamer::TextureStreamer(IFileSystem *filesystem, const size_t stagingSize) : textureImporter(filesystem) {
+
+	/*	Persistent mapped staging ring, requires buffer storage. Otherwise upload directly from the client memory.	*/
+	if (glBufferStorage && stagingSize > 0) {
+		glGenBuffers(1, &this->stagingBuffer);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, this->stagingBuffer);
+		glBufferStorage(GL_PIXEL_UNPACK_BUFFER, stagingSize, nullptr,
+						GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+		this->stagingMapped = static_cast<uint8_t *>(glMapBufferRange(
+			GL_PIXEL_UNPACK_BUFFER, 0, stagingSize, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT));
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		if (this->stagingMapped) {
+			this->stagingSize = stagingSize;
+		}
+	}
+}
+
+TextureStreamer::~TextureStreamer() {
+	this->stop = true;
+
+	/*	Queued tasks reference the streamer until completed.	*/
+	{
+		std::unique_lock<std::mutex> guard(this->lock);
+		this->taskCondition.wait(guard, [this]() { return this->nrTasksInFlight == 0; });
+	}
+	this->tasks.clear();
+
+	for (const StagingRegion &region : this->stagingRegions) {
+		glDeleteSync(region.fence);
+	}
+
+	if (this->stagingBuffer > 0) {
+		if (this->stagingMapped) {
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, this->stagingBuffer);
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		}
+		glDeleteBuffers(1, &this->stagingBuffer);
+	}
+}
+
+void TextureStreamer::load(const TextureAssetObject &texture, const size_t index, const ColorSpace colorSpace,
+						   const TextureCompression compression, const bool convertNormalMap) {
+
+	TextureRequest request;
+	request.index = index;
+	request.filepath = texture.filepath;
+	request.width = texture.width;
+	request.height = texture.height;
+	request.colorSpace = colorSpace;
+	request.compression = compression;
+	request.convertNormalMap = convertNormalMap;
+
+	/*	Embedded data is owned by the importer, which can be released before the texture is decoded.	*/
+	if (texture.data != nullptr && texture.dataSize > 0) {
+		request.data.assign(texture.data, texture.data + texture.dataSize);
+	}
+
+	this->nrPending++;
+
+	IScheduler *scheduler = TaskParallel::getScheduler();
+	if (scheduler == nullptr) {
+		this->decodeRequest(request);
+		return;
+	}
+
+	DecodeTask *task = new DecodeTask(this, std::move(request));
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		this->tasks.emplace_back(task);
+		this->nrTasksInFlight++;
+	}
+
+	try {
+		scheduler->addTask(task);
+	} catch (...) {
+		/*	Not scheduled, decode on the calling thread instead.	*/
+		task->Execute();
+		task->Complete();
+	}
+}
+
+void TextureStreamer::decode(const TextureRequest &request, DecodedTexture &texture) {
+
+	ImageLoader imageLoader;
+
+	/*	Decode tasks already run in parallel, each image is compressed on a single thread.	*/
+	const bool blockCompress =
+		request.compression == TextureCompression::Default || request.compression == TextureCompression::BPTC;
+
+	if (request.data.empty()) {
+		if (blockCompress) {
+			TextureCompressor::loadImage(request.filepath, request.compression, request.colorSpace,
+										 request.convertNormalMap, texture.compressed, texture.image, 1);
+			return;
+		}
+
+		Ref<IO> refIO = Ref<IO>(new FileIO(request.filepath, FileIO::READ));
+		Image image = imageLoader.loadImage(refIO);
+		refIO->close();
+
+		if (request.convertNormalMap) {
+			image = ImageUtil::convert2NormalMap(image);
+		}
+		texture.image.emplace(std::move(image));
+		return;
+	}
+
+	if (request.height == 0 && request.width > 0) {
+		/*	Compressed data.	*/
+		Ref<IO> refIO = Ref<IO>(new BufferIO((const void *)request.data.data(), (unsigned long)request.data.size()));
+		texture.image.emplace(imageLoader.loadImage(refIO));
+		refIO->close();
+	} else {
+		/*	None-compressed.	*/
+		texture.image.emplace(request.width, request.height, ImageFormat::ARGB32);
+		texture.image->setPixelData(const_cast<char *>(request.data.data()), texture.image->getSize());
+	}
+
+	/*	Embedded textures are not cached, since there is no file to store the cache next to.	*/
+	if (TextureCompressor::isSupported(texture.image->getFormat(), request.compression)) {
+		texture.compressed =
+			TextureCompressor::compress(texture.image.value(), request.compression, request.colorSpace, 1);
+		texture.image.reset();
+	}
+}
+
+void TextureStreamer::decodeRequest(const TextureRequest &request) {
+
+	try {
+		DecodedTexture texture;
+		texture.index = request.index;
+		texture.name = request.filepath;
+		texture.colorSpace = request.colorSpace;
+		texture.compression = request.compression;
+		TextureStreamer::decode(request, texture);
+
+		std::lock_guard<std::mutex> guard(this->lock);
+		this->decoded.push_back(std::move(texture));
+
+	} catch (const std::exception &ex) {
+		std::cerr << "Failed to load: " << request.filepath << " " << ex.what() << std::endl;
+		this->nrPending--;
+	}
+}
+
+void TextureStreamer::retireStagingRegions() {
+	while (!this->stagingRegions.empty()) {
+		const StagingRegion &region = this->stagingRegions.front();
+
+		const GLenum status = glClientWaitSync(region.fence, 0, 0);
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+			break;
+		}
+
+		glDeleteSync(region.fence);
+		this->stagingRegions.pop_front();
+	}
+}
+
+bool TextureStreamer::allocateStaging(const size_t size, size_t &offset) noexcept {
+
+	if (size > this->stagingSize) {
+		return false;
+	}
+
+	if (this->stagingRegions.empty()) {
+		this->stagingHead = 0;
+		offset = 0;
+		return true;
+	}
+
+	/*	Oldest region still read by the GPU. Regions are allocated in order, so the ring has wrapped once the newest
+	 *	region begins before the oldest. The head can then be equal to the tail, when the ring is full.	*/
+	const size_t tail = this->stagingRegions.front().begin;
+	const size_t head = Math::align<size_t>(this->stagingHead, staging_alignment);
+	const bool wrapped = this->stagingRegions.back().begin < tail;
+
+	if (wrapped) {
+		/*	Free space is between the head and the tail, reused once the oldest fence is signaled.	*/
+		if (head + size <= tail) {
+			offset = head;
+			return true;
+		}
+		return false;
+	}
+
+	if (head + size <= this->stagingSize) {
+		offset = head;
+		return true;
+	}
+	/*	Wrap around.	*/
+	if (size <= tail) {
+		offset = 0;
+		return true;
+	}
+	return false;
+}
+
+size_t TextureStreamer::update(std::vector<TextureAssetObject> &textures) {
+
+	if (this->nrPending == 0) {
+		return 0;
+	}
+
+	this->retireStagingRegions();
+
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		while (!this->decoded.empty()) {
+			this->uploads.push_back(std::move(this->decoded.front()));
+			this->decoded.pop_front();
+		}
+
+		/*	Release the tasks the scheduler is done with.	*/
+		this->tasks.erase(std::remove_if(this->tasks.begin(), this->tasks.end(),
+										 [](const std::unique_ptr<DecodeTask> &task) { return task->isCompleted(); }),
+						  this->tasks.end());
+	}
+
+	size_t nrAssigned = 0;
+	size_t uploadedBytes = 0;
+
+	while (!this->uploads.empty() && uploadedBytes < this->uploadBudget) {
+		const DecodedTexture &upload = this->uploads.front();
+		const bool isCompressed = !upload.image.has_value();
+		const size_t imageSize = isCompressed ? upload.compressed.data.size() : upload.image->getSize();
+
+		int texture = -1;
+		size_t offset = 0;
+
+		try {
+			if (imageSize > this->stagingSize || this->stagingMapped == nullptr) {
+				/*	Does not fit in the ring, upload directly from the client memory.	*/
+				if (isCompressed) {
+					texture = this->textureImporter.loadCompressedImage2D(upload.compressed);
+				} else {
+					texture = this->textureImporter.loadImage2DRaw(upload.image.value(), upload.colorSpace,
+																   upload.compression);
+				}
+
+			} else if (this->allocateStaging(imageSize, offset)) {
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, this->stagingBuffer);
+				if (isCompressed) {
+					std::memcpy(&this->stagingMapped[offset], upload.compressed.data.data(), imageSize);
+					texture = this->textureImporter.loadCompressedImage2DFromBuffer(upload.compressed, offset);
+				} else {
+					std::memcpy(&this->stagingMapped[offset], upload.image->getPixelData(), imageSize);
+					texture = this->textureImporter.loadImage2DFromBuffer(upload.image.value(), offset,
+																		  upload.colorSpace, upload.compression);
+				}
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+				this->stagingRegions.push_back(
+					{offset, offset + imageSize, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+				this->stagingHead = offset + imageSize;
+
+			} else {
+				/*	Ring is full, wait for the GPU to consume previous uploads.	*/
+				break;
+			}
+		} catch (const std::exception &ex) {
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			std::cerr << "Failed to load: " << upload.name << " " << ex.what() << std::endl;
+		}
+
+		if (texture > 0) {
+			glObjectLabel(GL_TEXTURE, texture, upload.name.size(), upload.name.data());
+
+			/*	Swap in the loaded texture, replacing the default texture.	*/
+			if (upload.index < textures.size()) {
+				textures[upload.index].texture = texture;
+				nrAssigned++;
+			} else {
+				GLuint unused = texture;
+				glDeleteTextures(1, &unused);
+			}
+		}
+
+		uploadedBytes += imageSize;
+		this->nrPending--;
+		this->uploads.pop_front();
+	}
+
+	return nrAssigned;
+}
@@ -0,0 +1,143 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "ImageImport.h"
+#include "ModelImporter.h"
+#include <GL/glew.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace glsample {
+
+	/**
+	 * @brief Load textures in the background, while the scene is rendered with the default textures.
+	 *
+	 * Images are decoded, and block compressed if requested, as tasks on the task scheduler. The pixels are copied
+	 * into a persistently mapped pixel unpack buffer used as a ring, and uploaded from it on the OpenGL
+	 * thread in update. Each upload is guarded by a fence, the ring memory is only reused once the upload
+	 * has been consumed.
+	 */
+	class FVDECLSPEC TextureStreamer {
+	  public:
+		TextureStreamer(const TextureStreamer &) = delete;
+		TextureStreamer(TextureStreamer &&) = delete;
+		TextureStreamer &operator=(const TextureStreamer &) = delete;
+		TextureStreamer &operator=(TextureStreamer &&) = delete;
+
+		/**
+		 * @param stagingSize size in bytes of the pixel unpack ring buffer.
+		 */
+		TextureStreamer(fragcore::IFileSystem *filesystem, const size_t stagingSize = 64 * 1024 * 1024);
+		virtual ~TextureStreamer();
+
+		/**
+		 * @brief Queue the texture for loading, from its file path or its embedded data.
+		 *
+		 * Decoded on the calling thread when no task scheduler is assigned to TaskParallel.
+		 *
+		 * @param index index of the texture in the texture list passed to update.
+		 * @param convertNormalMap convert the height map to a normal map.
+		 */
+		void load(const TextureAssetObject &texture, const size_t index, const ColorSpace colorSpace,
+				  const TextureCompression compression, const bool convertNormalMap = false);
+
+		/**
+		 * @brief Upload decoded textures and assign them to the texture list. Must be called on the OpenGL thread.
+		 *
+		 * @return number of textures assigned.
+		 */
+		size_t update(std::vector<TextureAssetObject> &textures);
+
+		/**
+		 * @brief Max number of bytes uploaded per update.
+		 */
+		void setUploadBudget(const size_t bytes) noexcept { this->uploadBudget = bytes; }
+		size_t getUploadBudget() const noexcept { return this->uploadBudget; }
+
+		/**
+		 * @brief Number of textures queued, but not yet assigned.
+		 */
+		size_t getNrPending() const noexcept { return this->nrPending; }
+		bool isDone() const noexcept { return this->nrPending == 0; }
+
+	  protected:
+		using TextureRequest = struct texture_request_t {
+			size_t index = 0;
+			std::string filepath;
+			std::vector<char> data; /*	Copy of the embedded texture.	*/
+			size_t width = 0;
+			size_t height = 0;
+			ColorSpace colorSpace = ColorSpace::RawLinear;
+			TextureCompression compression = TextureCompression::None;
+			bool convertNormalMap = false;
+		};
+
+		/*	Either block compressed on the CPU, or the decoded image if the format could not be compressed.	*/
+		using DecodedTexture = struct decoded_texture_t {
+			size_t index = 0;
+			std::string name;
+			std::optional<fragcore::Image> image;
+			CompressedImage compressed;
+			ColorSpace colorSpace = ColorSpace::RawLinear;
+			TextureCompression compression = TextureCompression::None;
+		};
+
+		using StagingRegion = struct staging_region_t {
+			size_t begin;
+			size_t end;
+			GLsync fence;
+		};
+
+		class DecodeTask;
+
+		void decodeRequest(const TextureRequest &request);
+		static void decode(const TextureRequest &request, DecodedTexture &texture);
+
+		/*	Release the staging regions consumed by the GPU, allocate a contiguous region of the ring.	*/
+		void retireStagingRegions();
+		bool allocateStaging(const size_t size, size_t &offset) noexcept;
+
+	  private:
+		TextureImporter textureImporter;
+
+		/*	Staging ring.	*/
+		unsigned int stagingBuffer = 0;
+		uint8_t *stagingMapped = nullptr;
+		size_t stagingSize = 0;
+		size_t stagingHead = 0;
+		std::deque<StagingRegion> stagingRegions;
+		size_t uploadBudget = 16 * 1024 * 1024;
+
+		/*	Decode tasks, released once completed by the scheduler.	*/
+		std::vector<std::unique_ptr<DecodeTask>> tasks;
+		std::mutex lock;
+		std::condition_variable taskCondition;
+		std::deque<DecodedTexture> decoded;
+		size_t nrTasksInFlight = 0;
+		std::atomic<size_t> nrPending{0};
+		std::atomic<bool> stop{false};
+
+		/*	Decoded, waiting for staging memory, only accessed on the OpenGL thread.	*/
+		std::deque<DecodedTexture> uploads;
+	};
+
+} // namespace glsample
@@ -0,0 +1,156 @@
+#include "OcclusionQuery.h"
+#include "IOUtil.h"
+#include <GL/glew.h>
+#include <ShaderLoader.h>
+#include <algorithm>
+#include <cstddef>
+
+using namespace fragcore;
+
+namespace glsample {
+
+	OcclusionQuery::~OcclusionQuery() { this->release(); }
+
+	void OcclusionQuery::init(fragcore::IFileSystem *filesystem) {
+
+		/*	*/
+		const std::string vertexBoxShaderPath = "Shaders/culling/occlusion_box.vert.spv";
+		const std::string fragmentBoxShaderPath = "Shaders/culling/occlusion_box.frag.spv";
+
+		/*	Load shader binaries.	*/
+		const std::vector<uint32_t> vertex_binary = IOUtil::readFileData<uint32_t>(vertexBoxShaderPath, filesystem);
+		const std::vector<uint32_t> fragment_binary =
+			IOUtil::readFileData<uint32_t>(fragmentBoxShaderPath, filesystem);
+
+		/*	*/
+		fragcore::ShaderCompiler::CompilerConvertOption compilerOptions;
+		compilerOptions.target = fragcore::ShaderLanguage::GLSL;
+		compilerOptions.glslVersion = 460;
+
+		this->box_program = ShaderLoader::loadGraphicProgram(compilerOptions, &vertex_binary, &fragment_binary);
+
+		/*	Setup graphic pipeline.	*/
+		glUseProgram(this->box_program);
+		const int uniform_buffer_index = glGetUniformBlockIndex(this->box_program, "UniformBufferBlock");
+		glUniformBlockBinding(this->box_program, uniform_buffer_index, this->uniform_buffer_binding);
+		glUseProgram(0);
+
+		/*	*/
+		this->queries.resize(this->nrQueries);
+		glGenQueries(this->queries.size(), this->queries.data());
+
+		/*	*/
+		glGenBuffers(1, &this->uniform_buffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		/*	Box bounds per instance, the corners are generated from the vertex index.	*/
+		glGenVertexArrays(1, &this->vao);
+		glBindVertexArray(this->vao);
+
+		glGenBuffers(1, &this->instance_buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, this->instance_buffer);
+		glBufferData(GL_ARRAY_BUFFER, this->nrQueries * sizeof(BoxInstance), nullptr, GL_DYNAMIC_DRAW);
+
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(BoxInstance), nullptr);
+		glVertexAttribDivisor(0, 1);
+
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(BoxInstance),
+							  reinterpret_cast<void *>(offsetof(BoxInstance, boundMax)));
+		glVertexAttribDivisor(1, 1);
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void OcclusionQuery::release() {
+		if (this->box_program > 0) {
+			glDeleteProgram(this->box_program);
+			this->box_program = 0;
+		}
+		if (!this->queries.empty()) {
+			glDeleteQueries(this->queries.size(), this->queries.data());
+			this->queries.clear();
+		}
+		if (this->vao) {
+			glDeleteVertexArrays(1, &this->vao);
+			this->vao = 0;
+		}
+		for (unsigned int *buffer : {&this->instance_buffer, &this->uniform_buffer}) {
+			if (*buffer) {
+				glDeleteBuffers(1, buffer);
+				*buffer = 0;
+			}
+		}
+	}
+
+	void OcclusionQuery::query(const glm::mat4 &viewProjection, const glm::vec3 *boundMin, const glm::vec3 *boundMax,
+							   const size_t count) {
+		const size_t nrBoxes = std::min(count, this->queries.size());
+		if (nrBoxes == 0) {
+			return;
+		}
+
+		std::vector<BoxInstance> boxes(nrBoxes);
+		for (size_t i = 0; i < nrBoxes; i++) {
+			boxes[i] = {boundMin[i], boundMax[i]};
+		}
+
+		/*	Orphan the previous boxes, they may still be in use by the previous queries.	*/
+		glBindBuffer(GL_ARRAY_BUFFER, this->instance_buffer);
+		glBufferData(GL_ARRAY_BUFFER, this->nrQueries * sizeof(BoxInstance), nullptr, GL_DYNAMIC_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, nrBoxes * sizeof(BoxInstance), boxes.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), &viewProjection[0][0]);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		/*	Current states of the caller.	*/
+		GLint program = 0;
+		GLboolean depthMask = GL_TRUE;
+		GLboolean colorMask[4] = {GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE};
+		glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+		glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+		glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+		const GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+
+		/*	Both sides are tested, and boxes crossing the near plane are clamped instead of clipped.	*/
+		glDepthMask(GL_FALSE);
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+		glDisable(GL_CULL_FACE);
+		glEnable(GL_DEPTH_CLAMP);
+
+		glUseProgram(this->box_program);
+		glBindBufferBase(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer);
+		glBindVertexArray(this->vao);
+
+		for (size_t i = 0; i < nrBoxes; i++) {
+			glBeginQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE, this->queries[i]);
+			glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, 36, 1, i);
+			glEndQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+		}
+
+		glBindVertexArray(0);
+
+		/*	Restore states.	*/
+		glDisable(GL_DEPTH_CLAMP);
+		if (cullFace) {
+			glEnable(GL_CULL_FACE);
+		}
+		glColorMask(colorMask[0], colorMask[1], colorMask[2], colorMask[3]);
+		glDepthMask(depthMask);
+		glUseProgram(program);
+	}
+
+	void OcclusionQuery::beginConditionalRender(const size_t index) const {
+		/*	Waits on the GPU for the query, never on the CPU.	*/
+		glBeginConditionalRender(this->queries[index], GL_QUERY_WAIT);
+	}
+
+	void OcclusionQuery::endConditionalRender() const { glEndConditionalRender(); }
+
+} // namespace glsample
@@ -0,0 +1,82 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "FragDef.h"
+#include "GLSampleSession.h"
+#include <IO/FileSystem.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace glsample {
+
+	/**
+	 * @brief Occlusion queries of bounding boxes against the current depth buffer, consumed by conditional
+	 * rendering.
+	 *
+	 * The result never leaves the GPU, the draws of a hidden box are discarded by glBeginConditionalRender
+	 * without a read back to the CPU.
+	 */
+	class FVDECLSPEC OcclusionQuery {
+	  public:
+		OcclusionQuery() = default;
+		OcclusionQuery(const OcclusionQuery &) = delete;
+		OcclusionQuery &operator=(const OcclusionQuery &) = delete;
+		virtual ~OcclusionQuery();
+
+		/**
+		 * @brief Load the bounding box program and create the queries.
+		 */
+		void init(fragcore::IFileSystem *filesystem);
+
+		void release();
+
+		/**
+		 * @brief Rasterize the world space boxes with GL_ANY_SAMPLES_PASSED_CONSERVATIVE, one query per box.
+		 * Color and depth writes are disabled, the program and states are restored afterward.
+		 *
+		 * @param count at most getNrQueries boxes.
+		 */
+		void query(const glm::mat4 &viewProjection, const glm::vec3 *boundMin, const glm::vec3 *boundMax,
+				   const size_t count);
+
+		/**
+		 * @brief Draw calls until endConditionalRender are discarded if no sample of the box passed.
+		 */
+		void beginConditionalRender(const size_t index) const;
+		void endConditionalRender() const;
+
+		size_t getNrQueries() const noexcept { return this->queries.size(); }
+
+	  private:
+		using BoxInstance = struct box_instance_t {
+			glm::vec3 boundMin;
+			glm::vec3 boundMax;
+		};
+
+		std::vector<unsigned int> queries;
+
+		int box_program = 0;
+		unsigned int vao = 0;
+		unsigned int instance_buffer = 0;
+		unsigned int uniform_buffer = 0;
+
+		const size_t nrQueries = 32;
+
+		/*	Not shared with the sample and scene bindings.	*/
+		unsigned int uniform_buffer_binding = 7;
+	};
+
+} // namespace glsample
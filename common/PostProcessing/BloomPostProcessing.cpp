@@ -13,6 +13,9 @@ BloomPostProcessing::BloomPostProcessing() {
 	this->addRequireBuffer(GBuffer::Color);
 	this->addRequireBuffer(GBuffer::IntermediateTarget);
 	this->addRequireBuffer(GBuffer::IntermediateTarget2);
+	this->addWriteBuffer(GBuffer::Color, BufferAccess::Attachment);
+	this->addWriteBuffer(GBuffer::IntermediateTarget, BufferAccess::Image);
+	this->addWriteBuffer(GBuffer::IntermediateTarget2, BufferAccess::Image);
 }
 
 BloomPostProcessing::~BloomPostProcessing() {
@@ -22,6 +25,10 @@ BloomPostProcessing::~BloomPostProcessing() {
 	if (glIsSampler(this->texture_sampler)) {
 		glDeleteSamplers(1, &this->texture_sampler);
 	}
+	if (this->vao > 0) {
+		glDeleteVertexArrays(1, &this->vao);
+		this->vao = 0;
+	}
 }
 
 void BloomPostProcessing::initialize(fragcore::IFileSystem *filesystem) {
@@ -112,18 +119,14 @@ void BloomPostProcessing::render(FrameBuffer *framebuffer, unsigned int color_te
 	unsigned int readTexture = color_texture; /*	*/
 	unsigned int targetTexture = intermediate0;
 
-	glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+	this->memoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
 
 	glBindSampler((int)GBuffer::Albedo, this->texture_sampler);
 
 	{
 		GLint width = 0;
 		GLint height = 0;
-
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, framebuffer->attachments[0]);
-		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
-		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+		this->getRenderSize(framebuffer->attachments[0], width, height);
 
 		glUseProgram(this->downsample_compute_program);
 		glUniform1i(glGetUniformLocation(this->downsample_compute_program, "settings.filterRadius"), 1);
@@ -204,7 +207,7 @@ void BloomPostProcessing::render(FrameBuffer *framebuffer, unsigned int color_te
 		glUseProgram(0);
 	}
 
-	glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
+	this->memoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
 }
 
 void BloomPostProcessing::renderUI() { ImGui::DragInt("Image Size", (int *)&this->nr_down_samples); }
\ No newline at end of file
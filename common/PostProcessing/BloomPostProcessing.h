@@ -51,6 +51,6 @@ namespace glsample {
 		float mean = 0;
 		int localWorkGroupSize[3];
 		float threadshold = 1;
-		int vao = 0;
+		unsigned int vao = 0;
 	};
 } // namespace glsample
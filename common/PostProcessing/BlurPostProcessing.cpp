@@ -14,6 +14,8 @@ BlurPostProcessing::BlurPostProcessing() {
 	this->setName("Blur");
 	this->addRequireBuffer(GBuffer::Color);
 	this->addRequireBuffer(GBuffer::IntermediateTarget);
+	this->addWriteBuffer(GBuffer::Color, BufferAccess::Image);
+	this->addWriteBuffer(GBuffer::IntermediateTarget, BufferAccess::Image);
 }
 
 BlurPostProcessing::~BlurPostProcessing() {
@@ -115,12 +117,7 @@ void BlurPostProcessing::render(glsample::FrameBuffer *framebuffer, unsigned int
 								unsigned int write_texture) {
 	GLint width = 0;
 	GLint height = 0;
-
-	/*	*/
-	glActiveTexture(GL_TEXTURE1);
-	glBindTexture(GL_TEXTURE_2D, write_texture);
-	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
-	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+	this->getRenderSize(write_texture, width, height);
 
 	switch (this->blurType) {
 	case BoxBlur:
@@ -216,7 +213,7 @@ void BlurPostProcessing::render(glsample::FrameBuffer *framebuffer, unsigned int
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + 1, GL_TEXTURE_2D, framebuffer->attachments[1], 0);
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + 0, GL_TEXTURE_2D, framebuffer->attachments[0], 0);
 
-	glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
+	this->memoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
 }
 
 void BlurPostProcessing::updateGuassianKernel() {
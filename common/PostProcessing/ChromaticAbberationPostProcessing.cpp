@@ -12,13 +12,18 @@ ChromaticAbberationPostProcessing::ChromaticAbberationPostProcessing() {
 	this->setName("Chromatic Abberation");
 	this->addRequireBuffer(GBuffer::Color);
 	this->addRequireBuffer(GBuffer::IntermediateTarget);
+	this->addWriteBuffer(GBuffer::Color, BufferAccess::Attachment);
+	this->addWriteBuffer(GBuffer::IntermediateTarget, BufferAccess::Attachment);
 }
 
 ChromaticAbberationPostProcessing::~ChromaticAbberationPostProcessing() {
 	if (glIsProgram(this->chromatic_abberation_graphic_program)) {
 		glDeleteProgram(this->chromatic_abberation_graphic_program);
 	}
-	glDeleteVertexArrays(1, &this->vao);
+	if (this->vao > 0) {
+		glDeleteVertexArrays(1, &this->vao);
+		this->vao = 0;
+	}
 }
 
 void ChromaticAbberationPostProcessing::initialize(fragcore::IFileSystem *filesystem) {
@@ -72,7 +77,7 @@ void ChromaticAbberationPostProcessing::render(glsample::FrameBuffer *framebuffe
 	const unsigned int source_texture = source_color_texture;
 	const unsigned int target_texture = this->getMappedBuffer(GBuffer::IntermediateTarget);
 
-	glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
+	this->memoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
 
 	glUseProgram(this->chromatic_abberation_graphic_program);
 
@@ -98,7 +103,7 @@ void ChromaticAbberationPostProcessing::render(glsample::FrameBuffer *framebuffe
 	glUseProgram(0);
 	glBindVertexArray(0);
 
-	glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
+	this->memoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
 
 	/*	Swap buffers.	(ping pong)	*/
 	framebuffer->attachments[0] = target_texture;
@@ -13,6 +13,7 @@ FXAAPostProcessing::FXAAPostProcessing() {
 	this->addRequireBuffer(GBuffer::Color);
 	this->addRequireBuffer(GBuffer::IntermediateTarget);
 	this->addRequireBuffer(GBuffer::Depth);
+	this->addWriteBuffer(GBuffer::Color, BufferAccess::Image);
 }
 
 FXAAPostProcessing::~FXAAPostProcessing() {
@@ -59,14 +60,11 @@ void FXAAPostProcessing::draw(
 
 void FXAAPostProcessing::render(unsigned int source_texture) {
 
-	glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+	this->memoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
 
 	GLint width = 0;
 	GLint height = 0;
-
-	glBindTexture(GL_TEXTURE_2D, source_texture);
-	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
-	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+	this->getRenderSize(source_texture, width, height);
 
 	glUseProgram(this->fxaa_compute_program);
 
@@ -11,12 +11,17 @@ using namespace glsample;
 GrainPostProcessing::GrainPostProcessing() {
 	this->setName("Grain");
 	this->addRequireBuffer(GBuffer::Albedo);
+	this->addWriteBuffer(GBuffer::Albedo, BufferAccess::Attachment);
 }
 
 GrainPostProcessing::~GrainPostProcessing() {
 	if (this->grain_graphic_program >= 0) {
 		glDeleteProgram(this->grain_graphic_program);
 	}
+	if (this->vao > 0) {
+		glDeleteVertexArrays(1, &this->vao);
+		this->vao = 0;
+	}
 }
 
 void GrainPostProcessing::initialize(fragcore::IFileSystem *filesystem) {
@@ -52,7 +57,7 @@ void GrainPostProcessing::draw(
 	const std::initializer_list<std::tuple<const GBuffer, const unsigned int &>> &render_targets) {
 	PostProcessing::draw(framebuffer, render_targets);
 
-	glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
+	this->memoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
 
 	glUseProgram(this->grain_graphic_program);
 
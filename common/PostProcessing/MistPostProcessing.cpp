@@ -1,4 +1,5 @@
 #include "MistPostProcessing.h"
+#include "FrameRingAllocator.h"
 #include "PostProcessing/PostProcessing.h"
 #include "SampleHelper.h"
 #include "ShaderLoader.h"
@@ -12,14 +13,16 @@ MistPostProcessing::MistPostProcessing() {
 	this->setName("MistFog");
 	this->addRequireBuffer(GBuffer::Color);
 	this->addRequireBuffer(GBuffer::Depth);
+	this->addWriteBuffer(GBuffer::Color, BufferAccess::Attachment);
 }
 
 MistPostProcessing::~MistPostProcessing() {
 	if (this->mist_fog_program >= 0) {
 		glDeleteProgram(this->mist_fog_program);
 	}
-	if (glIsBuffer(this->uniform_buffer)) {
-		glDeleteBuffers(1, &this->uniform_buffer);
+	if (this->vao > 0) {
+		glDeleteVertexArrays(1, &this->vao);
+		this->vao = 0;
 	}
 }
 
@@ -65,17 +68,6 @@ void MistPostProcessing::initialize(fragcore::IFileSystem *filesystem) {
 	glUniform1i(glGetUniformLocation(this->simple_fog_program, "DepthTexture"), (int)GBuffer::Depth);
 	glUseProgram(0);
 
-	/*	*/
-	GLint minMapBufferSize = 0;
-	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-	this->uniformAlignSize = Math::align<size_t>(sizeof(MistUniformBuffer), (size_t)minMapBufferSize);
-
-	/*	Create uniform buffer.	*/
-	glGenBuffers(1, &this->uniform_buffer);
-	glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-	glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignSize * 1, nullptr, GL_DYNAMIC_DRAW);
-	glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 	/*	Create sampler for sampling GBuffer regardless of the texture internal sampler.	*/
 	glCreateSamplers(1, &this->texture_sampler);
 	glSamplerParameteri(this->texture_sampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -100,17 +92,14 @@ void MistPostProcessing::draw(
 
 void MistPostProcessing::render(unsigned int skybox, unsigned int frame_texture, unsigned int depth_texture) {
 
-	glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+	this->memoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
 
-	/*	Update uniform values.	*/
-	glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-	void *uniformPointer =
-		glMapBufferRange(GL_UNIFORM_BUFFER, 0 * this->uniformAlignSize, this->uniformAlignSize, GL_MAP_WRITE_BIT);
-	memcpy(uniformPointer, &this->mistsettings, sizeof(this->mistsettings));
-	glUnmapBuffer(GL_UNIFORM_BUFFER);
+	/*	Update uniform values, fenced with the frame.	*/
+	const FrameRingAllocator::Allocation uniform_allocation =
+		FrameRingAllocator::getActive().allocate(this->mistsettings);
 
-	glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-					  (1 % 1) * this->uniformAlignSize, this->uniformAlignSize);
+	glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, uniform_allocation.buffer,
+					  uniform_allocation.offset, uniform_allocation.size);
 
 	/*	*/
 	{
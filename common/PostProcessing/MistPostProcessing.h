@@ -56,8 +56,6 @@ namespace glsample {
 
 		bool useSimple = false;
 
-		unsigned int uniform_buffer = 0;
 		unsigned int uniform_buffer_binding = 1;
-		size_t uniformAlignSize = sizeof(MistUniformBuffer);
 	};
 } // namespace glsample
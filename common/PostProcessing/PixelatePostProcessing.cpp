@@ -12,6 +12,8 @@ using namespace glsample;
 PixelatePostProcessing::PixelatePostProcessing() {
 	this->setName("Pixelate");
 	this->addRequireBuffer(GBuffer::Color);
+	this->addWriteBuffer(GBuffer::Color, BufferAccess::Attachment);
+	this->addWriteBuffer(GBuffer::IntermediateTarget, BufferAccess::Attachment);
 }
 
 PixelatePostProcessing::~PixelatePostProcessing() {
@@ -54,11 +54,41 @@ const unsigned int &PostProcessing::getMappedBuffer(const GBuffer buffer_target)
 																				: temp;
 }
 
+bool PostProcessing::isBufferWritten(const GBuffer buffer) const noexcept {
+	return std::find_if(this->written_buffer.begin(), this->written_buffer.end(),
+						[buffer](const std::tuple<GBuffer, BufferAccess> &written) {
+							return std::get<0>(written) == buffer;
+						}) != this->written_buffer.end();
+}
+
 void PostProcessing::addRequireBuffer(const GBuffer required_data_buffer) noexcept {
 	this->required_buffer.push_back(required_data_buffer);
 }
 void PostProcessing::removeRequireBuffer(const GBuffer required_data_buffer) noexcept {}
 
+void PostProcessing::addWriteBuffer(const GBuffer buffer, const BufferAccess access) noexcept {
+	this->written_buffer.push_back(std::make_tuple(buffer, access));
+}
+
+void PostProcessing::memoryBarrier(const unsigned int barriers) const noexcept {
+	if (!this->externalSynchronization) {
+		glMemoryBarrier(barriers);
+	}
+}
+
+void PostProcessing::getRenderSize(const unsigned int texture, int &width, int &height) const noexcept {
+	if (this->renderWidth > 0 && this->renderHeight > 0) {
+		width = this->renderWidth;
+		height = this->renderHeight;
+		return;
+	}
+
+	/*	Fallback when used outside the post processing manager.	*/
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+}
+
 int PostProcessing::createVAO() {
 	unsigned int vao = 0;
 	glGenVertexArrays(1, &vao);
@@ -16,9 +16,19 @@
 #pragma once
 #include "IO/IFileSystem.h"
 #include "SampleHelper.h"
+#include <tuple>
+#include <vector>
 
 namespace glsample {
 
+	/**
+	 * @brief How a post processing produces a buffer, used to derive the memory barriers between them.
+	 */
+	enum class BufferAccess : unsigned int {
+		Attachment = 0, /*	Written as framebuffer attachment.	*/
+		Image = 1,		/*	Written with image store.	*/
+	};
+
 	class FVDECLSPEC PostProcessing : public fragcore::Object {
 	  public:
 		PostProcessing();
@@ -41,12 +51,52 @@ namespace glsample {
 		virtual void setItensity(const float intensity);
 
 		bool isBufferRequired(const GBuffer required_data_buffer) const noexcept;
+		const std::vector<GBuffer> &getRequiredBuffers() const noexcept { return this->required_buffer; }
+
+		/**
+		 * @brief Buffers whose content is produced by the post processing, after any ping pong swap.
+		 */
+		bool isBufferWritten(const GBuffer buffer) const noexcept;
+		const std::vector<std::tuple<GBuffer, BufferAccess>> &getWrittenBuffers() const noexcept {
+			return this->written_buffer;
+		}
+
+		/**
+		 * @brief Transient buffers are scratch memory, shared between all post processing. Their
+		 * content is undefined between post processings.
+		 */
+		static bool isTransientBuffer(const GBuffer buffer) noexcept {
+			return buffer == GBuffer::IntermediateTarget || buffer == GBuffer::IntermediateTarget2;
+		}
+
+		/**
+		 * @brief Let the caller insert the memory barriers between post processings, instead of each
+		 * post processing issuing its own.
+		 */
+		void setExternalSynchronization(const bool enabled) noexcept { this->externalSynchronization = enabled; }
+
+		/**
+		 * @brief Size of the render targets, 0 query it from the texture.
+		 */
+		void setRenderSize(const int width, const int height) noexcept {
+			this->renderWidth = width;
+			this->renderHeight = height;
+		}
 
 		/*	Common data references.	*/
 
 	  protected:
 		void addRequireBuffer(const GBuffer required_data_buffer) noexcept;
 		void removeRequireBuffer(const GBuffer required_data_buffer) noexcept;
+		void addWriteBuffer(const GBuffer buffer, const BufferAccess access) noexcept;
+
+		/**
+		 * @brief Memory barrier at the start or end of the post processing, skipped when synchronized
+		 * externally.
+		 */
+		void memoryBarrier(const unsigned int barriers) const noexcept;
+
+		void getRenderSize(const unsigned int texture, int &width, int &height) const noexcept;
 
 		const unsigned int &getMappedBuffer(const GBuffer buffer_target) const noexcept;
 
@@ -56,8 +106,12 @@ namespace glsample {
 
 	  protected:
 		std::vector<GBuffer> required_buffer;
+		std::vector<std::tuple<GBuffer, BufferAccess>> written_buffer;
 		std::map<GBuffer, const unsigned int *> mapped_buffer;
 		bool computeShaderSupported = true;
+		bool externalSynchronization = false;
+		int renderWidth = 0;
+		int renderHeight = 0;
 		float intensity = 1;
 	};
 } // namespace glsample
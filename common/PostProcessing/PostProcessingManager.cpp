@@ -1,46 +1,214 @@
 #include "PostProcessing/PostProcessingManager.h"
 #include "PostProcessing/PostProcessing.h"
+#include "Profiler.h"
 #include <GL/glew.h>
+#include <cstdint>
 
 using namespace glsample;
 
+PostProcessingManager::~PostProcessingManager() {
+	for (PostProcessingEntry &entry : this->postProcessings) {
+		/*	Only release the post processing created by the manager.	*/
+		if (entry.factory) {
+			delete entry.postProcessing;
+		}
+	}
+}
+
 void PostProcessingManager::addPostProcessing(PostProcessing &postProcessing) {
-	this->postProcessings.push_back(&postProcessing);
-	this->post_enabled.push_back(false);
+	PostProcessingEntry entry;
+	entry.postProcessing = &postProcessing;
+	entry.initialized = true;
+	this->postProcessings.push_back(entry);
+}
+
+void PostProcessingManager::addPostProcessing(const PostProcessingFactory &factory) {
+	PostProcessingEntry entry;
+	/*	Construction is cheap, all the resources are created in initialize.	*/
+	entry.postProcessing = factory();
+	entry.factory = factory;
+	this->postProcessings.push_back(entry);
 }
 
 size_t PostProcessingManager::getNrPostProcessing() const noexcept { return this->postProcessings.size(); }
-PostProcessing &PostProcessingManager::getPostProcessing(const size_t index) { return *this->postProcessings[index]; }
+PostProcessing &PostProcessingManager::getPostProcessing(const size_t index) {
+	return *this->postProcessings[index].postProcessing;
+}
 
 bool PostProcessingManager::isEnabled(const size_t index) const noexcept {
-	return this->post_enabled[index] && this->postProcessings[index]->getIntensity() > 0;
+	return this->postProcessings[index].enabled && this->postProcessings[index].postProcessing->getIntensity() > 0;
 }
 
 void PostProcessingManager::enablePostProcessing(const size_t index, const bool enabled) {
-	this->post_enabled[index] = enabled;
+	PostProcessingEntry &entry = this->postProcessings[index];
+
+	/*	Load all resources on first use.	*/
+	if (enabled && !entry.initialized) {
+		entry.postProcessing->initialize(this->filesystem);
+		entry.initialized = true;
+	}
+
+	entry.enabled = enabled;
+	entry.idleFrames = 0;
+}
+
+void PostProcessingManager::release(const size_t index) {
+	PostProcessingEntry &entry = this->postProcessings[index];
+
+	/*	Recreate the post processing without any resources, keeping the user settings.	*/
+	const float intensity = entry.postProcessing->getIntensity();
+	delete entry.postProcessing;
+
+	entry.postProcessing = entry.factory();
+	entry.postProcessing->setItensity(intensity);
+	entry.initialized = false;
+	entry.idleFrames = 0;
+}
+
+void PostProcessingManager::setRenderSize(const int width, const int height) noexcept {
+	this->renderWidth = width;
+	this->renderHeight = height;
+}
+
+static inline uint32_t bufferMask(const GBuffer buffer) noexcept { return 1u << static_cast<unsigned int>(buffer); }
+
+void PostProcessingManager::compile() {
+
+	this->passes.clear();
+	this->livePasses.assign(this->postProcessings.size(), false);
+	this->nrCulledPasses = 0;
+
+	/*	Backward, from the final color, to find all post processing contributing to it.	*/
+	uint32_t liveBuffers = bufferMask(GBuffer::Color);
+	for (size_t i = this->postProcessings.size(); i > 0; i--) {
+		const size_t index = i - 1;
+		const PostProcessing &postprocessing = *this->postProcessings[index].postProcessing;
+
+		if (!this->isEnabled(index) || !postprocessing.isActive()) {
+			continue;
+		}
+
+		uint32_t written = 0;
+		for (const std::tuple<GBuffer, BufferAccess> &buffer : postprocessing.getWrittenBuffers()) {
+			if (!PostProcessing::isTransientBuffer(std::get<0>(buffer))) {
+				written |= bufferMask(std::get<0>(buffer));
+			}
+		}
+
+		if ((written & liveBuffers) == 0) {
+			this->nrCulledPasses++;
+			continue;
+		}
+
+		uint32_t read = 0;
+		for (const GBuffer buffer : postprocessing.getRequiredBuffers()) {
+			if (!PostProcessing::isTransientBuffer(buffer)) {
+				read |= bufferMask(buffer);
+			}
+		}
+
+		liveBuffers = (liveBuffers & ~written) | read;
+		this->livePasses[index] = true;
+	}
+
+	/*	Forward, buffers written with image store, not yet visible to each type of access.	*/
+	uint32_t pendingFetch = 0;
+	uint32_t pendingImage = 0;
+	uint32_t pendingFramebuffer = 0;
+
+	for (size_t index = 0; index < this->postProcessings.size(); index++) {
+		if (!this->livePasses[index]) {
+			continue;
+		}
+		const PostProcessing &postprocessing = *this->postProcessings[index].postProcessing;
+
+		PostProcessingPass pass;
+		pass.index = index;
+
+		uint32_t read = 0;
+		for (const GBuffer buffer : postprocessing.getRequiredBuffers()) {
+			read |= bufferMask(buffer);
+		}
+
+		if ((read & pendingFetch) != 0) {
+			pass.barriers |= GL_TEXTURE_FETCH_BARRIER_BIT;
+			pendingFetch = 0;
+		}
+
+		uint32_t imageWritten = 0;
+		for (const std::tuple<GBuffer, BufferAccess> &buffer : postprocessing.getWrittenBuffers()) {
+			const uint32_t mask = bufferMask(std::get<0>(buffer));
+
+			if (std::get<1>(buffer) == BufferAccess::Image) {
+				if ((pendingImage & mask) != 0) {
+					pass.barriers |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+					pendingImage = 0;
+				}
+				imageWritten |= mask;
+			} else if ((pendingFramebuffer & mask) != 0) {
+				pass.barriers |= GL_FRAMEBUFFER_BARRIER_BIT;
+				pendingFramebuffer = 0;
+			}
+		}
+
+		pendingFetch |= imageWritten;
+		pendingImage |= imageWritten;
+		pendingFramebuffer |= imageWritten;
+
+		this->passes.push_back(pass);
+	}
+
+	/*	Final color is sampled and blitted after the post processing.	*/
+	this->finalBarriers = 0;
+	if ((pendingFetch & bufferMask(GBuffer::Color)) != 0) {
+		this->finalBarriers |= GL_TEXTURE_FETCH_BARRIER_BIT;
+	}
+	if ((pendingFramebuffer & bufferMask(GBuffer::Color)) != 0) {
+		this->finalBarriers |= GL_FRAMEBUFFER_BARRIER_BIT;
+	}
 }
 
 void PostProcessingManager::render(
 	glsample::FrameBuffer *framebuffer,
 	const std::initializer_list<std::tuple<const GBuffer, const unsigned int &>> &render_targets) { /*	*/
 
-	/*	Bind Common Data.	*/
-	
-	/*	*/
-	for (size_t i = 0; i < this->getNrPostProcessing(); i++) {
+	this->compile();
+
+	for (const PostProcessingPass &pass : this->passes) {
 		/*	*/
-		PostProcessing &postprocessing = getPostProcessing(i);
-		if (this->isEnabled(i) && postprocessing.isActive()) {
+		PostProcessingEntry &entry = this->postProcessings[pass.index];
+		PostProcessing &postprocessing = *entry.postProcessing;
+
+		Profiler::pushScope(postprocessing.getName());
 
-			glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 1, postprocessing.getName().length(),
-							 postprocessing.getName().c_str());
+		if (pass.barriers != 0) {
+			glMemoryBarrier(pass.barriers);
+		}
+
+		postprocessing.setExternalSynchronization(true);
+		postprocessing.setRenderSize(this->renderWidth, this->renderHeight);
+		postprocessing.bind();
 
-			postprocessing.bind();
+		/*	Render.	*/
+		postprocessing.draw(framebuffer, render_targets);
 
-			/*	Render.	*/
-			postprocessing.draw(framebuffer, render_targets);
+		Profiler::popScope();
+
+		entry.idleFrames = 0;
+	}
 
-			glPopDebugGroup();
+	if (this->finalBarriers != 0) {
+		glMemoryBarrier(this->finalBarriers);
+	}
+
+	/*	Release resources of post processing not used for a while.	*/
+	if (this->releaseIdleFrameCount > 0) {
+		for (size_t i = 0; i < this->getNrPostProcessing(); i++) {
+			PostProcessingEntry &entry = this->postProcessings[i];
+			if (entry.initialized && entry.factory && !entry.enabled &&
+				++entry.idleFrames > this->releaseIdleFrameCount) {
+				this->release(i);
+			}
 		}
 	}
-}
\ No newline at end of file
+}
@@ -16,6 +16,7 @@
 #pragma once
 #include "PostProcessing.h"
 #include "SampleHelper.h"
+#include <functional>
 #include <initializer_list>
 
 namespace glsample {
@@ -26,26 +27,91 @@ namespace glsample {
 	 */
 	class FVDECLSPEC PostProcessingManager : public fragcore::Object {
 	  public:
+		using PostProcessingFactory = std::function<PostProcessing *()>;
+
 		PostProcessingManager() = default;
-		~PostProcessingManager() override = default;
+		PostProcessingManager(fragcore::IFileSystem *filesystem) : filesystem(filesystem) {}
+		~PostProcessingManager() override;
 
+		/**
+		 * @brief Add already initialized post processing, owned by the caller.
+		 */
 		void addPostProcessing(PostProcessing &postProcessing);
 
+		/**
+		 * @brief Add post processing created by the factory. Shaders, textures and buffers are not
+		 * loaded until the post processing is enabled the first time.
+		 */
+		void addPostProcessing(const PostProcessingFactory &factory);
+
 		size_t getNrPostProcessing() const noexcept;
 		PostProcessing &getPostProcessing(const size_t index);
 
 		bool isEnabled(const size_t index) const noexcept;
 		void enablePostProcessing(const size_t index, const bool enabled);
 
+		bool isInitialized(const size_t index) const noexcept { return this->postProcessings[index].initialized; }
+
+		/**
+		 * @brief Release the resources of factory created post processing that has not been rendered for
+		 * the number of frames, 0 never release.
+		 */
+		void setReleaseIdleFrameCount(const size_t nrFrames) noexcept { this->releaseIdleFrameCount = nrFrames; }
+		size_t getReleaseIdleFrameCount() const noexcept { return this->releaseIdleFrameCount; }
+
+		/**
+		 * @brief Size of the render targets, avoid querying the texture size in each post processing.
+		 */
+		void setRenderSize(const int width, const int height) noexcept;
+
 		void render(glsample::FrameBuffer *framebuffer,
 					const std::initializer_list<std::tuple<const GBuffer, const unsigned int &>> &render_targets);
 
+		/**
+		 * @brief Number of post processing scheduled and culled in the last render.
+		 */
+		size_t getNrScheduledPasses() const noexcept { return this->passes.size(); }
+		size_t getNrCulledPasses() const noexcept { return this->nrCulledPasses; }
+
 		void populateCommonData() {}
 
 	  protected:
-		// TODO: shared_pointer
-		std::vector<PostProcessing *> postProcessings;
-		std::vector<bool> post_enabled;
+		void release(const size_t index);
+
+		/**
+		 * @brief Build the schedule of the enabled post processing, from their read and written buffers.
+		 *
+		 * Post processing whose written buffers are never read before being overwritten, or by the
+		 * final output, are culled. Transient buffers are aliased between all post processing, since
+		 * their content does not outlive a single post processing. Memory barriers are only inserted
+		 * before a post processing that reads or writes a buffer last written with image store.
+		 */
+		void compile();
+
+		using PostProcessingPass = struct post_processing_pass_t {
+			size_t index = 0;
+			unsigned int barriers = 0; /*	Memory barrier bits, issued before the pass.	*/
+		};
+
+		using PostProcessingEntry = struct post_processing_entry_t {
+			PostProcessing *postProcessing = nullptr;
+			PostProcessingFactory factory; /*	Empty if not owned by the manager.	*/
+			bool enabled = false;
+			bool initialized = false;
+			size_t idleFrames = 0;
+		};
+
+		std::vector<PostProcessingEntry> postProcessings;
+		fragcore::IFileSystem *filesystem = nullptr;
+		size_t releaseIdleFrameCount = 0;
+
+		/*	Schedule, reused between frames.	*/
+		std::vector<PostProcessingPass> passes;
+		std::vector<bool> livePasses;
+		unsigned int finalBarriers = 0;
+		size_t nrCulledPasses = 0;
+		int renderWidth = 0;
+		int renderHeight = 0;
 
 		unsigned int common_uniform_buffer = 0;
 	};
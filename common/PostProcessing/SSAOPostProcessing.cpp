@@ -1,5 +1,6 @@
 #include "PostProcessing/SSAOPostProcessing.h"
 #include "Common.h"
+#include "FrameRingAllocator.h"
 #include "GLSampleSession.h"
 #include "PostProcessing/PostProcessing.h"
 #include "SampleHelper.h"
@@ -16,6 +17,7 @@ SSAOPostProcessing::SSAOPostProcessing() {
 	this->addRequireBuffer(GBuffer::Color);
 	this->addRequireBuffer(GBuffer::Depth);
 	this->addRequireBuffer(GBuffer::Normal);
+	this->addWriteBuffer(GBuffer::Color, BufferAccess::Attachment);
 }
 
 SSAOPostProcessing::~SSAOPostProcessing() {
@@ -32,13 +34,17 @@ SSAOPostProcessing::~SSAOPostProcessing() {
 		glDeleteProgram(this->downsample_compute_program);
 	}
 
-	if (glIsBuffer(this->uniform_ssao_buffer)) {
-		glDeleteBuffers(1, &this->uniform_ssao_buffer);
-	}
-
 	if (glIsTexture(this->random_texture)) {
 		glDeleteTextures(1, &this->random_texture);
 	}
+	if (glIsTexture(this->white_texture)) {
+		glDeleteTextures(1, &this->white_texture);
+		this->white_texture = 0;
+	}
+	if (this->vao > 0) {
+		glDeleteVertexArrays(1, &this->vao);
+		this->vao = 0;
+	}
 }
 
 void SSAOPostProcessing::initialize(fragcore::IFileSystem *filesystem) {
@@ -98,13 +104,6 @@ void SSAOPostProcessing::initialize(fragcore::IFileSystem *filesystem) {
 						  this->uniform_ssao_buffer_binding);
 	glUseProgram(0);
 
-	/*	Align uniform buffer in respect to driver requirement.	*/
-	GLint minMapBufferSize = 0;
-	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-
-	this->uniformSSAOBufferAlignSize =
-		fragcore::Math::align<size_t>(this->uniformSSAOBufferAlignSize, (size_t)minMapBufferSize);
-
 	/*	FIXME: improve vectors.		*/
 	{
 		/*	Create random vector.	*/
@@ -126,13 +125,6 @@ void SSAOPostProcessing::initialize(fragcore::IFileSystem *filesystem) {
 			this->uniformStageBlockSSAO.kernel[i] = glm::vec4(sample, 0);
 		}
 
-		/*	*/
-		glGenBuffers(1, &this->uniform_ssao_buffer);
-		glBindBufferARB(GL_UNIFORM_BUFFER, this->uniform_ssao_buffer);
-		glBufferData(GL_UNIFORM_BUFFER, this->uniformSSAOBufferAlignSize * 1, &this->uniformStageBlockSSAO,
-					 GL_DYNAMIC_DRAW);
-		glBindBufferARB(GL_UNIFORM_BUFFER, 0);
-
 		/*	Create white texture.	*/
 		this->white_texture = glsample::Common::createColorTexture(1, 1, Color::white());
 
@@ -194,19 +186,17 @@ void SSAOPostProcessing::draw(
 void SSAOPostProcessing::render(glsample::FrameBuffer *framebuffer, unsigned int depth_texture,
 								unsigned int world_texture, unsigned int normal_texture) {
 
-	glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_ssao_buffer);
-	void *uniformPointer = glMapBufferRange(GL_UNIFORM_BUFFER, 0, this->uniformSSAOBufferAlignSize,
-											GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-	memcpy(uniformPointer, &this->uniformStageBlockSSAO, sizeof(uniformStageBlockSSAO));
-	glUnmapBuffer(GL_UNIFORM_BUFFER);
+	/*	Fenced with the frame, no write while the previous frames read it.	*/
+	const FrameRingAllocator::Allocation uniform_allocation =
+		FrameRingAllocator::getActive().allocate(this->uniformStageBlockSSAO);
 
 	/*	*/
-	glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
+	this->memoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
 
 	/*	Draw Ambient Occlusion.	*/
 	{
-		glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_ssao_buffer_binding, this->uniform_ssao_buffer, 0,
-						  this->uniformSSAOBufferAlignSize);
+		glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_ssao_buffer_binding, uniform_allocation.buffer,
+						  uniform_allocation.offset, uniform_allocation.size);
 
 		glActiveTexture(GL_TEXTURE0 + (int)GBuffer::TextureCoordinate);
 		glBindTexture(GL_TEXTURE_2D, this->random_texture);
@@ -62,8 +62,6 @@ namespace glsample {
 
 			glm::vec4 kernel[maxKernels]{};
 		} uniformStageBlockSSAO;
-		size_t uniformSSAOBufferAlignSize = sizeof(UniformSSAOBufferBlock);
-		unsigned int uniform_ssao_buffer = 0;
 		/*	Random direction texture.	*/
 		unsigned int random_texture = 0;
 		unsigned int white_texture = 0;
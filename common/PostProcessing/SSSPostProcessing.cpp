@@ -13,8 +13,14 @@ SSSPostProcessing::SSSPostProcessing() {
 	this->setName("Space Space Shadowing");
 	this->addRequireBuffer(GBuffer::Color);
 	this->addRequireBuffer(GBuffer::Depth);
+	this->addWriteBuffer(GBuffer::Color, BufferAccess::Attachment);
+}
+SSSPostProcessing::~SSSPostProcessing() {
+	if (this->vao > 0) {
+		glDeleteVertexArrays(1, &this->vao);
+		this->vao = 0;
+	}
 }
-SSSPostProcessing::~SSSPostProcessing() = default;
 
 void SSSPostProcessing::initialize(fragcore::IFileSystem *filesystem) {
 
@@ -71,7 +77,7 @@ void SSSPostProcessing::draw(
 	PostProcessing::draw(framebuffer, render_targets);
 
 	/*	*/
-	glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
+	this->memoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
 
 	/*	Draw Screen Space Shadowing.	*/
 	{
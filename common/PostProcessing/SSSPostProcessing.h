@@ -50,6 +50,6 @@ namespace glsample {
 
 		unsigned int world_position_sampler = 0;
 		// int localWorkGroupSize[3];
-		int vao;
+		unsigned int vao = 0;
 	};
 } // namespace glsample
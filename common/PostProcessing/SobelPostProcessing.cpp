@@ -12,6 +12,8 @@ SobelProcessing::SobelProcessing() {
 	this->setName("Sobel Edge Detection");
 	this->addRequireBuffer(GBuffer::Color);
 	this->addRequireBuffer(GBuffer::IntermediateTarget);
+	this->addWriteBuffer(GBuffer::Color, BufferAccess::Image);
+	this->addWriteBuffer(GBuffer::IntermediateTarget, BufferAccess::Image);
 }
 
 SobelProcessing::~SobelProcessing() {
@@ -60,10 +62,7 @@ void SobelProcessing::render(glsample::FrameBuffer *framebuffer, unsigned int so
 
 	GLint width = 0;
 	GLint height = 0;
-
-	glBindTexture(GL_TEXTURE_2D, source_texture);
-	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
-	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+	this->getRenderSize(source_texture, width, height);
 
 	glUseProgram(this->sobel_program);
 
@@ -82,7 +81,7 @@ void SobelProcessing::render(glsample::FrameBuffer *framebuffer, unsigned int so
 	}
 	glUseProgram(0);
 
-	glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
+	this->memoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
 
 	/*	Swap buffers.	(ping pong)	*/
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + 0, GL_TEXTURE_2D, framebuffer->attachments[1], 0);
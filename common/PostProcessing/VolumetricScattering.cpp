@@ -13,6 +13,8 @@ VolumetricScatteringPostProcessing::VolumetricScatteringPostProcessing() {
 	this->setName("VolumetriccScattering");
 	this->addRequireBuffer(GBuffer::Color);
 	this->addRequireBuffer(GBuffer::Depth);
+	this->addWriteBuffer(GBuffer::Color, BufferAccess::Attachment);
+	this->addWriteBuffer(GBuffer::IntermediateTarget, BufferAccess::Attachment);
 }
 
 VolumetricScatteringPostProcessing::~VolumetricScatteringPostProcessing() {
@@ -23,6 +25,10 @@ VolumetricScatteringPostProcessing::~VolumetricScatteringPostProcessing() {
 	if (this->downsample_compute_program >= 0) {
 		glDeleteProgram(this->downsample_compute_program);
 	}
+	if (this->vao > 0) {
+		glDeleteVertexArrays(1, &this->vao);
+		this->vao = 0;
+	}
 }
 
 void VolumetricScatteringPostProcessing::initialize(fragcore::IFileSystem *filesystem) {
@@ -114,7 +120,7 @@ void VolumetricScatteringPostProcessing::draw(
 
 		glBindVertexArray(0);
 
-		glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
+		this->memoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
 
 		/*	Swap buffers.	*/
 		framebuffer->attachments[0] = target_texture;
@@ -0,0 +1,229 @@
+#include "Profiler.h"
+#include "IOUtil.h"
+#include <Exception.hpp>
+#include <GL/glew.h>
+#include <algorithm>
+#include <chrono>
+#include <fmt/core.h>
+#include <fstream>
+
+using namespace glsample;
+
+bool Profiler::enabled = false;
+bool Profiler::frameActive = false;
+std::vector<Profiler::FrameScopes> Profiler::frames;
+size_t Profiler::frameIndex = 0;
+size_t Profiler::currentFrame = 0;
+std::vector<size_t> Profiler::scopeStack;
+Profiler::FrameResult Profiler::resolvedFrame;
+std::vector<uint64_t> Profiler::resolveTimestamps;
+int64_t Profiler::gpuTimeOffset = 0;
+size_t Profiler::traceFirstFrame = 0;
+size_t Profiler::traceFramesRemaining = 0;
+std::vector<Profiler::TraceEvent> Profiler::traceEvents;
+
+void Profiler::setEnabled(const bool enabled) {
+	if (Profiler::frames.empty()) {
+		Profiler::frames.resize(Profiler::nrFramesInFlight);
+	}
+
+	/*	Pending results are dropped, the scopes may be incomplete.	*/
+	if (!enabled) {
+		for (FrameScopes &frameScopes : Profiler::frames) {
+			frameScopes.issued = false;
+		}
+		Profiler::frameActive = false;
+		Profiler::scopeStack.clear();
+		Profiler::traceFramesRemaining = 0;
+	}
+	Profiler::enabled = enabled;
+}
+
+void Profiler::beginFrame(const size_t frame) {
+	Profiler::currentFrame = frame;
+	if (!Profiler::enabled) {
+		return;
+	}
+
+	/*	The oldest frame in the ring was issued nrFramesInFlight - 1 frames ago.	*/
+	Profiler::frameIndex = (Profiler::frameIndex + 1) % Profiler::frames.size();
+	FrameScopes &frameScopes = Profiler::frames[Profiler::frameIndex];
+	if (frameScopes.issued) {
+		Profiler::resolve(frameScopes);
+	}
+
+	frameScopes.scopes.clear();
+	frameScopes.nrUsedQueries = 0;
+	frameScopes.frame = frame;
+	Profiler::scopeStack.clear();
+	Profiler::frameActive = true;
+
+	Profiler::beginScope("Frame");
+}
+
+void Profiler::endFrame() {
+	if (!Profiler::frameActive) {
+		return;
+	}
+
+	/*	Close unbalanced scopes, including the root.	*/
+	while (!Profiler::scopeStack.empty()) {
+		Profiler::endScope();
+	}
+	Profiler::frames[Profiler::frameIndex].issued = true;
+	Profiler::frameActive = false;
+}
+
+void Profiler::pushScope(const std::string_view name) {
+	glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 1, name.size(), name.data());
+	if (Profiler::frameActive) {
+		Profiler::beginScope(name);
+	}
+}
+
+void Profiler::popScope() {
+	/*	The root scope is only closed by the end of the frame.	*/
+	if (Profiler::frameActive && Profiler::scopeStack.size() > 1) {
+		Profiler::endScope();
+	}
+	glPopDebugGroup();
+}
+
+void Profiler::captureTrace(const size_t nrFrames) {
+	if (!Profiler::enabled) {
+		Profiler::setEnabled(true);
+	}
+
+	/*	Offset between the two clocks, GL_TIMESTAMP is the time once the previous commands reach the GPU.	*/
+	GLint64 gpuTime = 0;
+	glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+	Profiler::gpuTimeOffset = Profiler::getCPUTime() - gpuTime;
+
+	Profiler::traceEvents.clear();
+	Profiler::traceFirstFrame = Profiler::currentFrame + 1;
+	Profiler::traceFramesRemaining = nrFrames;
+}
+
+void Profiler::saveTrace(const std::string &path) {
+	std::ofstream file(path, std::ios::trunc);
+	if (!file.is_open()) {
+		throw cxxexcept::RuntimeException("Failed to open trace output {}", path);
+	}
+
+	/*	Complete events, in microseconds. The CPU and GPU are each a thread of their own.	*/
+	file << "{\"traceEvents\": [\n";
+	file << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": 0, \"args\": {\"name\": \"CPU\"}},\n";
+	file << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": 1, \"args\": {\"name\": \"GPU\"}}";
+	for (const TraceEvent &event : Profiler::traceEvents) {
+		file << fmt::format(",\n  {{\"name\": \"{}\", \"cat\": \"{}\", \"ph\": \"X\", \"pid\": 0, \"tid\": {}, "
+							"\"ts\": {:.3f}, \"dur\": {:.3f}}}",
+							glsample::IOUtil::escapeJSON(event.name), event.thread == 0 ? "cpu" : "gpu", event.thread,
+							(double)event.begin / 1000.0, (double)event.duration / 1000.0);
+	}
+	file << "\n], \"displayTimeUnit\": \"ms\"}\n";
+
+	Profiler::traceEvents.clear();
+}
+
+void Profiler::release() {
+	for (FrameScopes &frameScopes : Profiler::frames) {
+		if (!frameScopes.queries.empty()) {
+			glDeleteQueries(frameScopes.queries.size(), frameScopes.queries.data());
+		}
+	}
+	Profiler::frames.clear();
+	Profiler::scopeStack.clear();
+	Profiler::resolvedFrame.scopes.clear();
+	Profiler::resolveTimestamps.clear();
+	Profiler::traceEvents.clear();
+	Profiler::traceFramesRemaining = 0;
+	Profiler::frameActive = false;
+	Profiler::enabled = false;
+}
+
+void Profiler::beginScope(const std::string_view name) {
+	FrameScopes &frameScopes = Profiler::frames[Profiler::frameIndex];
+
+	Scope scope{};
+	scope.name = name;
+	scope.depth = Profiler::scopeStack.size();
+	scope.cpuBegin = Profiler::getCPUTime();
+	scope.beginQuery = Profiler::nextQuery(frameScopes);
+	glQueryCounter(frameScopes.queries[scope.beginQuery], GL_TIMESTAMP);
+
+	Profiler::scopeStack.push_back(frameScopes.scopes.size());
+	frameScopes.scopes.push_back(std::move(scope));
+}
+
+void Profiler::endScope() {
+	FrameScopes &frameScopes = Profiler::frames[Profiler::frameIndex];
+
+	Scope &scope = frameScopes.scopes[Profiler::scopeStack.back()];
+	Profiler::scopeStack.pop_back();
+
+	scope.endQuery = Profiler::nextQuery(frameScopes);
+	glQueryCounter(frameScopes.queries[scope.endQuery], GL_TIMESTAMP);
+	scope.cpuEnd = Profiler::getCPUTime();
+}
+
+unsigned int Profiler::nextQuery(FrameScopes &frameScopes) {
+	/*	Grow the query pool of the frame, the queries are reused by the following frames.	*/
+	if (frameScopes.nrUsedQueries == frameScopes.queries.size()) {
+		const size_t previousSize = frameScopes.queries.size();
+		frameScopes.queries.resize(std::max<size_t>(64, previousSize * 2));
+		glGenQueries(frameScopes.queries.size() - previousSize, &frameScopes.queries[previousSize]);
+	}
+	return frameScopes.nrUsedQueries++;
+}
+
+void Profiler::resolve(FrameScopes &frameScopes) {
+	frameScopes.issued = false;
+	if (frameScopes.scopes.empty()) {
+		return;
+	}
+
+	/*	Only blocks if the GPU is more than nrFramesInFlight - 1 frames behind.	*/
+	std::vector<uint64_t> &timestamps = Profiler::resolveTimestamps;
+	timestamps.resize(frameScopes.nrUsedQueries);
+	for (size_t query_index = 0; query_index < timestamps.size(); query_index++) {
+		glGetQueryObjectui64v(frameScopes.queries[query_index], GL_QUERY_RESULT, &timestamps[query_index]);
+	}
+
+	const Scope &root = frameScopes.scopes.front();
+	const int64_t cpuOrigin = root.cpuBegin;
+	const GLuint64 gpuOrigin = timestamps[root.beginQuery];
+
+	const bool trace = Profiler::traceFramesRemaining > 0 && frameScopes.frame >= Profiler::traceFirstFrame;
+
+	/*	Results assigned in place, the names reuse the storage of the previous frame.	*/
+	Profiler::resolvedFrame.frame = frameScopes.frame;
+	Profiler::resolvedFrame.scopes.resize(frameScopes.scopes.size());
+	for (size_t scope_index = 0; scope_index < frameScopes.scopes.size(); scope_index++) {
+		const Scope &scope = frameScopes.scopes[scope_index];
+		const GLuint64 gpuBegin = timestamps[scope.beginQuery];
+		const GLuint64 gpuEnd = timestamps[scope.endQuery];
+
+		ScopeResult &result = Profiler::resolvedFrame.scopes[scope_index];
+		result.name = scope.name;
+		result.depth = scope.depth;
+		result.cpuBegin = (double)(scope.cpuBegin - cpuOrigin) / 1.0e6;
+		result.cpuEnd = (double)(scope.cpuEnd - cpuOrigin) / 1.0e6;
+		result.gpuBegin = (double)(int64_t)(gpuBegin - gpuOrigin) / 1.0e6;
+		result.gpuEnd = (double)(int64_t)(gpuEnd - gpuOrigin) / 1.0e6;
+
+		if (trace) {
+			Profiler::traceEvents.push_back({scope.name, 0, scope.cpuBegin, scope.cpuEnd - scope.cpuBegin});
+			Profiler::traceEvents.push_back({scope.name, 1, (int64_t)gpuBegin + Profiler::gpuTimeOffset,
+											 (int64_t)(gpuEnd - gpuBegin)});
+		}
+	}
+
+	if (trace) {
+		Profiler::traceFramesRemaining--;
+	}
+}
+
+int64_t Profiler::getCPUTime() noexcept {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+		.count();
+}
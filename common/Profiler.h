@@ -0,0 +1,153 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "FragDef.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace glsample {
+
+	/**
+	 * @brief Hierarchical CPU and GPU timing of the debug group scopes of each frame.
+	 *
+	 * Each scope pushes a debug group, and while enabled a GL_TIMESTAMP query and a CPU timestamp at both ends.
+	 * The queries of a frame are resolved when its slot in the ring is reused, nrFramesInFlight - 1 frames
+	 * later, so the GPU rarely has to be waited on. Only to be used from the render thread.
+	 */
+	class FVDECLSPEC Profiler {
+	  public:
+		using ScopeResult = struct profile_scope_result_t {
+			std::string name;
+			unsigned int depth;
+			/*	Milliseconds since the beginning of the frame, on each timeline.	*/
+			double cpuBegin;
+			double cpuEnd;
+			double gpuBegin;
+			double gpuEnd;
+		};
+
+		using FrameResult = struct profile_frame_result_t {
+			size_t frame = 0;
+			/*	Root scope first, followed by the scopes in the order they began.	*/
+			std::vector<ScopeResult> scopes;
+		};
+
+		static void setEnabled(const bool enabled);
+		static bool isEnabled() noexcept { return Profiler::enabled; }
+
+		static void beginFrame(const size_t frame);
+		static void endFrame();
+
+		/**
+		 * @brief Push a debug group, timed while the profiler is enabled.
+		 */
+		static void pushScope(const std::string_view name);
+		static void popScope();
+
+		/**
+		 * @brief Latest frame with all its query results available.
+		 */
+		static const FrameResult &getResolvedFrame() noexcept { return Profiler::resolvedFrame; }
+
+		/**
+		 * @brief Record the next number of frames as trace events.
+		 */
+		static void captureTrace(const size_t nrFrames);
+		static bool isCapturingTrace() noexcept { return Profiler::traceFramesRemaining > 0; }
+		static bool hasTrace() noexcept { return !Profiler::isCapturingTrace() && !Profiler::traceEvents.empty(); }
+
+		/**
+		 * @brief Write the captured trace in the Chrome trace event format, and clear it.
+		 */
+		static void saveTrace(const std::string &path);
+
+		/**
+		 * @brief Delete the queries, requires the OpenGL context to still be current.
+		 */
+		static void release();
+
+	  private:
+		using Scope = struct profile_scope_t {
+			std::string name;
+			unsigned int depth;
+			int64_t cpuBegin;
+			int64_t cpuEnd;
+			/*	Index of the queries in the frame query pool.	*/
+			unsigned int beginQuery;
+			unsigned int endQuery;
+		};
+
+		using FrameScopes = struct profile_frame_scopes_t {
+			std::vector<Scope> scopes;
+			std::vector<unsigned int> queries;
+			size_t nrUsedQueries = 0;
+			size_t frame = 0;
+			bool issued = false;
+		};
+
+		using TraceEvent = struct profile_trace_event_t {
+			std::string name;
+			unsigned int thread;
+			int64_t begin;
+			int64_t duration;
+		};
+
+		static void beginScope(const std::string_view name);
+		static void endScope();
+		static unsigned int nextQuery(FrameScopes &frameScopes);
+		static void resolve(FrameScopes &frameScopes);
+		static int64_t getCPUTime() noexcept;
+
+		static const size_t nrFramesInFlight = 4;
+
+		static bool enabled;
+		static bool frameActive;
+		static std::vector<FrameScopes> frames;
+		static size_t frameIndex;
+		static size_t currentFrame;
+		static std::vector<size_t> scopeStack;
+		static FrameResult resolvedFrame;
+
+		/*	Query results of the resolved frame, reused between frames.	*/
+		static std::vector<uint64_t> resolveTimestamps;
+
+		/*	Nanoseconds, the GPU timestamps are moved to the CPU timeline by the calibrated offset.	*/
+		static int64_t gpuTimeOffset;
+		static size_t traceFirstFrame;
+		static size_t traceFramesRemaining;
+		static std::vector<TraceEvent> traceEvents;
+	};
+
+	/**
+	 * @brief Profiler scope for the lifetime of the object.
+	 */
+	class FVDECLSPEC ProfileScope {
+	  public:
+		ProfileScope(const std::string_view name) { Profiler::pushScope(name); }
+		ProfileScope(const ProfileScope &) = delete;
+		ProfileScope &operator=(const ProfileScope &) = delete;
+		~ProfileScope() { Profiler::popScope(); }
+	};
+
+} // namespace glsample
+
+#define GLSAMPLE_PROFILE_CONCAT_INNER(a, b) a##b
+#define GLSAMPLE_PROFILE_CONCAT(a, b) GLSAMPLE_PROFILE_CONCAT_INNER(a, b)
+/*	Debug group and profiler scope until the end of the enclosing block.	*/
+#define GLSAMPLE_PROFILE_SCOPE(name)                                                                                   \
+	const glsample::ProfileScope GLSAMPLE_PROFILE_CONCAT(profile_scope_, __LINE__) { name }
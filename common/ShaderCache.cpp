@@ -0,0 +1,218 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#include "ShaderCache.h"
+#include "Util/Hash.h"
+#include <GL/glew.h>
+#include <GLHelper.h>
+#include <cstring>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace fs = std::filesystem;
+using namespace glsample;
+
+std::string ShaderCache::cacheDirectory;
+std::atomic<size_t> ShaderCache::programHits{0};
+std::atomic<size_t> ShaderCache::programMisses{0};
+std::atomic<size_t> ShaderCache::sourceHits{0};
+std::atomic<size_t> ShaderCache::sourceMisses{0};
+
+/*	Bump whenever the layout of the cache entries changes.	*/
+static const uint32_t shader_cache_version = 1;
+static const uint32_t shader_cache_magic = 0x43534C47; /*	GLSC	*/
+
+using ProgramBinaryHeader = struct program_binary_header_t {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t format;
+	uint32_t size;
+};
+
+static inline uint64_t hashString(const GLubyte *str, const uint64_t hash) noexcept {
+	if (str == nullptr) {
+		return hash;
+	}
+	return hashBytes(str, std::strlen(reinterpret_cast<const char *>(str)), hash);
+}
+
+void ShaderCache::setCacheDirectory(const std::string &directory) { ShaderCache::cacheDirectory = directory; }
+
+ShaderCache::CacheKey
+ShaderCache::computeStageKey(const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
+							 const std::vector<uint32_t> &spirv) noexcept {
+
+	const uint32_t target = static_cast<uint32_t>(compilerOptions.target);
+	const uint32_t glslVersion = static_cast<uint32_t>(compilerOptions.glslVersion);
+
+	uint64_t hash = hashBytes(&shader_cache_version, sizeof(shader_cache_version));
+	hash = hashBytes(&target, sizeof(target), hash);
+	hash = hashBytes(&glslVersion, sizeof(glslVersion), hash);
+	return hashBytes(spirv.data(), spirv.size() * sizeof(spirv[0]), hash);
+}
+
+ShaderCache::CacheKey ShaderCache::computeProgramKey(const std::vector<CacheKey> &stageKeys) {
+
+	uint64_t hash = hashBytes(stageKeys.data(), stageKeys.size() * sizeof(stageKeys[0]));
+
+	/*	Program binaries are only valid for the same driver.	*/
+	hash = hashString(glGetString(GL_VENDOR), hash);
+	hash = hashString(glGetString(GL_RENDERER), hash);
+	hash = hashString(glGetString(GL_VERSION), hash);
+
+	return hash;
+}
+
+std::vector<char> ShaderCache::convertSPIRV(const std::vector<uint32_t> &spirv,
+											const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions) {
+
+	if (!ShaderCache::isEnabled()) {
+		return fragcore::ShaderCompiler::convertSPIRV(spirv, compilerOptions);
+	}
+
+	const std::string path = ShaderCache::getEntryPath(ShaderCache::computeStageKey(compilerOptions, spirv), "glsl");
+
+	std::vector<char> source;
+	if (ShaderCache::readEntry(path, source)) {
+		ShaderCache::sourceHits++;
+		return source;
+	}
+	ShaderCache::sourceMisses++;
+
+	source = fragcore::ShaderCompiler::convertSPIRV(spirv, compilerOptions);
+	ShaderCache::writeEntry(path, source.data(), source.size());
+
+	return source;
+}
+
+int ShaderCache::loadProgram(const CacheKey key) {
+
+	if (!ShaderCache::isEnabled() || !glProgramBinary) {
+		return 0;
+	}
+
+	std::vector<char> data;
+	if (!ShaderCache::readEntry(ShaderCache::getEntryPath(key, "bin"), data) ||
+		data.size() < sizeof(ProgramBinaryHeader)) {
+		ShaderCache::programMisses++;
+		return 0;
+	}
+
+	ProgramBinaryHeader header;
+	std::memcpy(&header, data.data(), sizeof(header));
+
+	if (header.magic != shader_cache_magic || header.version != shader_cache_version ||
+		header.size != data.size() - sizeof(header)) {
+		ShaderCache::programMisses++;
+		return 0;
+	}
+
+	const int program = glCreateProgram();
+	glProgramBinary(program, header.format, data.data() + sizeof(header), header.size);
+
+	/*	Driver is allowed to reject the binary at any time, e.g after driver update.	*/
+	int lstatus = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &lstatus);
+	if (lstatus != GL_TRUE) {
+		glDeleteProgram(program);
+		fragcore::resetErrorFlag();
+
+		ShaderCache::programMisses++;
+		return 0;
+	}
+
+	ShaderCache::programHits++;
+	return program;
+}
+
+void ShaderCache::storeProgram(const CacheKey key, const int program) {
+
+	if (!ShaderCache::isEnabled() || !glGetProgramBinary) {
+		return;
+	}
+
+	int binaryLength = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+	if (binaryLength <= 0) {
+		return;
+	}
+
+	std::vector<char> data(sizeof(ProgramBinaryHeader) + binaryLength);
+
+	GLenum format = 0;
+	GLsizei length = 0;
+	glGetProgramBinary(program, binaryLength, &length, &format, data.data() + sizeof(ProgramBinaryHeader));
+	fragcore::checkError();
+
+	const ProgramBinaryHeader header = {shader_cache_magic, shader_cache_version, format,
+										static_cast<uint32_t>(length)};
+	std::memcpy(data.data(), &header, sizeof(header));
+
+	ShaderCache::writeEntry(ShaderCache::getEntryPath(key, "bin"), data.data(), sizeof(header) + length);
+}
+
+std::string ShaderCache::getEntryPath(const CacheKey key, const char *extension) {
+	return fmt::format("{}/{:016x}.{}", ShaderCache::cacheDirectory, key, extension);
+}
+
+bool ShaderCache::readEntry(const std::string &path, std::vector<char> &data) {
+
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	const std::streamsize size = file.tellg();
+	if (size <= 0) {
+		return false;
+	}
+
+	data.resize(static_cast<size_t>(size));
+	file.seekg(0, std::ios::beg);
+	return static_cast<bool>(file.read(data.data(), size));
+}
+
+void ShaderCache::writeEntry(const std::string &path, const void *data, const size_t size) {
+
+	std::error_code error;
+	fs::create_directories(ShaderCache::cacheDirectory, error);
+	if (error) {
+		return;
+	}
+
+	/*	Write to temporary file first, to prevent other processes from reading partial entries.	*/
+	const std::string tmpPath =
+		fmt::format("{}.{}.tmp", path, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+	{
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			return;
+		}
+		file.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+		if (!file) {
+			file.close();
+			fs::remove(tmpPath, error);
+			return;
+		}
+	}
+
+	fs::rename(tmpPath, path, error);
+	if (error) {
+		fs::remove(tmpPath, error);
+	}
+}
@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include <ShaderCompiler.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace glsample {
+
+	/**
+	 * @brief On-disk cache of cross-compiled GLSL and linked program binaries.
+	 *
+	 * GLSL entries are keyed on the SPIR-V bytes and the conversion options. Program entries are
+	 * additionally keyed on the driver vendor, renderer and version, since program binaries are
+	 * only valid for the driver that produced them.
+	 */
+	class FVDECLSPEC ShaderCache {
+	  public:
+		using CacheKey = uint64_t;
+
+		/**
+		 * @brief Set the directory to store the cache entries, an empty path disable the cache.
+		 */
+		static void setCacheDirectory(const std::string &directory);
+		static const std::string &getCacheDirectory() noexcept { return ShaderCache::cacheDirectory; }
+
+		static bool isEnabled() noexcept { return !ShaderCache::cacheDirectory.empty(); }
+
+		/**
+		 * @brief Compute cache key of a single shader stage.
+		 */
+		static CacheKey computeStageKey(const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
+										const std::vector<uint32_t> &spirv) noexcept;
+
+		/**
+		 * @brief Compute cache key of a program, from all its stage keys and the current driver.
+		 * Requires a current OpenGL context.
+		 */
+		static CacheKey computeProgramKey(const std::vector<CacheKey> &stageKeys);
+
+		/**
+		 * @brief Convert the SPIR-V to the target language, reusing the cached conversion if any.
+		 */
+		static std::vector<char> convertSPIRV(const std::vector<uint32_t> &spirv,
+											  const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions);
+
+		/**
+		 * @brief Create program from the cached program binary.
+		 *
+		 * @return program object, 0 if not cached or rejected by the driver.
+		 */
+		static int loadProgram(const CacheKey key);
+
+		/**
+		 * @brief Store the linked program binary.
+		 */
+		static void storeProgram(const CacheKey key, const int program);
+
+		static size_t getProgramHitCount() noexcept { return ShaderCache::programHits; }
+		static size_t getProgramMissCount() noexcept { return ShaderCache::programMisses; }
+		static size_t getSourceHitCount() noexcept { return ShaderCache::sourceHits; }
+		static size_t getSourceMissCount() noexcept { return ShaderCache::sourceMisses; }
+
+	  private:
+		static std::string getEntryPath(const CacheKey key, const char *extension);
+		static bool readEntry(const std::string &path, std::vector<char> &data);
+		static void writeEntry(const std::string &path, const void *data, const size_t size);
+
+		static std::string cacheDirectory;
+		static std::atomic<size_t> programHits;
+		static std::atomic<size_t> programMisses;
+		static std::atomic<size_t> sourceHits;
+		static std::atomic<size_t> sourceMisses;
+	};
+} // namespace glsample
@@ -14,9 +14,11 @@
  * all copies or substantial portions of the Software.
  */
 #include "ShaderLoader.h"
+#include "Util/TaskParallel.h"
 #include <GL/glew.h>
 #include <GLHelper.h>
 #include <GLRendererInterface.h>
+#include <thread>
 
 using namespace glsample;
 
@@ -31,49 +33,45 @@ int ShaderLoader::loadGraphicProgram(const fragcore::ShaderCompiler::CompilerCon
 	} else {
 	}
 
+	/*	Reuse the linked program from previous run, if any.	*/
+	const ShaderCache::CacheKey programKey =
+		ShaderLoader::computeProgramKey(compilerOptions, {vertex, fragment, geometry, tessela1ion_control,
+														  tesselation_evolution});
+	const int cachedProgram = ShaderCache::loadProgram(programKey);
+	if (cachedProgram > 0) {
+		return cachedProgram;
+	}
+
 	std::vector<char> vertex_source;
 	if (vertex) {
-
-		const std::vector<char> vertex_source_code = fragcore::ShaderCompiler::convertSPIRV(*vertex, compilerOptions);
-		vertex_source.insert(vertex_source.end(), vertex_source_code.begin(), vertex_source_code.end());
+		vertex_source = ShaderCache::convertSPIRV(*vertex, compilerOptions);
 	}
 
 	std::vector<char> fragment_source;
 	if (fragment) {
-
-		const std::vector<char> fragment_source_code =
-			fragcore::ShaderCompiler::convertSPIRV(*fragment, compilerOptions);
-		fragment_source.insert(fragment_source.end(), fragment_source_code.begin(), fragment_source_code.end());
+		fragment_source = ShaderCache::convertSPIRV(*fragment, compilerOptions);
 	}
 
 	std::vector<char> geometry_source;
 	if (geometry) {
-
-		const std::vector<char> geometry_source_code =
-			fragcore::ShaderCompiler::convertSPIRV(*geometry, compilerOptions);
-		geometry_source.insert(geometry_source.end(), geometry_source_code.begin(), geometry_source_code.end());
+		geometry_source = ShaderCache::convertSPIRV(*geometry, compilerOptions);
 	}
 
 	std::vector<char> tesse_control_source;
 	if (tessela1ion_control) {
-
-		const std::vector<char> geometry_source_code =
-			fragcore::ShaderCompiler::convertSPIRV(*tessela1ion_control, compilerOptions);
-		tesse_control_source.insert(tesse_control_source.end(), geometry_source_code.begin(),
-									geometry_source_code.end());
+		tesse_control_source = ShaderCache::convertSPIRV(*tessela1ion_control, compilerOptions);
 	}
 
 	std::vector<char> tesse_evolution_source;
 	if (tesselation_evolution) {
-
-		const std::vector<char> geometry_source_code =
-			fragcore::ShaderCompiler::convertSPIRV(*tesselation_evolution, compilerOptions);
-		tesse_evolution_source.insert(tesse_evolution_source.end(), geometry_source_code.begin(),
-									  geometry_source_code.end());
+		tesse_evolution_source = ShaderCache::convertSPIRV(*tesselation_evolution, compilerOptions);
 	}
 
-	return ShaderLoader::loadGraphicProgram(&vertex_source, &fragment_source, &geometry_source, &tesse_control_source,
-											&tesse_evolution_source);
+	const int program = ShaderLoader::loadGraphicProgram(&vertex_source, &fragment_source, &geometry_source,
+														 &tesse_control_source, &tesse_evolution_source);
+	ShaderCache::storeProgram(programKey, program);
+
+	return program;
 }
 
 int ShaderLoader::loadGraphicProgram(const std::vector<char> *vertex, const std::vector<char> *fragment,
@@ -124,11 +122,10 @@ int ShaderLoader::loadGraphicProgram(const std::vector<char> *vertex, const std:
 		fragcore::checkError();
 	}
 
-	/*	Default vertex attribute for now.TODO: determine it can be pass on elsewhere	*/
-	glBindAttribLocation(program, 0, "Vertex");
-	glBindAttribLocation(program, 1, "TextureCoord");
-	glBindAttribLocation(program, 2, "Normal");
-	glBindAttribLocation(program, 3, "Tangent");
+	ShaderLoader::bindDefaultAttributeLocations(program);
+
+	/*	Allow the linked program to be stored in the shader cache.	*/
+	glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
 	glLinkProgram(program);
 	fragcore::checkError();
@@ -194,14 +191,21 @@ int ShaderLoader::loadComputeProgram(const fragcore::ShaderCompiler::CompilerCon
 	} else {
 	}
 
-	if (compute_binary) {
+	/*	Reuse the linked program from previous run, if any.	*/
+	const ShaderCache::CacheKey programKey = ShaderLoader::computeProgramKey(compilerOptions, {compute_binary});
+	const int cachedProgram = ShaderCache::loadProgram(programKey);
+	if (cachedProgram > 0) {
+		return cachedProgram;
+	}
 
-		const std::vector<char> vertex_source_code =
-			fragcore::ShaderCompiler::convertSPIRV(*compute_binary, compilerOptions);
-		compute_source.insert(compute_source.end(), vertex_source_code.begin(), vertex_source_code.end());
+	if (compute_binary) {
+		compute_source = ShaderCache::convertSPIRV(*compute_binary, compilerOptions);
 	}
 
-	return ShaderLoader::loadComputeProgram({&compute_source});
+	const int program = ShaderLoader::loadComputeProgram({&compute_source});
+	ShaderCache::storeProgram(programKey, program);
+
+	return program;
 }
 
 int ShaderLoader::loadComputeProgram(const std::vector<const std::vector<char> *> &computePaths) {
@@ -218,6 +222,9 @@ int ShaderLoader::loadComputeProgram(const std::vector<const std::vector<char> *
 	glAttachShader(program, shader_compute);
 	fragcore::checkError();
 
+	/*	Allow the linked program to be stored in the shader cache.	*/
+	glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 	/*	*/
 	glLinkProgram(program);
 	fragcore::checkError();
@@ -246,29 +253,34 @@ int ShaderLoader::loadComputeProgram(const std::vector<const std::vector<char> *
 int ShaderLoader::loadMeshProgram(const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
 								  const std::vector<uint32_t> *meshs, const std::vector<uint32_t> *tasks,
 								  const std::vector<uint32_t> *fragment) {
+
+	/*	Reuse the linked program from previous run, if any.	*/
+	const ShaderCache::CacheKey programKey =
+		ShaderLoader::computeProgramKey(compilerOptions, {meshs, tasks, fragment});
+	const int cachedProgram = ShaderCache::loadProgram(programKey);
+	if (cachedProgram > 0) {
+		return cachedProgram;
+	}
+
 	std::vector<char> mesh_source;
 	if (meshs) {
-
-		const std::vector<char> mesh_source_code = fragcore::ShaderCompiler::convertSPIRV(*meshs, compilerOptions);
-		mesh_source.insert(mesh_source.end(), mesh_source_code.begin(), mesh_source_code.end());
+		mesh_source = ShaderCache::convertSPIRV(*meshs, compilerOptions);
 	}
 
 	std::vector<char> task_source;
 	if (tasks) {
-
-		const std::vector<char> task_source_code = fragcore::ShaderCompiler::convertSPIRV(*tasks, compilerOptions);
-		task_source.insert(task_source.end(), task_source_code.begin(), task_source_code.end());
+		task_source = ShaderCache::convertSPIRV(*tasks, compilerOptions);
 	}
 
 	std::vector<char> fragment_source;
 	if (fragment) {
-
-		const std::vector<char> fragment_source_code =
-			fragcore::ShaderCompiler::convertSPIRV(*fragment, compilerOptions);
-		fragment_source.insert(fragment_source.end(), fragment_source_code.begin(), fragment_source_code.end());
+		fragment_source = ShaderCache::convertSPIRV(*fragment, compilerOptions);
 	}
 
-	return ShaderLoader::loadMeshProgram(&mesh_source, &task_source, &fragment_source);
+	const int program = ShaderLoader::loadMeshProgram(&mesh_source, &task_source, &fragment_source);
+	ShaderCache::storeProgram(programKey, program);
+
+	return program;
 }
 
 int ShaderLoader::loadMeshProgram(const std::vector<char> *meshs, const std::vector<char> *tasks,
@@ -298,6 +310,9 @@ int ShaderLoader::loadMeshProgram(const std::vector<char> *meshs, const std::vec
 	glAttachShader(program, shader_frag);
 	fragcore::checkError();
 
+	/*	Allow the linked program to be stored in the shader cache.	*/
+	glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 	/*	*/
 	glLinkProgram(program);
 	fragcore::checkError();
@@ -329,6 +344,18 @@ int ShaderLoader::loadMeshProgram(const std::vector<char> *meshs, const std::vec
 	return program;
 }
 
+ShaderCache::CacheKey
+ShaderLoader::computeProgramKey(const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
+								const std::vector<const std::vector<uint32_t> *> &stages) {
+	std::vector<ShaderCache::CacheKey> stageKeys(stages.size(), 0);
+	for (size_t i = 0; i < stages.size(); i++) {
+		if (stages[i]) {
+			stageKeys[i] = ShaderCache::computeStageKey(compilerOptions, *stages[i]);
+		}
+	}
+	return ShaderCache::computeProgramKey(stageKeys);
+}
+
 static void checkShaderError(int shader) {
 
 	GLint cstatus = 0;
@@ -350,8 +377,25 @@ static void checkShaderError(int shader) {
 	}
 }
 
+void ShaderLoader::bindDefaultAttributeLocations(const int program) {
+	/*	Default vertex attribute for now.TODO: determine it can be pass on elsewhere	*/
+	glBindAttribLocation(program, 0, "Vertex");
+	glBindAttribLocation(program, 1, "TextureCoord");
+	glBindAttribLocation(program, 2, "Normal");
+	glBindAttribLocation(program, 3, "Tangent");
+}
+
 int ShaderLoader::loadShader(const std::vector<char> &source, const int type) {
 
+	const int shader = ShaderLoader::compileShader(source, type);
+
+	/*	*/
+	checkShaderError(shader);
+	return shader;
+}
+
+int ShaderLoader::compileShader(const std::vector<char> &source, const int type) {
+
 	/*	*/
 	const unsigned int spirv_magic_number = 0x07230203;
 	const unsigned int magic_number = (source[3] << 24) | (source[2] << 16) | (source[1] << 8) | source[0];
@@ -377,7 +421,264 @@ int ShaderLoader::loadShader(const std::vector<char> &source, const int type) {
 		fragcore::checkError();
 	}
 
-	/*	*/
-	checkShaderError(shader);
 	return shader;
 }
+
+ShaderProgramBatch::~ShaderProgramBatch() {
+	/*	Release programs that was never retrieved.	*/
+	for (ProgramEntry &entry : this->programs) {
+		if (entry.retrieved) {
+			continue;
+		}
+		for (const int shader : entry.shaders) {
+			if (shader > 0) {
+				glDeleteShader(shader);
+			}
+		}
+		if (entry.program > 0) {
+			glDeleteProgram(entry.program);
+		}
+	}
+}
+
+size_t ShaderProgramBatch::addGraphicProgram(const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
+											 const std::vector<uint32_t> *vertex,
+											 const std::vector<uint32_t> *fragment,
+											 const std::vector<uint32_t> *geometry,
+											 const std::vector<uint32_t> *tesselationc,
+											 const std::vector<uint32_t> *tesselatione) {
+	return this->addProgram(ProgramType::Graphic, compilerOptions,
+							{vertex, fragment, geometry, tesselationc, tesselatione});
+}
+
+size_t ShaderProgramBatch::addComputeProgram(const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
+											 const std::vector<uint32_t> *compute) {
+	return this->addProgram(ProgramType::Compute, compilerOptions, {compute});
+}
+
+size_t ShaderProgramBatch::addMeshProgram(const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
+										  const std::vector<uint32_t> *meshs, const std::vector<uint32_t> *tasks,
+										  const std::vector<uint32_t> *fragment) {
+	return this->addProgram(ProgramType::Mesh, compilerOptions, {meshs, tasks, fragment});
+}
+
+size_t ShaderProgramBatch::addProgram(const ProgramType type,
+									  const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
+									  const std::initializer_list<const std::vector<uint32_t> *> &binaries) {
+	if (this->submitted) {
+		throw cxxexcept::RuntimeException("Can not add program to an already submitted batch");
+	}
+
+	ProgramEntry entry;
+	entry.type = type;
+	entry.compilerOptions = compilerOptions;
+	std::copy(binaries.begin(), binaries.end(), entry.binaries.begin());
+
+	this->programs.push_back(entry);
+	return this->programs.size() - 1;
+}
+
+const std::array<int, ShaderProgramBatch::maxStages> &
+ShaderProgramBatch::getStageTypes(const ProgramType type) noexcept {
+	static const std::array<int, maxStages> graphicStages = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER,
+															 GL_TESS_CONTROL_SHADER, GL_TESS_EVALUATION_SHADER};
+	static const std::array<int, maxStages> computeStages = {GL_COMPUTE_SHADER, 0, 0, 0, 0};
+	static const std::array<int, maxStages> meshStages = {GL_MESH_SHADER_NV, GL_TASK_SHADER_NV, GL_FRAGMENT_SHADER, 0,
+														  0};
+	switch (type) {
+	case ProgramType::Compute:
+		return computeStages;
+	case ProgramType::Mesh:
+		return meshStages;
+	case ProgramType::Graphic:
+	default:
+		return graphicStages;
+	}
+}
+
+void ShaderProgramBatch::submit() {
+	if (this->submitted) {
+		return;
+	}
+	this->submitted = true;
+
+	/*	Reuse the linked programs from previous run, if any.	*/
+	std::vector<std::pair<size_t, size_t>> pendingStages;
+	for (size_t program_index = 0; program_index < this->programs.size(); program_index++) {
+		ProgramEntry &entry = this->programs[program_index];
+
+		entry.key = ShaderLoader::computeProgramKey(
+			entry.compilerOptions, std::vector<const std::vector<uint32_t> *>(entry.binaries.begin(),
+																			   entry.binaries.end()));
+		entry.program = ShaderCache::loadProgram(entry.key);
+		entry.cached = entry.program > 0;
+
+		if (!entry.cached) {
+			for (size_t stage_index = 0; stage_index < maxStages; stage_index++) {
+				if (entry.binaries[stage_index]) {
+					pendingStages.emplace_back(program_index, stage_index);
+				}
+			}
+		}
+	}
+
+	/*	Cross compile all stages in parallel.	*/
+	parallelFor(pendingStages.size(), 1, [&](const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			ProgramEntry &entry = this->programs[pendingStages[i].first];
+			const size_t stage_index = pendingStages[i].second;
+			entry.sources[stage_index] =
+				ShaderCache::convertSPIRV(*entry.binaries[stage_index], entry.compilerOptions);
+		}
+	});
+
+	/*	Issue all compile and link commands, without querying any status, which would force the driver to finish.
+	 */
+	fragcore::resetErrorFlag();
+	for (ProgramEntry &entry : this->programs) {
+		if (entry.cached) {
+			continue;
+		}
+
+		entry.program = glCreateProgram();
+		fragcore::checkError();
+
+		const std::array<int, maxStages> &stageTypes = ShaderProgramBatch::getStageTypes(entry.type);
+		for (size_t stage_index = 0; stage_index < maxStages; stage_index++) {
+			if (entry.sources[stage_index].empty()) {
+				continue;
+			}
+
+			entry.shaders[stage_index] =
+				ShaderLoader::compileShader(entry.sources[stage_index], stageTypes[stage_index]);
+			glAttachShader(entry.program, entry.shaders[stage_index]);
+			fragcore::checkError();
+
+			/*	Source no longer needed.	*/
+			entry.sources[stage_index] = std::vector<char>();
+		}
+
+		if (entry.type == ProgramType::Graphic) {
+			ShaderLoader::bindDefaultAttributeLocations(entry.program);
+		}
+
+		/*	Allow the linked program to be stored in the shader cache.	*/
+		glProgramParameteri(entry.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+		glLinkProgram(entry.program);
+		fragcore::checkError();
+	}
+}
+
+bool ShaderProgramBatch::isCompleted(const size_t index) const {
+	const ProgramEntry &entry = this->programs.at(index);
+
+	if (!this->submitted) {
+		return false;
+	}
+	if (entry.cached || entry.linked || entry.program == 0) {
+		return true;
+	}
+	/*	Without the extension, the completion status can not be queried and the status query blocks.	*/
+	if (!GLEW_KHR_parallel_shader_compile && !GLEW_ARB_parallel_shader_compile) {
+		return true;
+	}
+
+	int completed = GL_FALSE;
+	glGetProgramiv(entry.program, GL_COMPLETION_STATUS_KHR, &completed);
+	return completed == GL_TRUE;
+}
+
+bool ShaderProgramBatch::poll() {
+	if (!this->submitted) {
+		return false;
+	}
+
+	bool completed = true;
+	for (size_t index = 0; index < this->programs.size(); index++) {
+		ProgramEntry &entry = this->programs[index];
+		if (entry.cached || entry.linked || entry.program == 0) {
+			continue;
+		}
+		if (!this->isCompleted(index)) {
+			completed = false;
+			continue;
+		}
+
+		/*	Status is available without waiting, failures are reported once the program is requested.	*/
+		int lstatus = 0;
+		glGetProgramiv(entry.program, GL_LINK_STATUS, &lstatus);
+		if (lstatus == GL_TRUE) {
+			this->finalize(entry);
+		}
+	}
+	return completed;
+}
+
+int ShaderProgramBatch::getProgram(const size_t index) {
+	ProgramEntry &entry = this->programs.at(index);
+
+	if (!this->submitted) {
+		this->submit();
+	}
+
+	/*	Finish the other programs while waiting on the driver, rather than blocking on the link status.	*/
+	while (!this->isCompleted(index)) {
+		this->poll();
+		std::this_thread::yield();
+	}
+
+	if (entry.program == 0) {
+		throw cxxexcept::RuntimeException("Program {} failed to link", index);
+	}
+	if (!entry.cached && !entry.linked) {
+		this->finalize(entry);
+	}
+
+	entry.retrieved = true;
+	return entry.program;
+}
+
+void ShaderProgramBatch::finalize(ProgramEntry &entry) {
+
+	int lstatus = 0;
+	glGetProgramiv(entry.program, GL_LINK_STATUS, &lstatus);
+	fragcore::checkError();
+
+	if (lstatus != GL_TRUE) {
+		/*	Include shader errors, since compile status was never checked.	*/
+		for (const int shader : entry.shaders) {
+			if (shader > 0) {
+				checkShaderError(shader);
+			}
+		}
+
+		char log[4096];
+		glGetProgramInfoLog(entry.program, sizeof(log), nullptr, log);
+		fragcore::checkError();
+
+		/*	Release the failed program, so that nothing is left for the batch to leak.	*/
+		for (int &shader : entry.shaders) {
+			if (shader > 0) {
+				glDeleteShader(shader);
+				shader = 0;
+			}
+		}
+		glDeleteProgram(entry.program);
+		entry.program = 0;
+
+		throw cxxexcept::RuntimeException("Failed to link program: {}", log);
+	}
+
+	/*	Remove shader resources not needed after linking.	*/
+	for (int &shader : entry.shaders) {
+		if (shader > 0) {
+			glDetachShader(entry.program, shader);
+			glDeleteShader(shader);
+			shader = 0;
+		}
+	}
+
+	ShaderCache::storeProgram(entry.key, entry.program);
+	entry.linked = true;
+}
@@ -14,8 +14,11 @@
  * all copies or substantial portions of the Software.
  */
 #pragma once
+#include "ShaderCache.h"
 #include <IO/IOUtil.h>
 #include <ShaderCompiler.h>
+#include <array>
+#include <initializer_list>
 
 namespace glsample {
 
@@ -57,6 +60,102 @@ namespace glsample {
 								   const std::vector<char> *fragment);
 
 	  private:
+		friend class ShaderProgramBatch;
+
+		static ShaderCache::CacheKey
+		computeProgramKey(const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
+						  const std::vector<const std::vector<uint32_t> *> &stages);
 		static int loadShader(const std::vector<char> &data, const int type);
+		static int compileShader(const std::vector<char> &data, const int type);
+		static void bindDefaultAttributeLocations(const int program);
+	};
+
+	/**
+	 * @brief Load multiple programs concurrently.
+	 *
+	 * All SPIR-V stages are cross-compiled in parallel on submit, and every program is handed to the
+	 * driver before any status is queried, allowing KHR_parallel_shader_compile to compile them on the
+	 * driver threads. The link status of a program is only queried once the driver reports it completed.
+	 * The SPIR-V binaries must be kept alive until submit has returned.
+	 */
+	class FVDECLSPEC ShaderProgramBatch {
+	  public:
+		ShaderProgramBatch() = default;
+		ShaderProgramBatch(const ShaderProgramBatch &) = delete;
+		ShaderProgramBatch(ShaderProgramBatch &&) = delete;
+		ShaderProgramBatch &operator=(const ShaderProgramBatch &) = delete;
+		ShaderProgramBatch &operator=(ShaderProgramBatch &&) = delete;
+		~ShaderProgramBatch();
+
+		/**
+		 * @brief
+		 *
+		 * @return index of the program within the batch.
+		 */
+		size_t addGraphicProgram(const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
+								 const std::vector<uint32_t> *vertex, const std::vector<uint32_t> *fragment,
+								 const std::vector<uint32_t> *geometry = nullptr,
+								 const std::vector<uint32_t> *tesselationc = nullptr,
+								 const std::vector<uint32_t> *tesselatione = nullptr);
+		size_t addComputeProgram(const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
+								 const std::vector<uint32_t> *compute);
+		size_t addMeshProgram(const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
+							  const std::vector<uint32_t> *meshs, const std::vector<uint32_t> *tasks,
+							  const std::vector<uint32_t> *fragment);
+
+		/**
+		 * @brief Cross-compile all programs and start compiling and linking them.
+		 */
+		void submit();
+
+		/**
+		 * @brief Check without blocking if the driver has finished compiling the program.
+		 */
+		bool isCompleted(const size_t index) const;
+
+		/**
+		 * @brief Finish every program the driver has completed, without blocking.
+		 *
+		 * @return true if all programs are completed.
+		 */
+		bool poll();
+
+		/**
+		 * @brief Get the linked program, polling the completion of the batch until the program is completed.
+		 *
+		 * @throw RuntimeException if the program failed to link.
+		 */
+		int getProgram(const size_t index);
+
+		size_t getNrPrograms() const noexcept { return this->programs.size(); }
+
+	  private:
+		static const size_t maxStages = 5;
+
+		enum class ProgramType : unsigned int { Graphic, Compute, Mesh };
+
+		using ProgramEntry = struct program_entry_t {
+			ProgramType type = ProgramType::Graphic;
+			fragcore::ShaderCompiler::CompilerConvertOption compilerOptions;
+			std::array<const std::vector<uint32_t> *, maxStages> binaries{};
+			std::array<std::vector<char>, maxStages> sources;
+			std::array<int, maxStages> shaders{};
+			ShaderCache::CacheKey key = 0;
+			int program = 0;
+			bool cached = false;
+			bool linked = false;
+			bool retrieved = false;
+		};
+
+		static const std::array<int, maxStages> &getStageTypes(const ProgramType type) noexcept;
+
+		void finalize(ProgramEntry &entry);
+
+		size_t addProgram(const ProgramType type,
+						  const fragcore::ShaderCompiler::CompilerConvertOption &compilerOptions,
+						  const std::initializer_list<const std::vector<uint32_t> *> &binaries);
+
+		std::vector<ProgramEntry> programs;
+		bool submitted = false;
 	};
 } // namespace glsample
\ No newline at end of file
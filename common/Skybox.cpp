@@ -1,6 +1,8 @@
 #include "Skybox.h"
 #include "Common.h"
+#include "FrameRingAllocator.h"
 #include "IOUtil.h"
+#include "Profiler.h"
 #include "imgui.h"
 #include <GL/glew.h>
 #include <ProceduralGeometry.h>
@@ -23,17 +25,6 @@ namespace glsample {
 
 	void Skybox::Init(unsigned int texture, unsigned int program) {
 
-		/*	*/
-		GLint minMapBufferSize = 0;
-		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &minMapBufferSize);
-		this->uniformAlignSize = Math::align<size_t>(sizeof(uniform_buffer_block), (size_t)minMapBufferSize);
-
-		/*	Create uniform buffer.	*/
-		glGenBuffers(1, &this->uniform_buffer);
-		glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-		glBufferData(GL_UNIFORM_BUFFER, this->uniformAlignSize * this->nrUniformBuffer, nullptr, GL_DYNAMIC_DRAW);
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
 		glCreateSamplers(1, &this->skybox_sampler);
 		glSamplerParameteri(this->skybox_sampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glSamplerParameteri(this->skybox_sampler, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -63,18 +54,14 @@ namespace glsample {
 		/*	*/
 		this->uniform_stage_buffer.modelViewProjection = viewProj;
 
-		/*	Update uniform values.	*/
-		glBindBuffer(GL_UNIFORM_BUFFER, this->uniform_buffer);
-		void *uniformPointer =
-			glMapBufferRange(GL_UNIFORM_BUFFER, ((frameIndex + 1) % this->nrUniformBuffer) * this->uniformAlignSize,
-							 this->uniformAlignSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-		memcpy(uniformPointer, &this->uniform_stage_buffer, sizeof(this->uniform_stage_buffer));
-		glUnmapBuffer(GL_UNIFORM_BUFFER);
+		/*	Update uniform values, fenced with the frame.	*/
+		const FrameRingAllocator::Allocation uniform_allocation =
+			FrameRingAllocator::getActive().allocate(this->uniform_stage_buffer);
 
 		{
 
-			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, this->uniform_buffer,
-							  (frameIndex % this->nrUniformBuffer) * this->uniformAlignSize, this->uniformAlignSize);
+			glBindBufferRange(GL_UNIFORM_BUFFER, this->uniform_buffer_binding, uniform_allocation.buffer,
+							  uniform_allocation.offset, uniform_allocation.size);
 
 			/*	Extract current state. to restore afterward rendered the skybox.	*/
 			GLint cullstate = 0, blend = 0, depth_test = 0, depth_func = 0, cull_face_mode = 0;
@@ -87,8 +74,7 @@ namespace glsample {
 			glGetBooleanv(GL_DEPTH_WRITEMASK, &depth_write);
 			glGetBooleanv(GL_MULTISAMPLE, &use_multisample);
 
-			const std::string groupName = "Skybox";
-			glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 1, groupName.length(), groupName.data());
+			Profiler::pushScope("Skybox");
 
 			/*	*/
 			glDisable(GL_MULTISAMPLE); /*	*/
@@ -120,7 +106,7 @@ namespace glsample {
 
 			glBindSampler(0, 0);
 
-			glPopDebugGroup();
+			Profiler::popScope();
 
 			if (cullstate) {
 				glEnable(GL_CULL_FACE);
@@ -146,8 +132,6 @@ namespace glsample {
 			glDepthMask(depth_write);
 			glCullFace(cull_face_mode);
 		}
-
-		this->frameIndex = (this->frameIndex + 1) % this->nrUniformBuffer;
 	}
 
 	void Skybox::RenderImGUI() {
@@ -65,15 +65,10 @@ namespace glsample {
 		MeshObject SkyboxCube;
 		unsigned int skybox_program;
 
-		int frameIndex = 0;
-
 		unsigned int skybox_texture_panoramic;
 		unsigned int skybox_sampler;
 		/*	Uniform buffer.	*/
 		unsigned int uniform_buffer_binding = 0;
-		unsigned int uniform_buffer;
-		const size_t nrUniformBuffer = 3;
-		size_t uniformAlignSize = sizeof(uniform_buffer_block);
 		glm::vec3 rotation;
 		bool isEnabled = true;
 
@@ -0,0 +1,360 @@
+#include "Util/BoundingVolumeHierarchy.h"
+#include "Util/TaskParallel.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+using namespace glsample;
+
+/*	Below this number of items, the culling is not worth splitting across threads.	*/
+static const size_t parallel_cull_min_items = 4096;
+
+/*	Depth of the median split tree is log2(items / leaf size), far from the limit.	*/
+static const size_t max_traversal_depth = 64;
+
+void BoundingVolumeHierarchy::build(const glm::vec3 *mins, const glm::vec3 *maxs, const size_t nrItems) {
+
+	this->clear();
+	if (nrItems == 0) {
+		return;
+	}
+
+	std::vector<glm::vec3> centers(nrItems);
+	this->items.resize(nrItems);
+	this->itemLeaf.resize(nrItems);
+	for (size_t i = 0; i < nrItems; i++) {
+		centers[i] = (mins[i] + maxs[i]) * 0.5f;
+		this->items[i] = static_cast<uint32_t>(i);
+	}
+
+	using BuildTask = struct build_task_t {
+		uint32_t begin;
+		uint32_t end;
+		uint32_t parent;
+		bool right;
+	};
+
+	/*	Nodes are created in depth first order, the left child always directly after its parent.	*/
+	std::vector<BuildTask> stack = {{0, static_cast<uint32_t>(nrItems), 0, false}};
+	this->nodes.reserve((2 * nrItems) / maxLeafSize + 1);
+
+	while (!stack.empty()) {
+		const BuildTask task = stack.back();
+		stack.pop_back();
+
+		const uint32_t node_index = static_cast<uint32_t>(this->nodes.size());
+		BVHNode node = {};
+		node.itemBegin = task.begin;
+		node.itemCount = task.end - task.begin;
+		node.parent = task.parent;
+		this->nodes.push_back(node);
+
+		if (task.right) {
+			this->nodes[task.parent].rightChild = node_index;
+		}
+
+		if (node.itemCount <= maxLeafSize) {
+			for (uint32_t i = task.begin; i < task.end; i++) {
+				this->itemLeaf[this->items[i]] = node_index;
+			}
+			continue;
+		}
+
+		/*	Median split along the longest axis of the item centers.	*/
+		glm::vec3 centerMin = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 centerMax = glm::vec3(-std::numeric_limits<float>::max());
+		for (uint32_t i = task.begin; i < task.end; i++) {
+			centerMin = glm::min(centerMin, centers[this->items[i]]);
+			centerMax = glm::max(centerMax, centers[this->items[i]]);
+		}
+
+		const glm::vec3 extent = centerMax - centerMin;
+		const int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+		const uint32_t middle = task.begin + (task.end - task.begin) / 2;
+		std::nth_element(
+			this->items.begin() + task.begin, this->items.begin() + middle, this->items.begin() + task.end,
+			[&centers, axis](const uint32_t a, const uint32_t b) { return centers[a][axis] < centers[b][axis]; });
+
+		stack.push_back({middle, task.end, node_index, true});
+		stack.push_back({task.begin, middle, node_index, false});
+	}
+
+	/*	Structure of arrays in leaf order.	*/
+	const size_t paddedSize = nrItems + maxLeafSize;
+	this->minX.assign(paddedSize, 0);
+	this->minY.assign(paddedSize, 0);
+	this->minZ.assign(paddedSize, 0);
+	this->maxX.assign(paddedSize, 0);
+	this->maxY.assign(paddedSize, 0);
+	this->maxZ.assign(paddedSize, 0);
+	this->itemLocation.resize(nrItems);
+
+	for (size_t i = 0; i < nrItems; i++) {
+		const uint32_t item = this->items[i];
+		this->itemLocation[item] = static_cast<uint32_t>(i);
+
+		this->minX[i] = mins[item].x;
+		this->minY[i] = mins[item].y;
+		this->minZ[i] = mins[item].z;
+		this->maxX[i] = maxs[item].x;
+		this->maxY[i] = maxs[item].y;
+		this->maxZ[i] = maxs[item].z;
+	}
+
+	/*	Compute all node bounds, as a refit of every node.	*/
+	this->dirtyNodes.assign(this->nodes.size(), 1);
+	this->dirty = true;
+	this->refit();
+}
+
+void BoundingVolumeHierarchy::setBounds(const size_t item, const glm::vec3 &min, const glm::vec3 &max) noexcept {
+
+	const uint32_t location = this->itemLocation[item];
+	this->minX[location] = min.x;
+	this->minY[location] = min.y;
+	this->minZ[location] = min.z;
+	this->maxX[location] = max.x;
+	this->maxY[location] = max.y;
+	this->maxZ[location] = max.z;
+
+	/*	Mark the path to the root, stop at the first already marked node.	*/
+	uint32_t node_index = this->itemLeaf[item];
+	while (!this->dirtyNodes[node_index]) {
+		this->dirtyNodes[node_index] = 1;
+		if (node_index == 0) {
+			break;
+		}
+		node_index = this->nodes[node_index].parent;
+	}
+	this->dirty = true;
+}
+
+void BoundingVolumeHierarchy::refit() noexcept {
+
+	if (!this->dirty) {
+		return;
+	}
+
+	/*	Children are always after their parent, refit in reverse order.	*/
+	for (size_t i = this->nodes.size(); i-- > 0;) {
+		if (!this->dirtyNodes[i]) {
+			continue;
+		}
+
+		BVHNode &node = this->nodes[i];
+		if (node.rightChild == 0) {
+			this->computeLeafBounds(node);
+		} else {
+			const BVHNode &left = this->nodes[i + 1];
+			const BVHNode &right = this->nodes[node.rightChild];
+			node.min = glm::min(left.min, right.min);
+			node.max = glm::max(left.max, right.max);
+		}
+		this->dirtyNodes[i] = 0;
+	}
+
+	this->dirty = false;
+}
+
+void BoundingVolumeHierarchy::computeLeafBounds(BVHNode &node) const noexcept {
+	node.min = glm::vec3(std::numeric_limits<float>::max());
+	node.max = glm::vec3(-std::numeric_limits<float>::max());
+
+	for (uint32_t i = node.itemBegin; i < node.itemBegin + node.itemCount; i++) {
+		node.min = glm::min(node.min, glm::vec3(this->minX[i], this->minY[i], this->minZ[i]));
+		node.max = glm::max(node.max, glm::vec3(this->maxX[i], this->maxY[i], this->maxZ[i]));
+	}
+}
+
+unsigned int BoundingVolumeHierarchy::testLeaf(const size_t begin, const glm::vec4 *planes,
+											   const unsigned int planeMask) const noexcept {
+#if defined(__AVX__)
+	const __m256 minx = _mm256_loadu_ps(&this->minX[begin]);
+	const __m256 miny = _mm256_loadu_ps(&this->minY[begin]);
+	const __m256 minz = _mm256_loadu_ps(&this->minZ[begin]);
+	const __m256 maxx = _mm256_loadu_ps(&this->maxX[begin]);
+	const __m256 maxy = _mm256_loadu_ps(&this->maxY[begin]);
+	const __m256 maxz = _mm256_loadu_ps(&this->maxZ[begin]);
+
+	__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+	for (unsigned int i = 0; i < Frustum::NPLANES; i++) {
+		if ((planeMask & (1u << i)) == 0) {
+			continue;
+		}
+		const glm::vec4 &plane = planes[i];
+
+		/*	Corner furthest along the plane normal, same choice for all boxes.	*/
+		const __m256 px = plane.x >= 0 ? maxx : minx;
+		const __m256 py = plane.y >= 0 ? maxy : miny;
+		const __m256 pz = plane.z >= 0 ? maxz : minz;
+
+		__m256 distance = _mm256_mul_ps(px, _mm256_set1_ps(plane.x));
+		distance = _mm256_add_ps(distance, _mm256_mul_ps(py, _mm256_set1_ps(plane.y)));
+		distance = _mm256_add_ps(distance, _mm256_mul_ps(pz, _mm256_set1_ps(plane.z)));
+		distance = _mm256_add_ps(distance, _mm256_set1_ps(plane.w));
+
+		inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+	}
+
+	return static_cast<unsigned int>(_mm256_movemask_ps(inside));
+#else
+	/*	Same lanes as the AVX path, fixed width allows the compiler to vectorize.	*/
+	bool inside[maxLeafSize];
+	std::fill(inside, inside + maxLeafSize, true);
+
+	for (unsigned int i = 0; i < Frustum::NPLANES; i++) {
+		if ((planeMask & (1u << i)) == 0) {
+			continue;
+		}
+		const glm::vec4 &plane = planes[i];
+
+		const float *px = plane.x >= 0 ? &this->maxX[begin] : &this->minX[begin];
+		const float *py = plane.y >= 0 ? &this->maxY[begin] : &this->minY[begin];
+		const float *pz = plane.z >= 0 ? &this->maxZ[begin] : &this->minZ[begin];
+
+		for (unsigned int lane = 0; lane < maxLeafSize; lane++) {
+			const float distance = px[lane] * plane.x + py[lane] * plane.y + pz[lane] * plane.z + plane.w;
+			inside[lane] &= distance >= 0;
+		}
+	}
+
+	unsigned int mask = 0;
+	for (unsigned int lane = 0; lane < maxLeafSize; lane++) {
+		mask |= static_cast<unsigned int>(inside[lane]) << lane;
+	}
+	return mask;
+#endif
+}
+
+void BoundingVolumeHierarchy::cullSubtree(const CullTask &task, const glm::vec4 *planes,
+										  std::vector<uint32_t> &visible) const {
+
+	CullTask stack[max_traversal_depth];
+	size_t stackSize = 0;
+	stack[stackSize++] = task;
+
+	while (stackSize > 0) {
+		const CullTask current = stack[--stackSize];
+		const BVHNode &node = this->nodes[current.node];
+
+		/*	Remove the planes the node is completely inside of, they are inherited by the children.	*/
+		unsigned int planeMask = current.planeMask;
+		bool outside = false;
+		for (unsigned int i = 0; i < Frustum::NPLANES && !outside; i++) {
+			if ((planeMask & (1u << i)) == 0) {
+				continue;
+			}
+			const glm::vec3 normal = glm::vec3(planes[i]);
+			const glm::vec3 positive = glm::vec3(normal.x >= 0 ? node.max.x : node.min.x,
+												 normal.y >= 0 ? node.max.y : node.min.y,
+												 normal.z >= 0 ? node.max.z : node.min.z);
+			const glm::vec3 negative = glm::vec3(normal.x >= 0 ? node.min.x : node.max.x,
+												 normal.y >= 0 ? node.min.y : node.max.y,
+												 normal.z >= 0 ? node.min.z : node.max.z);
+
+			if (glm::dot(normal, positive) + planes[i].w < 0) {
+				outside = true;
+			} else if (glm::dot(normal, negative) + planes[i].w >= 0) {
+				planeMask &= ~(1u << i);
+			}
+		}
+
+		if (outside) {
+			continue;
+		}
+
+		/*	Completely inside the frustum, accept the whole subtree.	*/
+		if (planeMask == 0) {
+			visible.insert(visible.end(), this->items.begin() + node.itemBegin,
+						   this->items.begin() + node.itemBegin + node.itemCount);
+			continue;
+		}
+
+		if (node.rightChild == 0) {
+			const unsigned int mask =
+				this->testLeaf(node.itemBegin, planes, planeMask) & ((1u << node.itemCount) - 1u);
+			for (unsigned int lane = 0; lane < node.itemCount; lane++) {
+				if (mask & (1u << lane)) {
+					visible.push_back(this->items[node.itemBegin + lane]);
+				}
+			}
+			continue;
+		}
+
+		stack[stackSize++] = {node.rightChild, planeMask};
+		stack[stackSize++] = {current.node + 1, planeMask};
+	}
+}
+
+void BoundingVolumeHierarchy::cull(const Frustum &frustum, std::vector<uint32_t> &visible,
+								   const size_t maxThreads) const {
+
+	if (this->nodes.empty()) {
+		return;
+	}
+
+	const glm::vec4 *planes = frustum.getPlaneEquations();
+	const unsigned int allPlanes = (1u << Frustum::NPLANES) - 1u;
+
+	if (this->items.size() < parallel_cull_min_items) {
+		this->cullSubtree({0, allPlanes}, planes, visible);
+		return;
+	}
+
+	/*	Split the top of the tree into a few subtrees per thread, to balance uneven visibility.	*/
+	const size_t nrThreads = maxThreads > 0 ? maxThreads : TaskParallel::getNrWorkers() + 1;
+	std::vector<CullTask> tasks = {{0, allPlanes}};
+	while (tasks.size() < nrThreads * 4) {
+		std::vector<CullTask> subtrees;
+		subtrees.reserve(tasks.size() * 2);
+
+		for (const CullTask &task : tasks) {
+			const BVHNode &node = this->nodes[task.node];
+			if (node.rightChild == 0) {
+				subtrees.push_back(task);
+			} else {
+				subtrees.push_back({task.node + 1, task.planeMask});
+				subtrees.push_back({node.rightChild, task.planeMask});
+			}
+		}
+
+		if (subtrees.size() == tasks.size()) {
+			break;
+		}
+		tasks = std::move(subtrees);
+	}
+
+	std::vector<std::vector<uint32_t>> results(tasks.size());
+	parallelFor(
+		tasks.size(), 1,
+		[&](const size_t begin, const size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				this->cullSubtree(tasks[i], planes, results[i]);
+			}
+		},
+		maxThreads);
+
+	for (const std::vector<uint32_t> &result : results) {
+		visible.insert(visible.end(), result.begin(), result.end());
+	}
+}
+
+void BoundingVolumeHierarchy::clear() noexcept {
+	this->nodes.clear();
+	this->minX.clear();
+	this->minY.clear();
+	this->minZ.clear();
+	this->maxX.clear();
+	this->maxY.clear();
+	this->maxZ.clear();
+	this->items.clear();
+	this->itemLocation.clear();
+	this->itemLeaf.clear();
+	this->dirtyNodes.clear();
+	this->dirty = false;
+}
@@ -0,0 +1,99 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "Util/Frustum.h"
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace glsample {
+
+	/**
+	 * @brief Bounding volume hierarchy of world space AABBs, for frustum culling.
+	 *
+	 * The item bounds are stored in leaf order as a structure of arrays, min and max per axis as
+	 * contiguous floats. Each leaf holds up to 8 items, tested against the frustum planes as a single
+	 * AVX batch. Items can be moved without rebuilding the hierarchy, only the nodes above the
+	 * changed leaves are refitted.
+	 */
+	class FVDECLSPEC BoundingVolumeHierarchy {
+	  public:
+		static const unsigned int maxLeafSize = 8;
+
+		/**
+		 * @brief Build the hierarchy from the world space bounds of each item.
+		 */
+		void build(const glm::vec3 *mins, const glm::vec3 *maxs, const size_t nrItems);
+
+		/**
+		 * @brief Assign the new bounds of the item, applied to the hierarchy on the next refit.
+		 */
+		void setBounds(const size_t item, const glm::vec3 &min, const glm::vec3 &max) noexcept;
+
+		/**
+		 * @brief Refit the nodes above the leaves with changed items.
+		 */
+		void refit() noexcept;
+
+		/**
+		 * @brief Append the items intersecting the frustum, subtrees are culled on the task scheduler workers.
+		 *
+		 * @param maxThreads upper limit of threads, including the calling thread, 0 use all workers.
+		 */
+		void cull(const Frustum &frustum, std::vector<uint32_t> &visible, const size_t maxThreads = 0) const;
+
+		void clear() noexcept;
+
+		size_t getNrItems() const noexcept { return this->items.size(); }
+		size_t getNrNodes() const noexcept { return this->nodes.size(); }
+
+	  protected:
+		/*	Left child is the next node, subtree items are contiguous in leaf order.	*/
+		using BVHNode = struct bvh_node_t {
+			glm::vec3 min;
+			uint32_t itemBegin;
+			glm::vec3 max;
+			uint32_t itemCount;
+			uint32_t rightChild; /*	0 for leaves.	*/
+			uint32_t parent;
+		};
+
+		using CullTask = struct cull_task_t {
+			uint32_t node;
+			unsigned int planeMask;
+		};
+
+		void cullSubtree(const CullTask &task, const glm::vec4 *planes, std::vector<uint32_t> &visible) const;
+		unsigned int testLeaf(const size_t begin, const glm::vec4 *planes, const unsigned int planeMask) const noexcept;
+		void computeLeafBounds(BVHNode &node) const noexcept;
+
+	  private:
+		std::vector<BVHNode> nodes;
+
+		/*	Item bounds in leaf order, padded to a multiple of the leaf size.	*/
+		std::vector<float> minX, minY, minZ;
+		std::vector<float> maxX, maxY, maxZ;
+
+		std::vector<uint32_t> items;		/*	Leaf order to item.	*/
+		std::vector<uint32_t> itemLocation; /*	Item to leaf order.	*/
+		std::vector<uint32_t> itemLeaf;		/*	Item to leaf node.	*/
+
+		std::vector<uint8_t> dirtyNodes;
+		bool dirty = false;
+	};
+
+} // namespace glsample
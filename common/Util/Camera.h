@@ -35,6 +35,8 @@ namespace glsample {
 	  public:
 		Camera() noexcept { this->updateProjectionMatrix(); }
 
+		using Frustum::calcFrustumPlanes;
+
 		void calcFrustumPlanes(const Vector3 &position, const Vector3 &look_forward, const Vector3 &up,
 							   const Vector3 &right) override {
 			/*	*/
@@ -45,14 +47,14 @@ namespace glsample {
 			const Vector3 farDistance = this->getFar() * look_forward;
 
 			/*	*/
-			this->planes[NEAR_PLANE] = {position + this->getNear() * look_forward, look_forward};
-			this->planes[FAR_PLANE] = {position + farDistance, -look_forward};
+			this->setPlane(NEAR_PLANE, position + this->getNear() * look_forward, look_forward);
+			this->setPlane(FAR_PLANE, position + farDistance, -look_forward);
 
-			this->planes[RIGHT_PLANE] = {position, (farDistance - right * halfHSide).cross(up)};
-			this->planes[LEFT_PLANE] = {position, up.cross(farDistance + right * halfHSide)};
+			this->setPlane(RIGHT_PLANE, position, (farDistance - right * halfHSide).cross(up));
+			this->setPlane(LEFT_PLANE, position, up.cross(farDistance + right * halfHSide));
 
-			this->planes[TOP_PLANE] = {position, right.cross(farDistance - up * halfVSide)};
-			this->planes[BOTTOM_PLANE] = {position, (farDistance + up * halfVSide).cross(right)};
+			this->setPlane(TOP_PLANE, position, right.cross(farDistance - up * halfVSide));
+			this->setPlane(BOTTOM_PLANE, position, (farDistance + up * halfVSide).cross(right));
 		}
 
 		void setAspect(const float aspect) noexcept {
@@ -103,15 +103,11 @@ bool CameraController::hasMoved() const noexcept { return true; }
 void CameraController::update() noexcept {
 	flythrough_camera_update(&this->pos[0], &this->look[0], &this->up[0], &this->view[0][0], 0, 0, 0.5f * activated,
 							 this->fov_degree, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+	this->updateFrustum();
 }
 
 void CameraController::updateFrustum() {
-
-	/*	*/
-	const Vector3 position = Vector3(this->pos[0], this->pos[1], this->pos[2]);
-	const Vector3 look = Vector3(this->look[0], this->look[1], this->look[2]).normalized();
-	const Vector3 up = Vector3(this->up[0], this->up[1], this->up[2]).normalized();
-	const Vector3 right = look.cross(up).normalized();
-
-	this->calcFrustumPlanes(position, look, up, right);
-}
\ No newline at end of file
+	/*	Planes from the same matrices used for rendering.	*/
+	this->calcFrustumPlanes(this->getProjectionMatrix() * this->getViewMatrix());
+}
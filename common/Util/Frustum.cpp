@@ -1,12 +1,76 @@
 #include "Util/Frustum.h"
+#include <cmath>
 
 namespace glsample {
 
-	Frustum::Frustum(const Frustum &other) : Node(other) {}
+	Frustum::Frustum(const Frustum &other) : Node(other) {
+		for (unsigned int i = 0; i < FrustumPlanes::NPLANES; i++) {
+			this->planes[i] = other.planes[i];
+			this->planeEquations[i] = other.planeEquations[i];
+		}
+	}
 
 	void Frustum::calcFrustumPlanes(const Vector3 &position, const Vector3 &look_forward, const Vector3 &up,
 									const Vector3 &right) {}
 
+	void Frustum::calcFrustumPlanes(const glm::mat4 &viewProjection) {
+
+		/*	Rows of the matrix, glm is column major.	*/
+		const glm::vec4 rowX = glm::vec4(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0],
+										 viewProjection[3][0]);
+		const glm::vec4 rowY = glm::vec4(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1],
+										 viewProjection[3][1]);
+		const glm::vec4 rowZ = glm::vec4(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2],
+										 viewProjection[3][2]);
+		const glm::vec4 rowW = glm::vec4(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3],
+										 viewProjection[3][3]);
+
+		/*	Clip space -w <= x,y,z <= w.	*/
+		glm::vec4 equations[FrustumPlanes::NPLANES];
+		equations[LEFT_PLANE] = rowW + rowX;
+		equations[RIGHT_PLANE] = rowW - rowX;
+		equations[BOTTOM_PLANE] = rowW + rowY;
+		equations[TOP_PLANE] = rowW - rowY;
+		equations[NEAR_PLANE] = rowW + rowZ;
+		equations[FAR_PLANE] = rowW - rowZ;
+
+		for (unsigned int i = 0; i < FrustumPlanes::NPLANES; i++) {
+			const glm::vec3 normal = glm::vec3(equations[i]);
+			const float length = glm::length(normal);
+			const glm::vec3 point = normal * (-equations[i].w / (length * length));
+
+			this->setPlane(i, Vector3(point.x, point.y, point.z), Vector3(normal.x, normal.y, normal.z));
+		}
+	}
+
+	void Frustum::setPlane(const unsigned int index, const Vector3 &point, const Vector3 &normal) {
+		this->planes[index] = {point, normal};
+
+		const Vector3 unitNormal = normal.normalized();
+		this->planeEquations[index] =
+			glm::vec4(unitNormal.x(), unitNormal.y(), unitNormal.z(), -unitNormal.dot(point));
+	}
+
+	void Frustum::computeCorners(glm::vec3 corners[8]) const noexcept {
+
+		const unsigned int horizontal[2] = {LEFT_PLANE, RIGHT_PLANE};
+		const unsigned int vertical[2] = {BOTTOM_PLANE, TOP_PLANE};
+		const unsigned int depth[2] = {NEAR_PLANE, FAR_PLANE};
+
+		for (unsigned int i = 0; i < 8; i++) {
+			const glm::vec4 &a = this->planeEquations[horizontal[i & 1]];
+			const glm::vec4 &b = this->planeEquations[vertical[(i >> 1) & 1]];
+			const glm::vec4 &c = this->planeEquations[depth[(i >> 2) & 1]];
+
+			const glm::vec3 bc = glm::cross(glm::vec3(b), glm::vec3(c));
+			const glm::vec3 ca = glm::cross(glm::vec3(c), glm::vec3(a));
+			const glm::vec3 ab = glm::cross(glm::vec3(a), glm::vec3(b));
+
+			const float denominator = glm::dot(glm::vec3(a), bc);
+			corners[i] = (bc * -a.w + ca * -b.w + ab * -c.w) / denominator;
+		}
+	}
+
 	Frustum::Intersection Frustum::checkPoint(const Vector3 &pos) const noexcept {
 
 		/*	Iterate through each plane.	*/
@@ -35,11 +99,28 @@ namespace glsample {
 		return result;
 	}
 
-	Frustum::Intersection Frustum::intersectionOBB(const Vector3 &u, const Vector3 &v,
+	Frustum::Intersection Frustum::intersectionOBB(const Vector3 &center, const Vector3 &u, const Vector3 &v,
 												   const Vector3 &w) const noexcept {
-		return Intersection::Out;
+		Frustum::Intersection result = Frustum::In;
+
+		for (unsigned int i = 0; i < FrustumPlanes::NPLANES; i++) {
+			const Vector3 normal =
+				Vector3(this->planeEquations[i].x, this->planeEquations[i].y, this->planeEquations[i].z);
+
+			/*	Projected radius of the box onto the plane normal.	*/
+			const float radius = std::fabs(normal.dot(u)) + std::fabs(normal.dot(v)) + std::fabs(normal.dot(w));
+			const float distance = normal.dot(center) + this->planeEquations[i].w;
+
+			if (distance < -radius) {
+				return Intersection::Out;
+			}
+			if (distance < radius) {
+				result = Intersection::Intersect;
+			}
+		}
+
+		return result;
 	}
-	Frustum::Intersection Frustum::intersectionOBB(const OBB &obb) const noexcept { return Out; }
 
 	Frustum::Intersection Frustum::intersectionSphere(const Vector3 &pos, float radius) const noexcept {
 		return Frustum::intersectionSphere(BoundingSphere(pos, radius));
@@ -58,7 +139,38 @@ namespace glsample {
 	Frustum::Intersection Frustum::intersectPlane(const Plane<float> &plane) const noexcept { return Intersection::In; }
 
 	Frustum::Intersection Frustum::intersectionFrustum(const Frustum &frustum) const noexcept {
-		return Intersection::In;
+
+		glm::vec3 corners[8];
+		glm::vec3 otherCorners[8];
+		this->computeCorners(corners);
+		frustum.computeCorners(otherCorners);
+
+		/*	Separated if all the corners of either frustum are outside a single plane of the other.	*/
+		bool inside = true;
+		for (unsigned int i = 0; i < FrustumPlanes::NPLANES; i++) {
+			unsigned int nrOutside = 0;
+			for (unsigned int c = 0; c < 8; c++) {
+				const glm::vec4 &plane = this->planeEquations[i];
+				nrOutside += (glm::dot(glm::vec3(plane), otherCorners[c]) + plane.w) < 0;
+			}
+			if (nrOutside == 8) {
+				return Intersection::Out;
+			}
+			inside &= nrOutside == 0;
+		}
+
+		for (unsigned int i = 0; i < FrustumPlanes::NPLANES; i++) {
+			unsigned int nrOutside = 0;
+			for (unsigned int c = 0; c < 8; c++) {
+				const glm::vec4 &plane = frustum.planeEquations[i];
+				nrOutside += (glm::dot(glm::vec3(plane), corners[c]) + plane.w) < 0;
+			}
+			if (nrOutside == 8) {
+				return Intersection::Out;
+			}
+		}
+
+		return inside ? Intersection::In : Intersection::Intersect;
 	}
 
 } // namespace glsample
\ No newline at end of file
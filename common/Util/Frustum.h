@@ -19,6 +19,7 @@
 #include <GeometryUtil.h>
 #include <Math3D/BoundingSphere.h>
 #include <Math3D/Plane.h>
+#include <glm/glm.hpp>
 
 namespace glsample {
 
@@ -62,6 +63,16 @@ namespace glsample {
 		Plane<float> &getPlane(int index) { return this->planes[index]; }
 		const Plane<float> &getPlane(int index) const { return this->planes[index]; }
 
+		/**
+		 * @brief Normalized plane equation, xyz the normal and w the distance.
+		 *
+		 * A point p is on the inside of the plane if dot(xyz, p) + w >= 0.
+		 */
+		const glm::vec4 &getPlaneEquation(const unsigned int index) const noexcept {
+			return this->planeEquations[index];
+		}
+		const glm::vec4 *getPlaneEquations() const noexcept { return this->planeEquations; }
+
 		/**
 		 *	Comput the frustum planes,
 		 *	planes normal pointing positive towards the frustum volume.
@@ -69,6 +80,11 @@ namespace glsample {
 		virtual void calcFrustumPlanes(const Vector3 &position, const Vector3 &look_forward, const Vector3 &up,
 									   const Vector3 &right);
 
+		/**
+		 * @brief Extract the frustum planes from the view projection matrix, with OpenGL clip space depth.
+		 */
+		void calcFrustumPlanes(const glm::mat4 &viewProjection);
+
 		/**
 		 *	Check if point is inside the frustum.
 		 *	@Return eIn if inside frustum, eOut otherwise.
@@ -85,8 +101,12 @@ namespace glsample {
 
 		virtual Intersection intersectionAABB(const AABB &bounds) const noexcept;
 
-		virtual Intersection intersectionOBB(const Vector3 &u, const Vector3 &v, const Vector3 &w) const noexcept;
-		virtual Intersection intersectionOBB(const OBB &obb) const noexcept;
+		/**
+		 * @brief Check if the oriented box intersects the frustum.
+		 * @param u,v,w half size axes of the box.
+		 */
+		virtual Intersection intersectionOBB(const Vector3 &center, const Vector3 &u, const Vector3 &v,
+											 const Vector3 &w) const noexcept;
 
 		/**
 		 *	Check if sphere intersects frustum.
@@ -111,8 +131,15 @@ namespace glsample {
 		Frustum() = default;
 		Frustum(const Frustum &other);
 
-	  protected:				/*	Attributes.	*/
-		Plane<float> planes[6]; /*	*/
+		/*	Assign both the plane and its normalized equation.	*/
+		void setPlane(const unsigned int index, const Vector3 &point, const Vector3 &normal);
+
+		/*	Corners as the intersection of three planes, near plane corners first.	*/
+		void computeCorners(glm::vec3 corners[8]) const noexcept;
+
+	  protected:					   /*	Attributes.	*/
+		Plane<float> planes[6];		   /*	*/
+		glm::vec4 planeEquations[6]{}; /*	*/
 	};
 
 } // namespace glsample
\ No newline at end of file
@@ -0,0 +1,34 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace glsample {
+
+	/**
+	 * @brief FNV-1a 64 bit hash, can be chained by passing the previous hash.
+	 */
+	inline uint64_t hashBytes(const void *data, const size_t size, uint64_t hash = 0xcbf29ce484222325ull) noexcept {
+		const uint8_t *bytes = static_cast<const uint8_t *>(data);
+		for (size_t i = 0; i < size; i++) {
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+} // namespace glsample
@@ -34,6 +34,8 @@ namespace glsample {
 	  public:
 		Light() noexcept { this->updateProjectionMatrix(); }
 
+		using Frustum::calcFrustumPlanes;
+
 		void calcFrustumPlanes(const Vector3 &position, const Vector3 &look_forward, const Vector3 &up,
 							   const Vector3 &right) override {}
 
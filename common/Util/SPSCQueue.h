@@ -0,0 +1,94 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace glsample {
+
+	/**
+	 * @brief Bounded lock-free queue, for exactly one producer thread and one consumer thread.
+	 *
+	 * push never blocks, it fails when the queue is full. The consumer may peek at the front item before
+	 * popping it.
+	 */
+	template <typename T> class SPSCQueue {
+	  public:
+		explicit SPSCQueue(const size_t capacity) : items(capacity + 1) {}
+		SPSCQueue(const SPSCQueue &) = delete;
+		SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+		/**
+		 * @brief Producer only.
+		 * @return false if the queue is full.
+		 */
+		bool push(const T &item) noexcept {
+			const size_t tail = this->tail.load(std::memory_order_relaxed);
+			const size_t next = this->increment(tail);
+			if (next == this->head.load(std::memory_order_acquire)) {
+				return false;
+			}
+
+			this->items[tail] = item;
+			this->tail.store(next, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Consumer only.
+		 * @return false if the queue is empty.
+		 */
+		bool pop(T &item) noexcept {
+			const size_t head = this->head.load(std::memory_order_relaxed);
+			if (head == this->tail.load(std::memory_order_acquire)) {
+				return false;
+			}
+
+			item = this->items[head];
+			this->head.store(this->increment(head), std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Consumer only, the item stays valid until it is popped.
+		 * @return nullptr if the queue is empty.
+		 */
+		const T *front() const noexcept {
+			const size_t head = this->head.load(std::memory_order_relaxed);
+			if (head == this->tail.load(std::memory_order_acquire)) {
+				return nullptr;
+			}
+			return &this->items[head];
+		}
+
+		bool empty() const noexcept {
+			return this->head.load(std::memory_order_acquire) == this->tail.load(std::memory_order_acquire);
+		}
+
+		size_t capacity() const noexcept { return this->items.size() - 1; }
+
+	  private:
+		size_t increment(const size_t index) const noexcept { return (index + 1) % this->items.size(); }
+
+		std::vector<T> items;
+
+		/*	Separate cache lines, written by the consumer and the producer respectively.	*/
+		alignas(64) std::atomic<size_t> head{0};
+		alignas(64) std::atomic<size_t> tail{0};
+	};
+
+} // namespace glsample
@@ -0,0 +1,73 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include <Core/Time.h>
+
+namespace glsample {
+
+	/**
+	 * @brief Frame timer of the sample, either the real time or a fixed simulated time step.
+	 *
+	 * With a fixed delta time, every frame advances the simulated time by the same step regardless of how
+	 * long the frame took, so animations and simulations are identical between runs and machines.
+	 */
+	class SampleTime {
+	  public:
+		void start() noexcept {
+			this->time.start();
+			this->simulatedElapsed = 0;
+		}
+
+		void update() noexcept {
+			this->time.update();
+			this->simulatedElapsed += this->fixedDeltaTime;
+		}
+
+		template <typename T> T deltaTime() const noexcept {
+			if (this->isFixed()) {
+				return static_cast<T>(this->fixedDeltaTime);
+			}
+			return this->time.deltaTime<T>();
+		}
+
+		template <typename T> T getElapsed() const noexcept {
+			if (this->isFixed()) {
+				return static_cast<T>(this->simulatedElapsed);
+			}
+			return this->time.getElapsed<T>();
+		}
+
+		auto getTimeResolution() const noexcept { return this->time.getTimeResolution(); }
+
+		/**
+		 * @brief Time step of each frame in seconds, 0 to use the real time.
+		 */
+		void setFixedDeltaTime(const double deltaTime) noexcept { this->fixedDeltaTime = deltaTime; }
+		double getFixedDeltaTime() const noexcept { return this->fixedDeltaTime; }
+		bool isFixed() const noexcept { return this->fixedDeltaTime > 0; }
+
+		/**
+		 * @brief Wall clock time, regardless of the fixed time step.
+		 */
+		const fragcore::Time &getRealTime() const noexcept { return this->time; }
+
+	  private:
+		fragcore::Time time;
+		double fixedDeltaTime = 0;
+		double simulatedElapsed = 0;
+	};
+
+} // namespace glsample
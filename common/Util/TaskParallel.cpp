@@ -0,0 +1,111 @@
+#include "Util/TaskParallel.h"
+#include "TaskScheduler/Task.h"
+#include <Math/Math.h>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+using namespace glsample;
+
+fragcore::IScheduler *TaskParallel::scheduler = nullptr;
+size_t TaskParallel::nrWorkers = 0;
+
+namespace {
+
+	/*	State of a single loop, shared between the calling thread and its tasks.	*/
+	struct LoopState {
+		const std::function<void(size_t, size_t)> *func = nullptr;
+		size_t count = 0;
+		size_t grain = 1;
+		size_t nrChunks = 0;
+		std::atomic<size_t> nextChunk{0};
+
+		size_t pendingTasks = 0;
+		std::mutex lock;
+		std::condition_variable completed;
+		std::exception_ptr exception = nullptr;
+
+		void work() noexcept {
+			size_t chunk = 0;
+			while ((chunk = this->nextChunk.fetch_add(1, std::memory_order_relaxed)) < this->nrChunks) {
+				const size_t begin = chunk * this->grain;
+				const size_t end = fragcore::Math::min<size_t>(begin + this->grain, this->count);
+				try {
+					(*this->func)(begin, end);
+				} catch (...) {
+					std::lock_guard<std::mutex> guard(this->lock);
+					if (!this->exception) {
+						this->exception = std::current_exception();
+					}
+				}
+			}
+		}
+	};
+
+	class LoopTask : public fragcore::Task {
+	  public:
+		void Execute() noexcept override { this->state->work(); }
+
+		/*	Called by the worker once it no longer references the task, the tasks and the state are released by the
+		 *	calling thread once the last task has signaled.	*/
+		void Complete() noexcept override {
+			std::lock_guard<std::mutex> guard(this->state->lock);
+			if (--this->state->pendingTasks == 0) {
+				this->state->completed.notify_one();
+			}
+		}
+
+		LoopState *state = nullptr;
+	};
+} // namespace
+
+void TaskParallel::setScheduler(fragcore::IScheduler *scheduler, const size_t nrWorkers) noexcept {
+	TaskParallel::scheduler = scheduler;
+	TaskParallel::nrWorkers = scheduler ? nrWorkers : 0;
+}
+
+void TaskParallel::dispatch(const size_t count, const size_t grainSize,
+							const std::function<void(size_t, size_t)> &func, const size_t maxThreads) {
+
+	if (count == 0) {
+		return;
+	}
+
+	LoopState state;
+	state.func = &func;
+	state.count = count;
+	state.grain = fragcore::Math::max<size_t>(grainSize, 1);
+	state.nrChunks = (count + state.grain - 1) / state.grain;
+
+	/*	The calling thread is used as one of the workers.	*/
+	const size_t nrThreads = maxThreads > 0 ? fragcore::Math::min<size_t>(maxThreads, TaskParallel::nrWorkers + 1)
+											: TaskParallel::nrWorkers + 1;
+	const size_t nrTasks = fragcore::Math::min<size_t>(nrThreads, state.nrChunks) - 1;
+
+	std::vector<LoopTask> tasks(nrTasks);
+	state.pendingTasks = nrTasks;
+	for (size_t task_index = 0; task_index < nrTasks; task_index++) {
+		tasks[task_index].state = &state;
+		try {
+			TaskParallel::scheduler->addTask(&tasks[task_index]);
+		} catch (...) {
+			/*	Remaining chunks are processed by the submitted tasks and the calling thread.	*/
+			std::lock_guard<std::mutex> guard(state.lock);
+			state.pendingTasks -= nrTasks - task_index;
+			break;
+		}
+	}
+
+	state.work();
+
+	if (nrTasks > 0) {
+		std::unique_lock<std::mutex> guard(state.lock);
+		state.completed.wait(guard, [&state]() { return state.pendingTasks == 0; });
+	}
+
+	if (state.exception) {
+		std::rethrow_exception(state.exception);
+	}
+}
@@ -0,0 +1,62 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2025 Valdemar Lindberg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+#pragma once
+#include "TaskScheduler/IScheduler.h"
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace glsample {
+
+	/**
+	 * @brief Parallel loops on the persistent workers of the fragcore task scheduler.
+	 *
+	 * The scheduler is assigned once by the sample on startup. Without a scheduler, loops run on the
+	 * calling thread.
+	 */
+	class FVDECLSPEC TaskParallel {
+	  public:
+		static void setScheduler(fragcore::IScheduler *scheduler, const size_t nrWorkers) noexcept;
+		static fragcore::IScheduler *getScheduler() noexcept { return TaskParallel::scheduler; }
+		static size_t getNrWorkers() noexcept { return TaskParallel::nrWorkers; }
+
+		/**
+		 * @brief Execute func(begin, end) over [0, count), in chunks of grainSize items.
+		 *
+		 * The calling thread claims chunks along with the scheduler workers, so uneven workloads are
+		 * balanced dynamically. The first exception thrown by any chunk is rethrown on the calling thread
+		 * once all chunks are completed. Must not be called from a task of the scheduler.
+		 *
+		 * @param maxThreads upper limit of threads, including the calling thread, 0 use all workers.
+		 */
+		static void dispatch(const size_t count, const size_t grainSize,
+							 const std::function<void(size_t, size_t)> &func, const size_t maxThreads = 0);
+
+	  private:
+		static fragcore::IScheduler *scheduler;
+		static size_t nrWorkers;
+	};
+
+	/**
+	 * @brief Execute func(begin, end) over [0, count) on the task scheduler, see TaskParallel::dispatch.
+	 */
+	template <typename Func>
+	void parallelFor(const size_t count, const size_t grainSize, Func &&func, const size_t maxThreads = 0) {
+		TaskParallel::dispatch(count, grainSize, std::function<void(size_t, size_t)>(std::forward<Func>(func)),
+							   maxThreads);
+	}
+
+} // namespace glsample